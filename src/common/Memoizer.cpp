@@ -19,29 +19,62 @@
  **/
  
 #include "Memoizer.h"
+#include "thread/threads.h"
 
+// C++
+#include <functional>
 #include <unordered_map>
 
 namespace love
 {
 
-static std::unordered_map<void *, void *> objectMap;
+namespace
+{
+
+struct Shard
+{
+	thread::MutexRef mutex;
+	std::unordered_map<void *, void *> objects;
+};
+
+// Must be a power of two.
+const size_t SHARD_COUNT = 16;
+
+Shard shards[SHARD_COUNT];
+
+Shard &getShard(void *key)
+{
+	// Pointers are aligned, so the low bits alone would pick few shards.
+	size_t h = std::hash<void *>()(key);
+	h ^= h >> 4;
+	h ^= h >> 9;
+	return shards[h & (SHARD_COUNT - 1)];
+}
+
+} // anonymous namespace
 
 void Memoizer::add(void *key, void *val)
 {
-	objectMap[key] = val;
+	Shard &shard = getShard(key);
+	thread::Lock lock(shard.mutex);
+	shard.objects[key] = val;
 }
 
 void Memoizer::remove(void *key)
 {
-	objectMap.erase(key);
+	Shard &shard = getShard(key);
+	thread::Lock lock(shard.mutex);
+	shard.objects.erase(key);
 }
 
 void *Memoizer::find(void *key)
 {
-	auto it = objectMap.find(key);
+	Shard &shard = getShard(key);
+	thread::Lock lock(shard.mutex);
+
+	auto it = shard.objects.find(key);
 
-	if (it != objectMap.end())
+	if (it != shard.objects.end())
 		return it->second;
 	else
 		return nullptr;
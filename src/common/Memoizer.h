@@ -24,6 +24,14 @@
 namespace love
 {
 
+/**
+ * Maps arbitrary pointers to other pointers. Safe to use from several threads
+ * at once: keys are spread over independently locked shards, so unrelated
+ * lookups rarely wait on each other.
+ *
+ * Prefer storing a back-pointer in the object itself where one can be had,
+ * love.physics does that with Box2D's user data for example.
+ **/
 class Memoizer
 {
 public:
@@ -50,6 +50,7 @@ public:
 		M_MATH,
 		M_MOUSE,
 		M_PHYSICS,
+		M_PROFILER,
 		M_SOUND,
 		M_SYSTEM,
 		M_THREAD,
@@ -147,6 +147,26 @@ Variant &Variant::operator = (const Variant &v)
 	return *this;
 }
 
+Variant &Variant::operator = (Variant &&v)
+{
+	if (this == &v)
+		return *this;
+
+	if (type == STRING)
+		data.string->release();
+	else if (type == LOVEOBJECT && data.objectproxy.object != nullptr)
+		data.objectproxy.object->release();
+	else if (type == TABLE)
+		data.table->release();
+
+	type = v.type;
+	data = v.data;
+
+	v.type = NIL;
+
+	return *this;
+}
+
 Variant Variant::fromLua(lua_State *L, int n, std::set<const void*> *tableSet)
 {
 	size_t len;
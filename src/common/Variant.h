@@ -61,6 +61,7 @@ public:
 	~Variant();
 
 	Variant &operator = (const Variant &v);
+	Variant &operator = (Variant &&v);
 
 	Type getType() const { return type; }
 
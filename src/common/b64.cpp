@@ -19,10 +19,20 @@
  **/
 
 #include "b64.h"
+#include "int.h"
 #include "Exception.h"
 
 #include <limits>
-#include <stdio.h>
+#include <algorithm>
+#include <string.h>
+
+#if defined(LOVE_SIMD_AVX2)
+#include <immintrin.h>
+#elif defined(LOVE_SIMD_SSSE3)
+#include <tmmintrin.h>
+#elif defined(LOVE_SIMD_NEON)
+#include <arm_neon.h>
+#endif
 
 namespace love
 {
@@ -30,32 +40,372 @@ namespace love
 // Translation table as described in RFC1113
 static const char cb64[]="ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
 
-// Translation table to decode (created by Bob Trower)
-static const char cd64[]="|$$$}rstuvwxyz{$$$$$$$>?@ABCDEFGHIJKLMNOPQRSTUVW$$$$$$XYZ[\\]^_`abcdefghijklmnopq";
+// Maps characters to their 6-bit values, or 0xFF for characters outside of the
+// base64 alphabet.
+static const uint8 cd64[256] =
+{
+	255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,  62, 255, 255, 255,  63,
+	 52,  53,  54,  55,  56,  57,  58,  59,  60,  61, 255, 255, 255, 255, 255, 255,
+	255,   0,   1,   2,   3,   4,   5,   6,   7,   8,   9,  10,  11,  12,  13,  14,
+	 15,  16,  17,  18,  19,  20,  21,  22,  23,  24,  25, 255, 255, 255, 255, 255,
+	255,  26,  27,  28,  29,  30,  31,  32,  33,  34,  35,  36,  37,  38,  39,  40,
+	 41,  42,  43,  44,  45,  46,  47,  48,  49,  50,  51, 255, 255, 255, 255, 255,
+	255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+};
+
+static const uint8 B64_INVALID = 0xFF;
+
+#if defined(LOVE_SIMD_SSSE3)
+
+// The SSSE3 and AVX2 codecs are based on the approach described by Wojciech
+// Mula and Alfred Klomp: bytes are reshuffled into 6-bit lanes with shuffles
+// and multiplies, and translated to/from ASCII with small lookup tables.
+
+static inline __m128i b64_enc_reshuffle(__m128i in)
+{
+	in = _mm_shuffle_epi8(in, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+
+	const __m128i t0 = _mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00));
+	const __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+	const __m128i t2 = _mm_and_si128(in, _mm_set1_epi32(0x003f03f0));
+	const __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+
+	return _mm_or_si128(t1, t3);
+}
+
+static inline __m128i b64_enc_translate(__m128i in)
+{
+	const __m128i lut = _mm_setr_epi8(65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0);
+
+	__m128i indices = _mm_subs_epu8(in, _mm_set1_epi8(51));
+	__m128i mask = _mm_cmpgt_epi8(in, _mm_set1_epi8(25));
+	indices = _mm_sub_epi8(indices, mask);
+
+	return _mm_add_epi8(in, _mm_shuffle_epi8(lut, indices));
+}
+
+// Decodes 16 characters into 12 bytes. Returns false (without writing
+// anything) if any of the characters are outside of the base64 alphabet.
+static inline bool b64_dec_block16(const uint8 *src, uint8 *dst)
+{
+	const __m128i lut_lo = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+	const __m128i lut_hi = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+	const __m128i lut_roll = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+	const __m128i mask_2F = _mm_set1_epi8(0x2F);
+
+	__m128i str = _mm_loadu_si128((const __m128i *) src);
+
+	const __m128i hi_nibbles = _mm_and_si128(_mm_srli_epi32(str, 4), mask_2F);
+	const __m128i lo_nibbles = _mm_and_si128(str, mask_2F);
+	const __m128i hi = _mm_shuffle_epi8(lut_hi, hi_nibbles);
+	const __m128i lo = _mm_shuffle_epi8(lut_lo, lo_nibbles);
+
+	if (_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_and_si128(lo, hi), _mm_setzero_si128())) != 0)
+		return false;
+
+	const __m128i eq_2F = _mm_cmpeq_epi8(str, mask_2F);
+	const __m128i roll = _mm_shuffle_epi8(lut_roll, _mm_add_epi8(eq_2F, hi_nibbles));
+
+	str = _mm_add_epi8(str, roll);
+
+	const __m128i merged = _mm_maddubs_epi16(str, _mm_set1_epi32(0x01400140));
+	__m128i out = _mm_madd_epi16(merged, _mm_set1_epi32(0x00011000));
+	out = _mm_shuffle_epi8(out, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+
+	_mm_storel_epi64((__m128i *) dst, out);
+	int32 last = _mm_cvtsi128_si32(_mm_srli_si128(out, 8));
+	memcpy(dst + 8, &last, sizeof(int32));
+
+	return true;
+}
+
+#endif // LOVE_SIMD_SSSE3
+
+#if defined(LOVE_SIMD_AVX2)
+
+// Decodes 32 characters into 24 bytes. Returns false (without writing
+// anything) if any of the characters are outside of the base64 alphabet.
+static inline bool b64_dec_block32(const uint8 *src, uint8 *dst)
+{
+	const __m256i lut_lo = _mm256_setr_epi8(
+		0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A,
+		0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+	const __m256i lut_hi = _mm256_setr_epi8(
+		0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+		0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+	const __m256i lut_roll = _mm256_setr_epi8(
+		0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+	const __m256i mask_2F = _mm256_set1_epi8(0x2F);
+
+	__m256i str = _mm256_loadu_si256((const __m256i *) src);
+
+	const __m256i hi_nibbles = _mm256_and_si256(_mm256_srli_epi32(str, 4), mask_2F);
+	const __m256i lo_nibbles = _mm256_and_si256(str, mask_2F);
+	const __m256i hi = _mm256_shuffle_epi8(lut_hi, hi_nibbles);
+	const __m256i lo = _mm256_shuffle_epi8(lut_lo, lo_nibbles);
+
+	if (!_mm256_testz_si256(lo, hi))
+		return false;
+
+	const __m256i eq_2F = _mm256_cmpeq_epi8(str, mask_2F);
+	const __m256i roll = _mm256_shuffle_epi8(lut_roll, _mm256_add_epi8(eq_2F, hi_nibbles));
+
+	str = _mm256_add_epi8(str, roll);
+
+	const __m256i merged = _mm256_maddubs_epi16(str, _mm256_set1_epi32(0x01400140));
+	__m256i out = _mm256_madd_epi16(merged, _mm256_set1_epi32(0x00011000));
+	out = _mm256_shuffle_epi8(out, _mm256_setr_epi8(
+		2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+		2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+
+	// Move the 12 bytes in each lane next to each other.
+	out = _mm256_permutevar8x32_epi32(out, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, -1, -1));
+
+	_mm_storeu_si128((__m128i *) dst, _mm256_castsi256_si128(out));
+	_mm_storel_epi64((__m128i *) (dst + 16), _mm256_extracti128_si256(out, 1));
+
+	return true;
+}
+
+#endif // LOVE_SIMD_AVX2
+
+#if defined(LOVE_SIMD_NEON)
+
+static inline uint8x16_t b64_enc_translate(uint8x16_t in)
+{
+	// Offsets from the 6-bit value to its ASCII character, for each of the
+	// ranges in the alphabet.
+	uint8x16_t offset = vdupq_n_u8(65);
+	offset = vaddq_u8(offset, vandq_u8(vcgeq_u8(in, vdupq_n_u8(26)), vdupq_n_u8(6)));
+	offset = vsubq_u8(offset, vandq_u8(vcgeq_u8(in, vdupq_n_u8(52)), vdupq_n_u8(75)));
+	offset = vsubq_u8(offset, vandq_u8(vcgeq_u8(in, vdupq_n_u8(62)), vdupq_n_u8(15)));
+	offset = vaddq_u8(offset, vandq_u8(vcgeq_u8(in, vdupq_n_u8(63)), vdupq_n_u8(3)));
+	return vaddq_u8(in, offset);
+}
+
+static inline uint8x16_t b64_dec_translate(uint8x16_t in, uint8x16_t &valid)
+{
+	uint8x16_t upper = vsubq_u8(in, vdupq_n_u8('A'));
+	uint8x16_t lower = vsubq_u8(in, vdupq_n_u8('a' - 26));
+	uint8x16_t digit = vaddq_u8(in, vdupq_n_u8(52 - '0'));
+
+	uint8x16_t isupper = vcltq_u8(upper, vdupq_n_u8(26));
+	uint8x16_t islower = vcltq_u8(vsubq_u8(in, vdupq_n_u8('a')), vdupq_n_u8(26));
+	uint8x16_t isdigit = vcltq_u8(vsubq_u8(in, vdupq_n_u8('0')), vdupq_n_u8(10));
+	uint8x16_t isplus = vceqq_u8(in, vdupq_n_u8('+'));
+	uint8x16_t isslash = vceqq_u8(in, vdupq_n_u8('/'));
+
+	valid = vandq_u8(valid, vorrq_u8(vorrq_u8(isupper, islower), vorrq_u8(isdigit, vorrq_u8(isplus, isslash))));
+
+	uint8x16_t out = vandq_u8(upper, isupper);
+	out = vorrq_u8(out, vandq_u8(lower, islower));
+	out = vorrq_u8(out, vandq_u8(digit, isdigit));
+	out = vorrq_u8(out, vandq_u8(vdupq_n_u8(62), isplus));
+	out = vorrq_u8(out, vandq_u8(vdupq_n_u8(63), isslash));
+	return out;
+}
+
+// Decodes 64 characters into 48 bytes. Returns false (without writing
+// anything) if any of the characters are outside of the base64 alphabet.
+static inline bool b64_dec_block64(const uint8 *src, uint8 *dst)
+{
+	uint8x16x4_t in = vld4q_u8(src);
+	uint8x16_t valid = vdupq_n_u8(0xFF);
+
+	uint8x16_t a = b64_dec_translate(in.val[0], valid);
+	uint8x16_t b = b64_dec_translate(in.val[1], valid);
+	uint8x16_t c = b64_dec_translate(in.val[2], valid);
+	uint8x16_t d = b64_dec_translate(in.val[3], valid);
+
+	uint8x8_t v = vand_u8(vget_low_u8(valid), vget_high_u8(valid));
+	if (vget_lane_u64(vreinterpret_u64_u8(v), 0) != ~0ULL)
+		return false;
+
+	uint8x16x3_t out;
+	out.val[0] = vorrq_u8(vshlq_n_u8(a, 2), vshrq_n_u8(b, 4));
+	out.val[1] = vorrq_u8(vshlq_n_u8(b, 4), vshrq_n_u8(c, 2));
+	out.val[2] = vorrq_u8(vshlq_n_u8(c, 6), d);
+	vst3q_u8(dst, out);
+
+	return true;
+}
+
+#endif // LOVE_SIMD_NEON
 
 /**
  * encode 3 8-bit binary bytes as 4 '6-bit' characters
  **/
-static void b64_encode_block(char in[3], char out[4], int len)
+static inline void b64_encode_block(const uint8 *in, char *out)
 {
-	out[0] = (char) cb64[(int)((in[0] & 0xfc) >> 2)];
-	out[1] = (char) cb64[(int)(((in[0] & 0x03) << 4) | ((in[1] & 0xf0) >> 4))];
-	out[2] = (char) (len > 1 ? cb64[(int)(((in[1] & 0x0f) << 2) | ((in[2] & 0xc0) >> 6))] : '=');
-	out[3] = (char) (len > 2 ? cb64[(int)(in[2] & 0x3f)] : '=');
+	out[0] = cb64[in[0] >> 2];
+	out[1] = cb64[((in[0] & 0x03) << 4) | (in[1] >> 4)];
+	out[2] = cb64[((in[1] & 0x0f) << 2) | (in[2] >> 6)];
+	out[3] = cb64[in[2] & 0x3f];
 }
 
-char *b64_encode(const char *src, size_t srclen, size_t linelen, size_t &dstlen)
+/**
+ * encode the final 1 or 2 bytes, with padding.
+ **/
+static inline void b64_encode_tail(const uint8 *in, size_t len, char *out)
+{
+	uint8 block[3] = {0, 0, 0};
+	memcpy(block, in, len);
+	b64_encode_block(block, out);
+
+	out[3] = '=';
+	if (len < 2)
+		out[2] = '=';
+}
+
+/**
+ * Encodes count complete 3-byte blocks. srclen is the number of bytes which
+ * can safely be read from src, which may be more than count * 3.
+ **/
+static void b64_encode_blocks(const uint8 *src, size_t srclen, size_t count, char *dst)
+{
+	size_t i = 0;
+
+#if defined(LOVE_SIMD_AVX2)
+	// Reads 28 bytes (two overlapping 16 byte loads) and consumes 24.
+	while (count - i >= 8 && srclen - i * 3 >= 28)
+	{
+		const uint8 *s = src + i * 3;
+		__m256i in = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i *) s)),
+		                                     _mm_loadu_si128((const __m128i *) (s + 12)), 1);
+
+		in = _mm256_shuffle_epi8(in, _mm256_set_epi8(
+			10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1,
+			10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+
+		const __m256i t0 = _mm256_and_si256(in, _mm256_set1_epi32(0x0fc0fc00));
+		const __m256i t1 = _mm256_mulhi_epu16(t0, _mm256_set1_epi32(0x04000040));
+		const __m256i t2 = _mm256_and_si256(in, _mm256_set1_epi32(0x003f03f0));
+		const __m256i t3 = _mm256_mullo_epi16(t2, _mm256_set1_epi32(0x01000010));
+		const __m256i indices = _mm256_or_si256(t1, t3);
+
+		const __m256i lut = _mm256_setr_epi8(
+			65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0,
+			65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0);
+
+		__m256i offsets = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+		offsets = _mm256_sub_epi8(offsets, _mm256_cmpgt_epi8(indices, _mm256_set1_epi8(25)));
+
+		__m256i out = _mm256_add_epi8(indices, _mm256_shuffle_epi8(lut, offsets));
+		_mm256_storeu_si256((__m256i *) (dst + i * 4), out);
+
+		i += 8;
+	}
+#endif
+
+#if defined(LOVE_SIMD_SSSE3)
+	// Reads 16 bytes and consumes 12.
+	while (count - i >= 4 && srclen - i * 3 >= 16)
+	{
+		__m128i in = _mm_loadu_si128((const __m128i *) (src + i * 3));
+		__m128i out = b64_enc_translate(b64_enc_reshuffle(in));
+		_mm_storeu_si128((__m128i *) (dst + i * 4), out);
+		i += 4;
+	}
+#elif defined(LOVE_SIMD_NEON)
+	while (count - i >= 16)
+	{
+		uint8x16x3_t in = vld3q_u8(src + i * 3);
+		uint8x16x4_t out;
+
+		out.val[0] = vshrq_n_u8(in.val[0], 2);
+		out.val[1] = vandq_u8(vorrq_u8(vshlq_n_u8(in.val[0], 4), vshrq_n_u8(in.val[1], 4)), vdupq_n_u8(0x3F));
+		out.val[2] = vandq_u8(vorrq_u8(vshlq_n_u8(in.val[1], 2), vshrq_n_u8(in.val[2], 6)), vdupq_n_u8(0x3F));
+		out.val[3] = vandq_u8(in.val[2], vdupq_n_u8(0x3F));
+
+		for (int j = 0; j < 4; j++)
+			out.val[j] = b64_enc_translate(out.val[j]);
+
+		vst4q_u8((uint8 *) (dst + i * 4), out);
+		i += 16;
+	}
+#endif
+
+	for (; i < count; i++)
+		b64_encode_block(src + i * 3, dst + i * 4);
+}
+
+/**
+ * Encodes all complete 3-byte blocks in src, inserting a newline after every
+ * lineblocks blocks (0 means no newlines). linepos is the number of blocks
+ * already written to the current line, and is updated.
+ **/
+static size_t b64_encode_lines(const uint8 *src, size_t srclen, size_t lineblocks, size_t &linepos, char *dst)
+{
+	size_t count = srclen / 3;
+	char *d = dst;
+
+	if (lineblocks == 0)
+	{
+		b64_encode_blocks(src, srclen, count, d);
+		return count * 4;
+	}
+
+	size_t block = 0;
+	while (block < count)
+	{
+		size_t n = std::min(lineblocks - linepos, count - block);
+
+		b64_encode_blocks(src + block * 3, srclen - block * 3, n, d);
+		d += n * 4;
+		block += n;
+		linepos += n;
+
+		if (linepos == lineblocks)
+		{
+			*(d++) = '\n';
+			linepos = 0;
+		}
+	}
+
+	return (size_t) (d - dst);
+}
+
+static size_t b64_encode_lineblocks(size_t linelen)
 {
 	if (linelen == 0)
-		linelen = std::numeric_limits<size_t>::max();
+		return 0;
+
+	return std::max(linelen / 4, (size_t) 1);
+}
 
-	size_t blocksout = 0;
-	size_t srcpos = 0;
+size_t b64_encoded_size(size_t srclen, size_t linelen)
+{
+	size_t paddedlen = ((srclen + 2) / 3) * 4;
+	size_t lineblocks = b64_encode_lineblocks(linelen);
+
+	if (lineblocks == 0)
+		return paddedlen;
 
-	size_t adjustment = (srclen % 3) ? (3 - (srclen % 3)) : 0;
-	size_t paddedlen = ((srclen + adjustment) / 3) * 4;
+	return paddedlen + (paddedlen / 4) / lineblocks;
+}
 
-	dstlen = paddedlen + paddedlen / linelen;
+size_t b64_encode(const char *src, size_t srclen, size_t linelen, char *dst)
+{
+	B64EncodeStream stream;
+	b64_encode_begin(stream, linelen);
+
+	size_t dstlen = b64_encode_update(stream, src, srclen, dst);
+	return dstlen + b64_encode_end(stream, dst + dstlen);
+}
+
+char *b64_encode(const char *src, size_t srclen, size_t linelen, size_t &dstlen)
+{
+	dstlen = b64_encoded_size(srclen, linelen);
 
 	if (dstlen == 0)
 		return nullptr;
@@ -70,107 +420,191 @@ char *b64_encode(const char *src, size_t srclen, size_t linelen, size_t &dstlen)
 		throw love::Exception("Out of memory.");
 	}
 
-	size_t dstpos = 0;
+	dstlen = b64_encode(src, srclen, linelen, dst);
+	dst[dstlen] = '\0';
+
+	return dst;
+}
 
-	while (srcpos < srclen)
+void b64_encode_begin(B64EncodeStream &stream, size_t linelen)
+{
+	stream.lineblocks = b64_encode_lineblocks(linelen);
+	stream.linepos = 0;
+	stream.pendinglen = 0;
+}
+
+size_t b64_encode_update(B64EncodeStream &stream, const char *src, size_t srclen, char *dst)
+{
+	const uint8 *s = (const uint8 *) src;
+	size_t dstlen = 0;
+
+	// Complete a block which was started by a previous piece.
+	if (stream.pendinglen > 0)
 	{
-		char in[3]  = {0};
-		char out[4] = {0};
+		size_t n = std::min(3 - stream.pendinglen, srclen);
+		memcpy(stream.pending + stream.pendinglen, s, n);
+		stream.pendinglen += n;
+		s += n;
+		srclen -= n;
 
-		int len = 0;
+		if (stream.pendinglen < 3)
+			return 0;
 
-		for (int i = 0; i < 3; i++)
-		{
-			if (srcpos >= srclen)
-				break;
+		dstlen += b64_encode_lines(stream.pending, 3, stream.lineblocks, stream.linepos, dst);
+		stream.pendinglen = 0;
+	}
 
-			in[i] = src[srcpos++];
-			len++;
-		}
+	dstlen += b64_encode_lines(s, srclen, stream.lineblocks, stream.linepos, dst + dstlen);
 
-		if (len > 0)
-		{
-			b64_encode_block(in, out, len);
+	stream.pendinglen = srclen % 3;
+	memcpy(stream.pending, s + srclen - stream.pendinglen, stream.pendinglen);
 
-			for (int i = 0; i < 4 && dstpos < dstlen; i++, dstpos++)
-				dst[dstpos] = out[i];
+	return dstlen;
+}
 
-			blocksout++;
-		}
+size_t b64_encode_end(B64EncodeStream &stream, char *dst)
+{
+	size_t dstlen = 0;
 
-		if (blocksout >= linelen / 4 || srcpos >= srclen)
-		{
-			if (blocksout > 0 && dstpos < dstlen)
-				dst[dstpos++] = '\n';
+	if (stream.pendinglen > 0)
+	{
+		b64_encode_tail(stream.pending, stream.pendinglen, dst);
+		dstlen += 4;
+		stream.pendinglen = 0;
 
-			blocksout = 0;
+		if (stream.lineblocks > 0 && ++stream.linepos == stream.lineblocks)
+		{
+			dst[dstlen++] = '\n';
+			stream.linepos = 0;
 		}
 	}
 
-	dst[dstpos] = '\0';
-	return dst;
+	return dstlen;
 }
 
-static void b64_decode_block(char in[4], char out[3])
+size_t b64_decoded_size_max(size_t srclen)
 {
-	out[0] = (char)(in[0] << 2 | in[1] >> 4);
-	out[1] = (char)(in[1] << 4 | in[2] >> 2);
-	out[2] = (char)(((in[2] << 6) & 0xc0) | in[3]);
+	// Every 4 characters in the alphabet produce 3 bytes. A stream may also
+	// have up to 6 bits left over from a previous piece.
+	return (srclen / 4) * 3 + ((srclen % 4) * 3 + 3) / 4;
 }
 
-char *b64_decode(const char *src, size_t srclen, size_t &size)
+size_t b64_decoded_size(const char *src, size_t srclen)
 {
-	size_t paddedsize = (srclen / 4) * 3;
+	size_t count = 0;
 
-	char *dst = nullptr;
-	try
-	{
-		dst = new char[paddedsize];
-	}
-	catch (std::exception &)
+	for (size_t i = 0; i < srclen; i++)
 	{
-		throw love::Exception("Out of memory.");
+		if (cd64[(uint8) src[i]] != B64_INVALID)
+			count++;
 	}
 
-	char *d = dst;
+	return (count * 6) / 8;
+}
 
-	char in[4]  = {0};
-	char out[3] = {0};
-	size_t i, len, srcpos = 0;
+size_t b64_decode_update(B64DecodeStream &stream, const char *src, size_t srclen, char *dst)
+{
+	const uint8 *s = (const uint8 *) src;
+	uint8 *d = (uint8 *) dst;
+	size_t i = 0;
 
-	while (srcpos <= srclen)
+	while (i < srclen)
 	{
-		for (len = 0, i = 0; i < 4 && srcpos <= srclen; i++)
+		if (stream.bitcount == 0)
 		{
-			char v = 0;
-
-			while (srcpos <= srclen && v == 0)
+			// Fast paths for runs of characters that are all in the alphabet.
+			// Anything else (whitespace, padding) drops to the loop below.
+#if defined(LOVE_SIMD_AVX2)
+			while (srclen - i >= 32 && b64_dec_block32(s + i, d))
 			{
-				v = src[srcpos++];
-				v = (char)((v < 43 || v > 122) ? 0 : cd64[v - 43]);
-				if (v != 0)
-					v = (char)((v == '$') ? 0 : v - 61);
+				i += 32;
+				d += 24;
 			}
-
-			if (srcpos <= srclen)
+#endif
+#if defined(LOVE_SIMD_SSSE3)
+			while (srclen - i >= 16 && b64_dec_block16(s + i, d))
 			{
-				len++;
-				if (v != 0)
-					in[i] = (char)(v - 1);
+				i += 16;
+				d += 12;
 			}
-			else
-				in[i] = 0;
+#elif defined(LOVE_SIMD_NEON)
+			while (srclen - i >= 64 && b64_dec_block64(s + i, d))
+			{
+				i += 64;
+				d += 48;
+			}
+#endif
+			while (srclen - i >= 4)
+			{
+				uint32 a = cd64[s[i + 0]];
+				uint32 b = cd64[s[i + 1]];
+				uint32 c = cd64[s[i + 2]];
+				uint32 e = cd64[s[i + 3]];
+
+				if ((a | b | c | e) > 63)
+					break;
+
+				uint32 v = (a << 18) | (b << 12) | (c << 6) | e;
+				d[0] = (uint8) (v >> 16);
+				d[1] = (uint8) (v >> 8);
+				d[2] = (uint8) v;
+
+				i += 4;
+				d += 3;
+			}
+
+			if (i >= srclen)
+				break;
 		}
 
-		if (len)
+		uint8 v = cd64[s[i++]];
+		if (v == B64_INVALID)
+			continue;
+
+		stream.bits = (stream.bits << 6) | v;
+		stream.bitcount += 6;
+
+		if (stream.bitcount >= 8)
 		{
-			b64_decode_block(in, out);
-			for (i = 0; i < len - 1; i++)
-				 *(d++) = out[i];
+			stream.bitcount -= 8;
+			*(d++) = (uint8) (stream.bits >> stream.bitcount);
+			stream.bits &= (1u << stream.bitcount) - 1;
 		}
 	}
 
-	size = (size_t)(ptrdiff_t) (d - dst);
+	return (size_t) (d - (uint8 *) dst);
+}
+
+void b64_decode_begin(B64DecodeStream &stream)
+{
+	stream.bits = 0;
+	stream.bitcount = 0;
+}
+
+size_t b64_decode(const char *src, size_t srclen, char *dst)
+{
+	B64DecodeStream stream;
+	b64_decode_begin(stream);
+
+	// Any bits left over at the end are discarded.
+	return b64_decode_update(stream, src, srclen, dst);
+}
+
+char *b64_decode(const char *src, size_t srclen, size_t &size)
+{
+	size_t maxsize = b64_decoded_size_max(srclen);
+
+	char *dst = nullptr;
+	try
+	{
+		dst = new char[maxsize];
+	}
+	catch (std::exception &)
+	{
+		throw love::Exception("Out of memory.");
+	}
+
+	size = b64_decode(src, srclen, dst);
 	return dst;
 }
 
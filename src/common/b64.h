@@ -28,6 +28,33 @@
 namespace love
 {
 
+/**
+ * Gets the length of the string produced by base64-encoding data.
+ *
+ * @param srclen The size in bytes of the data to encode.
+ * @param linelen The maximum length of each line in the encoded string.
+ *        0 indicates no maximum length. Line lengths are rounded down to a
+ *        multiple of 4.
+ * @return The length of the encoded string, not counting a null terminator.
+ */
+size_t b64_encoded_size(size_t srclen, size_t linelen);
+
+/**
+ * Gets the maximum size of the data produced by decoding a base64 string.
+ *
+ * @param srclen The length of the base64 string.
+ */
+size_t b64_decoded_size_max(size_t srclen);
+
+/**
+ * Gets the exact size of the data produced by decoding a base64 string. This
+ * has to scan the whole string.
+ *
+ * @param src The string containing the base64 data.
+ * @param srclen The length of the string.
+ */
+size_t b64_decoded_size(const char *src, size_t srclen);
+
 /**
  * Base64-encode data.
  *
@@ -40,6 +67,19 @@ namespace love
  */
 char *b64_encode(const char *src, size_t srclen, size_t linelen, size_t &dstlen);
 
+/**
+ * Base64-encode data into an existing buffer.
+ *
+ * @param src The data to encode.
+ * @param srclen The size in bytes of the data.
+ * @param linelen The maximum length of each line in the encoded string.
+ *        0 indicates no maximum length.
+ * @param dst The buffer to write into. It must have room for at least
+ *        b64_encoded_size(srclen, linelen) bytes. No null terminator is added.
+ * @return The number of bytes written to dst.
+ */
+size_t b64_encode(const char *src, size_t srclen, size_t linelen, char *dst);
+
 /**
  * Decode base64 encoded data.
  *
@@ -50,6 +90,69 @@ char *b64_encode(const char *src, size_t srclen, size_t linelen, size_t &dstlen)
  */
 char *b64_decode(const char *src, size_t srclen, size_t &dstlen);
 
+/**
+ * Decode base64 encoded data into an existing buffer. Characters outside of
+ * the base64 alphabet (whitespace, padding) are skipped.
+ *
+ * @param src The string containing the base64 data.
+ * @param srclen The length of the string.
+ * @param dst The buffer to write into. It must have room for at least
+ *        b64_decoded_size_max(srclen) bytes.
+ * @return The number of bytes written to dst.
+ */
+size_t b64_decode(const char *src, size_t srclen, char *dst);
+
+/**
+ * State for encoding a stream of data in pieces. The output is identical to
+ * encoding all of the pieces at once.
+ */
+struct B64EncodeStream
+{
+	size_t lineblocks = 0;
+	size_t linepos = 0;
+	unsigned char pending[3];
+	size_t pendinglen = 0;
+};
+
+/**
+ * State for decoding a stream of base64 data in pieces.
+ */
+struct B64DecodeStream
+{
+	unsigned int bits = 0;
+	int bitcount = 0;
+};
+
+void b64_encode_begin(B64EncodeStream &stream, size_t linelen);
+
+/**
+ * Encodes the next piece of a stream. Up to 2 trailing bytes of src are kept
+ * in the stream state until more data arrives or b64_encode_end is called.
+ *
+ * @param dst The buffer to write into. It must have room for at least
+ *        b64_encoded_size(srclen + 2, linelen) + 1 bytes.
+ * @return The number of bytes written to dst.
+ */
+size_t b64_encode_update(B64EncodeStream &stream, const char *src, size_t srclen, char *dst);
+
+/**
+ * Flushes any pending bytes (with padding). dst must have room for 5 bytes.
+ *
+ * @return The number of bytes written to dst.
+ */
+size_t b64_encode_end(B64EncodeStream &stream, char *dst);
+
+void b64_decode_begin(B64DecodeStream &stream);
+
+/**
+ * Decodes the next piece of a stream.
+ *
+ * @param dst The buffer to write into. It must have room for at least
+ *        b64_decoded_size_max(srclen) bytes.
+ * @return The number of bytes written to dst.
+ */
+size_t b64_decode_update(B64DecodeStream &stream, const char *src, size_t srclen, char *dst);
+
 } // love
 
 #endif // LOVE_B64_H
@@ -71,6 +71,18 @@
 #	endif
 #endif
 
+// Wider x86 instruction sets. These are only used when the compiler is told it
+// can target them (e.g. -mssse3 or -mavx2), there's no runtime dispatch.
+#if defined(__SSE2__) || defined(_M_AMD64) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#	define LOVE_SIMD_SSE2
+#endif
+#if defined(__SSSE3__) || defined(__AVX2__)
+#	define LOVE_SIMD_SSSE3
+#endif
+#if defined(__AVX2__)
+#	define LOVE_SIMD_AVX2
+#endif
+
 // NEON instructions.
 #if defined(__ARM_NEON)
 #	define LOVE_SIMD_NEON
@@ -150,6 +162,7 @@
 #	define LOVE_ENABLE_MATH
 #	define LOVE_ENABLE_MOUSE
 #	define LOVE_ENABLE_PHYSICS
+#	define LOVE_ENABLE_PROFILER
 #	define LOVE_ENABLE_SOUND
 #	define LOVE_ENABLE_SYSTEM
 #	define LOVE_ENABLE_THREAD
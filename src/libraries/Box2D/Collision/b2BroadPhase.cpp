@@ -118,3 +118,82 @@ bool b2BroadPhase::QueryCallback(int32 proxyId)
 
 	return true;
 }
+
+// LOVE: The tree's state follows the move buffer, which is padded to keep it
+// aligned.
+struct b2BroadPhaseState
+{
+	int32 proxyCount;
+	int32 moveCount;
+};
+
+static int32 b2GetMoveBufferSize(int32 moveCount)
+{
+	return (moveCount * sizeof(int32) + 7) & ~7;
+}
+
+int32 b2BroadPhase::GetStateSize() const
+{
+	return sizeof(b2BroadPhaseState) + b2GetMoveBufferSize(m_moveCount) + m_tree.GetStateSize();
+}
+
+int32 b2BroadPhase::SaveState(void* data) const
+{
+	b2BroadPhaseState* state = (b2BroadPhaseState*)data;
+	state->proxyCount = m_proxyCount;
+	state->moveCount = m_moveCount;
+
+	char* moves = (char*)(state + 1);
+	memcpy(moves, m_moveBuffer, m_moveCount * sizeof(int32));
+
+	int32 size = sizeof(b2BroadPhaseState) + b2GetMoveBufferSize(m_moveCount);
+	return size + m_tree.SaveState(moves + b2GetMoveBufferSize(m_moveCount));
+}
+
+bool b2BroadPhase::CheckState(const void* data, int32 size) const
+{
+	const b2BroadPhaseState* state = (const b2BroadPhaseState*)data;
+	if (size < (int32)sizeof(b2BroadPhaseState) || state->proxyCount != m_proxyCount ||
+		state->moveCount < 0 || state->moveCount > (size - (int32)sizeof(b2BroadPhaseState)) / (int32)sizeof(int32))
+	{
+		return false;
+	}
+
+	int32 headerSize = sizeof(b2BroadPhaseState) + b2GetMoveBufferSize(state->moveCount);
+	if (headerSize > size)
+	{
+		return false;
+	}
+
+	// Moved proxies are looked up in the tree, the rest are cleared.
+	const int32* moves = (const int32*)(state + 1);
+	for (int32 i = 0; i < state->moveCount; ++i)
+	{
+		if (moves[i] != e_nullProxy && !m_tree.IsProxy(moves[i]))
+		{
+			return false;
+		}
+	}
+
+	return m_tree.CheckState((const char*)data + headerSize, size - headerSize);
+}
+
+int32 b2BroadPhase::LoadState(const void* data)
+{
+	const b2BroadPhaseState* state = (const b2BroadPhaseState*)data;
+	m_proxyCount = state->proxyCount;
+
+	if (state->moveCount > m_moveCapacity)
+	{
+		b2Free(m_moveBuffer);
+		m_moveCapacity = state->moveCount;
+		m_moveBuffer = (int32*)b2Alloc(m_moveCapacity * sizeof(int32));
+	}
+
+	const char* moves = (const char*)(state + 1);
+	m_moveCount = state->moveCount;
+	memcpy(m_moveBuffer, moves, m_moveCount * sizeof(int32));
+
+	int32 size = sizeof(b2BroadPhaseState) + b2GetMoveBufferSize(m_moveCount);
+	return size + m_tree.LoadState(moves + b2GetMoveBufferSize(m_moveCount));
+}
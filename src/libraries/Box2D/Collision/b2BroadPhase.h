@@ -104,6 +104,22 @@ public:
 	/// @param newOrigin the new origin with respect to the old origin
 	void ShiftOrigin(const b2Vec2& newOrigin);
 
+	/// LOVE: Get the size of the broad-phase state, in bytes.
+	int32 GetStateSize() const;
+
+	/// LOVE: Copy the proxies, the tree and the buffered moves to memory of
+	/// GetStateSize bytes. Returns the number of bytes written.
+	int32 SaveState(void* data) const;
+
+	/// LOVE: Check that a state of size bytes can be put back, i.e. that it
+	/// has the same proxies as the broad-phase has now. It's safe to pass in
+	/// any data.
+	bool CheckState(const void* data, int32 size) const;
+
+	/// LOVE: Put back a state which passed CheckState. Returns the number of
+	/// bytes read.
+	int32 LoadState(const void* data);
+
 private:
 
 	friend class b2DynamicTree;
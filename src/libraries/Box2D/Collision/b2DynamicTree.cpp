@@ -767,6 +767,185 @@ void b2DynamicTree::RebuildBottomUp()
 	Validate();
 }
 
+struct b2DynamicTreeState
+{
+	int32 root;
+	int32 nodeCount;
+	int32 nodeCapacity;
+	int32 freeList;
+	uint32 path;
+	int32 insertionCount;
+};
+
+int32 b2DynamicTree::GetStateSize() const
+{
+	return sizeof(b2DynamicTreeState) + m_nodeCapacity * sizeof(b2TreeNode);
+}
+
+int32 b2DynamicTree::SaveState(void* data) const
+{
+	b2DynamicTreeState* state = (b2DynamicTreeState*)data;
+	state->root = m_root;
+	state->nodeCount = m_nodeCount;
+	state->nodeCapacity = m_nodeCapacity;
+	state->freeList = m_freeList;
+	state->path = m_path;
+	state->insertionCount = m_insertionCount;
+
+	memcpy(state + 1, m_nodes, m_nodeCapacity * sizeof(b2TreeNode));
+
+	// The user data pointers stay behind, LoadState keeps the current ones.
+	b2TreeNode* nodes = (b2TreeNode*)(state + 1);
+	for (int32 i = 0; i < m_nodeCapacity; ++i)
+	{
+		nodes[i].userData = NULL;
+	}
+
+	return GetStateSize();
+}
+
+bool b2DynamicTree::CheckState(const void* data, int32 size) const
+{
+	const b2DynamicTreeState* state = (const b2DynamicTreeState*)data;
+	if (size < (int32)sizeof(b2DynamicTreeState) || state->nodeCapacity <= 0 ||
+		state->nodeCapacity > (size - (int32)sizeof(b2DynamicTreeState)) / (int32)sizeof(b2TreeNode) ||
+		size != (int32)sizeof(b2DynamicTreeState) + state->nodeCapacity * (int32)sizeof(b2TreeNode))
+	{
+		return false;
+	}
+
+	int32 capacity = state->nodeCapacity;
+	const b2TreeNode* nodes = (const b2TreeNode*)(state + 1);
+
+	if (state->nodeCount < 0 || state->nodeCount > capacity ||
+		state->root < b2_nullNode || state->root >= capacity ||
+		state->freeList < b2_nullNode || state->freeList >= capacity)
+	{
+		return false;
+	}
+
+	// Every node has to be either in the tree under the root, or in the free
+	// list, exactly once.
+	uint8* seen = (uint8*)b2Alloc(capacity);
+	memset(seen, 0, capacity);
+
+	bool valid = true;
+	int32 nodeCount = 0;
+	int32 freeCount = 0;
+	int32 leafCount = 0;
+
+	b2GrowableStack<int32, 256> stack;
+	if (state->root != b2_nullNode)
+	{
+		valid = nodes[state->root].parent == b2_nullNode;
+		stack.Push(state->root);
+	}
+
+	while (valid && stack.GetCount() > 0)
+	{
+		int32 index = stack.Pop();
+		const b2TreeNode* node = nodes + index;
+
+		if (seen[index])
+		{
+			valid = false;
+			break;
+		}
+		seen[index] = 1;
+		++nodeCount;
+
+		if (node->IsLeaf())
+		{
+			// The leaves have to be the proxies this tree has now, since
+			// their user data is kept.
+			valid = node->child2 == b2_nullNode && node->height == 0 &&
+				index < m_nodeCapacity && m_nodes[index].height == 0 && m_nodes[index].IsLeaf();
+			++leafCount;
+			continue;
+		}
+
+		int32 child1 = node->child1;
+		int32 child2 = node->child2;
+		valid = child1 >= 0 && child1 < capacity && child2 >= 0 && child2 < capacity &&
+			nodes[child1].parent == index && nodes[child2].parent == index &&
+			node->height == 1 + b2Max(nodes[child1].height, nodes[child2].height);
+
+		stack.Push(child1);
+		stack.Push(child2);
+	}
+
+	int32 index = state->freeList;
+	while (valid && index != b2_nullNode)
+	{
+		valid = index >= 0 && index < capacity && !seen[index] && nodes[index].height == -1;
+		if (valid)
+		{
+			seen[index] = 1;
+			++freeCount;
+			index = nodes[index].next;
+		}
+	}
+
+	b2Free(seen);
+
+	if (!valid || nodeCount != state->nodeCount || nodeCount + freeCount != capacity)
+	{
+		return false;
+	}
+
+	int32 liveLeafCount = 0;
+	for (int32 i = 0; i < m_nodeCapacity; ++i)
+	{
+		if (m_nodes[i].height == 0)
+		{
+			++liveLeafCount;
+		}
+	}
+
+	return leafCount == liveLeafCount;
+}
+
+int32 b2DynamicTree::LoadState(const void* data)
+{
+	const b2DynamicTreeState* state = (const b2DynamicTreeState*)data;
+
+	// The leaves are the same proxies as before (see CheckState), so they
+	// keep their user data.
+	int32 oldCapacity = m_nodeCapacity;
+	void** oldUserData = (void**)b2Alloc(oldCapacity * sizeof(void*));
+	for (int32 i = 0; i < oldCapacity; ++i)
+	{
+		oldUserData[i] = m_nodes[i].userData;
+	}
+
+	if (state->nodeCapacity != m_nodeCapacity)
+	{
+		b2Free(m_nodes);
+		m_nodeCapacity = state->nodeCapacity;
+		m_nodes = (b2TreeNode*)b2Alloc(m_nodeCapacity * sizeof(b2TreeNode));
+	}
+
+	m_root = state->root;
+	m_nodeCount = state->nodeCount;
+	m_freeList = state->freeList;
+	m_path = state->path;
+	m_insertionCount = state->insertionCount;
+
+	memcpy((void*)m_nodes, state + 1, m_nodeCapacity * sizeof(b2TreeNode));
+
+	for (int32 i = 0; i < m_nodeCapacity; ++i)
+	{
+		if (m_nodes[i].height == 0)
+		{
+			m_nodes[i].userData = i < oldCapacity ? oldUserData[i] : NULL;
+		}
+	}
+
+	b2Free(oldUserData);
+
+	return GetStateSize();
+}
+
 void b2DynamicTree::ShiftOrigin(const b2Vec2& newOrigin)
 {
 	// Build array of leaves. Free the rest.
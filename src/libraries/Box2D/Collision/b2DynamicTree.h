@@ -123,6 +123,24 @@ public:
 	/// @param newOrigin the new origin with respect to the old origin
 	void ShiftOrigin(const b2Vec2& newOrigin);
 
+	/// LOVE: Get the size of the tree's state, in bytes.
+	int32 GetStateSize() const;
+
+	/// LOVE: Copy the tree's state to memory of GetStateSize bytes. The user
+	/// data pointers are left out. Returns the number of bytes written.
+	int32 SaveState(void* data) const;
+
+	/// LOVE: Check that a state of size bytes is a valid tree whose leaves are
+	/// the same proxies this tree has now. It's safe to pass in any data.
+	bool CheckState(const void* data, int32 size) const;
+
+	/// LOVE: Whether the id belongs to a proxy in the tree.
+	bool IsProxy(int32 proxyId) const;
+
+	/// LOVE: Put back a state which passed CheckState. The leaves keep their
+	/// current user data. Returns the number of bytes read.
+	int32 LoadState(const void* data);
+
 private:
 
 	int32 AllocateNode();
@@ -153,6 +171,11 @@ private:
 	int32 m_insertionCount;
 };
 
+inline bool b2DynamicTree::IsProxy(int32 proxyId) const
+{
+	return 0 <= proxyId && proxyId < m_nodeCapacity && m_nodes[proxyId].height == 0;
+}
+
 inline void* b2DynamicTree::GetUserData(int32 proxyId) const
 {
 	b2Assert(0 <= proxyId && proxyId < m_nodeCapacity);
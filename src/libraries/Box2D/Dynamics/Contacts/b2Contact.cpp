@@ -98,6 +98,18 @@ b2Contact* b2Contact::Create(b2Fixture* fixtureA, int32 indexA, b2Fixture* fixtu
 	}
 }
 
+bool b2Contact::IsPrimary(b2Shape::Type typeA, b2Shape::Type typeB)
+{
+	if (s_initialized == false)
+	{
+		InitializeRegisters();
+		s_initialized = true;
+	}
+
+	const b2ContactRegister& reg = s_registers[typeA][typeB];
+	return reg.createFcn != NULL && reg.primary;
+}
+
 void b2Contact::Destroy(b2Contact* contact, b2BlockAllocator* allocator)
 {
 	b2Assert(s_initialized == true);
@@ -154,11 +166,34 @@ b2Contact::b2Contact(b2Fixture* fA, int32 indexA, b2Fixture* fB, int32 indexB)
 	m_restitution = b2MixRestitution(m_fixtureA->m_restitution, m_fixtureB->m_restitution);
 
 	m_tangentSpeed = 0.0f;
+
+	m_userData = NULL;
+}
+
+void b2Contact::Precompute(b2ContactUpdate* update)
+{
+	update->sensor = m_fixtureA->IsSensor() || m_fixtureB->IsSensor();
+
+	const b2Transform& xfA = m_fixtureA->GetBody()->GetTransform();
+	const b2Transform& xfB = m_fixtureB->GetBody()->GetTransform();
+
+	if (update->sensor)
+	{
+		const b2Shape* shapeA = m_fixtureA->GetShape();
+		const b2Shape* shapeB = m_fixtureB->GetShape();
+		update->touching = b2TestOverlap(shapeA, m_indexA, shapeB, m_indexB, xfA, xfB);
+		update->manifold.pointCount = 0;
+	}
+	else
+	{
+		Evaluate(&update->manifold, xfA, xfB);
+		update->touching = update->manifold.pointCount > 0;
+	}
 }
 
 // Update the contact manifold and touching status.
 // Note: do not assume the fixture AABBs are overlapping or are valid.
-void b2Contact::Update(b2ContactListener* listener)
+void b2Contact::Update(b2ContactListener* listener, const b2ContactUpdate* precomputed)
 {
 	b2Manifold oldManifold = m_manifold;
 
@@ -177,19 +212,40 @@ void b2Contact::Update(b2ContactListener* listener)
 	const b2Transform& xfA = bodyA->GetTransform();
 	const b2Transform& xfB = bodyB->GetTransform();
 
+	// LOVE: A precomputed result is stale if the sensor flag was changed
+	// since (by a contact callback, for example.)
+	if (precomputed != NULL && precomputed->sensor != sensor)
+	{
+		precomputed = NULL;
+	}
+
 	// Is this contact a sensor?
 	if (sensor)
 	{
-		const b2Shape* shapeA = m_fixtureA->GetShape();
-		const b2Shape* shapeB = m_fixtureB->GetShape();
-		touching = b2TestOverlap(shapeA, m_indexA, shapeB, m_indexB, xfA, xfB);
+		if (precomputed != NULL)
+		{
+			touching = precomputed->touching;
+		}
+		else
+		{
+			const b2Shape* shapeA = m_fixtureA->GetShape();
+			const b2Shape* shapeB = m_fixtureB->GetShape();
+			touching = b2TestOverlap(shapeA, m_indexA, shapeB, m_indexB, xfA, xfB);
+		}
 
 		// Sensors don't generate manifolds.
 		m_manifold.pointCount = 0;
 	}
 	else
 	{
-		Evaluate(&m_manifold, xfA, xfB);
+		if (precomputed != NULL)
+		{
+			m_manifold = precomputed->manifold;
+		}
+		else
+		{
+			Evaluate(&m_manifold, xfA, xfB);
+		}
 		touching = m_manifold.pointCount > 0;
 
 		// Match old contact ids to new contact ids and copy the
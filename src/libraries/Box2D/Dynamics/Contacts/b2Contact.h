@@ -71,6 +71,15 @@ struct b2ContactEdge
 	b2ContactEdge* next;	///< the next contact edge in the body's contact list
 };
 
+/// LOVE: The narrow phase result of a contact, computed ahead of
+/// b2Contact::Update so that it can be done for many contacts in parallel.
+struct b2ContactUpdate
+{
+	b2Manifold manifold;
+	bool touching;
+	bool sensor;
+};
+
 /// The class manages contact between two shapes. A contact exists for each overlapping
 /// AABB in the broad-phase (except if filtered). Therefore a contact object may exist
 /// that has no contact points.
@@ -141,9 +150,19 @@ public:
 	/// Get the desired tangent speed. In meters per second.
 	float32 GetTangentSpeed() const;
 
+	/// LOVE: Get the user data pointer that was provided in SetUserData.
+	void* GetUserData() const;
+
+	/// LOVE: Set the user data. Use this to store your application specific data.
+	void SetUserData(void* data);
+
 	/// Evaluate this contact with your own manifold and transforms.
 	virtual void Evaluate(b2Manifold* manifold, const b2Transform& xfA, const b2Transform& xfB) = 0;
 
+	/// LOVE: Compute what the next update of this contact would, without
+	/// changing anything. This may be done on any thread during a time step.
+	void Precompute(b2ContactUpdate* update);
+
 protected:
 	friend class b2ContactManager;
 	friend class b2World;
@@ -180,14 +199,18 @@ protected:
 						b2Shape::Type typeA, b2Shape::Type typeB);
 	static void InitializeRegisters();
 	static b2Contact* Create(b2Fixture* fixtureA, int32 indexA, b2Fixture* fixtureB, int32 indexB, b2BlockAllocator* allocator);
+
+	/// LOVE: Whether Create makes a contact for these types of fixtures
+	/// without swapping them.
+	static bool IsPrimary(b2Shape::Type typeA, b2Shape::Type typeB);
 	static void Destroy(b2Contact* contact, b2Shape::Type typeA, b2Shape::Type typeB, b2BlockAllocator* allocator);
 	static void Destroy(b2Contact* contact, b2BlockAllocator* allocator);
 
-	b2Contact() : m_fixtureA(NULL), m_fixtureB(NULL) {}
+	b2Contact() : m_fixtureA(NULL), m_fixtureB(NULL), m_userData(NULL) {}
 	b2Contact(b2Fixture* fixtureA, int32 indexA, b2Fixture* fixtureB, int32 indexB);
 	virtual ~b2Contact() {}
 
-	void Update(b2ContactListener* listener);
+	void Update(b2ContactListener* listener, const b2ContactUpdate* precomputed = NULL);
 
 	static b2ContactRegister s_registers[b2Shape::e_typeCount][b2Shape::e_typeCount];
 	static bool s_initialized;
@@ -217,6 +240,9 @@ protected:
 	float32 m_restitution;
 
 	float32 m_tangentSpeed;
+
+	// LOVE: See SetUserData.
+	void* m_userData;
 };
 
 inline b2Manifold* b2Contact::GetManifold()
@@ -346,4 +372,14 @@ inline float32 b2Contact::GetTangentSpeed() const
 	return m_tangentSpeed;
 }
 
+inline void* b2Contact::GetUserData() const
+{
+	return m_userData;
+}
+
+inline void b2Contact::SetUserData(void* data)
+{
+	m_userData = data;
+}
+
 #endif
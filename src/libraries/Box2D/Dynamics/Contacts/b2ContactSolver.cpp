@@ -28,28 +28,41 @@
 
 bool g_blockSolve = true;
 
-struct b2ContactPositionConstraint
+b2ContactSolver::b2ContactSolver(b2ContactSolverDef* def)
 {
-	b2Vec2 localPoints[b2_maxManifoldPoints];
-	b2Vec2 localNormal;
-	b2Vec2 localPoint;
-	int32 indexA;
-	int32 indexB;
-	float32 invMassA, invMassB;
-	b2Vec2 localCenterA, localCenterB;
-	float32 invIA, invIB;
-	b2Manifold::Type type;
-	float32 radiusA, radiusB;
-	int32 pointCount;
-};
+	Initialize(def);
+}
 
-b2ContactSolver::b2ContactSolver(b2ContactSolverDef* def)
+b2ContactSolver::b2ContactSolver()
+{
+	m_positions = NULL;
+	m_velocities = NULL;
+	m_allocator = NULL;
+	m_positionConstraints = NULL;
+	m_velocityConstraints = NULL;
+	m_contacts = NULL;
+	m_count = 0;
+}
+
+void b2ContactSolver::Initialize(b2ContactSolverDef* def)
 {
 	m_step = def->step;
-	m_allocator = def->allocator;
 	m_count = def->count;
-	m_positionConstraints = (b2ContactPositionConstraint*)m_allocator->Allocate(m_count * sizeof(b2ContactPositionConstraint));
-	m_velocityConstraints = (b2ContactVelocityConstraint*)m_allocator->Allocate(m_count * sizeof(b2ContactVelocityConstraint));
+
+	if (def->positionConstraints != NULL && def->velocityConstraints != NULL)
+	{
+		// LOVE: The caller owns the constraint arrays.
+		m_allocator = NULL;
+		m_positionConstraints = def->positionConstraints;
+		m_velocityConstraints = def->velocityConstraints;
+	}
+	else
+	{
+		m_allocator = def->allocator;
+		m_positionConstraints = (b2ContactPositionConstraint*)m_allocator->Allocate(m_count * sizeof(b2ContactPositionConstraint));
+		m_velocityConstraints = (b2ContactVelocityConstraint*)m_allocator->Allocate(m_count * sizeof(b2ContactVelocityConstraint));
+	}
+
 	m_positions = def->positions;
 	m_velocities = def->velocities;
 	m_contacts = def->contacts;
@@ -132,8 +145,11 @@ b2ContactSolver::b2ContactSolver(b2ContactSolverDef* def)
 
 b2ContactSolver::~b2ContactSolver()
 {
-	m_allocator->Free(m_velocityConstraints);
-	m_allocator->Free(m_positionConstraints);
+	if (m_allocator != NULL)
+	{
+		m_allocator->Free(m_velocityConstraints);
+		m_allocator->Free(m_positionConstraints);
+	}
 }
 
 // Initialize position dependent portions of the velocity constraints.
@@ -26,7 +26,6 @@
 class b2Contact;
 class b2Body;
 class b2StackAllocator;
-struct b2ContactPositionConstraint;
 
 struct b2VelocityConstraintPoint
 {
@@ -56,14 +55,38 @@ struct b2ContactVelocityConstraint
 	int32 contactIndex;
 };
 
+// LOVE: Moved here from b2ContactSolver.cpp, so the parallel island solver
+// can size the constraint arrays it provides.
+struct b2ContactPositionConstraint
+{
+	b2Vec2 localPoints[b2_maxManifoldPoints];
+	b2Vec2 localNormal;
+	b2Vec2 localPoint;
+	int32 indexA;
+	int32 indexB;
+	float32 invMassA, invMassB;
+	b2Vec2 localCenterA, localCenterB;
+	float32 invIA, invIB;
+	b2Manifold::Type type;
+	float32 radiusA, radiusB;
+	int32 pointCount;
+};
+
 struct b2ContactSolverDef
 {
+	b2ContactSolverDef() : positionConstraints(NULL), velocityConstraints(NULL) {}
+
 	b2TimeStep step;
 	b2Contact** contacts;
 	int32 count;
 	b2Position* positions;
 	b2Velocity* velocities;
 	b2StackAllocator* allocator;
+
+	// LOVE: Constraint arrays with room for count constraints. If these are
+	// set, the solver uses them instead of allocating its own.
+	b2ContactPositionConstraint* positionConstraints;
+	b2ContactVelocityConstraint* velocityConstraints;
 };
 
 class b2ContactSolver
@@ -72,6 +95,10 @@ public:
 	b2ContactSolver(b2ContactSolverDef* def);
 	~b2ContactSolver();
 
+	/// LOVE: A solver which is set up later with Initialize.
+	b2ContactSolver();
+	void Initialize(b2ContactSolverDef* def);
+
 	void InitializeVelocityConstraints();
 
 	void WarmStart();
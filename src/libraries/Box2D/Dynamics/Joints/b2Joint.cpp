@@ -33,6 +33,7 @@
 #include <Box2D/Common/b2BlockAllocator.h>
 
 #include <new>
+#include <string.h>
 
 b2Joint* b2Joint::Create(const b2JointDef* def, b2BlockAllocator* allocator)
 {
@@ -180,6 +181,143 @@ void b2Joint::Destroy(b2Joint* joint, b2BlockAllocator* allocator)
 	}
 }
 
+int32 b2Joint::GetSize(b2JointType type)
+{
+	switch (type)
+	{
+	case e_distanceJoint:
+		return sizeof(b2DistanceJoint);
+	case e_mouseJoint:
+		return sizeof(b2MouseJoint);
+	case e_prismaticJoint:
+		return sizeof(b2PrismaticJoint);
+	case e_revoluteJoint:
+		return sizeof(b2RevoluteJoint);
+	case e_pulleyJoint:
+		return sizeof(b2PulleyJoint);
+	case e_gearJoint:
+		return sizeof(b2GearJoint);
+	case e_wheelJoint:
+		return sizeof(b2WheelJoint);
+	case e_weldJoint:
+		return sizeof(b2WeldJoint);
+	case e_frictionJoint:
+		return sizeof(b2FrictionJoint);
+	case e_ropeJoint:
+		return sizeof(b2RopeJoint);
+	case e_motorJoint:
+		return sizeof(b2MotorJoint);
+	default:
+		b2Assert(false);
+		return 0;
+	}
+}
+
+// The joint types' own members start right after b2Joint. It ends with a
+// pointer, so they can't be packed into its tail padding.
+int32 b2Joint::GetStateSize(b2JointType type)
+{
+	return GetSize(type) - (int32)sizeof(b2Joint);
+}
+
+void b2Joint::SaveState(void* data) const
+{
+	memcpy(data, (const char*)this + sizeof(b2Joint), GetStateSize(m_type));
+
+	if (m_type == e_gearJoint)
+	{
+		// Don't hand out pointers, LoadState keeps the current ones anyway.
+		const b2GearJoint* gear = (const b2GearJoint*)this;
+		char* state = (char*)data - sizeof(b2Joint);
+		memset(state + ((const char*)&gear->m_joint1 - (const char*)this), 0, sizeof(gear->m_joint1));
+		memset(state + ((const char*)&gear->m_joint2 - (const char*)this), 0, sizeof(gear->m_joint2));
+		memset(state + ((const char*)&gear->m_bodyC - (const char*)this), 0, sizeof(gear->m_bodyC));
+		memset(state + ((const char*)&gear->m_bodyD - (const char*)this), 0, sizeof(gear->m_bodyD));
+	}
+}
+
+// Bools and enums can't hold just any bytes.
+static bool b2IsValidBoolState(const char* state, int32 offset)
+{
+	uint8 value;
+	memcpy(&value, state + offset, sizeof(value));
+	return value <= 1;
+}
+
+static bool b2IsValidLimitState(const char* state, int32 offset)
+{
+	int32 value;
+	memcpy(&value, state + offset, sizeof(value));
+	return value >= e_inactiveLimit && value <= e_equalLimits;
+}
+
+bool b2Joint::CheckState(const void* data) const
+{
+	const char* state = (const char*)data - sizeof(b2Joint);
+	const char* joint = (const char*)this;
+
+	switch (m_type)
+	{
+	case e_revoluteJoint:
+		{
+			const b2RevoluteJoint* revolute = (const b2RevoluteJoint*)this;
+			return b2IsValidBoolState(state, (const char*)&revolute->m_enableMotor - joint) &&
+				b2IsValidBoolState(state, (const char*)&revolute->m_enableLimit - joint) &&
+				b2IsValidLimitState(state, (const char*)&revolute->m_limitState - joint);
+		}
+
+	case e_prismaticJoint:
+		{
+			const b2PrismaticJoint* prismatic = (const b2PrismaticJoint*)this;
+			return b2IsValidBoolState(state, (const char*)&prismatic->m_enableMotor - joint) &&
+				b2IsValidBoolState(state, (const char*)&prismatic->m_enableLimit - joint) &&
+				b2IsValidLimitState(state, (const char*)&prismatic->m_limitState - joint);
+		}
+
+	case e_wheelJoint:
+		{
+			const b2WheelJoint* wheel = (const b2WheelJoint*)this;
+			return b2IsValidBoolState(state, (const char*)&wheel->m_enableMotor - joint);
+		}
+
+	case e_ropeJoint:
+		{
+			const b2RopeJoint* rope = (const b2RopeJoint*)this;
+			return b2IsValidLimitState(state, (const char*)&rope->m_state - joint);
+		}
+
+	default:
+		return true;
+	}
+}
+
+void b2Joint::LoadState(const void* data)
+{
+	if (m_type == e_gearJoint)
+	{
+		b2GearJoint* gear = (b2GearJoint*)this;
+		b2Joint* joint1 = gear->m_joint1;
+		b2Joint* joint2 = gear->m_joint2;
+		b2JointType typeA = gear->m_typeA;
+		b2JointType typeB = gear->m_typeB;
+		b2Body* bodyC = gear->m_bodyC;
+		b2Body* bodyD = gear->m_bodyD;
+
+		memcpy((char*)this + sizeof(b2Joint), data, GetStateSize(m_type));
+
+		gear->m_joint1 = joint1;
+		gear->m_joint2 = joint2;
+		gear->m_typeA = typeA;
+		gear->m_typeB = typeB;
+		gear->m_bodyC = bodyC;
+		gear->m_bodyD = bodyD;
+	}
+	else
+	{
+		memcpy((char*)this + sizeof(b2Joint), data, GetStateSize(m_type));
+	}
+}
+
 b2Joint::b2Joint(const b2JointDef* def)
 {
 	b2Assert(def->bodyA != def->bodyB);
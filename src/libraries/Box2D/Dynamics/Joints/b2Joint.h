@@ -158,6 +158,22 @@ protected:
 	static b2Joint* Create(const b2JointDef* def, b2BlockAllocator* allocator);
 	static void Destroy(b2Joint* joint, b2BlockAllocator* allocator);
 
+	// LOVE: The size of the joint's object.
+	static int32 GetSize(b2JointType type);
+
+	// LOVE: The size of the state SaveState writes for a type of joint.
+	static int32 GetStateSize(b2JointType type);
+
+	// LOVE: Copy the joint type's own members (its solver state) to memory of
+	// GetStateSize bytes, or back from it. Everything in b2Joint itself (the
+	// links, bodies and user data) and a gear joint's joints and bodies are
+	// left out.
+	void SaveState(void* data) const;
+	void LoadState(const void* data);
+
+	// LOVE: Check that a state for this joint's type holds valid flags.
+	bool CheckState(const void* data) const;
+
 	b2Joint(const b2JointDef* def);
 	virtual ~b2Joint() {}
 
@@ -171,6 +171,8 @@ b2Fixture* b2Body::CreateFixture(const b2FixtureDef* def)
 		return NULL;
 	}
 
+	++m_world->m_structureVersion;
+
 	b2BlockAllocator* allocator = &m_world->m_blockAllocator;
 
 	void* memory = allocator->Allocate(sizeof(b2Fixture));
@@ -219,6 +221,8 @@ void b2Body::DestroyFixture(b2Fixture* fixture)
 		return;
 	}
 
+	++m_world->m_structureVersion;
+
 	b2Assert(fixture->m_body == this);
 
 	// Remove the fixture from this body's singly linked list.
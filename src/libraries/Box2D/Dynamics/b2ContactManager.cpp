@@ -32,6 +32,16 @@ b2ContactManager::b2ContactManager()
 	m_contactFilter = &b2_defaultFilter;
 	m_contactListener = &b2_defaultListener;
 	m_allocator = NULL;
+	m_taskScheduler = NULL;
+	m_candidates = NULL;
+	m_updates = NULL;
+	m_candidateCapacity = 0;
+}
+
+b2ContactManager::~b2ContactManager()
+{
+	b2Free(m_candidates);
+	b2Free(m_updates);
 }
 
 void b2ContactManager::Destroy(b2Contact* c)
@@ -99,15 +109,103 @@ void b2ContactManager::Destroy(b2Contact* c)
 	--m_contactCount;
 }
 
+// LOVE: Contacts which are updated in parallel, see Collide.
+static const int32 b2_collideMinRange = 32;
+
+struct b2CollideContext
+{
+	b2Contact** contacts;
+	b2ContactUpdate* updates;
+};
+
+static void b2PrecomputeContacts(int32 begin, int32 end, void* context)
+{
+	b2CollideContext* ctx = (b2CollideContext*)context;
+
+	for (int32 i = begin; i < end; ++i)
+	{
+		ctx->contacts[i]->Precompute(ctx->updates + i);
+	}
+}
+
+// LOVE: Finds the contacts the loop in Collide will update, assuming nothing
+// changes on the way, and does their narrow phase in parallel. Contacts which
+// still have to be filtered are left to Collide.
+int32 b2ContactManager::PrecomputeContacts()
+{
+	if (m_contactCount > m_candidateCapacity)
+	{
+		b2Free(m_candidates);
+		b2Free(m_updates);
+		m_candidateCapacity = m_contactCount + m_contactCount / 2;
+		m_candidates = (b2Contact**)b2Alloc(m_candidateCapacity * sizeof(b2Contact*));
+		m_updates = (b2ContactUpdate*)b2Alloc(m_candidateCapacity * sizeof(b2ContactUpdate));
+	}
+
+	int32 count = 0;
+	for (b2Contact* c = m_contactList; c; c = c->GetNext())
+	{
+		if (c->m_flags & b2Contact::e_filterFlag)
+		{
+			continue;
+		}
+
+		b2Fixture* fixtureA = c->GetFixtureA();
+		b2Fixture* fixtureB = c->GetFixtureB();
+		b2Body* bodyA = fixtureA->GetBody();
+		b2Body* bodyB = fixtureB->GetBody();
+
+		bool activeA = bodyA->IsAwake() && bodyA->m_type != b2_staticBody;
+		bool activeB = bodyB->IsAwake() && bodyB->m_type != b2_staticBody;
+		if (activeA == false && activeB == false)
+		{
+			continue;
+		}
+
+		int32 proxyIdA = fixtureA->m_proxies[c->GetChildIndexA()].proxyId;
+		int32 proxyIdB = fixtureB->m_proxies[c->GetChildIndexB()].proxyId;
+		if (m_broadPhase.TestOverlap(proxyIdA, proxyIdB) == false)
+		{
+			continue;
+		}
+
+		m_candidates[count++] = c;
+	}
+
+	b2CollideContext context;
+	context.contacts = m_candidates;
+	context.updates = m_updates;
+	m_taskScheduler->ParallelFor(count, b2_collideMinRange, b2PrecomputeContacts, &context);
+
+	return count;
+}
+
 // This is the top level collision call for the time step. Here
 // all the narrow phase collision is processed for the world
 // contact list.
 void b2ContactManager::Collide()
 {
+	// LOVE: The contacts found by PrecomputeContacts come up in the same order
+	// in the loop below. Ones which no longer pass its checks are skipped over
+	// like the rest, and any others are updated the usual way.
+	int32 precomputedCount = 0;
+	int32 next = 0;
+	if (m_taskScheduler != NULL && m_contactCount > b2_collideMinRange)
+	{
+		precomputedCount = PrecomputeContacts();
+	}
+
 	// Update awake contacts.
 	b2Contact* c = m_contactList;
 	while (c)
 	{
+		const b2ContactUpdate* precomputed = NULL;
+		if (next < precomputedCount && m_candidates[next] == c)
+		{
+			precomputed = m_updates + next;
+			++next;
+		}
+
 		b2Fixture* fixtureA = c->GetFixtureA();
 		b2Fixture* fixtureB = c->GetFixtureB();
 		int32 indexA = c->GetChildIndexA();
@@ -164,7 +262,7 @@ void b2ContactManager::Collide()
 		}
 
 		// The contact persists.
-		c->Update(m_contactListener);
+		c->Update(m_contactListener, precomputed);
 		c = c->GetNext();
 	}
 }
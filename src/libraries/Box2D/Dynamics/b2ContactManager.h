@@ -25,12 +25,15 @@ class b2Contact;
 class b2ContactFilter;
 class b2ContactListener;
 class b2BlockAllocator;
+class b2TaskScheduler;
+struct b2ContactUpdate;
 
 // Delegate of b2World.
 class b2ContactManager
 {
 public:
 	b2ContactManager();
+	~b2ContactManager();
 
 	// Broad-phase callback.
 	void AddPair(void* proxyUserDataA, void* proxyUserDataB);
@@ -40,6 +43,7 @@ public:
 	void Destroy(b2Contact* c);
 
 	void Collide();
+	int32 PrecomputeContacts();
             
 	b2BroadPhase m_broadPhase;
 	b2Contact* m_contactList;
@@ -47,6 +51,13 @@ public:
 	b2ContactFilter* m_contactFilter;
 	b2ContactListener* m_contactListener;
 	b2BlockAllocator* m_allocator;
+
+	// LOVE: Set by b2World::SetTaskScheduler. Collide keeps the contacts it
+	// updates in parallel, and their results, between steps.
+	b2TaskScheduler* m_taskScheduler;
+	b2Contact** m_candidates;
+	b2ContactUpdate* m_updates;
+	int32 m_candidateCapacity;
 };
 
 #endif
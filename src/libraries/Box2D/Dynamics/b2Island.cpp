@@ -170,8 +170,43 @@ b2Island::b2Island(
 	m_positions = (b2Position*)m_allocator->Allocate(m_bodyCapacity * sizeof(b2Position));
 }
 
+b2Island::b2Island(
+	b2Body** bodies,
+	b2Contact** contacts,
+	b2Joint** joints,
+	b2Position* positions,
+	b2Velocity* velocities,
+	int32 bodyCapacity,
+	int32 contactCapacity,
+	int32 jointCapacity,
+	b2ContactListener* listener)
+{
+	m_bodyCapacity = bodyCapacity;
+	m_contactCapacity = contactCapacity;
+	m_jointCapacity	 = jointCapacity;
+	m_bodyCount = 0;
+	m_contactCount = 0;
+	m_jointCount = 0;
+
+	m_allocator = NULL;
+	m_listener = listener;
+
+	m_bodies = bodies;
+	m_contacts = contacts;
+	m_joints = joints;
+
+	m_velocities = velocities;
+	m_positions = positions;
+}
+
 b2Island::~b2Island()
 {
+	// LOVE: The arrays belong to the caller if there's no allocator.
+	if (m_allocator == NULL)
+	{
+		return;
+	}
+
 	// Warning: the order should reverse the constructor order.
 	m_allocator->Free(m_positions);
 	m_allocator->Free(m_velocities);
@@ -181,6 +216,19 @@ b2Island::~b2Island()
 }
 
 void b2Island::Solve(b2Profile* profile, const b2TimeStep& step, const b2Vec2& gravity, bool allowSleep)
+{
+	b2ContactSolver contactSolver;
+
+	SolveInit(profile, step, gravity, &contactSolver, NULL, NULL);
+	SolveConstraints(profile, step, &contactSolver, true);
+
+	Report(contactSolver.m_velocityConstraints);
+
+	SolveSleep(step, allowSleep, true);
+}
+
+void b2Island::SolveInit(b2Profile* profile, const b2TimeStep& step, const b2Vec2& gravity, b2ContactSolver* contactSolver,
+					b2ContactPositionConstraint* positionConstraints, b2ContactVelocityConstraint* velocityConstraints)
 {
 	b2Timer timer;
 
@@ -226,10 +274,9 @@ void b2Island::Solve(b2Profile* profile, const b2TimeStep& step, const b2Vec2& g
 	timer.Reset();
 
 	// Solver data
-	b2SolverData solverData;
-	solverData.step = step;
-	solverData.positions = m_positions;
-	solverData.velocities = m_velocities;
+	m_solverData.step = step;
+	m_solverData.positions = m_positions;
+	m_solverData.velocities = m_velocities;
 
 	// Initialize velocity constraints.
 	b2ContactSolverDef contactSolverDef;
@@ -239,36 +286,44 @@ void b2Island::Solve(b2Profile* profile, const b2TimeStep& step, const b2Vec2& g
 	contactSolverDef.positions = m_positions;
 	contactSolverDef.velocities = m_velocities;
 	contactSolverDef.allocator = m_allocator;
+	contactSolverDef.positionConstraints = positionConstraints;
+	contactSolverDef.velocityConstraints = velocityConstraints;
 
-	b2ContactSolver contactSolver(&contactSolverDef);
-	contactSolver.InitializeVelocityConstraints();
+	contactSolver->Initialize(&contactSolverDef);
+	contactSolver->InitializeVelocityConstraints();
 
 	if (step.warmStarting)
 	{
-		contactSolver.WarmStart();
+		contactSolver->WarmStart();
 	}
 	
 	for (int32 i = 0; i < m_jointCount; ++i)
 	{
-		m_joints[i]->InitVelocityConstraints(solverData);
+		m_joints[i]->InitVelocityConstraints(m_solverData);
 	}
 
 	profile->solveInit = timer.GetMilliseconds();
+}
+
+void b2Island::SolveConstraints(b2Profile* profile, const b2TimeStep& step, b2ContactSolver* contactSolver, bool updateStatic)
+{
+	b2Timer timer;
+
+	float32 h = step.dt;
 
 	// Solve velocity constraints
-	timer.Reset();
 	for (int32 i = 0; i < step.velocityIterations; ++i)
 	{
 		for (int32 j = 0; j < m_jointCount; ++j)
 		{
-			m_joints[j]->SolveVelocityConstraints(solverData);
+			m_joints[j]->SolveVelocityConstraints(m_solverData);
 		}
 
-		contactSolver.SolveVelocityConstraints();
+		contactSolver->SolveVelocityConstraints();
 	}
 
 	// Store impulses for warm starting
-	contactSolver.StoreImpulses();
+	contactSolver->StoreImpulses();
 	profile->solveVelocity = timer.GetMilliseconds();
 
 	// Integrate positions
@@ -306,22 +361,22 @@ void b2Island::Solve(b2Profile* profile, const b2TimeStep& step, const b2Vec2& g
 
 	// Solve position constraints
 	timer.Reset();
-	bool positionSolved = false;
+	m_positionSolved = false;
 	for (int32 i = 0; i < step.positionIterations; ++i)
 	{
-		bool contactsOkay = contactSolver.SolvePositionConstraints();
+		bool contactsOkay = contactSolver->SolvePositionConstraints();
 
 		bool jointsOkay = true;
 		for (int32 i = 0; i < m_jointCount; ++i)
 		{
-			bool jointOkay = m_joints[i]->SolvePositionConstraints(solverData);
+			bool jointOkay = m_joints[i]->SolvePositionConstraints(m_solverData);
 			jointsOkay = jointsOkay && jointOkay;
 		}
 
 		if (contactsOkay && jointsOkay)
 		{
 			// Exit early if the position errors are small.
-			positionSolved = true;
+			m_positionSolved = true;
 			break;
 		}
 	}
@@ -330,6 +385,14 @@ void b2Island::Solve(b2Profile* profile, const b2TimeStep& step, const b2Vec2& g
 	for (int32 i = 0; i < m_bodyCount; ++i)
 	{
 		b2Body* body = m_bodies[i];
+
+		// LOVE: Static bodies don't move, and may be shared with islands
+		// which are being solved at the same time.
+		if (updateStatic == false && body->m_type == b2_staticBody)
+		{
+			continue;
+		}
+
 		body->m_sweep.c = m_positions[i].c;
 		body->m_sweep.a = m_positions[i].a;
 		body->m_linearVelocity = m_velocities[i].v;
@@ -338,8 +401,11 @@ void b2Island::Solve(b2Profile* profile, const b2TimeStep& step, const b2Vec2& g
 	}
 
 	profile->solvePosition = timer.GetMilliseconds();
+}
 
-	Report(contactSolver.m_velocityConstraints);
+bool b2Island::SolveSleep(const b2TimeStep& step, bool allowSleep, bool updateStatic)
+{
+	float32 h = step.dt;
 
 	if (allowSleep)
 	{
@@ -370,15 +436,23 @@ void b2Island::Solve(b2Profile* profile, const b2TimeStep& step, const b2Vec2& g
 			}
 		}
 
-		if (minSleepTime >= b2_timeToSleep && positionSolved)
+		if (minSleepTime >= b2_timeToSleep && m_positionSolved)
 		{
 			for (int32 i = 0; i < m_bodyCount; ++i)
 			{
 				b2Body* b = m_bodies[i];
+				if (updateStatic == false && b->GetType() == b2_staticBody)
+				{
+					continue;
+				}
 				b->SetAwake(false);
 			}
+
+			return true;
 		}
 	}
+
+	return false;
 }
 
 void b2Island::SolveTOI(const b2TimeStep& subStep, int32 toiIndexA, int32 toiIndexB)
@@ -27,6 +27,8 @@ class b2Contact;
 class b2Joint;
 class b2StackAllocator;
 class b2ContactListener;
+class b2ContactSolver;
+struct b2ContactPositionConstraint;
 struct b2ContactVelocityConstraint;
 struct b2Profile;
 
@@ -36,6 +38,14 @@ class b2Island
 public:
 	b2Island(int32 bodyCapacity, int32 contactCapacity, int32 jointCapacity,
 			b2StackAllocator* allocator, b2ContactListener* listener);
+
+	/// LOVE: An island which uses arrays owned by the caller, for islands
+	/// which are solved in parallel (see b2World::SolveParallel.)
+	b2Island(b2Body** bodies, b2Contact** contacts, b2Joint** joints,
+			b2Position* positions, b2Velocity* velocities,
+			int32 bodyCapacity, int32 contactCapacity, int32 jointCapacity,
+			b2ContactListener* listener);
+
 	~b2Island();
 
 	void Clear()
@@ -47,6 +57,18 @@ public:
 
 	void Solve(b2Profile* profile, const b2TimeStep& step, const b2Vec2& gravity, bool allowSleep);
 
+	/// LOVE: The parts of Solve, in order. SolveInit reads b2Body::m_islandIndex,
+	/// which static bodies share between islands, so islands which are solved
+	/// in parallel run it right after they're built. Static bodies are also left
+	/// alone by the other parts when updateStatic is false, since other
+	/// islands may be using them at the same time.
+	void SolveInit(b2Profile* profile, const b2TimeStep& step, const b2Vec2& gravity, b2ContactSolver* contactSolver,
+				b2ContactPositionConstraint* positionConstraints, b2ContactVelocityConstraint* velocityConstraints);
+	void SolveConstraints(b2Profile* profile, const b2TimeStep& step, b2ContactSolver* contactSolver, bool updateStatic);
+
+	/// LOVE: Returns whether the island fell asleep.
+	bool SolveSleep(const b2TimeStep& step, bool allowSleep, bool updateStatic);
+
 	void SolveTOI(const b2TimeStep& subStep, int32 toiIndexA, int32 toiIndexB);
 
 	void Add(b2Body* body)
@@ -88,6 +110,10 @@ public:
 	int32 m_bodyCapacity;
 	int32 m_contactCapacity;
 	int32 m_jointCapacity;
+
+	// LOVE: State shared by the parts of Solve.
+	b2SolverData m_solverData;
+	bool m_positionSolved;
 };
 
 #endif
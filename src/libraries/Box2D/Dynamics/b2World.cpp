@@ -33,6 +33,7 @@
 #include <Box2D/Common/b2Draw.h>
 #include <Box2D/Common/b2Timer.h>
 #include <new>
+#include <string.h>
 
 b2World::b2World(const b2Vec2& gravity)
 {
@@ -49,6 +50,14 @@ b2World::b2World(const b2Vec2& gravity)
 	m_continuousPhysics = true;
 	m_subStepping = false;
 
+	m_taskScheduler = NULL;
+	m_parallelMemory = NULL;
+	m_parallelMemorySize = 0;
+
+	m_structureVersion = 0;
+
+	m_userData = NULL;
+
 	m_stepComplete = true;
 
 	m_allowSleep = true;
@@ -61,6 +70,15 @@ b2World::b2World(const b2Vec2& gravity)
 	m_contactManager.m_allocator = &m_blockAllocator;
 
 	memset(&m_profile, 0, sizeof(b2Profile));
+
+	// LOVE: Register the contact types here instead of lazily in
+	// b2Contact::Create, so Worlds which are stepped on different threads
+	// don't race to do it.
+	if (b2Contact::s_initialized == false)
+	{
+		b2Contact::InitializeRegisters();
+		b2Contact::s_initialized = true;
+	}
 }
 
 b2World::~b2World()
@@ -82,6 +100,8 @@ b2World::~b2World()
 
 		b = bNext;
 	}
+
+	b2Free(m_parallelMemory);
 }
 
 void b2World::SetDestructionListener(b2DestructionListener* listener)
@@ -99,6 +119,12 @@ void b2World::SetContactListener(b2ContactListener* listener)
 	m_contactManager.m_contactListener = listener;
 }
 
+void b2World::SetTaskScheduler(b2TaskScheduler* scheduler)
+{
+	m_taskScheduler = scheduler;
+	m_contactManager.m_taskScheduler = scheduler;
+}
+
 void b2World::SetDebugDraw(b2Draw* debugDraw)
 {
 	g_debugDraw = debugDraw;
@@ -112,6 +138,8 @@ b2Body* b2World::CreateBody(const b2BodyDef* def)
 		return NULL;
 	}
 
+	++m_structureVersion;
+
 	void* mem = m_blockAllocator.Allocate(sizeof(b2Body));
 	b2Body* b = new (mem) b2Body(def, this);
 
@@ -137,6 +165,8 @@ void b2World::DestroyBody(b2Body* b)
 		return;
 	}
 
+	++m_structureVersion;
+
 	// Delete the attached joints.
 	b2JointEdge* je = b->m_jointList;
 	while (je)
@@ -217,6 +247,8 @@ b2Joint* b2World::CreateJoint(const b2JointDef* def)
 		return NULL;
 	}
 
+	++m_structureVersion;
+
 	b2Joint* j = b2Joint::Create(def, &m_blockAllocator);
 
 	// Connect to the world list.
@@ -277,6 +309,8 @@ void b2World::DestroyJoint(b2Joint* j)
 		return;
 	}
 
+	++m_structureVersion;
+
 	bool collideConnected = j->m_collideConnected;
 
 	// Remove from the doubly linked list.
@@ -385,6 +419,13 @@ void b2World::SetAllowSleeping(bool flag)
 // Find islands, integrate and solve constraints, solve position constraints
 void b2World::Solve(const b2TimeStep& step)
 {
+	// LOVE: Spread the islands over several threads, if we can.
+	if (m_taskScheduler != NULL)
+	{
+		SolveParallel(step);
+		return;
+	}
+
 	m_profile.solveInit = 0.0f;
 	m_profile.solveVelocity = 0.0f;
 	m_profile.solvePosition = 0.0f;
@@ -396,19 +437,7 @@ void b2World::Solve(const b2TimeStep& step)
 					&m_stackAllocator,
 					m_contactManager.m_contactListener);
 
-	// Clear all the island flags.
-	for (b2Body* b = m_bodyList; b; b = b->m_next)
-	{
-		b->m_flags &= ~b2Body::e_islandFlag;
-	}
-	for (b2Contact* c = m_contactManager.m_contactList; c; c = c->m_next)
-	{
-		c->m_flags &= ~b2Contact::e_islandFlag;
-	}
-	for (b2Joint* j = m_jointList; j; j = j->m_next)
-	{
-		j->m_islandFlag = false;
-	}
+	ClearIslandFlags();
 
 	// Build and simulate all awake islands.
 	int32 stackSize = m_bodyCount;
@@ -433,144 +462,364 @@ void b2World::Solve(const b2TimeStep& step)
 
 		// Reset island and stack.
 		island.Clear();
-		int32 stackCount = 0;
-		stack[stackCount++] = seed;
-		seed->m_flags |= b2Body::e_islandFlag;
+		BuildIsland(&island, seed, stack, stackSize);
 
-		// Perform a depth first search (DFS) on the constraint graph.
-		while (stackCount > 0)
+		b2Profile profile;
+		island.Solve(&profile, step, m_gravity, m_allowSleep);
+		m_profile.solveInit += profile.solveInit;
+		m_profile.solveVelocity += profile.solveVelocity;
+		m_profile.solvePosition += profile.solvePosition;
+
+		// Post solve cleanup.
+		for (int32 i = 0; i < island.m_bodyCount; ++i)
 		{
-			// Grab the next body off the stack and add it to the island.
-			b2Body* b = stack[--stackCount];
-			b2Assert(b->IsActive() == true);
-			island.Add(b);
+			// Allow static bodies to participate in other islands.
+			b2Body* b = island.m_bodies[i];
+			if (b->GetType() == b2_staticBody)
+			{
+				b->m_flags &= ~b2Body::e_islandFlag;
+			}
+		}
+	}
 
-			// Make sure the body is awake.
-			b->SetAwake(true);
+	m_stackAllocator.Free(stack);
 
-			// To keep islands as small as possible, we don't
-			// propagate islands across static bodies.
-			if (b->GetType() == b2_staticBody)
+	SynchronizeFixtures();
+}
+
+void b2World::ClearIslandFlags()
+{
+	// Clear all the island flags.
+	for (b2Body* b = m_bodyList; b; b = b->m_next)
+	{
+		b->m_flags &= ~b2Body::e_islandFlag;
+	}
+	for (b2Contact* c = m_contactManager.m_contactList; c; c = c->m_next)
+	{
+		c->m_flags &= ~b2Contact::e_islandFlag;
+	}
+	for (b2Joint* j = m_jointList; j; j = j->m_next)
+	{
+		j->m_islandFlag = false;
+	}
+}
+
+void b2World::BuildIsland(b2Island* island, b2Body* seed, b2Body** stack, int32 stackSize)
+{
+	int32 stackCount = 0;
+	stack[stackCount++] = seed;
+	seed->m_flags |= b2Body::e_islandFlag;
+
+	// Perform a depth first search (DFS) on the constraint graph.
+	while (stackCount > 0)
+	{
+		// Grab the next body off the stack and add it to the island.
+		b2Body* b = stack[--stackCount];
+		b2Assert(b->IsActive() == true);
+		island->Add(b);
+
+		// Make sure the body is awake.
+		b->SetAwake(true);
+
+		// To keep islands as small as possible, we don't
+		// propagate islands across static bodies.
+		if (b->GetType() == b2_staticBody)
+		{
+			continue;
+		}
+
+		// Search all contacts connected to this body.
+		for (b2ContactEdge* ce = b->m_contactList; ce; ce = ce->next)
+		{
+			b2Contact* contact = ce->contact;
+
+			// Has this contact already been added to an island?
+			if (contact->m_flags & b2Contact::e_islandFlag)
 			{
 				continue;
 			}
 
-			// Search all contacts connected to this body.
-			for (b2ContactEdge* ce = b->m_contactList; ce; ce = ce->next)
+			// Is this contact solid and touching?
+			if (contact->IsEnabled() == false ||
+				contact->IsTouching() == false)
 			{
-				b2Contact* contact = ce->contact;
+				continue;
+			}
 
-				// Has this contact already been added to an island?
-				if (contact->m_flags & b2Contact::e_islandFlag)
-				{
-					continue;
-				}
+			// Skip sensors.
+			bool sensorA = contact->m_fixtureA->m_isSensor;
+			bool sensorB = contact->m_fixtureB->m_isSensor;
+			if (sensorA || sensorB)
+			{
+				continue;
+			}
 
-				// Is this contact solid and touching?
-				if (contact->IsEnabled() == false ||
-					contact->IsTouching() == false)
-				{
-					continue;
-				}
+			island->Add(contact);
+			contact->m_flags |= b2Contact::e_islandFlag;
 
-				// Skip sensors.
-				bool sensorA = contact->m_fixtureA->m_isSensor;
-				bool sensorB = contact->m_fixtureB->m_isSensor;
-				if (sensorA || sensorB)
-				{
-					continue;
-				}
+			b2Body* other = ce->other;
 
-				island.Add(contact);
-				contact->m_flags |= b2Contact::e_islandFlag;
+			// Was the other body already added to this island?
+			if (other->m_flags & b2Body::e_islandFlag)
+			{
+				continue;
+			}
 
-				b2Body* other = ce->other;
+			b2Assert(stackCount < stackSize);
+			stack[stackCount++] = other;
+			other->m_flags |= b2Body::e_islandFlag;
+		}
 
-				// Was the other body already added to this island?
-				if (other->m_flags & b2Body::e_islandFlag)
-				{
-					continue;
-				}
+		// Search all joints connect to this body.
+		for (b2JointEdge* je = b->m_jointList; je; je = je->next)
+		{
+			if (je->joint->m_islandFlag == true)
+			{
+				continue;
+			}
+
+			b2Body* other = je->other;
 
-				b2Assert(stackCount < stackSize);
-				stack[stackCount++] = other;
-				other->m_flags |= b2Body::e_islandFlag;
+			// Don't simulate joints connected to inactive bodies.
+			if (other->IsActive() == false)
+			{
+				continue;
 			}
 
-			// Search all joints connect to this body.
-			for (b2JointEdge* je = b->m_jointList; je; je = je->next)
+			island->Add(je->joint);
+			je->joint->m_islandFlag = true;
+
+			if (other->m_flags & b2Body::e_islandFlag)
 			{
-				if (je->joint->m_islandFlag == true)
-				{
-					continue;
-				}
+				continue;
+			}
 
-				b2Body* other = je->other;
+			b2Assert(stackCount < stackSize);
+			stack[stackCount++] = other;
+			other->m_flags |= b2Body::e_islandFlag;
+		}
+	}
+}
 
-				// Don't simulate joints connected to inactive bodies.
-				if (other->IsActive() == false)
-				{
-					continue;
-				}
+void b2World::SynchronizeFixtures()
+{
+	b2Timer timer;
+	// Synchronize fixtures, check for out of range bodies.
+	for (b2Body* b = m_bodyList; b; b = b->GetNext())
+	{
+		// If a body was not in an island then it did not move.
+		if ((b->m_flags & b2Body::e_islandFlag) == 0)
+		{
+			continue;
+		}
 
-				island.Add(je->joint);
-				je->joint->m_islandFlag = true;
+		if (b->GetType() == b2_staticBody)
+		{
+			continue;
+		}
 
-				if (other->m_flags & b2Body::e_islandFlag)
-				{
-					continue;
-				}
+		// Update fixtures (for broad-phase).
+		b->SynchronizeFixtures();
+	}
 
-				b2Assert(stackCount < stackSize);
-				stack[stackCount++] = other;
-				other->m_flags |= b2Body::e_islandFlag;
-			}
+	// Look for new contacts.
+	m_contactManager.FindNewContacts();
+	m_profile.broadphase = timer.GetMilliseconds();
+}
+
+// LOVE: What the island tasks of SolveParallel work on.
+struct b2ParallelSolveContext
+{
+	b2Island* islands;
+	b2ContactSolver* contactSolvers;
+	bool* slept;
+	const b2TimeStep* step;
+	bool allowSleep;
+};
+
+static void b2SolveIslands(int32 begin, int32 end, void* context)
+{
+	b2ParallelSolveContext* ctx = (b2ParallelSolveContext*)context;
+
+	for (int32 i = begin; i < end; ++i)
+	{
+		b2Profile profile;
+		ctx->islands[i].SolveConstraints(&profile, *ctx->step, ctx->contactSolvers + i, false);
+		ctx->slept[i] = ctx->islands[i].SolveSleep(*ctx->step, ctx->allowSleep, false);
+	}
+}
+
+static int32 b2AlignSize(int32 size)
+{
+	return (size + 15) & ~15;
+}
+
+// LOVE: Solve with the islands spread over the task scheduler's threads. The
+// islands are built one after another like in Solve, and their constraints are
+// set up right away. Only the solver iterations run in parallel. Everything
+// that touches static bodies, which can be part of several islands, happens
+// afterwards in island order. That keeps the results identical to Solve's.
+void b2World::SolveParallel(const b2TimeStep& step)
+{
+	m_profile.solveInit = 0.0f;
+	m_profile.solveVelocity = 0.0f;
+	m_profile.solvePosition = 0.0f;
+
+	int32 contactCount = m_contactManager.m_contactCount;
+
+	// Static bodies are added to every island they touch through a contact or
+	// a joint, so this is the most bodies all the islands can add up to.
+	int32 bodyCapacity = m_bodyCount + contactCount + m_jointCount;
+	int32 islandCapacity = m_bodyCount;
+	int32 stackSize = m_bodyCount;
+
+	// Lay out all the arrays in one block of memory.
+	int32 islandsOffset = 0;
+	int32 solversOffset = islandsOffset + b2AlignSize(islandCapacity * sizeof(b2Island));
+	int32 sleptOffset = solversOffset + b2AlignSize(islandCapacity * sizeof(b2ContactSolver));
+	int32 stackOffset = sleptOffset + b2AlignSize(islandCapacity * sizeof(bool));
+	int32 bodiesOffset = stackOffset + b2AlignSize(stackSize * sizeof(b2Body*));
+	int32 positionsOffset = bodiesOffset + b2AlignSize(bodyCapacity * sizeof(b2Body*));
+	int32 velocitiesOffset = positionsOffset + b2AlignSize(bodyCapacity * sizeof(b2Position));
+	int32 contactsOffset = velocitiesOffset + b2AlignSize(bodyCapacity * sizeof(b2Velocity));
+	int32 positionConstraintsOffset = contactsOffset + b2AlignSize(contactCount * sizeof(b2Contact*));
+	int32 velocityConstraintsOffset = positionConstraintsOffset + b2AlignSize(contactCount * sizeof(b2ContactPositionConstraint));
+	int32 jointsOffset = velocityConstraintsOffset + b2AlignSize(contactCount * sizeof(b2ContactVelocityConstraint));
+	int32 size = jointsOffset + b2AlignSize(m_jointCount * sizeof(b2Joint*));
+
+	if (size > m_parallelMemorySize)
+	{
+		b2Free(m_parallelMemory);
+		m_parallelMemorySize = size + size / 2;
+		m_parallelMemory = b2Alloc(m_parallelMemorySize);
+	}
+
+	char* memory = (char*)m_parallelMemory;
+	b2Island* islands = (b2Island*)(memory + islandsOffset);
+	b2ContactSolver* contactSolvers = (b2ContactSolver*)(memory + solversOffset);
+	bool* slept = (bool*)(memory + sleptOffset);
+	b2Body** stack = (b2Body**)(memory + stackOffset);
+	b2Body** bodies = (b2Body**)(memory + bodiesOffset);
+	b2Position* positions = (b2Position*)(memory + positionsOffset);
+	b2Velocity* velocities = (b2Velocity*)(memory + velocitiesOffset);
+	b2Contact** contacts = (b2Contact**)(memory + contactsOffset);
+	b2ContactPositionConstraint* positionConstraints = (b2ContactPositionConstraint*)(memory + positionConstraintsOffset);
+	b2ContactVelocityConstraint* velocityConstraints = (b2ContactVelocityConstraint*)(memory + velocityConstraintsOffset);
+	b2Joint** joints = (b2Joint**)(memory + jointsOffset);
+
+	ClearIslandFlags();
+
+	// Build all awake islands and set up their constraints.
+	int32 islandCount = 0;
+	int32 bodyOffset = 0;
+	int32 contactOffset = 0;
+	int32 jointOffset = 0;
+	for (b2Body* seed = m_bodyList; seed; seed = seed->m_next)
+	{
+		if (seed->m_flags & b2Body::e_islandFlag)
+		{
+			continue;
+		}
+
+		if (seed->IsAwake() == false || seed->IsActive() == false)
+		{
+			continue;
+		}
+
+		// The seed can be dynamic or kinematic.
+		if (seed->GetType() == b2_staticBody)
+		{
+			continue;
 		}
 
+		b2Island* island = new (islands + islandCount) b2Island(bodies + bodyOffset,
+																contacts + contactOffset,
+																joints + jointOffset,
+																positions + bodyOffset,
+																velocities + bodyOffset,
+																bodyCapacity - bodyOffset,
+																contactCount - contactOffset,
+																m_jointCount - jointOffset,
+																m_contactManager.m_contactListener);
+
+		BuildIsland(island, seed, stack, stackSize);
+
+		// The m_islandIndex of static bodies is only right for this island
+		// until the next one is built.
+		b2ContactSolver* contactSolver = new (contactSolvers + islandCount) b2ContactSolver();
 		b2Profile profile;
-		island.Solve(&profile, step, m_gravity, m_allowSleep);
+		island->SolveInit(&profile, step, m_gravity, contactSolver,
+						  positionConstraints + contactOffset, velocityConstraints + contactOffset);
 		m_profile.solveInit += profile.solveInit;
-		m_profile.solveVelocity += profile.solveVelocity;
-		m_profile.solvePosition += profile.solvePosition;
 
-		// Post solve cleanup.
-		for (int32 i = 0; i < island.m_bodyCount; ++i)
+		for (int32 i = 0; i < island->m_bodyCount; ++i)
 		{
 			// Allow static bodies to participate in other islands.
-			b2Body* b = island.m_bodies[i];
+			b2Body* b = island->m_bodies[i];
 			if (b->GetType() == b2_staticBody)
 			{
 				b->m_flags &= ~b2Body::e_islandFlag;
 			}
 		}
-	}
 
-	m_stackAllocator.Free(stack);
+		bodyOffset += island->m_bodyCount;
+		contactOffset += island->m_contactCount;
+		jointOffset += island->m_jointCount;
+		++islandCount;
+	}
 
 	{
 		b2Timer timer;
-		// Synchronize fixtures, check for out of range bodies.
-		for (b2Body* b = m_bodyList; b; b = b->GetNext())
+
+		b2ParallelSolveContext context;
+		context.islands = islands;
+		context.contactSolvers = contactSolvers;
+		context.slept = slept;
+		context.step = &step;
+		context.allowSleep = m_allowSleep;
+
+		m_taskScheduler->ParallelFor(islandCount, 1, b2SolveIslands, &context);
+
+		// The velocity and position phases overlap between islands, so they
+		// aren't timed separately.
+		m_profile.solveVelocity = timer.GetMilliseconds();
+	}
+
+	for (int32 i = 0; i < islandCount; ++i)
+	{
+		b2Island* island = islands + i;
+
+		// A single-threaded solve wakes the static bodies of each island
+		// while building it, and puts them to sleep after solving it if the
+		// island fell asleep.
+		for (int32 j = 0; j < island->m_bodyCount; ++j)
 		{
-			// If a body was not in an island then it did not move.
-			if ((b->m_flags & b2Body::e_islandFlag) == 0)
+			b2Body* b = island->m_bodies[j];
+			if (b->GetType() == b2_staticBody)
 			{
-				continue;
+				b->SetAwake(true);
 			}
+		}
 
-			if (b->GetType() == b2_staticBody)
+		island->Report(contactSolvers[i].m_velocityConstraints);
+
+		if (slept[i])
+		{
+			for (int32 j = 0; j < island->m_bodyCount; ++j)
 			{
-				continue;
+				b2Body* b = island->m_bodies[j];
+				if (b->GetType() == b2_staticBody)
+				{
+					b->SetAwake(false);
+				}
 			}
-
-			// Update fixtures (for broad-phase).
-			b->SynchronizeFixtures();
 		}
 
-		// Look for new contacts.
-		m_contactManager.FindNewContacts();
-		m_profile.broadphase = timer.GetMilliseconds();
+		contactSolvers[i].~b2ContactSolver();
+		island->~b2Island();
 	}
+
+	SynchronizeFixtures();
 }
 
 // Find TOI contacts and solve them.
@@ -1337,3 +1586,587 @@ void b2World::Dump()
 	b2Log("joints = NULL;\n");
 	b2Log("bodies = NULL;\n");
 }
+
+// LOVE: The layout of SaveState. Every section starts 8-byte aligned. The
+// state can come from anywhere (it's a Data object in LOVE), so it holds no
+// pointers: fixtures are referred to by their position in the world, in body
+// list and then fixture list order.
+struct b2WorldState
+{
+	uint32 structureVersion;
+	int32 size;
+	int32 bodyCount;
+	int32 fixtureCount;
+	int32 proxyCount;
+	int32 jointSize;
+	int32 contactCount;
+	int32 newFixture;
+	b2Vec2 gravity;
+};
+
+struct b2BodyState
+{
+	b2Transform xf;
+	b2Sweep sweep;
+	b2Vec2 linearVelocity;
+	float32 angularVelocity;
+	b2Vec2 force;
+	float32 torque;
+	float32 mass, invMass;
+	float32 I, invI;
+	float32 linearDamping;
+	float32 angularDamping;
+	float32 gravityScale;
+	float32 sleepTime;
+	int32 type;
+	uint16 flags;
+};
+
+struct b2FixtureState
+{
+	b2Filter filter;
+	float32 density;
+	float32 friction;
+	float32 restitution;
+	int32 proxyCount;
+	uint8 isSensor;
+};
+
+struct b2FixtureProxyState
+{
+	b2AABB aabb;
+	int32 proxyId;
+};
+
+// Each joint's state is preceded by this, and padded.
+struct b2JointStateHeader
+{
+	int32 type;
+	int32 size;
+};
+
+struct b2ContactState
+{
+	int32 fixtureA;
+	int32 fixtureB;
+	int32 indexA;
+	int32 indexB;
+	uint32 flags;
+	int32 toiCount;
+	float32 toi;
+	float32 friction;
+	float32 restitution;
+	float32 tangentSpeed;
+	b2Manifold manifold;
+};
+
+static int32 b2AlignState(int32 size)
+{
+	return (size + 7) & ~7;
+}
+
+int32 b2World::GetStateSize() const
+{
+	int32 fixtureCount = 0;
+	int32 proxyCount = 0;
+	for (b2Body* b = m_bodyList; b; b = b->m_next)
+	{
+		fixtureCount += b->m_fixtureCount;
+		for (b2Fixture* f = b->m_fixtureList; f; f = f->m_next)
+		{
+			proxyCount += f->m_proxyCount;
+		}
+	}
+
+	int32 jointSize = 0;
+	for (b2Joint* j = m_jointList; j; j = j->m_next)
+	{
+		jointSize += sizeof(b2JointStateHeader) + b2AlignState(b2Joint::GetStateSize(j->m_type));
+	}
+
+	int32 size = b2AlignState(sizeof(b2WorldState));
+	size += b2AlignState(m_bodyCount * sizeof(b2BodyState));
+	size += b2AlignState(fixtureCount * sizeof(b2FixtureState));
+	size += b2AlignState(proxyCount * sizeof(b2FixtureProxyState));
+	size += jointSize;
+	size += b2AlignState(m_contactManager.m_contactCount * sizeof(b2ContactState));
+	size += m_contactManager.m_broadPhase.GetStateSize();
+	return size;
+}
+
+void b2World::SaveState(void* data) const
+{
+	b2Assert(IsLocked() == false);
+
+	b2WorldState* world = (b2WorldState*)data;
+	char* p = (char*)data + b2AlignState(sizeof(b2WorldState));
+
+	b2BodyState* bodies = (b2BodyState*)p;
+	for (b2Body* b = m_bodyList; b; b = b->m_next)
+	{
+		b2BodyState* state = bodies++;
+		state->xf = b->m_xf;
+		state->sweep = b->m_sweep;
+		state->linearVelocity = b->m_linearVelocity;
+		state->angularVelocity = b->m_angularVelocity;
+		state->force = b->m_force;
+		state->torque = b->m_torque;
+		state->mass = b->m_mass;
+		state->invMass = b->m_invMass;
+		state->I = b->m_I;
+		state->invI = b->m_invI;
+		state->linearDamping = b->m_linearDamping;
+		state->angularDamping = b->m_angularDamping;
+		state->gravityScale = b->m_gravityScale;
+		state->sleepTime = b->m_sleepTime;
+		state->type = b->m_type;
+		state->flags = b->m_flags;
+	}
+	p += b2AlignState(m_bodyCount * sizeof(b2BodyState));
+
+	int32 fixtureCount = 0;
+	int32 proxyCount = 0;
+	b2FixtureState* fixtures = (b2FixtureState*)p;
+	for (b2Body* b = m_bodyList; b; b = b->m_next)
+	{
+		for (b2Fixture* f = b->m_fixtureList; f; f = f->m_next)
+		{
+			b2FixtureState* state = fixtures++;
+			state->filter = f->m_filter;
+			state->density = f->m_density;
+			state->friction = f->m_friction;
+			state->restitution = f->m_restitution;
+			state->proxyCount = f->m_proxyCount;
+			state->isSensor = f->m_isSensor;
+
+			++fixtureCount;
+			proxyCount += f->m_proxyCount;
+		}
+	}
+	p += b2AlignState(fixtureCount * sizeof(b2FixtureState));
+
+	b2FixtureProxyState* proxies = (b2FixtureProxyState*)p;
+	for (b2Body* b = m_bodyList; b; b = b->m_next)
+	{
+		for (b2Fixture* f = b->m_fixtureList; f; f = f->m_next)
+		{
+			for (int32 i = 0; i < f->m_proxyCount; ++i)
+			{
+				b2FixtureProxyState* state = proxies++;
+				state->aabb = f->m_proxies[i].aabb;
+				state->proxyId = f->m_proxies[i].proxyId;
+			}
+		}
+	}
+	p += b2AlignState(proxyCount * sizeof(b2FixtureProxyState));
+
+	int32 jointSize = 0;
+	for (b2Joint* j = m_jointList; j; j = j->m_next)
+	{
+		b2JointStateHeader* header = (b2JointStateHeader*)(p + jointSize);
+		header->type = j->m_type;
+		header->size = b2Joint::GetStateSize(j->m_type);
+		j->SaveState(header + 1);
+		jointSize += sizeof(b2JointStateHeader) + b2AlignState(header->size);
+	}
+	p += jointSize;
+
+	// Contacts only exist between proxies, so a contact's fixtures can be
+	// found through the ids of its proxies.
+	int32* ordinals = NULL;
+	if (m_contactManager.m_contactCount > 0)
+	{
+		int32 proxyIdCount = 0;
+		for (b2Body* b = m_bodyList; b; b = b->m_next)
+		{
+			for (b2Fixture* f = b->m_fixtureList; f; f = f->m_next)
+			{
+				for (int32 i = 0; i < f->m_proxyCount; ++i)
+				{
+					proxyIdCount = b2Max(proxyIdCount, f->m_proxies[i].proxyId + 1);
+				}
+			}
+		}
+
+		ordinals = (int32*)b2Alloc(proxyIdCount * sizeof(int32));
+
+		int32 ordinal = 0;
+		for (b2Body* b = m_bodyList; b; b = b->m_next)
+		{
+			for (b2Fixture* f = b->m_fixtureList; f; f = f->m_next)
+			{
+				for (int32 i = 0; i < f->m_proxyCount; ++i)
+				{
+					ordinals[f->m_proxies[i].proxyId] = ordinal;
+				}
+				++ordinal;
+			}
+		}
+	}
+
+	b2ContactState* contacts = (b2ContactState*)p;
+	for (b2Contact* c = m_contactManager.m_contactList; c; c = c->m_next)
+	{
+		b2ContactState* state = contacts++;
+		state->fixtureA = ordinals[c->m_fixtureA->m_proxies[c->m_indexA].proxyId];
+		state->fixtureB = ordinals[c->m_fixtureB->m_proxies[c->m_indexB].proxyId];
+		state->indexA = c->m_indexA;
+		state->indexB = c->m_indexB;
+		state->flags = c->m_flags;
+		state->toiCount = c->m_toiCount;
+		state->toi = c->m_toi;
+		state->friction = c->m_friction;
+		state->restitution = c->m_restitution;
+		state->tangentSpeed = c->m_tangentSpeed;
+		state->manifold = c->m_manifold;
+	}
+	p += b2AlignState(m_contactManager.m_contactCount * sizeof(b2ContactState));
+
+	b2Free(ordinals);
+
+	p += m_contactManager.m_broadPhase.SaveState(p);
+
+	world->structureVersion = m_structureVersion;
+	world->size = (int32)(p - (char*)data);
+	world->bodyCount = m_bodyCount;
+	world->fixtureCount = fixtureCount;
+	world->proxyCount = proxyCount;
+	world->jointSize = jointSize;
+	world->contactCount = m_contactManager.m_contactCount;
+	world->newFixture = (m_flags & e_newFixture) != 0;
+	world->gravity = m_gravity;
+}
+
+bool b2World::CheckState(const void* data, int32 size) const
+{
+	const b2WorldState* world = (const b2WorldState*)data;
+	if (size < b2AlignState(sizeof(b2WorldState)) || world->size != size ||
+		world->structureVersion != m_structureVersion || world->bodyCount != m_bodyCount)
+	{
+		return false;
+	}
+
+	int32 fixtureCount = 0;
+	int32 proxyCount = 0;
+	for (b2Body* b = m_bodyList; b; b = b->m_next)
+	{
+		fixtureCount += b->m_fixtureCount;
+		for (b2Fixture* f = b->m_fixtureList; f; f = f->m_next)
+		{
+			proxyCount += f->m_proxyCount;
+		}
+	}
+
+	int32 jointSize = 0;
+	for (b2Joint* j = m_jointList; j; j = j->m_next)
+	{
+		jointSize += sizeof(b2JointStateHeader) + b2AlignState(b2Joint::GetStateSize(j->m_type));
+	}
+
+	if (world->fixtureCount != fixtureCount || world->proxyCount != proxyCount ||
+		world->jointSize != jointSize || world->contactCount < 0)
+	{
+		return false;
+	}
+
+	int32 offset = b2AlignState(sizeof(b2WorldState));
+	offset += b2AlignState(m_bodyCount * sizeof(b2BodyState));
+	offset += b2AlignState(fixtureCount * sizeof(b2FixtureState));
+	offset += b2AlignState(proxyCount * sizeof(b2FixtureProxyState));
+	offset += jointSize;
+
+	if (offset > size || world->contactCount > (size - offset) / (int32)sizeof(b2ContactState))
+	{
+		return false;
+	}
+
+	int32 broadPhaseOffset = offset + b2AlignState(world->contactCount * sizeof(b2ContactState));
+	if (broadPhaseOffset > size)
+	{
+		return false;
+	}
+
+	const char* p = (const char*)data + b2AlignState(sizeof(b2WorldState));
+	const b2BodyState* bodies = (const b2BodyState*)p;
+	p += b2AlignState(m_bodyCount * sizeof(b2BodyState));
+	const b2FixtureState* fixtures = (const b2FixtureState*)p;
+	p += b2AlignState(fixtureCount * sizeof(b2FixtureState));
+	const b2FixtureProxyState* proxies = (const b2FixtureProxyState*)p;
+	p += b2AlignState(proxyCount * sizeof(b2FixtureProxyState));
+	const char* joints = p;
+	p += jointSize;
+	const b2ContactState* contacts = (const b2ContactState*)p;
+	const b2BodyState* bodyStates = bodies;
+
+	// A body's proxies come and go with its active flag, so that has to stay
+	// as it is.
+	for (b2Body* b = m_bodyList; b; b = b->m_next)
+	{
+		const b2BodyState* state = bodies++;
+		if (state->type < b2_staticBody || state->type > b2_dynamicBody ||
+			(state->flags & b2Body::e_activeFlag) != (b->m_flags & b2Body::e_activeFlag))
+		{
+			return false;
+		}
+
+		for (b2Fixture* f = b->m_fixtureList; f; f = f->m_next)
+		{
+			const b2FixtureState* fixture = fixtures++;
+			if (fixture->proxyCount != f->m_proxyCount)
+			{
+				return false;
+			}
+
+			for (int32 i = 0; i < f->m_proxyCount; ++i)
+			{
+				const b2FixtureProxyState* proxy = proxies++;
+				if (proxy->proxyId != f->m_proxies[i].proxyId)
+				{
+					return false;
+				}
+			}
+		}
+	}
+
+	for (b2Joint* j = m_jointList; j; j = j->m_next)
+	{
+		const b2JointStateHeader* header = (const b2JointStateHeader*)joints;
+		if (header->type != j->m_type || header->size != b2Joint::GetStateSize(j->m_type) ||
+			!j->CheckState(header + 1))
+		{
+			return false;
+		}
+		joints += sizeof(b2JointStateHeader) + b2AlignState(header->size);
+	}
+
+	if (world->contactCount > 0)
+	{
+		b2Fixture** fixtureList = (b2Fixture**)b2Alloc(fixtureCount * sizeof(b2Fixture*));
+		int32* fixtureBodyTypes = (int32*)b2Alloc(fixtureCount * sizeof(int32));
+
+		int32 ordinal = 0;
+		const b2BodyState* body = bodyStates;
+		for (b2Body* b = m_bodyList; b; b = b->m_next, ++body)
+		{
+			for (b2Fixture* f = b->m_fixtureList; f; f = f->m_next)
+			{
+				fixtureBodyTypes[ordinal] = body->type;
+				fixtureList[ordinal++] = f;
+			}
+		}
+
+		bool valid = true;
+		for (int32 i = 0; valid && i < world->contactCount; ++i)
+		{
+			const b2ContactState* state = contacts + i;
+			if (state->fixtureA < 0 || state->fixtureA >= fixtureCount ||
+				state->fixtureB < 0 || state->fixtureB >= fixtureCount)
+			{
+				valid = false;
+				break;
+			}
+
+			// b2Contact::Create has to make the contact with the fixtures in
+			// the saved order, otherwise the manifold would be backwards. As
+			// in b2Body::ShouldCollide, one of the bodies has to be dynamic.
+			const b2Fixture* fixtureA = fixtureList[state->fixtureA];
+			const b2Fixture* fixtureB = fixtureList[state->fixtureB];
+			valid = fixtureA->m_body != fixtureB->m_body &&
+				(fixtureBodyTypes[state->fixtureA] == b2_dynamicBody || fixtureBodyTypes[state->fixtureB] == b2_dynamicBody) &&
+				state->indexA >= 0 && state->indexA < fixtureA->m_proxyCount &&
+				state->indexB >= 0 && state->indexB < fixtureB->m_proxyCount &&
+				b2Contact::IsPrimary(fixtureA->GetType(), fixtureB->GetType());
+
+			// The solver warm starts from the saved impulses, which it keeps
+			// positive. The manifold's type is only set once it has points.
+			const b2Manifold& manifold = state->manifold;
+			int32 manifoldType;
+			memcpy(&manifoldType, &manifold.type, sizeof(manifoldType));
+			valid = valid && manifold.pointCount >= 0 && manifold.pointCount <= b2_maxManifoldPoints &&
+				(manifold.pointCount == 0 || (manifoldType >= b2Manifold::e_circles && manifoldType <= b2Manifold::e_faceB));
+			for (int32 j = 0; valid && j < manifold.pointCount; ++j)
+			{
+				valid = manifold.points[j].normalImpulse >= 0.0f;
+			}
+		}
+
+		b2Free(fixtureBodyTypes);
+		b2Free(fixtureList);
+
+		if (!valid)
+		{
+			return false;
+		}
+	}
+
+	return m_contactManager.m_broadPhase.CheckState((const char*)data + broadPhaseOffset, size - broadPhaseOffset);
+}
+
+bool b2World::LoadState(const void* data, int32 size)
+{
+	b2Assert(IsLocked() == false);
+	if (IsLocked())
+	{
+		return false;
+	}
+
+	if (!CheckState(data, size))
+	{
+		return false;
+	}
+
+	const b2WorldState* world = (const b2WorldState*)data;
+
+	const char* p = (const char*)data + b2AlignState(sizeof(b2WorldState));
+	const b2BodyState* bodies = (const b2BodyState*)p;
+	p += b2AlignState(world->bodyCount * sizeof(b2BodyState));
+	const b2FixtureState* fixtures = (const b2FixtureState*)p;
+	p += b2AlignState(world->fixtureCount * sizeof(b2FixtureState));
+	const b2FixtureProxyState* proxies = (const b2FixtureProxyState*)p;
+	p += b2AlignState(world->proxyCount * sizeof(b2FixtureProxyState));
+	const char* joints = p;
+	p += world->jointSize;
+	const b2ContactState* contacts = (const b2ContactState*)p;
+	p += b2AlignState(world->contactCount * sizeof(b2ContactState));
+
+	// Get rid of the current contacts. Destroying them may wake bodies, so
+	// this goes before the bodies are put back.
+	b2ContactListener* listener = m_contactManager.m_contactListener;
+	m_contactManager.m_contactListener = NULL;
+	while (m_contactManager.m_contactList)
+	{
+		m_contactManager.Destroy(m_contactManager.m_contactList);
+	}
+	m_contactManager.m_contactListener = listener;
+
+	for (b2Joint* j = m_jointList; j; j = j->m_next)
+	{
+		const b2JointStateHeader* header = (const b2JointStateHeader*)joints;
+		j->LoadState(header + 1);
+		joints += sizeof(b2JointStateHeader) + b2AlignState(header->size);
+	}
+
+	b2Fixture** fixtureList = NULL;
+	if (world->contactCount > 0)
+	{
+		fixtureList = (b2Fixture**)b2Alloc(world->fixtureCount * sizeof(b2Fixture*));
+	}
+
+	int32 fixtureCount = 0;
+	for (b2Body* b = m_bodyList; b; b = b->m_next)
+	{
+		for (b2Fixture* f = b->m_fixtureList; f; f = f->m_next)
+		{
+			if (fixtureList != NULL)
+			{
+				fixtureList[fixtureCount] = f;
+			}
+			++fixtureCount;
+
+			// The proxy count and ids are checked to be the same.
+			const b2FixtureState* state = fixtures++;
+			f->m_filter = state->filter;
+			f->m_density = state->density;
+			f->m_friction = state->friction;
+			f->m_restitution = state->restitution;
+			f->m_isSensor = state->isSensor != 0;
+
+			for (int32 i = 0; i < f->m_proxyCount; ++i)
+			{
+				const b2FixtureProxyState* proxy = proxies++;
+				f->m_proxies[i].aabb = proxy->aabb;
+			}
+		}
+	}
+
+	m_contactManager.m_broadPhase.LoadState(p);
+
+	// Recreate the contacts back to front, since they're added to the front
+	// of the lists. That puts the contact lists of the bodies back in order
+	// as well.
+	for (int32 i = world->contactCount - 1; i >= 0; --i)
+	{
+		const b2ContactState* state = contacts + i;
+		b2Fixture* fixtureA = fixtureList[state->fixtureA];
+		b2Fixture* fixtureB = fixtureList[state->fixtureB];
+		b2Contact* c = b2Contact::Create(fixtureA, state->indexA, fixtureB, state->indexB, &m_blockAllocator);
+		b2Assert(c->m_fixtureA == fixtureA);
+
+		c->m_flags = state->flags;
+		c->m_toiCount = state->toiCount;
+		c->m_toi = state->toi;
+		c->m_friction = state->friction;
+		c->m_restitution = state->restitution;
+		c->m_tangentSpeed = state->tangentSpeed;
+		c->m_manifold = state->manifold;
+
+		b2Body* bodyA = c->m_fixtureA->m_body;
+		b2Body* bodyB = c->m_fixtureB->m_body;
+
+		c->m_prev = NULL;
+		c->m_next = m_contactManager.m_contactList;
+		if (m_contactManager.m_contactList != NULL)
+		{
+			m_contactManager.m_contactList->m_prev = c;
+		}
+		m_contactManager.m_contactList = c;
+
+		c->m_nodeA.contact = c;
+		c->m_nodeA.other = bodyB;
+		c->m_nodeA.prev = NULL;
+		c->m_nodeA.next = bodyA->m_contactList;
+		if (bodyA->m_contactList != NULL)
+		{
+			bodyA->m_contactList->prev = &c->m_nodeA;
+		}
+		bodyA->m_contactList = &c->m_nodeA;
+
+		c->m_nodeB.contact = c;
+		c->m_nodeB.other = bodyA;
+		c->m_nodeB.prev = NULL;
+		c->m_nodeB.next = bodyB->m_contactList;
+		if (bodyB->m_contactList != NULL)
+		{
+			bodyB->m_contactList->prev = &c->m_nodeB;
+		}
+		bodyB->m_contactList = &c->m_nodeB;
+
+		++m_contactManager.m_contactCount;
+	}
+
+	b2Free(fixtureList);
+
+	for (b2Body* b = m_bodyList; b; b = b->m_next)
+	{
+		const b2BodyState* state = bodies++;
+		b->m_xf = state->xf;
+		b->m_sweep = state->sweep;
+		b->m_linearVelocity = state->linearVelocity;
+		b->m_angularVelocity = state->angularVelocity;
+		b->m_force = state->force;
+		b->m_torque = state->torque;
+		b->m_mass = state->mass;
+		b->m_invMass = state->invMass;
+		b->m_I = state->I;
+		b->m_invI = state->invI;
+		b->m_linearDamping = state->linearDamping;
+		b->m_angularDamping = state->angularDamping;
+		b->m_gravityScale = state->gravityScale;
+		b->m_sleepTime = state->sleepTime;
+		b->m_type = (b2BodyType)state->type;
+		b->m_flags = state->flags;
+	}
+
+	if (world->newFixture)
+	{
+		m_flags |= e_newFixture;
+	}
+	else
+	{
+		m_flags &= ~e_newFixture;
+	}
+
+	m_gravity = world->gravity;
+
+	return true;
+}
@@ -31,6 +31,7 @@ struct b2BodyDef;
 struct b2Color;
 struct b2JointDef;
 class b2Body;
+class b2Island;
 class b2Draw;
 class b2Fixture;
 class b2Joint;
@@ -205,10 +206,52 @@ public:
 	/// Get the current profile.
 	const b2Profile& GetProfile() const;
 
+	/// LOVE: Get the user data pointer that was provided in SetUserData.
+	void* GetUserData() const;
+
+	/// LOVE: Set the user data. Use this to store your application specific data.
+	void SetUserData(void* data);
+
+	/// LOVE: Spread the island solver and the contact updates of each time
+	/// step over several threads. The results are the same as a single-threaded
+	/// step, except that PostSolve is only called once every island has been
+	/// solved. Pass NULL to go back to solving on the calling thread.
+	/// @warning the scheduler must outlive the world, or be unset first.
+	void SetTaskScheduler(b2TaskScheduler* scheduler);
+	b2TaskScheduler* GetTaskScheduler() const;
+
 	/// Dump the world into the log file.
 	/// @warning this should be called outside of a time step.
 	void Dump();
 
+	/// LOVE: Get a number which changes whenever a body, fixture or joint is
+	/// created or destroyed in this world.
+	uint32 GetStructureVersion() const;
+
+	/// LOVE: Get the size of the world's state, in bytes (see SaveState.)
+	int32 GetStateSize() const;
+
+	/// LOVE: Copy the state of the bodies, fixtures, joints, contacts and the
+	/// broad-phase into memory of GetStateSize bytes. Shapes aren't included.
+	/// The state holds no pointers: bodies, fixtures and joints are referred
+	/// to by their position in this world's lists.
+	/// @warning this should be called outside of a time step.
+	void SaveState(void* data) const;
+
+	/// LOVE: Check that a state of size bytes can be put back into this world.
+	/// It has to have the same structure version and the same bodies, fixtures,
+	/// proxies and joints. Every index in it is checked, so it's safe to pass
+	/// in any data.
+	bool CheckState(const void* data, int32 size) const;
+
+	/// LOVE: Put back the state saved by SaveState. No bodies, fixtures or
+	/// joints may have been created or destroyed in between (see
+	/// GetStructureVersion.) The contacts are recreated as they were, without
+	/// calling the contact listener.
+	/// @return false, without changing anything, if CheckState fails.
+	/// @warning this should be called outside of a time step.
+	bool LoadState(const void* data, int32 size);
+
 private:
 
 	// m_flags
@@ -227,6 +270,12 @@ private:
 	void Solve(const b2TimeStep& step);
 	void SolveTOI(const b2TimeStep& step);
 
+	// LOVE: Solve split up, for SolveParallel.
+	void ClearIslandFlags();
+	void BuildIsland(b2Island* island, b2Body* seed, b2Body** stack, int32 stackSize);
+	void SynchronizeFixtures();
+	void SolveParallel(const b2TimeStep& step);
+
 	void DrawJoint(b2Joint* joint);
 	void DrawShape(b2Fixture* shape, const b2Transform& xf, const b2Color& color);
 
@@ -258,6 +307,18 @@ private:
 	bool m_continuousPhysics;
 	bool m_subStepping;
 
+	// LOVE: See SetTaskScheduler. SolveParallel keeps its memory between
+	// steps.
+	b2TaskScheduler* m_taskScheduler;
+	void* m_parallelMemory;
+	int32 m_parallelMemorySize;
+
+	// LOVE: See GetStructureVersion.
+	uint32 m_structureVersion;
+
+	// LOVE: See SetUserData.
+	void* m_userData;
+
 	bool m_stepComplete;
 
 	b2Profile m_profile;
@@ -351,4 +412,24 @@ inline const b2Profile& b2World::GetProfile() const
 	return m_profile;
 }
 
+inline b2TaskScheduler* b2World::GetTaskScheduler() const
+{
+	return m_taskScheduler;
+}
+
+inline uint32 b2World::GetStructureVersion() const
+{
+	return m_structureVersion;
+}
+
+inline void* b2World::GetUserData() const
+{
+	return m_userData;
+}
+
+inline void b2World::SetUserData(void* data)
+{
+	m_userData = data;
+}
+
 #endif
@@ -152,4 +152,21 @@ public:
 									const b2Vec2& normal, float32 fraction) = 0;
 };
 
+/// LOVE: A function which processes the items [begin, end) of a parallel task.
+typedef void b2ParallelTask(int32 begin, int32 end, void* context);
+
+/// LOVE: Lets a world spread independent work over several threads. Used to
+/// solve islands and to compute contact manifolds concurrently.
+/// See b2World::SetTaskScheduler
+class b2TaskScheduler
+{
+public:
+	virtual ~b2TaskScheduler() {}
+
+	/// Calls task for consecutive ranges covering [0, count), possibly on
+	/// several threads at once, and returns once every range is done. Ranges
+	/// should be at least minRange items long (except the last one.)
+	virtual void ParallelFor(int32 count, int32 minRange, b2ParallelTask* task, void* context) = 0;
+};
+
 #endif
@@ -47,8 +47,11 @@ class Noise1234 {
     static float pnoise( float x, float y, float z, float w,
                               int px, int py, int pz, int pw );
 
-  private:
+    // LOVE: Public so love::math::NoiseField can compute the same noise
+    // several samples at a time.
     static unsigned char perm[];
+
+  private:
     static float  grad( int hash, float x );
     static float  grad( int hash, float x, float y );
     static float  grad( int hash, float x, float y , float z );
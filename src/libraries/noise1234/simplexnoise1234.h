@@ -43,8 +43,11 @@ class SimplexNoise1234 {
     static float noise( float x );
     static float noise( float x, float y );
 
-  private:
+    // LOVE: Public so love::math::NoiseField can compute the same noise
+    // several samples at a time.
     static unsigned char perm[];
+
+  private:
     static float  grad( int hash, float x );
     static float  grad( int hash, float x, float y );
 
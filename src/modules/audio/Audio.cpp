@@ -41,6 +41,11 @@ bool Audio::setMixWithSystem(bool mix)
 #endif
 }
 
+SourceCache &Audio::getSourceCache()
+{
+	return sourceCache;
+}
+
 StringMap<Audio::DistanceModel, Audio::DISTANCE_MAX_ENUM>::Entry Audio::distanceModelEntries[] =
 {
 	{"none", Audio::DISTANCE_NONE},
@@ -28,6 +28,7 @@
 #include "common/Module.h"
 #include "common/StringMap.h"
 #include "Source.h"
+#include "SourceCache.h"
 #include "Effect.h"
 #include "RecordingDevice.h"
 
@@ -104,6 +105,20 @@ public:
 	 **/
 	virtual bool play(const std::vector<Source*> &sources) = 0;
 
+	/**
+	 * Starts playing the specified Sources together, when the audio clock
+	 * reaches the given time.
+	 * @param sources The Sources to play.
+	 * @param time Time in seconds, on the clock given by getClock.
+	 **/
+	virtual bool playAt(const std::vector<Source*> &sources, double time) = 0;
+
+	/**
+	 * Gets the current time of the audio clock in seconds. The clock is
+	 * monotonic and follows the audio output rather than the system clock.
+	 **/
+	virtual double getClock() const = 0;
+
 	/**
 	 * Stops playback on the specified source.
 	 * @param source The source on which to stop the playback.
@@ -263,6 +278,17 @@ public:
 	 **/
 	bool setMixWithSystem(bool mix);
 
+	/**
+	 * Gets the cache of decoded static Sources, used when static Sources are
+	 * created directly from files.
+	 **/
+	SourceCache &getSourceCache();
+
+protected:
+
+	// Implementations must clear this before their Sources become unusable.
+	SourceCache sourceCache;
+
 private:
 
 	static StringMap<DistanceModel, DISTANCE_MAX_ENUM>::Entry distanceModelEntries[];
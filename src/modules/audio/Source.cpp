@@ -20,6 +20,9 @@
 
 #include "Source.h"
 
+// C++
+#include <algorithm>
+
 namespace love
 {
 namespace audio
@@ -36,6 +39,26 @@ Source::~Source()
 {
 }
 
+void Source::shiftSamples(const void *data, size_t length, int bitDepth, int channels, int64 frames, std::vector<uint8> &out)
+{
+	size_t frameSize = (size_t) (bitDepth / 8 * channels);
+	const uint8 *src = (const uint8 *) data;
+
+	out.clear();
+
+	if (frames >= 0)
+	{
+		// 8-bit samples are unsigned, so their silence isn't 0.
+		out.resize((size_t) frames * frameSize + length, bitDepth == 8 ? 128 : 0);
+		std::copy(src, src + length, out.begin() + (size_t) frames * frameSize);
+	}
+	else if ((size_t) -frames * frameSize < length)
+	{
+		size_t skip = (size_t) -frames * frameSize;
+		out.assign(src + skip, src + length);
+	}
+}
+
 Source::Type Source::getType() const
 {
 	return sourceType;
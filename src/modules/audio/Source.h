@@ -24,6 +24,8 @@
 // LOVE
 #include "common/Object.h"
 #include "common/StringMap.h"
+#include "common/Exception.h"
+#include "common/int.h"
 #include "Filter.h"
 
 #include <vector>
@@ -33,6 +35,73 @@ namespace love
 namespace audio
 {
 
+class InvalidFormatException : public love::Exception
+{
+public:
+
+	InvalidFormatException(int channels, int bitdepth)
+		: Exception("%d-channel Sources with %d bits per sample are not supported.", channels, bitdepth)
+	{
+	}
+
+};
+
+class SpatialSupportException : public love::Exception
+{
+public:
+
+	SpatialSupportException()
+		: Exception("This spatial audio functionality is only available for mono Sources. \
+Ensure the Source is not multi-channel before calling this function.")
+	{
+	}
+
+};
+
+class QueueFormatMismatchException : public love::Exception
+{
+public:
+
+	QueueFormatMismatchException()
+		: Exception("Queued sound data must have same format as sound Source.")
+	{
+	}
+
+};
+
+class QueueTypeMismatchException : public love::Exception
+{
+public:
+
+	QueueTypeMismatchException()
+		: Exception("Only queueable Sources can be queued with sound data.")
+	{
+	}
+
+};
+
+class QueueMalformedLengthException : public love::Exception
+{
+public:
+
+	QueueMalformedLengthException(int bytes)
+		: Exception("Data length must be a multiple of sample size (%d bytes).", bytes)
+	{
+	}
+
+};
+
+class QueueLoopingException : public love::Exception
+{
+public:
+
+	QueueLoopingException()
+		: Exception("Queueable Sources can not be looped.")
+	{
+	}
+
+};
+
 class Source : public Object
 {
 public:
@@ -122,6 +191,20 @@ public:
 	virtual int getFreeBufferCount() const = 0;
 	virtual bool queue(void *data, size_t length, int dataSampleRate, int dataBitDepth, int dataChannels) = 0;
 
+	/**
+	 * Starts playing the Source when the audio clock reaches the given time.
+	 * @param time Time in seconds, on the clock given by Audio::getClock.
+	 **/
+	virtual bool playAt(double time) = 0;
+
+	/**
+	 * Queues sound data which should start playing when the audio clock
+	 * reaches the given time. Silence fills any gap after the previously
+	 * queued data, and data which would have played before the given time is
+	 * dropped. A stopped Source is scheduled to start playing.
+	 **/
+	virtual bool queueAt(void *data, size_t length, int dataSampleRate, int dataBitDepth, int dataChannels, double time) = 0;
+
 	virtual Type getType() const;
 
 	static bool getConstant(const char *in, Type &out);
@@ -133,6 +216,13 @@ public:
 
 protected:
 
+	/**
+	 * Copies sample data, shifted in time by the given number of sample
+	 * frames. Positive shifts insert silence before the data, negative shifts
+	 * drop frames from its start.
+	 **/
+	static void shiftSamples(const void *data, size_t length, int bitDepth, int channels, int64 frames, std::vector<uint8> &out);
+
 	Type sourceType;
 
 private:
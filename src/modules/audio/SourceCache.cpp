@@ -0,0 +1,112 @@
+/**
+ * Copyright (c) 2006-2018 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#include "SourceCache.h"
+
+namespace love
+{
+namespace audio
+{
+
+SourceCache::SourceCache()
+	: budget(DEFAULT_BUDGET)
+	, size(0)
+{
+}
+
+SourceCache::~SourceCache()
+{
+}
+
+Source *SourceCache::get(const std::string &key)
+{
+	thread::Lock lock(mutex);
+
+	auto it = lookup.find(key);
+	if (it == lookup.end())
+		return nullptr;
+
+	// Move it to the front of the list.
+	entries.splice(entries.begin(), entries, it->second);
+
+	return it->second->source->clone();
+}
+
+void SourceCache::add(const std::string &key, Source *source, size_t bytes)
+{
+	if (source->getType() != Source::TYPE_STATIC)
+		return;
+
+	thread::Lock lock(mutex);
+
+	if (bytes > budget || lookup.find(key) != lookup.end())
+		return;
+
+	// The cached copy is never played or modified, so it can be cloned from
+	// later without anything leaking over from the Source the user gets.
+	StrongRef<Source> copy(source->clone(), Acquire::NORETAIN);
+
+	entries.push_front({key, copy, bytes});
+	lookup[key] = entries.begin();
+	size += bytes;
+
+	trim();
+}
+
+void SourceCache::setBudget(size_t bytes)
+{
+	thread::Lock lock(mutex);
+	budget = bytes;
+	trim();
+}
+
+size_t SourceCache::getBudget() const
+{
+	thread::Lock lock(mutex);
+	return budget;
+}
+
+size_t SourceCache::getSize() const
+{
+	thread::Lock lock(mutex);
+	return size;
+}
+
+void SourceCache::clear()
+{
+	thread::Lock lock(mutex);
+	lookup.clear();
+	entries.clear();
+	size = 0;
+}
+
+void SourceCache::trim()
+{
+	while (size > budget && !entries.empty())
+	{
+		const Entry &e = entries.back();
+		size -= e.size;
+		lookup.erase(e.key);
+		entries.pop_back();
+	}
+}
+
+} // audio
+} // love
@@ -0,0 +1,109 @@
+/**
+ * Copyright (c) 2006-2018 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#ifndef LOVE_AUDIO_SOURCE_CACHE_H
+#define LOVE_AUDIO_SOURCE_CACHE_H
+
+// LOVE
+#include "common/int.h"
+#include "thread/threads.h"
+#include "Source.h"
+
+// C++
+#include <list>
+#include <string>
+#include <unordered_map>
+
+namespace love
+{
+namespace audio
+{
+
+/**
+ * Keeps fully decoded static Sources around, so creating another Source from
+ * the same file doesn't decode it again. Sources created from the cache share
+ * their sample data with the cached copy.
+ *
+ * Entries are evicted in least-recently-used order once the total size of
+ * their sample data goes over the budget.
+ **/
+class SourceCache
+{
+public:
+
+	// 64 MB.
+	static const size_t DEFAULT_BUDGET = 64 * 1024 * 1024;
+
+	SourceCache();
+	~SourceCache();
+
+	/**
+	 * Creates a new Source from the cached entry with the given key.
+	 * @return A new Source which the caller must release, or null if there
+	 *         is no entry for the key.
+	 **/
+	Source *get(const std::string &key);
+
+	/**
+	 * Adds a copy of a newly created static Source to the cache.
+	 * @param key The key, which should identify the contents of the file.
+	 * @param source The Source. It should not have been modified yet.
+	 * @param bytes The size in bytes of the Source's sample data.
+	 **/
+	void add(const std::string &key, Source *source, size_t bytes);
+
+	void setBudget(size_t bytes);
+	size_t getBudget() const;
+
+	/**
+	 * Gets the total size in bytes of the sample data held by the cache.
+	 **/
+	size_t getSize() const;
+
+	void clear();
+
+private:
+
+	struct Entry
+	{
+		std::string key;
+		StrongRef<Source> source;
+		size_t size;
+	};
+
+	// Evicts entries until the cache fits in its budget. The mutex must be
+	// held.
+	void trim();
+
+	// Most recently used first.
+	std::list<Entry> entries;
+	std::unordered_map<std::string, std::list<Entry>::iterator> lookup;
+
+	size_t budget;
+	size_t size;
+
+	thread::MutexRef mutex;
+
+}; // SourceCache
+
+} // audio
+} // love
+
+#endif // LOVE_AUDIO_SOURCE_CACHE_H
@@ -76,6 +76,16 @@ bool Audio::play(const std::vector<love::audio::Source*>&)
 	return false;
 }
 
+bool Audio::playAt(const std::vector<love::audio::Source*>&, double)
+{
+	return false;
+}
+
+double Audio::getClock() const
+{
+	return 0.0;
+}
+
 void Audio::stop(love::audio::Source *)
 {
 }
@@ -52,6 +52,8 @@ public:
 	int getMaxSources() const;
 	bool play(love::audio::Source *source);
 	bool play(const std::vector<love::audio::Source*> &sources);
+	bool playAt(const std::vector<love::audio::Source*> &sources, double time);
+	double getClock() const;
 	void stop(love::audio::Source *source);
 	void stop(const std::vector<love::audio::Source*> &sources);
 	void stop();
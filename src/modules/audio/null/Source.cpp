@@ -239,6 +239,16 @@ bool Source::queue(void *, size_t, int, int, int)
 	return false;
 }
 
+bool Source::playAt(double)
+{
+	return false;
+}
+
+bool Source::queueAt(void *, size_t, int, int, int, double)
+{
+	return false;
+}
+
 bool Source::setFilter(const std::map<Filter::Parameter, float> &)
 {
 	return false;
@@ -81,6 +81,8 @@ public:
 
 	virtual int getFreeBufferCount() const;
 	virtual bool queue(void *data, size_t length, int dataSampleRate, int dataBitDepth, int dataChannels);
+	virtual bool playAt(double time);
+	virtual bool queueAt(void *data, size_t length, int dataSampleRate, int dataBitDepth, int dataChannels, double time);
 
 	virtual bool setFilter(const std::map<Filter::Parameter, float> &params);
 	virtual bool setFilter();
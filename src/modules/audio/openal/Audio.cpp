@@ -57,15 +57,19 @@ void Audio::PoolThread::threadFunction()
 			}
 		}
 
-		pool->update();
-		sleep(5);
+		int timeout = pool->update();
+		pool->waitForUpdate(timeout);
 	}
 }
 
 void Audio::PoolThread::setFinish()
 {
-	thread::Lock lock(mutex);
-	finish = true;
+	{
+		thread::Lock lock(mutex);
+		finish = true;
+	}
+
+	pool->wake();
 }
 
 ALenum Audio::getFormat(int bitDepth, int channels)
@@ -184,6 +188,9 @@ Audio::Audio()
 
 Audio::~Audio()
 {
+	// The cached Sources need the pool and the OpenAL context.
+	sourceCache.clear();
+
 	poolThread->setFinish();
 	poolThread->wait();
 
@@ -239,6 +246,11 @@ int Audio::getActiveSourceCount() const
 	return pool->getActiveSourceCount();
 }
 
+double Audio::getClock() const
+{
+	return pool->getClock();
+}
+
 int Audio::getMaxSources() const
 {
 	return pool->getMaxSources();
@@ -254,6 +266,11 @@ bool Audio::play(const std::vector<love::audio::Source*> &sources)
 	return Source::play(sources);
 }
 
+bool Audio::playAt(const std::vector<love::audio::Source*> &sources, double time)
+{
+	return Source::playAt(sources, time);
+}
+
 void Audio::stop(love::audio::Source *source)
 {
 	source->stop();
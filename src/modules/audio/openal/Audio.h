@@ -86,9 +86,11 @@ public:
 	love::audio::Source *newSource(love::sound::SoundData *soundData);
 	love::audio::Source *newSource(int sampleRate, int bitDepth, int channels, int buffers);
 	int getActiveSourceCount() const;
+	double getClock() const;
 	int getMaxSources() const;
 	bool play(love::audio::Source *source);
 	bool play(const std::vector<love::audio::Source*> &sources);
+	bool playAt(const std::vector<love::audio::Source*> &sources, double time);
 	void stop(love::audio::Source *source);
 	void stop(const std::vector<love::audio::Source*> &sources);
 	void stop();
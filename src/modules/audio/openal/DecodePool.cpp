@@ -0,0 +1,122 @@
+/**
+ * Copyright (c) 2006-2018 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#include "DecodePool.h"
+#include "Pool.h"
+
+// STD
+#include <algorithm>
+
+namespace love
+{
+namespace audio
+{
+namespace openal
+{
+
+DecodePool::Worker::Worker(DecodePool *owner)
+	: owner(owner)
+{
+	threadName = "AudioDecode";
+}
+
+DecodePool::Worker::~Worker()
+{
+}
+
+void DecodePool::Worker::threadFunction()
+{
+	while (StreamBuffer *buffer = owner->next())
+	{
+		// Clear the flag first, so a request made while we're decoding isn't
+		// lost.
+		buffer->clearDecodePending();
+
+		if (buffer->fill())
+			owner->pool->wake();
+
+		buffer->release();
+	}
+}
+
+DecodePool::DecodePool(Pool *pool, int threadCount)
+	: pool(pool)
+	, finish(false)
+{
+	for (int i = 0; i < std::max(threadCount, 1); i++)
+	{
+		Worker *worker = new Worker(this);
+		worker->start();
+		workers.push_back(worker);
+	}
+}
+
+DecodePool::~DecodePool()
+{
+	{
+		thread::Lock lock(mutex);
+		finish = true;
+		cond->broadcast();
+	}
+
+	for (Worker *worker : workers)
+	{
+		worker->wait();
+		delete worker;
+	}
+
+	while (!requests.empty())
+	{
+		requests.front()->clearDecodePending();
+		requests.front()->release();
+		requests.pop();
+	}
+}
+
+void DecodePool::request(StreamBuffer *buffer)
+{
+	if (buffer->isFull() || !buffer->setDecodePending())
+		return;
+
+	thread::Lock lock(mutex);
+
+	buffer->retain();
+	requests.push(buffer);
+	cond->signal();
+}
+
+StreamBuffer *DecodePool::next()
+{
+	thread::Lock lock(mutex);
+
+	while (!finish && requests.empty())
+		cond->wait(mutex);
+
+	if (finish)
+		return nullptr;
+
+	StreamBuffer *buffer = requests.front();
+	requests.pop();
+	return buffer;
+}
+
+} // openal
+} // audio
+} // love
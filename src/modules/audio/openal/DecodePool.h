@@ -0,0 +1,98 @@
+/**
+ * Copyright (c) 2006-2018 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#ifndef LOVE_AUDIO_OPENAL_DECODE_POOL_H
+#define LOVE_AUDIO_OPENAL_DECODE_POOL_H
+
+// LOVE
+#include "common/config.h"
+#include "thread/threads.h"
+#include "StreamBuffer.h"
+
+// STD
+#include <queue>
+#include <vector>
+
+namespace love
+{
+namespace audio
+{
+namespace openal
+{
+
+class Pool;
+
+/**
+ * A small set of threads which decode audio for streaming Sources ahead of
+ * time, so the Pool's update thread only has to hand decoded buffers to
+ * OpenAL.
+ **/
+class DecodePool
+{
+public:
+
+	DecodePool(Pool *pool, int threadCount);
+	~DecodePool();
+
+	/**
+	 * Schedules a StreamBuffer to be filled by one of the decode threads. Does
+	 * nothing if it's already scheduled.
+	 **/
+	void request(StreamBuffer *buffer);
+
+private:
+
+	class Worker : public thread::Threadable
+	{
+	public:
+
+		Worker(DecodePool *owner);
+		virtual ~Worker();
+
+		void threadFunction();
+
+	private:
+
+		DecodePool *owner;
+	};
+
+	friend class Worker;
+
+	// Waits for the next requested StreamBuffer. Returns null when the decode
+	// threads should finish.
+	StreamBuffer *next();
+
+	Pool *pool;
+
+	std::vector<Worker *> workers;
+	std::queue<StreamBuffer *> requests;
+
+	bool finish;
+
+	thread::MutexRef mutex;
+	thread::ConditionalRef cond;
+
+}; // DecodePool
+
+} // openal
+} // audio
+} // love
+
+#endif // LOVE_AUDIO_OPENAL_DECODE_POOL_H
@@ -21,6 +21,11 @@
 #include "Pool.h"
 
 #include "Source.h"
+#include "DecodePool.h"
+#include "timer/Timer.h"
+
+// STD
+#include <algorithm>
 
 namespace love
 {
@@ -32,10 +37,21 @@ namespace openal
 Pool::Pool()
 	: sources()
 	, totalSources(0)
+	, decodePool(nullptr)
+	, wakePending(false)
+	, clockStart(love::timer::Timer::getTime())
 {
 	// Clear errors.
 	alGetError();
 
+#ifdef ALC_SOFT_device_clock
+	device = alcGetContextsDevice(alcGetCurrentContext());
+	alcGetInteger64vSOFT = nullptr;
+
+	if (device != nullptr && alcIsExtensionPresent(device, "ALC_SOFT_device_clock"))
+		alcGetInteger64vSOFT = (LPALCGETINTEGER64VSOFT) alcGetProcAddress(device, "alcGetInteger64vSOFT");
+#endif
+
 	// Generate sources.
 	for (int i = 0; i < MAX_SOURCES; i++)
 	{
@@ -69,12 +85,18 @@ Pool::Pool()
 
 		available.push(sources[i]);
 	}
+
+	// Leave a core for the main thread.
+	int threads = std::min(thread::getProcessorCount() - 1, MAX_DECODE_THREADS);
+	decodePool = new DecodePool(this, threads);
 }
 
 Pool::~Pool()
 {
 	Source::stop(this);
 
+	delete decodePool;
+
 	// Free all sources.
 	alDeleteSources(totalSources, sources);
 }
@@ -99,10 +121,12 @@ bool Pool::isPlaying(Source *s)
 	return p;
 }
 
-void Pool::update()
+int Pool::update()
 {
 	thread::Lock lock(mutex);
 
+	startScheduled();
+
 	std::vector<Source *> torelease;
 
 	for (const auto &i : playing)
@@ -113,6 +137,139 @@ void Pool::update()
 
 	for (Source *s : torelease)
 		releaseSource(s);
+
+	if (playing.empty() && scheduled.empty())
+		return -1;
+
+	float delay = MAX_UPDATE_DELAY / 1000.0f;
+	for (const auto &i : playing)
+		delay = std::min(delay, i.first->getUpdateDelay());
+
+	if (!scheduled.empty())
+	{
+		double now = getClock();
+		for (const auto &i : scheduled)
+			delay = std::min(delay, (float) (i.second - now));
+	}
+
+	return std::max((int) (delay * 1000.0f), 1);
+}
+
+void Pool::waitForUpdate(int timeout)
+{
+	thread::Lock lock(wakeMutex);
+
+	if (!wakePending)
+		wakeCond->wait(wakeMutex, timeout);
+
+	wakePending = false;
+}
+
+void Pool::wake()
+{
+	thread::Lock lock(wakeMutex);
+	wakePending = true;
+	wakeCond->signal();
+}
+
+double Pool::getClock() const
+{
+#ifdef ALC_SOFT_device_clock
+	if (alcGetInteger64vSOFT != nullptr)
+	{
+		ALCint64SOFT clock = 0;
+		alcGetInteger64vSOFT(device, ALC_DEVICE_CLOCK_SOFT, 1, &clock);
+		return (double) clock / 1000000000.0;
+	}
+#endif
+
+	return love::timer::Timer::getTime() - clockStart;
+}
+
+void Pool::schedule(Source *source, double time)
+{
+	auto it = scheduled.find(source);
+	if (it != scheduled.end())
+		it->second = time;
+	else
+	{
+		source->retain();
+		scheduled[source] = time;
+	}
+
+	// The update thread needs to know about the new start time.
+	wake();
+}
+
+bool Pool::unschedule(Source *source)
+{
+	auto it = scheduled.find(source);
+	if (it == scheduled.end())
+		return false;
+
+	scheduled.erase(it);
+	source->release();
+	return true;
+}
+
+void Pool::unscheduleAll()
+{
+	for (const auto &i : scheduled)
+		i.first->release();
+
+	scheduled.clear();
+}
+
+bool Pool::getScheduledTime(Source *source, double &time)
+{
+	auto it = scheduled.find(source);
+	if (it == scheduled.end())
+		return false;
+
+	time = it->second;
+	return true;
+}
+
+void Pool::startScheduled()
+{
+	if (scheduled.empty())
+		return;
+
+	double now = getClock();
+
+	std::vector<love::audio::Source *> due;
+	for (const auto &i : scheduled)
+	{
+		if (i.second > now)
+			continue;
+
+		// OpenAL can't start a Source at an exact time, so a Source which
+		// starts late begins that much further in, to stay in sync with the
+		// clock.
+		Source *s = i.first;
+		double late = (now - i.second) * s->getPitch();
+		if (late > 0.0)
+			s->seek(s->tell(Source::UNIT_SECONDS) + (float) late, Source::UNIT_SECONDS);
+
+		due.push_back(s);
+	}
+
+	if (due.empty())
+		return;
+
+	for (love::audio::Source *s : due)
+		scheduled.erase((Source *) s);
+
+	// Sources which were scheduled together start together.
+	Source::play(due);
+
+	for (love::audio::Source *s : due)
+		s->release();
+}
+
+void Pool::requestDecode(StreamBuffer *buffer)
+{
+	decodePool->request(buffer);
 }
 
 int Pool::getActiveSourceCount() const
@@ -142,6 +299,9 @@ bool Pool::assignSource(Source *source, ALuint &out, char &wasPlaying)
 
 	playing.insert(std::make_pair(source, out));
 	source->retain();
+
+	// The update thread may be asleep if nothing was playing.
+	wake();
 	return true;
 }
 
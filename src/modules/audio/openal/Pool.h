@@ -32,6 +32,7 @@
 #include "common/Exception.h"
 #include "thread/threads.h"
 #include "audio/Source.h"
+#include "StreamBuffer.h"
 
 // OpenAL
 #ifdef LOVE_APPLE_USE_FRAMEWORKS
@@ -59,6 +60,7 @@ namespace openal
 {
 
 class Source;
+class DecodePool;
 
 class Pool
 {
@@ -78,11 +80,34 @@ public:
 	 **/
 	bool isPlaying(Source *s);
 
-	void update();
+	/**
+	 * Updates all playing Sources.
+	 * @return How long in milliseconds until the next update is needed, or -1
+	 *         if nothing is playing.
+	 **/
+	int update();
+
+	/**
+	 * Blocks until wake is called, or until the timeout (in milliseconds)
+	 * runs out. A negative timeout waits indefinitely.
+	 **/
+	void waitForUpdate(int timeout);
+
+	/**
+	 * Wakes up the thread waiting in waitForUpdate. Can be called from any
+	 * thread.
+	 **/
+	void wake();
 
 	int getActiveSourceCount() const;
 	int getMaxSources() const;
 
+	/**
+	 * Gets the time of the audio clock in seconds. Uses the device's own clock
+	 * when OpenAL Soft exposes it.
+	 **/
+	double getClock() const;
+
 private:
 
 	friend class Source;
@@ -98,9 +123,31 @@ private:
 	bool assignSource(Source *source, ALuint &out, char &wasPlaying);
 	bool findSource(Source *source, ALuint &out);
 
+	/**
+	 * Asks the decode threads to decode ahead for a streaming Source.
+	 **/
+	void requestDecode(StreamBuffer *buffer);
+
+	/**
+	 * Starts playing the Source once the audio clock reaches the given time.
+	 **/
+	void schedule(Source *source, double time);
+	bool unschedule(Source *source);
+	void unscheduleAll();
+	bool getScheduledTime(Source *source, double &time);
+
+	// Starts the scheduled Sources which are due.
+	void startScheduled();
+
 	// Maximum possible number of OpenAL sources the pool attempts to generate.
 	static const int MAX_SOURCES = 64;
 
+	// Maximum number of threads used to decode streaming Sources.
+	static const int MAX_DECODE_THREADS = 4;
+
+	// Longest time in milliseconds between updates while something is playing.
+	static const int MAX_UPDATE_DELAY = 50;
+
 	// OpenAL sources
 	ALuint sources[MAX_SOURCES];
 
@@ -117,6 +164,24 @@ private:
 	// make sure of that.
 	love::thread::MutexRef mutex;
 
+	DecodePool *decodePool;
+
+	bool wakePending;
+	love::thread::MutexRef wakeMutex;
+	love::thread::ConditionalRef wakeCond;
+
+	// Sources waiting to be played, and the clock time to start them at.
+	// Retained.
+	std::map<Source *, double> scheduled;
+
+	// Start of the fallback clock, when the device has no clock of its own.
+	double clockStart;
+
+#ifdef ALC_SOFT_device_clock
+	ALCdevice *device;
+	LPALCGETINTEGER64VSOFT alcGetInteger64vSOFT;
+#endif
+
 }; // Pool
 
 } // openal
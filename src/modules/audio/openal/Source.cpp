@@ -23,10 +23,13 @@
 #include "Pool.h"
 #include "Audio.h"
 #include "common/math.h"
+#include "profiler/Profiler.h"
 
 // STD
 #include <iostream>
 #include <algorithm>
+#include <cfloat>
+#include <cmath>
 
 #define audiomodule() (Module::getInstance<Audio>(Module::M_AUDIO))
 
@@ -39,73 +42,6 @@ namespace audio
 namespace openal
 {
 
-class InvalidFormatException : public love::Exception
-{
-public:
-
-	InvalidFormatException(int channels, int bitdepth)
-		: Exception("%d-channel Sources with %d bits per sample are not supported.", channels, bitdepth)
-	{
-	}
-
-};
-
-class SpatialSupportException : public love::Exception
-{
-public:
-
-	SpatialSupportException()
-		: Exception("This spatial audio functionality is only available for mono Sources. \
-Ensure the Source is not multi-channel before calling this function.")
-	{
-	}
-
-};
-
-class QueueFormatMismatchException : public love::Exception
-{
-public:
-
-	QueueFormatMismatchException()
-		: Exception("Queued sound data must have same format as sound Source.")
-	{
-	}
-
-};
-
-class QueueTypeMismatchException : public love::Exception
-{
-public:
-
-	QueueTypeMismatchException()
-		: Exception("Only queueable Sources can be queued with sound data.")
-	{
-	}
-
-};
-
-class QueueMalformedLengthException : public love::Exception
-{
-public:
-
-	QueueMalformedLengthException(int bytes)
-		: Exception("Data length must be a multiple of sample size (%d bytes).", bytes)
-	{
-	}
-
-};
-
-class QueueLoopingException : public love::Exception
-{
-public:
-
-	QueueLoopingException()
-		: Exception("Queueable Sources can not be looped.")
-	{
-	}
-
-};
-
 StaticDataBuffer::StaticDataBuffer(ALenum format, const ALvoid *data, ALsizei size, ALsizei freq)
 	: size(size)
 {
@@ -147,12 +83,13 @@ Source::Source(Pool *pool, love::sound::Decoder *decoder)
 	, sampleRate(decoder->getSampleRate())
 	, channels(decoder->getChannelCount())
 	, bitDepth(decoder->getBitDepth())
-	, decoder(decoder)
 	, buffers(DEFAULT_BUFFERS)
 {
 	if (Audio::getFormat(decoder->getBitDepth(), decoder->getChannelCount()) == AL_NONE)
 		throw InvalidFormatException(decoder->getChannelCount(), decoder->getBitDepth());
 
+	stream.set(new StreamBuffer(decoder, buffers), Acquire::NORETAIN);
+
 	for (int i = 0; i < buffers; i++)
 	{
 		ALuint buf;
@@ -236,14 +173,18 @@ Source::Source(const Source &s)
 	, sampleRate(s.sampleRate)
 	, channels(s.channels)
 	, bitDepth(s.bitDepth)
-	, decoder(nullptr)
+	, stream(nullptr)
 	, toLoop(0)
 	, buffers(s.buffers)
 {
 	if (sourceType == TYPE_STREAM)
 	{
-		if (s.decoder.get())
-			decoder.set(s.decoder->clone(), Acquire::NORETAIN);
+		if (s.stream.get())
+		{
+			StrongRef<love::sound::Decoder> decoder(s.stream->cloneDecoder(), Acquire::NORETAIN);
+			stream.set(new StreamBuffer(decoder, buffers), Acquire::NORETAIN);
+			stream->setLooping(looping);
+		}
 	}
 	if (sourceType != TYPE_STATIC)
 	{
@@ -340,18 +281,29 @@ bool Source::play()
 	return valid = true;
 }
 
+bool Source::playAt(double time)
+{
+	Lock l = pool->lock();
+	pool->schedule(this, time);
+	return true;
+}
+
 void Source::stop()
 {
+	Lock l = pool->lock();
+	pool->unschedule(this);
+
 	if (!valid)
 		return;
 
-	Lock l = pool->lock();
 	pool->releaseSource(this);
 }
 
 void Source::pause()
 {
 	Lock l = pool->lock();
+	pool->unschedule(this);
+
 	if (pool->isPlaying(this))
 		pauseAtomic();
 }
@@ -371,7 +323,7 @@ bool Source::isFinished() const
 	if (!valid)
 		return false;
 
-	if (sourceType == TYPE_STREAM && (isLooping() || !decoder->isFinished()))
+	if (sourceType == TYPE_STREAM && (isLooping() || !stream->isFinished()))
 		return false;
 
 	ALenum state;
@@ -381,6 +333,8 @@ bool Source::isFinished() const
 
 bool Source::update()
 {
+	LOVE_PROFILE_ZONE("audio", "Source::update");
+
 	if (!valid)
 		return false;
 
@@ -399,7 +353,7 @@ bool Source::update()
 				ALint processed;
 				ALuint buffers[MAX_BUFFERS];
 				float curOffsetSamples, curOffsetSecs, newOffsetSamples, newOffsetSecs;
-				int freq = decoder->getSampleRate();
+				int freq = sampleRate;
 
 				alGetSourcef(source, AL_SAMPLE_OFFSET, &curOffsetSamples);
 				curOffsetSecs = curOffsetSamples / freq;
@@ -416,18 +370,32 @@ bool Source::update()
 				for (unsigned int i = 0; i < (unsigned int)processed; i++)
 					unusedBuffers.push(buffers[i]);
 
+				bool queued = false;
 				while (!unusedBuffers.empty())
 				{
 					auto b = unusedBuffers.top();
-					if (streamAtomic(b, decoder.get()) > 0)
+					if (streamAtomic(b) > 0)
 					{
 						alSourceQueueBuffers(source, 1, &b);
 						unusedBuffers.pop();
+						queued = true;
 					}
 					else
 						break;
 				}
 
+				// OpenAL stops the source if it runs out of buffers before the
+				// decode threads catch up.
+				if (queued)
+				{
+					ALenum state;
+					alGetSourcei(source, AL_SOURCE_STATE, &state);
+					if (state == AL_STOPPED)
+						alSourcePlay(source);
+				}
+
+				pool->requestDecode(stream.get());
+
 				return true;
 			}
 			return false;
@@ -532,7 +500,7 @@ void Source::seek(float offset, Source::Unit unit)
 			if (valid)
 				stop();
 
-			decoder->seek(offsetSeconds);
+			stream->seek(offsetSeconds);
 
 			if (wasPlaying)
 				play();
@@ -622,12 +590,12 @@ double Source::getDuration(Unit unit)
 	}
 	case TYPE_STREAM:
 	{
-		double seconds = decoder->getDuration();
+		double seconds = stream->getDuration();
 
 		if (unit == UNIT_SECONDS)
 			return seconds;
 		else
-			return seconds * decoder->getSampleRate();
+			return seconds * sampleRate;
 	}
 	case TYPE_QUEUE:
 	{
@@ -769,6 +737,9 @@ void Source::setLooping(bool enable)
 	if (valid && sourceType == TYPE_STATIC)
 		alSourcei(source, AL_LOOPING, enable ? AL_TRUE : AL_FALSE);
 
+	if (sourceType == TYPE_STREAM)
+		stream->setLooping(enable);
+
 	looping = enable;
 }
 
@@ -809,6 +780,65 @@ bool Source::queue(void *data, size_t length, int dataSampleRate, int dataBitDep
 	return true;
 }
 
+bool Source::queueAt(void *data, size_t length, int dataSampleRate, int dataBitDepth, int dataChannels, double time)
+{
+	if (sourceType != TYPE_QUEUE)
+		throw QueueTypeMismatchException();
+
+	if (dataSampleRate != sampleRate || dataBitDepth != bitDepth || dataChannels != channels )
+		throw QueueFormatMismatchException();
+
+	int frameSize = bitDepth / 8 * channels;
+	if (length % frameSize != 0)
+		throw QueueMalformedLengthException(frameSize);
+
+	if (length == 0)
+		return true;
+
+	Lock l = pool->lock();
+
+	if (unusedBuffers.empty())
+		return false;
+
+	double rate = sampleRate * std::max(pitch, 0.0001f);
+	double queuedFrames = (double) (bufferedBytes / frameSize);
+
+	// Work out when the new data would start playing if it was queued as-is.
+	double start = time;
+	double scheduledTime = 0.0;
+	bool startSource = false;
+
+	if (pool->isPlaying(this))
+	{
+		ALfloat offset = 0.0f;
+		alGetSourcef(source, AL_SAMPLE_OFFSET, &offset);
+		start = pool->getClock() + (queuedFrames - offset) / rate;
+	}
+	else if (pool->getScheduledTime(this, scheduledTime))
+		start = scheduledTime + queuedFrames / rate;
+	else
+		startSource = true;
+
+	// Pad or trim the start of the data so it lines up with the given time.
+	std::vector<uint8> shifted;
+	int64 shift = (int64) floor((time - start) * rate + 0.5);
+	shiftSamples(data, length, bitDepth, channels, shift, shifted);
+
+	// All of it would have played already.
+	if (shifted.empty())
+		return true;
+
+	if (!queue(&shifted[0], shifted.size(), dataSampleRate, dataBitDepth, dataChannels))
+		return false;
+
+	// Nothing to line up with, so start the Source such that the new data
+	// plays at the given time.
+	if (startSource)
+		pool->schedule(this, time - queuedFrames / rate);
+
+	return true;
+}
+
 int Source::getFreeBufferCount() const
 {
 	switch (sourceType) //why not :^)
@@ -838,18 +868,21 @@ void Source::prepareAtomic()
 		alSourcei(source, AL_BUFFER, staticBuffer->getBuffer());
 		break;
 	case TYPE_STREAM:
+		// Decode on this thread if the decode threads haven't got to it yet,
+		// so there's something to play right away.
+		stream->fill();
+
 		while (!unusedBuffers.empty())
 		{
 			auto b = unusedBuffers.top();
-			if (streamAtomic(b, decoder.get()) == 0)
+			if (streamAtomic(b) == 0)
 				break;
 
 			alSourceQueueBuffers(source, 1, &b);
 			unusedBuffers.pop();
-
-			if (decoder->isFinished())
-				break;
 		}
+
+		pool->requestDecode(stream.get());
 		break;
 	case TYPE_QUEUE:
 	{
@@ -876,7 +909,7 @@ void Source::teardownAtomic()
 		ALint queued;
 		ALuint buffer;
 
-		decoder->seek(0);
+		stream->seek(0);
 		// drain buffers
 		//since we only unqueue 1 buffer, it's OK to use singular variable pointer instead of array
 		alGetSourcei(source, AL_BUFFERS_QUEUED, &queued);
@@ -1032,6 +1065,21 @@ bool Source::play(const std::vector<love::audio::Source*> &sources)
 	return success;
 }
 
+bool Source::playAt(const std::vector<love::audio::Source*> &sources, double time)
+{
+	if (sources.size() == 0)
+		return true;
+
+	// Schedule them all at once, so the pool starts them in the same update.
+	Pool *pool = ((Source*) sources[0])->pool;
+	Lock l = pool->lock();
+
+	for (auto &_source : sources)
+		pool->schedule((Source*) _source, time);
+
+	return true;
+}
+
 void Source::stop(const std::vector<love::audio::Source*> &sources)
 {
 	if (sources.size() == 0)
@@ -1057,6 +1105,7 @@ void Source::stop(const std::vector<love::audio::Source*> &sources)
 		if (source->valid)
 			source->teardownAtomic();
 		pool->releaseSource(source, false);
+		pool->unschedule(source);
 	}
 }
 
@@ -1065,7 +1114,8 @@ void Source::pause(const std::vector<love::audio::Source*> &sources)
 	if (sources.size() == 0)
 		return;
 
-	Lock l = ((Source*) sources[0])->pool->lock();
+	Pool *pool = ((Source*) sources[0])->pool;
+	Lock l = pool->lock();
 
 	std::vector<ALuint> sourceIds;
 	sourceIds.reserve(sources.size());
@@ -1074,6 +1124,7 @@ void Source::pause(const std::vector<love::audio::Source*> &sources)
 		Source *source = (Source*) _source;
 		if (source->valid)
 			sourceIds.push_back(source->source);
+		pool->unschedule(source);
 	}
 
 	alSourcePausev((ALsizei) sourceIds.size(), &sourceIds[0]);
@@ -1090,6 +1141,7 @@ std::vector<love::audio::Source*> Source::pause(Pool *pool)
 	sources.erase(newend, sources.end());
 
 	pause(sources);
+	pool->unscheduleAll();
 	return sources;
 }
 
@@ -1097,6 +1149,7 @@ void Source::stop(Pool *pool)
 {
 	Lock l = pool->lock();
 	stop(pool->getPlayingSources());
+	pool->unscheduleAll();
 }
 
 void Source::reset()
@@ -1138,23 +1191,30 @@ void Source::setFloatv(float *dst, const float *src) const
 	dst[2] = src[2];
 }
 
-int Source::streamAtomic(ALuint buffer, love::sound::Decoder *d)
+int Source::streamAtomic(ALuint buffer)
 {
-	// Get more sound data.
-	int decoded = std::max(d->decode(), 0);
+	// Decoding happens ahead of time on the decode threads, so this only has
+	// to hand the next decoded chunk to OpenAL.
+	int decoded = 0;
+	bool endOfStream = false;
 
-	// OpenAL implementations are allowed to ignore 0-size alBufferData calls.
-	if (decoded > 0)
+	while (decoded == 0)
 	{
-		int fmt = Audio::getFormat(d->getBitDepth(), d->getChannelCount());
+		const StreamBuffer::Chunk *chunk = stream->front();
+		if (chunk == nullptr)
+			break;
 
-		if (fmt != AL_NONE)
-			alBufferData(buffer, fmt, d->getBuffer(), decoded, d->getSampleRate());
-		else
-			decoded = 0;
+		decoded = chunk->size;
+		endOfStream = endOfStream || chunk->endOfStream;
+
+		// OpenAL implementations are allowed to ignore 0-size alBufferData calls.
+		if (decoded > 0)
+			alBufferData(buffer, Audio::getFormat(bitDepth, channels), &chunk->data[0], decoded, sampleRate);
+
+		stream->pop();
 	}
 
-	if (decoder->isFinished() && isLooping())
+	if (endOfStream && isLooping())
 	{
 		int queued, processed;
 		alGetSourcei(source, AL_BUFFERS_QUEUED, &queued);
@@ -1163,10 +1223,9 @@ int Source::streamAtomic(ALuint buffer, love::sound::Decoder *d)
 			toLoop = queued-processed;
 		else
 			toLoop = buffers-processed;
-		d->rewind();
 	}
 
-	if (toLoop > 0)
+	if (decoded > 0 && toLoop > 0)
 	{
 		if (--toLoop == 0)
 		{
@@ -1178,6 +1237,53 @@ int Source::streamAtomic(ALuint buffer, love::sound::Decoder *d)
 	return decoded;
 }
 
+float Source::getUpdateDelay() const
+{
+	const float never = FLT_MAX;
+
+	if (!valid || pitch <= 0.0f)
+		return never;
+
+	ALenum state;
+	alGetSourcei(source, AL_SOURCE_STATE, &state);
+
+	switch (sourceType)
+	{
+	case TYPE_STATIC:
+	{
+		if (state != AL_PLAYING || isLooping())
+			return never;
+
+		// Wake up when the Source finishes, so it can be released.
+		ALfloat offset = 0.0f;
+		alGetSourcef(source, AL_SAMPLE_OFFSET, &offset);
+
+		float samples = (float) ((staticBuffer->getSize() / channels) / (bitDepth / 8));
+		return (samples - offset) / (sampleRate * pitch);
+	}
+	case TYPE_STREAM:
+	{
+		if (state != AL_PLAYING)
+			return never;
+
+		// Wake up when the buffer which is currently playing has been
+		// processed, so it can be refilled.
+		ALfloat offset = 0.0f;
+		alGetSourcef(source, AL_SAMPLE_OFFSET, &offset);
+
+		float samples = (float) ((stream->getChunkSize() / channels) / (bitDepth / 8));
+		return (samples - fmodf(offset, samples)) / (sampleRate * pitch);
+	}
+	case TYPE_QUEUE:
+		// Free buffers are reported to the user, so keep the old polling rate.
+		return 0.005f;
+	case TYPE_MAX_ENUM:
+		break;
+	}
+
+	return never;
+}
+
 void Source::setMinVolume(float volume)
 {
 	if (valid)
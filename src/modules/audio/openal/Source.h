@@ -30,6 +30,7 @@
 #include "sound/Decoder.h"
 #include "Audio.h"
 #include "Filter.h"
+#include "StreamBuffer.h"
 
 // STL
 #include <vector>
@@ -106,6 +107,7 @@ public:
 
 	virtual love::audio::Source *clone();
 	virtual bool play();
+	virtual bool playAt(double time);
 	virtual void stop();
 	virtual void pause();
 	virtual bool isPlaying() const;
@@ -156,6 +158,13 @@ public:
 
 	virtual int getFreeBufferCount() const;
 	virtual bool queue(void *data, size_t length, int dataSampleRate, int dataBitDepth, int dataChannels);
+	virtual bool queueAt(void *data, size_t length, int dataSampleRate, int dataBitDepth, int dataChannels, double time);
+
+	/**
+	 * Gets how long in seconds until this Source will next need an update,
+	 * for example to refill a streaming buffer.
+	 **/
+	float getUpdateDelay() const;
 
 	void prepareAtomic();
 	void teardownAtomic();
@@ -166,6 +175,7 @@ public:
 	void resumeAtomic();
 
 	static bool play(const std::vector<love::audio::Source*> &sources);
+	static bool playAt(const std::vector<love::audio::Source*> &sources, double time);
 	static void stop(const std::vector<love::audio::Source*> &sources);
 	static void pause(const std::vector<love::audio::Source*> &sources);
 
@@ -178,7 +188,7 @@ private:
 
 	void setFloatv(float *dst, const float *src) const;
 
-	int streamAtomic(ALuint buffer, love::sound::Decoder *d);
+	int streamAtomic(ALuint buffer);
 
 	Pool *pool = nullptr;
 	ALuint source = 0;
@@ -220,7 +230,9 @@ private:
 	int channels = 0;
 	int bitDepth = 0;
 
-	StrongRef<love::sound::Decoder> decoder;
+	// Decoded audio for streaming Sources. The Decoder itself is only used
+	// through this, since it's also accessed from the decode threads.
+	StrongRef<StreamBuffer> stream;
 
 	unsigned int toLoop = 0;
 	ALsizei bufferedBytes = 0;
@@ -0,0 +1,186 @@
+/**
+ * Copyright (c) 2006-2018 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#include "StreamBuffer.h"
+
+// STD
+#include <algorithm>
+#include <string.h>
+
+namespace love
+{
+namespace audio
+{
+namespace openal
+{
+
+StreamBuffer::StreamBuffer(love::sound::Decoder *decoder, int chunkCount)
+	: decoder(decoder)
+	, chunks(std::max(chunkCount, 1))
+	, readCount(0)
+	, writeCount(0)
+	, looping(false)
+	, finished(false)
+	, decodePending(false)
+{
+	for (Chunk &chunk : chunks)
+		chunk.data.resize(decoder->getSize());
+}
+
+StreamBuffer::~StreamBuffer()
+{
+}
+
+bool StreamBuffer::fill()
+{
+	bool decoded = false;
+
+	while (true)
+	{
+		// The lock is only held for one chunk at a time, so seeking from
+		// another thread doesn't have to wait for the whole ring to fill.
+		thread::Lock lock(decoderMutex);
+
+		size_t w = writeCount.load(std::memory_order_relaxed);
+		size_t r = readCount.load(std::memory_order_acquire);
+
+		if (w - r >= chunks.size())
+			break;
+
+		if (decoder->isFinished())
+		{
+			if (!looping)
+			{
+				finished = true;
+				break;
+			}
+
+			decoder->rewind();
+		}
+
+		int size = std::max(decoder->decode(), 0);
+		bool endOfStream = decoder->isFinished();
+
+		// A failed decode which isn't the end of the stream. Try again later
+		// rather than spinning here.
+		if (size == 0 && !endOfStream)
+			break;
+
+		Chunk &chunk = chunks[w % chunks.size()];
+		chunk.size = std::min(size, (int) chunk.data.size());
+		chunk.endOfStream = endOfStream;
+
+		if (chunk.size > 0)
+			memcpy(&chunk.data[0], decoder->getBuffer(), chunk.size);
+
+		writeCount.store(w + 1, std::memory_order_release);
+		decoded = true;
+
+		if (endOfStream && !looping)
+		{
+			finished = true;
+			break;
+		}
+	}
+
+	return decoded;
+}
+
+const StreamBuffer::Chunk *StreamBuffer::front() const
+{
+	size_t r = readCount.load(std::memory_order_relaxed);
+	size_t w = writeCount.load(std::memory_order_acquire);
+
+	if (r == w)
+		return nullptr;
+
+	return &chunks[r % chunks.size()];
+}
+
+void StreamBuffer::pop()
+{
+	size_t r = readCount.load(std::memory_order_relaxed);
+	if (r != writeCount.load(std::memory_order_acquire))
+		readCount.store(r + 1, std::memory_order_release);
+}
+
+bool StreamBuffer::isFull() const
+{
+	size_t r = readCount.load(std::memory_order_acquire);
+	size_t w = writeCount.load(std::memory_order_acquire);
+	return w - r >= chunks.size();
+}
+
+bool StreamBuffer::isFinished() const
+{
+	return finished && front() == nullptr;
+}
+
+void StreamBuffer::seek(float seconds)
+{
+	thread::Lock lock(decoderMutex);
+
+	decoder->seek(seconds);
+
+	// Nothing is decoding right now, so the reader can safely skip ahead.
+	readCount.store(writeCount.load(std::memory_order_acquire), std::memory_order_release);
+	finished = false;
+}
+
+void StreamBuffer::setLooping(bool looping)
+{
+	thread::Lock lock(decoderMutex);
+
+	this->looping = looping;
+
+	if (looping)
+		finished = false;
+}
+
+double StreamBuffer::getDuration()
+{
+	thread::Lock lock(decoderMutex);
+	return decoder->getDuration();
+}
+
+love::sound::Decoder *StreamBuffer::cloneDecoder()
+{
+	thread::Lock lock(decoderMutex);
+	return decoder->clone();
+}
+
+int StreamBuffer::getChunkSize() const
+{
+	return (int) chunks[0].data.size();
+}
+
+bool StreamBuffer::setDecodePending()
+{
+	return !decodePending.exchange(true);
+}
+
+void StreamBuffer::clearDecodePending()
+{
+	decodePending = false;
+}
+
+} // openal
+} // audio
+} // love
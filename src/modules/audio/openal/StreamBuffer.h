@@ -0,0 +1,136 @@
+/**
+ * Copyright (c) 2006-2018 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#ifndef LOVE_AUDIO_OPENAL_STREAM_BUFFER_H
+#define LOVE_AUDIO_OPENAL_STREAM_BUFFER_H
+
+// LOVE
+#include "common/config.h"
+#include "common/Object.h"
+#include "sound/Decoder.h"
+#include "thread/threads.h"
+
+// STD
+#include <vector>
+#include <atomic>
+
+namespace love
+{
+namespace audio
+{
+namespace openal
+{
+
+/**
+ * Holds audio which has been decoded ahead of time for a streaming Source.
+ *
+ * Decoded chunks are stored in a fixed-size ring. Only one thread decodes at a
+ * time (fill is serialized by a mutex around the Decoder), and only the thread
+ * which holds the Pool lock reads chunks back out, so the ring itself is
+ * lock-free.
+ **/
+class StreamBuffer : public love::Object
+{
+public:
+
+	struct Chunk
+	{
+		std::vector<char> data;
+		int size = 0;
+
+		// Whether the Decoder reached the end of the stream with this chunk.
+		bool endOfStream = false;
+	};
+
+	StreamBuffer(love::sound::Decoder *decoder, int chunkCount);
+	virtual ~StreamBuffer();
+
+	/**
+	 * Decodes into free chunks until the ring is full or the stream has ended.
+	 * Can be called from any thread.
+	 * @return True if at least one chunk was decoded.
+	 **/
+	bool fill();
+
+	/**
+	 * Gets the oldest decoded chunk, or null if none are ready.
+	 **/
+	const Chunk *front() const;
+
+	/**
+	 * Releases the chunk returned by front, so it can be decoded into again.
+	 **/
+	void pop();
+
+	bool isFull() const;
+
+	/**
+	 * Whether the end of a non-looping stream has been decoded and every chunk
+	 * has been read.
+	 **/
+	bool isFinished() const;
+
+	/**
+	 * Seeks the Decoder and discards everything which was decoded ahead.
+	 **/
+	void seek(float seconds);
+
+	void setLooping(bool looping);
+
+	double getDuration();
+	love::sound::Decoder *cloneDecoder();
+
+	/**
+	 * Size in bytes of a full chunk.
+	 **/
+	int getChunkSize() const;
+
+	/**
+	 * Marks this buffer as waiting for a decode thread. Returns false if it
+	 * was already marked.
+	 **/
+	bool setDecodePending();
+	void clearDecodePending();
+
+private:
+
+	StrongRef<love::sound::Decoder> decoder;
+
+	std::vector<Chunk> chunks;
+
+	// Total number of chunks read and written. The ring index is the value
+	// modulo the chunk count.
+	std::atomic<size_t> readCount;
+	std::atomic<size_t> writeCount;
+
+	std::atomic<bool> looping;
+	std::atomic<bool> finished;
+	std::atomic<bool> decodePending;
+
+	// Held while the Decoder is in use.
+	thread::MutexRef decoderMutex;
+
+}; // StreamBuffer
+
+} // openal
+} // audio
+} // love
+
+#endif // LOVE_AUDIO_OPENAL_STREAM_BUFFER_H
@@ -0,0 +1,265 @@
+/**
+ * Copyright (c) 2006-2018 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#include "Audio.h"
+
+// C++
+#include <algorithm>
+
+namespace love
+{
+namespace audio
+{
+namespace software
+{
+
+Audio::Audio()
+	: mixer(SAMPLE_RATE)
+{
+}
+
+Audio::~Audio()
+{
+	sourceCache.clear();
+	mixer.stop();
+}
+
+const char *Audio::getName() const
+{
+	return "love.audio.software";
+}
+
+love::audio::Source *Audio::newSource(love::sound::Decoder *decoder)
+{
+	return new Source(&mixer, decoder);
+}
+
+love::audio::Source *Audio::newSource(love::sound::SoundData *soundData)
+{
+	return new Source(&mixer, soundData);
+}
+
+love::audio::Source *Audio::newSource(int sampleRate, int bitDepth, int channels, int buffers)
+{
+	return new Source(&mixer, sampleRate, bitDepth, channels, buffers);
+}
+
+int Audio::getActiveSourceCount() const
+{
+	return mixer.getActiveSourceCount();
+}
+
+double Audio::getClock() const
+{
+	return mixer.getClock();
+}
+
+int Audio::getMaxSources() const
+{
+	return mixer.getMaxSources();
+}
+
+bool Audio::play(love::audio::Source *source)
+{
+	return source->play();
+}
+
+bool Audio::play(const std::vector<love::audio::Source*> &sources)
+{
+	return mixer.play(toSources(sources));
+}
+
+bool Audio::playAt(const std::vector<love::audio::Source*> &sources, double time)
+{
+	return mixer.playAt(toSources(sources), time);
+}
+
+void Audio::stop(love::audio::Source *source)
+{
+	source->stop();
+}
+
+void Audio::stop(const std::vector<love::audio::Source*> &sources)
+{
+	mixer.stop(toSources(sources));
+}
+
+void Audio::stop()
+{
+	mixer.stop();
+}
+
+void Audio::pause(love::audio::Source *source)
+{
+	source->pause();
+}
+
+void Audio::pause(const std::vector<love::audio::Source*> &sources)
+{
+	mixer.pause(toSources(sources));
+}
+
+std::vector<love::audio::Source*> Audio::pause()
+{
+	return mixer.pause();
+}
+
+void Audio::setVolume(float volume)
+{
+	mixer.setVolume(volume);
+}
+
+float Audio::getVolume() const
+{
+	return mixer.getVolume();
+}
+
+void Audio::getPosition(float *v) const
+{
+	auto l = mixer.lock();
+	const float *p = mixer.getListener().position;
+	std::copy(p, p + 3, v);
+}
+
+void Audio::setPosition(float *v)
+{
+	auto l = mixer.lock();
+	std::copy(v, v + 3, mixer.getListener().position);
+}
+
+void Audio::getOrientation(float *v) const
+{
+	auto l = mixer.lock();
+	const float *o = mixer.getListener().orientation;
+	std::copy(o, o + 6, v);
+}
+
+void Audio::setOrientation(float *v)
+{
+	auto l = mixer.lock();
+	std::copy(v, v + 6, mixer.getListener().orientation);
+}
+
+void Audio::getVelocity(float *v) const
+{
+	auto l = mixer.lock();
+	const float *p = mixer.getListener().velocity;
+	std::copy(p, p + 3, v);
+}
+
+void Audio::setVelocity(float *v)
+{
+	auto l = mixer.lock();
+	std::copy(v, v + 3, mixer.getListener().velocity);
+}
+
+void Audio::setDopplerScale(float scale)
+{
+	if (scale >= 0.0f)
+	{
+		auto l = mixer.lock();
+		mixer.getListener().dopplerScale = scale;
+	}
+}
+
+float Audio::getDopplerScale() const
+{
+	auto l = mixer.lock();
+	return mixer.getListener().dopplerScale;
+}
+
+const std::vector<love::audio::RecordingDevice*> &Audio::getRecordingDevices()
+{
+	return capture;
+}
+
+Audio::DistanceModel Audio::getDistanceModel() const
+{
+	auto l = mixer.lock();
+	return mixer.getListener().distanceModel;
+}
+
+void Audio::setDistanceModel(DistanceModel distanceModel)
+{
+	auto l = mixer.lock();
+	mixer.getListener().distanceModel = distanceModel;
+}
+
+bool Audio::setEffect(const char *, std::map<Effect::Parameter, float> &)
+{
+	return false;
+}
+
+bool Audio::unsetEffect(const char *)
+{
+	return false;
+}
+
+bool Audio::getEffect(const char *, std::map<Effect::Parameter, float> &)
+{
+	return false;
+}
+
+bool Audio::getActiveEffects(std::vector<std::string> &) const
+{
+	return false;
+}
+
+int Audio::getMaxSceneEffects() const
+{
+	return 0;
+}
+
+int Audio::getMaxSourceEffects() const
+{
+	return 0;
+}
+
+bool Audio::isEFXsupported() const
+{
+	return false;
+}
+
+love::sound::SoundData *Audio::render(int frames)
+{
+	love::sound::SoundData *data = new love::sound::SoundData(frames, SAMPLE_RATE, 16, 2);
+	mixer.render((int16 *) data->getData(), frames);
+	return data;
+}
+
+void Audio::render(float *out, int frames)
+{
+	mixer.render(out, frames);
+}
+
+std::vector<Source *> Audio::toSources(const std::vector<love::audio::Source *> &sources)
+{
+	std::vector<Source *> out;
+	out.reserve(sources.size());
+
+	for (love::audio::Source *s : sources)
+		out.push_back((Source *) s);
+
+	return out;
+}
+
+} // software
+} // audio
+} // love
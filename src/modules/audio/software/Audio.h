@@ -0,0 +1,125 @@
+/**
+ * Copyright (c) 2006-2018 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#ifndef LOVE_AUDIO_SOFTWARE_AUDIO_H
+#define LOVE_AUDIO_SOFTWARE_AUDIO_H
+
+// LOVE
+#include "audio/Audio.h"
+#include "sound/SoundData.h"
+
+#include "Mixer.h"
+#include "Source.h"
+
+namespace love
+{
+namespace audio
+{
+namespace software
+{
+
+/**
+ * An audio backend which mixes everything in software and doesn't need an
+ * audio device. Time only advances when audio is rendered, so the output is
+ * deterministic and can be produced faster than real time, e.g. for automated
+ * tests or offline rendering.
+ **/
+class Audio : public love::audio::Audio
+{
+public:
+
+	// Sample rate of the mixed output.
+	static const int SAMPLE_RATE = 44100;
+
+	Audio();
+	virtual ~Audio();
+
+	// Implements Module.
+	const char *getName() const;
+
+	// Implements Audio.
+	love::audio::Source *newSource(love::sound::Decoder *decoder);
+	love::audio::Source *newSource(love::sound::SoundData *soundData);
+	love::audio::Source *newSource(int sampleRate, int bitDepth, int channels, int buffers);
+	int getActiveSourceCount() const;
+	double getClock() const;
+	int getMaxSources() const;
+	bool play(love::audio::Source *source);
+	bool play(const std::vector<love::audio::Source*> &sources);
+	bool playAt(const std::vector<love::audio::Source*> &sources, double time);
+	void stop(love::audio::Source *source);
+	void stop(const std::vector<love::audio::Source*> &sources);
+	void stop();
+	void pause(love::audio::Source *source);
+	void pause(const std::vector<love::audio::Source*> &sources);
+	std::vector<love::audio::Source*> pause();
+	void setVolume(float volume);
+	float getVolume() const;
+
+	void getPosition(float *v) const;
+	void setPosition(float *v);
+	void getOrientation(float *v) const;
+	void setOrientation(float *v);
+	void getVelocity(float *v) const;
+	void setVelocity(float *v);
+
+	void setDopplerScale(float scale);
+	float getDopplerScale() const;
+
+	const std::vector<love::audio::RecordingDevice*> &getRecordingDevices();
+
+	DistanceModel getDistanceModel() const;
+	void setDistanceModel(DistanceModel distanceModel);
+
+	bool setEffect(const char *, std::map<Effect::Parameter, float> &params);
+	bool unsetEffect(const char *);
+	bool getEffect(const char *, std::map<Effect::Parameter, float> &params);
+	bool getActiveEffects(std::vector<std::string> &list) const;
+	int getMaxSceneEffects() const;
+	int getMaxSourceEffects() const;
+	bool isEFXsupported() const;
+
+	/**
+	 * Mixes the next frames of all playing Sources, advancing them.
+	 * @param frames The number of sample frames to render.
+	 * @return A new 16-bit stereo SoundData at SAMPLE_RATE.
+	 **/
+	love::sound::SoundData *render(int frames);
+
+	/**
+	 * Mixes the next frames of all playing Sources into interleaved stereo
+	 * floating point samples, advancing them.
+	 **/
+	void render(float *out, int frames);
+
+private:
+
+	static std::vector<Source *> toSources(const std::vector<love::audio::Source *> &sources);
+
+	Mixer mixer;
+	std::vector<love::audio::RecordingDevice*> capture;
+
+}; // Audio
+
+} // software
+} // audio
+} // love
+
+#endif // LOVE_AUDIO_SOFTWARE_AUDIO_H
@@ -0,0 +1,401 @@
+/**
+ * Copyright (c) 2006-2018 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#include "Mixer.h"
+#include "Source.h"
+
+// C++
+#include <algorithm>
+#include <cmath>
+
+#if defined(LOVE_SIMD_SSE)
+#include <xmmintrin.h>
+#endif
+#if defined(LOVE_SIMD_SSE2)
+#include <emmintrin.h>
+#endif
+#if defined(LOVE_SIMD_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace love
+{
+namespace audio
+{
+namespace software
+{
+
+Mixer::Mixer(int sampleRate)
+	: sampleRate(sampleRate)
+	, clock(0)
+	, volume(1.0f)
+	, block(BLOCK_FRAMES * 2)
+{
+	listener.position[0] = listener.position[1] = listener.position[2] = 0.0f;
+	listener.velocity[0] = listener.velocity[1] = listener.velocity[2] = 0.0f;
+
+	// Same defaults as OpenAL: looking down -z, with +y up.
+	float orientation[6] = {0.0f, 0.0f, -1.0f, 0.0f, 1.0f, 0.0f};
+	std::copy(orientation, orientation + 6, listener.orientation);
+
+	listener.dopplerScale = 1.0f;
+	listener.distanceModel = love::audio::Audio::DISTANCE_INVERSE_CLAMPED;
+}
+
+Mixer::~Mixer()
+{
+	stop();
+}
+
+bool Mixer::isPlaying(Source *s)
+{
+	thread::Lock lock(mutex);
+	return isActive(s) && s->getStartFrameAtomic() <= clock;
+}
+
+bool Mixer::isActive(Source *s)
+{
+	thread::Lock lock(mutex);
+	return std::find(playing.begin(), playing.end(), s) != playing.end();
+}
+
+bool Mixer::play(const std::vector<Source *> &sources)
+{
+	thread::Lock lock(mutex);
+	return play(sources, clock);
+}
+
+bool Mixer::playAt(const std::vector<Source *> &sources, double time)
+{
+	thread::Lock lock(mutex);
+
+	int64 startFrame = (int64) ceil(time * sampleRate);
+	return play(sources, std::max(startFrame, clock));
+}
+
+bool Mixer::play(const std::vector<Source *> &sources, int64 startFrame)
+{
+	// Starting several Sources under one lock means they start on the same
+	// sample frame.
+	for (Source *s : sources)
+	{
+		if (std::find(playing.begin(), playing.end(), s) != playing.end())
+			continue;
+
+		if ((int) playing.size() >= MAX_SOURCES)
+			return false;
+
+		s->prepareAtomic(startFrame);
+		s->retain();
+		playing.push_back(s);
+	}
+
+	return true;
+}
+
+void Mixer::stop(const std::vector<Source *> &sources)
+{
+	thread::Lock lock(mutex);
+
+	for (Source *s : sources)
+	{
+		auto it = std::find(playing.begin(), playing.end(), s);
+		if (it != playing.end())
+		{
+			playing.erase(it);
+			s->teardownAtomic();
+			s->release();
+		}
+		else
+			s->teardownAtomic();
+	}
+}
+
+void Mixer::stop()
+{
+	thread::Lock lock(mutex);
+
+	for (Source *s : playing)
+	{
+		s->teardownAtomic();
+		s->release();
+	}
+
+	playing.clear();
+}
+
+void Mixer::pause(const std::vector<Source *> &sources)
+{
+	thread::Lock lock(mutex);
+
+	for (Source *s : sources)
+	{
+		auto it = std::find(playing.begin(), playing.end(), s);
+		if (it != playing.end())
+		{
+			playing.erase(it);
+			s->release();
+		}
+	}
+}
+
+std::vector<love::audio::Source *> Mixer::pause()
+{
+	thread::Lock lock(mutex);
+
+	std::vector<love::audio::Source *> paused(playing.begin(), playing.end());
+
+	for (Source *s : playing)
+		s->release();
+
+	playing.clear();
+
+	return paused;
+}
+
+int Mixer::getActiveSourceCount() const
+{
+	thread::Lock lock(mutex);
+	return (int) playing.size();
+}
+
+int Mixer::getMaxSources() const
+{
+	return MAX_SOURCES;
+}
+
+int Mixer::getSampleRate() const
+{
+	return sampleRate;
+}
+
+void Mixer::setVolume(float volume)
+{
+	thread::Lock lock(mutex);
+	this->volume = volume;
+}
+
+double Mixer::getClock() const
+{
+	thread::Lock lock(mutex);
+	return (double) clock / sampleRate;
+}
+
+float Mixer::getVolume() const
+{
+	thread::Lock lock(mutex);
+	return volume;
+}
+
+Listener &Mixer::getListener()
+{
+	return listener;
+}
+
+const Listener &Mixer::getListener() const
+{
+	return listener;
+}
+
+void Mixer::render(float *out, int frames)
+{
+	thread::Lock lock(mutex);
+
+	while (frames > 0)
+	{
+		int n = std::min(frames, (int) BLOCK_FRAMES);
+		renderBlock(out, n);
+
+		out += n * 2;
+		frames -= n;
+	}
+}
+
+void Mixer::render(int16 *out, int frames)
+{
+	thread::Lock lock(mutex);
+
+	while (frames > 0)
+	{
+		int n = std::min(frames, (int) BLOCK_FRAMES);
+		renderBlock(block.data(), n);
+		convert(block.data(), n * 2, out);
+
+		out += n * 2;
+		frames -= n;
+	}
+}
+
+void Mixer::renderBlock(float *out, int frames)
+{
+	std::fill(out, out + frames * 2, 0.0f);
+
+	for (size_t i = 0; i < playing.size();)
+	{
+		Source *s = playing[i];
+
+		// Scheduled Sources can start partway through the block.
+		int64 offset = std::max(s->getStartFrameAtomic() - clock, (int64) 0);
+		if (offset >= frames)
+		{
+			i++;
+			continue;
+		}
+
+		int start = (int) offset;
+		if (s->mixAtomic(out + start * 2, frames - start, sampleRate, listener))
+			i++;
+		else
+		{
+			// Finished Sources are rewound, like with OpenAL.
+			playing.erase(playing.begin() + i);
+			s->teardownAtomic();
+			s->release();
+		}
+	}
+
+	if (volume != 1.0f)
+	{
+		for (int i = 0; i < frames * 2; i++)
+			out[i] *= volume;
+	}
+
+	clock += frames;
+}
+
+thread::Lock Mixer::lock() const
+{
+	return thread::Lock(mutex);
+}
+
+void Mixer::mixMono(const float *src, int frames, float leftGain, float rightGain, float *dst)
+{
+	int i = 0;
+
+#if defined(LOVE_SIMD_SSE)
+	const __m128 gains = _mm_setr_ps(leftGain, rightGain, leftGain, rightGain);
+
+	for (; i + 4 <= frames; i += 4)
+	{
+		__m128 s = _mm_loadu_ps(src + i);
+		__m128 lo = _mm_unpacklo_ps(s, s);
+		__m128 hi = _mm_unpackhi_ps(s, s);
+
+		float *d = dst + i * 2;
+		_mm_storeu_ps(d + 0, _mm_add_ps(_mm_loadu_ps(d + 0), _mm_mul_ps(lo, gains)));
+		_mm_storeu_ps(d + 4, _mm_add_ps(_mm_loadu_ps(d + 4), _mm_mul_ps(hi, gains)));
+	}
+#elif defined(LOVE_SIMD_NEON)
+	const float g[4] = {leftGain, rightGain, leftGain, rightGain};
+	const float32x4_t gains = vld1q_f32(g);
+
+	for (; i + 4 <= frames; i += 4)
+	{
+		float32x4_t s = vld1q_f32(src + i);
+		float32x4x2_t z = vzipq_f32(s, s);
+
+		float *d = dst + i * 2;
+		vst1q_f32(d + 0, vmlaq_f32(vld1q_f32(d + 0), z.val[0], gains));
+		vst1q_f32(d + 4, vmlaq_f32(vld1q_f32(d + 4), z.val[1], gains));
+	}
+#endif
+
+	for (; i < frames; i++)
+	{
+		dst[i * 2 + 0] += src[i] * leftGain;
+		dst[i * 2 + 1] += src[i] * rightGain;
+	}
+}
+
+void Mixer::mixStereo(const float *src, int frames, float leftGain, float rightGain, float *dst)
+{
+	int i = 0;
+	int count = frames * 2;
+
+#if defined(LOVE_SIMD_SSE)
+	const __m128 gains = _mm_setr_ps(leftGain, rightGain, leftGain, rightGain);
+
+	for (; i + 8 <= count; i += 8)
+	{
+		__m128 a = _mm_mul_ps(_mm_loadu_ps(src + i + 0), gains);
+		__m128 b = _mm_mul_ps(_mm_loadu_ps(src + i + 4), gains);
+		_mm_storeu_ps(dst + i + 0, _mm_add_ps(_mm_loadu_ps(dst + i + 0), a));
+		_mm_storeu_ps(dst + i + 4, _mm_add_ps(_mm_loadu_ps(dst + i + 4), b));
+	}
+#elif defined(LOVE_SIMD_NEON)
+	const float g[4] = {leftGain, rightGain, leftGain, rightGain};
+	const float32x4_t gains = vld1q_f32(g);
+
+	for (; i + 8 <= count; i += 8)
+	{
+		vst1q_f32(dst + i + 0, vmlaq_f32(vld1q_f32(dst + i + 0), vld1q_f32(src + i + 0), gains));
+		vst1q_f32(dst + i + 4, vmlaq_f32(vld1q_f32(dst + i + 4), vld1q_f32(src + i + 4), gains));
+	}
+#endif
+
+	for (; i < count; i += 2)
+	{
+		dst[i + 0] += src[i + 0] * leftGain;
+		dst[i + 1] += src[i + 1] * rightGain;
+	}
+}
+
+void Mixer::convert(const float *src, int count, int16 *dst)
+{
+	int i = 0;
+
+#if defined(LOVE_SIMD_SSE2)
+	const __m128 scale = _mm_set1_ps(32767.0f);
+	const __m128 lo = _mm_set1_ps(-1.0f);
+	const __m128 hi = _mm_set1_ps(1.0f);
+
+	for (; i + 8 <= count; i += 8)
+	{
+		__m128 a = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + i + 0), lo), hi);
+		__m128 b = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + i + 4), lo), hi);
+		__m128i ia = _mm_cvttps_epi32(_mm_mul_ps(a, scale));
+		__m128i ib = _mm_cvttps_epi32(_mm_mul_ps(b, scale));
+		_mm_storeu_si128((__m128i *) (dst + i), _mm_packs_epi32(ia, ib));
+	}
+#elif defined(LOVE_SIMD_NEON)
+	const float32x4_t scale = vdupq_n_f32(32767.0f);
+	const float32x4_t lo = vdupq_n_f32(-1.0f);
+	const float32x4_t hi = vdupq_n_f32(1.0f);
+
+	for (; i + 8 <= count; i += 8)
+	{
+		float32x4_t a = vminq_f32(vmaxq_f32(vld1q_f32(src + i + 0), lo), hi);
+		float32x4_t b = vminq_f32(vmaxq_f32(vld1q_f32(src + i + 4), lo), hi);
+		int16x4_t ia = vqmovn_s32(vcvtq_s32_f32(vmulq_f32(a, scale)));
+		int16x4_t ib = vqmovn_s32(vcvtq_s32_f32(vmulq_f32(b, scale)));
+		vst1q_s16(dst + i, vcombine_s16(ia, ib));
+	}
+#endif
+
+	for (; i < count; i++)
+	{
+		float v = std::min(std::max(src[i], -1.0f), 1.0f);
+		dst[i] = (int16) (v * 32767.0f);
+	}
+}
+
+} // software
+} // audio
+} // love
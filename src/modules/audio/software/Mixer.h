@@ -0,0 +1,158 @@
+/**
+ * Copyright (c) 2006-2018 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#ifndef LOVE_AUDIO_SOFTWARE_MIXER_H
+#define LOVE_AUDIO_SOFTWARE_MIXER_H
+
+// LOVE
+#include "common/config.h"
+#include "common/int.h"
+#include "thread/threads.h"
+#include "audio/Audio.h"
+
+// C++
+#include <vector>
+
+namespace love
+{
+namespace audio
+{
+namespace software
+{
+
+class Source;
+
+struct Listener
+{
+	float position[3];
+	float orientation[6];
+	float velocity[3];
+	float dopplerScale;
+	love::audio::Audio::DistanceModel distanceModel;
+};
+
+/**
+ * Keeps track of the playing Sources and mixes them together. Nothing is
+ * output to an audio device, the mixed audio is only available through
+ * render, which can be called as often (or as rarely) as needed.
+ **/
+class Mixer
+{
+public:
+
+	Mixer(int sampleRate);
+	~Mixer();
+
+	bool isPlaying(Source *s);
+
+	// Whether the Source is playing or waiting to start playing.
+	bool isActive(Source *s);
+
+	bool play(const std::vector<Source *> &sources);
+
+	/**
+	 * Starts playing the Sources on the first sample frame at or after the
+	 * given clock time. Sources scheduled in the past start right away.
+	 **/
+	bool playAt(const std::vector<Source *> &sources, double time);
+
+	void stop(const std::vector<Source *> &sources);
+	void stop();
+	void pause(const std::vector<Source *> &sources);
+	std::vector<love::audio::Source *> pause();
+
+	int getActiveSourceCount() const;
+	int getMaxSources() const;
+
+	int getSampleRate() const;
+
+	// Seconds of audio rendered so far.
+	double getClock() const;
+
+	void setVolume(float volume);
+	float getVolume() const;
+
+	// The listener must only be accessed with the lock held.
+	Listener &getListener();
+	const Listener &getListener() const;
+
+	/**
+	 * Mixes the next frames of all playing Sources, and advances them.
+	 * @param out Interleaved stereo output, with room for frames * 2 samples.
+	 * @param frames The number of sample frames to mix.
+	 **/
+	void render(float *out, int frames);
+
+	/**
+	 * Like render, but converts the mixed audio to 16 bit integer samples.
+	 **/
+	void render(int16 *out, int frames);
+
+	LOVE_WARN_UNUSED thread::Lock lock() const;
+
+	/**
+	 * Adds a mono signal to an interleaved stereo buffer, with a separate
+	 * gain for each output channel.
+	 **/
+	static void mixMono(const float *src, int frames, float leftGain, float rightGain, float *dst);
+
+	/**
+	 * Adds an interleaved stereo signal to an interleaved stereo buffer.
+	 **/
+	static void mixStereo(const float *src, int frames, float leftGain, float rightGain, float *dst);
+
+	/**
+	 * Converts float samples in [-1, 1] to 16 bit integers, clamping values
+	 * outside that range.
+	 **/
+	static void convert(const float *src, int count, int16 *dst);
+
+private:
+
+	// Maximum number of Sources which can play at once.
+	static const int MAX_SOURCES = 256;
+
+	// Longest stretch of audio mixed at once, in sample frames.
+	static const int BLOCK_FRAMES = 1024;
+
+	bool play(const std::vector<Source *> &sources, int64 startFrame);
+	void renderBlock(float *out, int frames);
+
+	// Retained.
+	std::vector<Source *> playing;
+
+	int sampleRate;
+
+	// Number of sample frames rendered so far.
+	int64 clock;
+	float volume;
+	Listener listener;
+
+	std::vector<float> block;
+
+	love::thread::MutexRef mutex;
+
+}; // Mixer
+
+} // software
+} // audio
+} // love
+
+#endif // LOVE_AUDIO_SOFTWARE_MIXER_H
@@ -0,0 +1,1034 @@
+/**
+ * Copyright (c) 2006-2018 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#include "Source.h"
+#include "Mixer.h"
+#include "common/math.h"
+#include "common/Vector.h"
+
+// C++
+#include <algorithm>
+#include <cmath>
+
+namespace love
+{
+namespace audio
+{
+namespace software
+{
+
+// Speed of sound in units per second, the same as OpenAL uses.
+static const float SPEED_OF_SOUND = 343.3f;
+
+// Filter gains apply below and above these frequencies, the same as the
+// reference frequencies of OpenAL's EFX filters.
+static const float FILTER_LOW_FREQUENCY = 250.0f;
+static const float FILTER_HIGH_FREQUENCY = 5000.0f;
+
+static void checkFormat(int bitDepth, int channels)
+{
+	if ((bitDepth != 8 && bitDepth != 16) || (channels != 1 && channels != 2))
+		throw InvalidFormatException(channels, bitDepth);
+}
+
+StaticDataBuffer::StaticDataBuffer(const void *data, size_t size, int bitDepth, int channels)
+	: frames((int) (size / (bitDepth / 8) / channels))
+{
+	samples.resize(frames * channels);
+	love::sound::SoundData::toFloat(data, bitDepth, frames * channels, samples.data());
+}
+
+StaticDataBuffer::~StaticDataBuffer()
+{
+}
+
+Source::Source(Mixer *mixer, love::sound::SoundData *soundData)
+	: love::audio::Source(Source::TYPE_STATIC)
+	, mixer(mixer)
+	, sampleRate(soundData->getSampleRate())
+	, channels(soundData->getChannelCount())
+	, bitDepth(soundData->getBitDepth())
+{
+	checkFormat(bitDepth, channels);
+	staticBuffer.set(new StaticDataBuffer(soundData->getData(), soundData->getSize(), bitDepth, channels), Acquire::NORETAIN);
+}
+
+Source::Source(Mixer *mixer, love::sound::Decoder *decoder)
+	: love::audio::Source(Source::TYPE_STREAM)
+	, mixer(mixer)
+	, sampleRate(decoder->getSampleRate())
+	, channels(decoder->getChannelCount())
+	, bitDepth(decoder->getBitDepth())
+	, decoder(decoder)
+{
+	checkFormat(bitDepth, channels);
+}
+
+Source::Source(Mixer *mixer, int sampleRate, int bitDepth, int channels, int buffers)
+	: love::audio::Source(Source::TYPE_QUEUE)
+	, mixer(mixer)
+	, sampleRate(sampleRate)
+	, channels(channels)
+	, bitDepth(bitDepth)
+	, buffers(buffers)
+{
+	checkFormat(bitDepth, channels);
+
+	if (buffers < 1)
+		this->buffers = 1;
+}
+
+Source::Source(const Source &s)
+	: love::audio::Source(s.sourceType)
+	, mixer(s.mixer)
+	, sampleRate(s.sampleRate)
+	, channels(s.channels)
+	, bitDepth(s.bitDepth)
+	, staticBuffer(s.staticBuffer)
+	, buffers(s.buffers)
+	, pitch(s.pitch)
+	, volume(s.volume)
+	, relative(s.relative)
+	, looping(s.looping)
+	, minVolume(s.minVolume)
+	, maxVolume(s.maxVolume)
+	, referenceDistance(s.referenceDistance)
+	, rolloffFactor(s.rolloffFactor)
+	, maxDistance(s.maxDistance)
+	, absorptionFactor(s.absorptionFactor)
+	, cone(s.cone)
+	, hasFilter(s.hasFilter)
+	, filterParams(s.filterParams)
+{
+	if (sourceType == TYPE_STREAM)
+		decoder.set(s.decoder->clone(), Acquire::NORETAIN);
+
+	std::copy(s.position, s.position + 3, position);
+	std::copy(s.velocity, s.velocity + 3, velocity);
+	std::copy(s.direction, s.direction + 3, direction);
+}
+
+Source::~Source()
+{
+}
+
+love::audio::Source *Source::clone()
+{
+	return new Source(*this);
+}
+
+bool Source::play()
+{
+	return mixer->play({this});
+}
+
+bool Source::playAt(double time)
+{
+	return mixer->playAt({this}, time);
+}
+
+void Source::stop()
+{
+	mixer->stop({this});
+}
+
+void Source::pause()
+{
+	mixer->pause({this});
+}
+
+bool Source::isPlaying() const
+{
+	return mixer->isPlaying((Source *) this);
+}
+
+bool Source::isFinished() const
+{
+	auto l = mixer->lock();
+	return primed && !currentValid;
+}
+
+bool Source::update()
+{
+	auto l = mixer->lock();
+	return !primed || currentValid;
+}
+
+void Source::setPitch(float pitch)
+{
+	this->pitch = pitch;
+}
+
+float Source::getPitch() const
+{
+	return pitch;
+}
+
+void Source::setVolume(float volume)
+{
+	this->volume = volume;
+}
+
+float Source::getVolume() const
+{
+	return volume;
+}
+
+void Source::seek(float offset, Source::Unit unit)
+{
+	auto l = mixer->lock();
+
+	int64 frame = 0;
+	if (unit == UNIT_SECONDS)
+		frame = (int64) ((double) offset * sampleRate);
+	else
+		frame = (int64) offset;
+
+	seekAtomic(std::max(frame, (int64) 0));
+}
+
+float Source::tell(Source::Unit unit)
+{
+	auto l = mixer->lock();
+
+	double frame = 0.0;
+
+	if (primed && currentValid)
+		frame = (double) currentIndex + fraction;
+	else if (sourceType == TYPE_STATIC)
+		frame = (double) staticOffset;
+	else if (sourceType == TYPE_STREAM)
+		frame = (double) streamPosition;
+
+	if (unit == UNIT_SECONDS)
+		return (float) (frame / sampleRate);
+	else
+		return (float) frame;
+}
+
+double Source::getDuration(Unit unit)
+{
+	auto l = mixer->lock();
+
+	switch (sourceType)
+	{
+	case TYPE_STATIC:
+	{
+		int frames = staticBuffer->getFrameCount();
+		if (unit == UNIT_SAMPLES)
+			return (double) frames;
+		else
+			return (double) frames / (double) sampleRate;
+	}
+	case TYPE_STREAM:
+	{
+		double seconds = decoder->getDuration();
+		if (unit == UNIT_SECONDS)
+			return seconds;
+		else
+			return seconds * sampleRate;
+	}
+	case TYPE_QUEUE:
+	{
+		size_t samples = 0;
+		auto buffers = queuedBuffers;
+		while (!buffers.empty())
+		{
+			samples += buffers.front().size();
+			buffers.pop();
+		}
+
+		double frames = (double) (samples / channels);
+		if (unit == UNIT_SAMPLES)
+			return frames;
+		else
+			return frames / (double) sampleRate;
+	}
+	case TYPE_MAX_ENUM:
+		break;
+	}
+
+	return 0.0;
+}
+
+void Source::setPosition(float *v)
+{
+	if (channels > 1)
+		throw SpatialSupportException();
+
+	std::copy(v, v + 3, position);
+}
+
+void Source::getPosition(float *v) const
+{
+	if (channels > 1)
+		throw SpatialSupportException();
+
+	std::copy(position, position + 3, v);
+}
+
+void Source::setVelocity(float *v)
+{
+	if (channels > 1)
+		throw SpatialSupportException();
+
+	std::copy(v, v + 3, velocity);
+}
+
+void Source::getVelocity(float *v) const
+{
+	if (channels > 1)
+		throw SpatialSupportException();
+
+	std::copy(velocity, velocity + 3, v);
+}
+
+void Source::setDirection(float *v)
+{
+	if (channels > 1)
+		throw SpatialSupportException();
+
+	std::copy(v, v + 3, direction);
+}
+
+void Source::getDirection(float *v) const
+{
+	if (channels > 1)
+		throw SpatialSupportException();
+
+	std::copy(direction, direction + 3, v);
+}
+
+void Source::setCone(float innerAngle, float outerAngle, float outerVolume, float outerHighGain)
+{
+	if (channels > 1)
+		throw SpatialSupportException();
+
+	cone.innerAngle = LOVE_TODEG(innerAngle);
+	cone.outerAngle = LOVE_TODEG(outerAngle);
+	cone.outerVolume = outerVolume;
+	cone.outerHighGain = outerHighGain;
+}
+
+void Source::getCone(float &innerAngle, float &outerAngle, float &outerVolume, float &outerHighGain) const
+{
+	if (channels > 1)
+		throw SpatialSupportException();
+
+	innerAngle = LOVE_TORAD(cone.innerAngle);
+	outerAngle = LOVE_TORAD(cone.outerAngle);
+	outerVolume = cone.outerVolume;
+	outerHighGain = cone.outerHighGain;
+}
+
+void Source::setRelative(bool enable)
+{
+	if (channels > 1)
+		throw SpatialSupportException();
+
+	relative = enable;
+}
+
+bool Source::isRelative() const
+{
+	if (channels > 1)
+		throw SpatialSupportException();
+
+	return relative;
+}
+
+void Source::setLooping(bool enable)
+{
+	if (sourceType == TYPE_QUEUE)
+		throw QueueLoopingException();
+
+	auto l = mixer->lock();
+	looping = enable;
+}
+
+bool Source::isLooping() const
+{
+	return looping;
+}
+
+void Source::setMinVolume(float volume)
+{
+	minVolume = volume;
+}
+
+float Source::getMinVolume() const
+{
+	return minVolume;
+}
+
+void Source::setMaxVolume(float volume)
+{
+	maxVolume = volume;
+}
+
+float Source::getMaxVolume() const
+{
+	return maxVolume;
+}
+
+void Source::setReferenceDistance(float distance)
+{
+	if (channels > 1)
+		throw SpatialSupportException();
+
+	referenceDistance = distance;
+}
+
+float Source::getReferenceDistance() const
+{
+	if (channels > 1)
+		throw SpatialSupportException();
+
+	return referenceDistance;
+}
+
+void Source::setRolloffFactor(float factor)
+{
+	if (channels > 1)
+		throw SpatialSupportException();
+
+	rolloffFactor = factor;
+}
+
+float Source::getRolloffFactor() const
+{
+	if (channels > 1)
+		throw SpatialSupportException();
+
+	return rolloffFactor;
+}
+
+void Source::setMaxDistance(float distance)
+{
+	if (channels > 1)
+		throw SpatialSupportException();
+
+	maxDistance = std::min(distance, FLT_MAX);
+}
+
+float Source::getMaxDistance() const
+{
+	if (channels > 1)
+		throw SpatialSupportException();
+
+	return maxDistance;
+}
+
+void Source::setAirAbsorptionFactor(float factor)
+{
+	if (channels > 1)
+		throw SpatialSupportException();
+
+	// Stored, but there's no air absorption without EFX.
+	absorptionFactor = factor;
+}
+
+float Source::getAirAbsorptionFactor() const
+{
+	if (channels > 1)
+		throw SpatialSupportException();
+
+	return absorptionFactor;
+}
+
+int Source::getChannelCount() const
+{
+	return channels;
+}
+
+bool Source::setFilter(const std::map<Filter::Parameter, float> &params)
+{
+	auto l = mixer->lock();
+
+	filterParams = params;
+	hasFilter = true;
+
+	return true;
+}
+
+bool Source::setFilter()
+{
+	auto l = mixer->lock();
+
+	filterParams.clear();
+	hasFilter = false;
+
+	return true;
+}
+
+bool Source::getFilter(std::map<Filter::Parameter, float> &params)
+{
+	auto l = mixer->lock();
+
+	if (!hasFilter)
+		return false;
+
+	params = filterParams;
+	return true;
+}
+
+bool Source::setEffect(const char *)
+{
+	return false;
+}
+
+bool Source::setEffect(const char *, const std::map<Filter::Parameter, float> &)
+{
+	return false;
+}
+
+bool Source::unsetEffect(const char *)
+{
+	return false;
+}
+
+bool Source::getEffect(const char *, std::map<Filter::Parameter, float> &)
+{
+	return false;
+}
+
+bool Source::getActiveEffects(std::vector<std::string> &) const
+{
+	return false;
+}
+
+int Source::getFreeBufferCount() const
+{
+	if (sourceType != TYPE_QUEUE)
+		return 0;
+
+	auto l = mixer->lock();
+	return buffers - (int) queuedBuffers.size();
+}
+
+bool Source::queue(void *data, size_t length, int dataSampleRate, int dataBitDepth, int dataChannels)
+{
+	if (sourceType != TYPE_QUEUE)
+		throw QueueTypeMismatchException();
+
+	if (dataSampleRate != sampleRate || dataBitDepth != bitDepth || dataChannels != channels)
+		throw QueueFormatMismatchException();
+
+	if (length % (bitDepth / 8 * channels) != 0)
+		throw QueueMalformedLengthException(bitDepth / 8 * channels);
+
+	if (length == 0)
+		return true;
+
+	auto l = mixer->lock();
+
+	if ((int) queuedBuffers.size() >= buffers)
+		return false;
+
+	int samples = (int) (length / (bitDepth / 8));
+
+	std::vector<float> buffer(samples);
+	love::sound::SoundData::toFloat(data, bitDepth, samples, buffer.data());
+	queuedBuffers.push(std::move(buffer));
+
+	return true;
+}
+
+bool Source::queueAt(void *data, size_t length, int dataSampleRate, int dataBitDepth, int dataChannels, double time)
+{
+	if (sourceType != TYPE_QUEUE)
+		throw QueueTypeMismatchException();
+
+	if (dataSampleRate != sampleRate || dataBitDepth != bitDepth || dataChannels != channels)
+		throw QueueFormatMismatchException();
+
+	int frameSize = bitDepth / 8 * channels;
+	if (length % frameSize != 0)
+		throw QueueMalformedLengthException(frameSize);
+
+	if (length == 0)
+		return true;
+
+	auto l = mixer->lock();
+
+	if ((int) queuedBuffers.size() >= buffers)
+		return false;
+
+	double rate = sampleRate * std::max(pitch, 0.0001f);
+	double pending = getPendingFramesAtomic();
+
+	// Work out when the new data would start playing if it was queued as-is.
+	double start = time;
+	bool startSource = !mixer->isActive(this);
+
+	if (!startSource)
+	{
+		double begin = std::max((double) startFrame / mixer->getSampleRate(), mixer->getClock());
+		start = begin + pending / rate;
+	}
+
+	// Pad or trim the start of the data so it lines up with the given time.
+	std::vector<uint8> shifted;
+	int64 shift = (int64) floor((time - start) * rate + 0.5);
+	shiftSamples(data, length, bitDepth, channels, shift, shifted);
+
+	// All of it would have played already.
+	if (shifted.empty())
+		return true;
+
+	if (!queue(&shifted[0], shifted.size(), dataSampleRate, dataBitDepth, dataChannels))
+		return false;
+
+	// Nothing to line up with, so start the Source such that the new data
+	// plays at the given time.
+	if (startSource)
+		return mixer->playAt({this}, time - pending / rate);
+
+	return true;
+}
+
+bool Source::mixAtomic(float *out, int frames, int outputRate, const Listener &listener)
+{
+	// Queueable Sources may have been started before anything was queued.
+	if (!primed || !currentValid)
+		primeAtomic();
+
+	if (!currentValid)
+		return false;
+
+	float gains[2];
+	float doppler = 1.0f;
+	getGains(listener, gains, doppler);
+
+	double step = std::max(((double) sampleRate / outputRate) * pitch * doppler, 0.0);
+
+	scratch.resize(frames * channels);
+	float *dst = scratch.data();
+
+	int produced = 0;
+
+	// Linear interpolation between input frames.
+	while (produced < frames && currentValid)
+	{
+		float t = (float) fraction;
+		for (int c = 0; c < channels; c++)
+			dst[produced * channels + c] = current[c] + (next[c] - current[c]) * t;
+
+		produced++;
+		fraction += step;
+
+		while (fraction >= 1.0 && currentValid)
+		{
+			fraction -= 1.0;
+
+			// More audio may have been queued since the last read.
+			if (!nextValid)
+				nextValid = readFrame(next, nextIndex);
+
+			std::copy(next, next + 2, current);
+			currentIndex = nextIndex;
+			currentValid = nextValid;
+
+			if (currentValid)
+				nextValid = readFrame(next, nextIndex);
+		}
+	}
+
+	if (hasFilter)
+		filterAtomic(dst, produced, outputRate);
+
+	if (channels == 1)
+		Mixer::mixMono(dst, produced, gains[0], gains[1], out);
+	else
+		Mixer::mixStereo(dst, produced, gains[0], gains[1], out);
+
+	return currentValid;
+}
+
+void Source::prepareAtomic(int64 startFrame)
+{
+	this->startFrame = startFrame;
+
+	if (!primed)
+		primeAtomic();
+}
+
+void Source::teardownAtomic()
+{
+	switch (sourceType)
+	{
+	case TYPE_STATIC:
+		staticOffset = 0;
+		break;
+	case TYPE_STREAM:
+		decoder->seek(0);
+		streamFrames = 0;
+		streamOffset = 0;
+		streamPosition = 0;
+		break;
+	case TYPE_QUEUE:
+		queuedBuffers = std::queue<std::vector<float>>();
+		queueOffset = 0;
+		queuePosition = 0;
+		break;
+	case TYPE_MAX_ENUM:
+		break;
+	}
+
+	primed = false;
+	currentValid = false;
+	nextValid = false;
+	fraction = 0.0;
+}
+
+bool Source::readFrame(float *frame, int64 &index)
+{
+	const float *src = nullptr;
+
+	switch (sourceType)
+	{
+	case TYPE_STATIC:
+	{
+		int frames = staticBuffer->getFrameCount();
+		if (staticOffset >= frames)
+		{
+			if (!looping || frames == 0)
+				break;
+			staticOffset = 0;
+		}
+
+		src = staticBuffer->getSamples() + staticOffset * channels;
+		index = staticOffset++;
+		break;
+	}
+	case TYPE_STREAM:
+		if (streamOffset >= streamFrames && !decodeChunk())
+			break;
+
+		src = streamChunk.data() + streamOffset * channels;
+		index = streamPosition++;
+		streamOffset++;
+		break;
+	case TYPE_QUEUE:
+		while (!queuedBuffers.empty() && queueOffset * channels >= (int) queuedBuffers.front().size())
+		{
+			queuedBuffers.pop();
+			queueOffset = 0;
+		}
+
+		if (queuedBuffers.empty())
+			break;
+
+		src = queuedBuffers.front().data() + queueOffset * channels;
+		index = queuePosition++;
+		queueOffset++;
+		break;
+	case TYPE_MAX_ENUM:
+		break;
+	}
+
+	if (src == nullptr)
+	{
+		frame[0] = frame[1] = 0.0f;
+		return false;
+	}
+
+	frame[0] = src[0];
+	frame[1] = channels > 1 ? src[1] : 0.0f;
+	return true;
+}
+
+bool Source::decodeChunk()
+{
+	streamFrames = 0;
+	streamOffset = 0;
+
+	// Only rewind once, in case the Decoder has no audio at all.
+	bool rewound = false;
+
+	while (true)
+	{
+		int decoded = decoder->decode();
+
+		if (decoded > 0)
+		{
+			streamFrames = decoded / (channels * (bitDepth / 8));
+			streamChunk.resize(streamFrames * channels);
+			love::sound::SoundData::toFloat(decoder->getBuffer(), bitDepth, streamFrames * channels, streamChunk.data());
+
+			if (streamFrames > 0)
+				return true;
+		}
+		else if (looping && !rewound && decoder->isFinished())
+		{
+			decoder->rewind();
+			streamPosition = 0;
+			rewound = true;
+		}
+		else
+			return false;
+	}
+}
+
+void Source::seekAtomic(int64 frame)
+{
+	switch (sourceType)
+	{
+	case TYPE_STATIC:
+		staticOffset = (int) std::min(frame, (int64) staticBuffer->getFrameCount());
+		break;
+	case TYPE_STREAM:
+		decoder->seek((float) ((double) frame / sampleRate));
+		streamFrames = 0;
+		streamOffset = 0;
+		streamPosition = frame;
+		break;
+	case TYPE_QUEUE:
+		// Offsets are relative to the start of the oldest queued buffer.
+		queueOffset = 0;
+		while (!queuedBuffers.empty())
+		{
+			int64 length = (int64) queuedBuffers.front().size() / channels;
+			if (frame < length)
+			{
+				queueOffset = (int) frame;
+				break;
+			}
+
+			frame -= length;
+			queuedBuffers.pop();
+		}
+		break;
+	case TYPE_MAX_ENUM:
+		break;
+	}
+
+	if (primed)
+		primeAtomic();
+}
+
+void Source::primeAtomic()
+{
+	currentValid = readFrame(current, currentIndex);
+
+	if (currentValid)
+		nextValid = readFrame(next, nextIndex);
+	else
+	{
+		next[0] = next[1] = 0.0f;
+		nextValid = false;
+	}
+
+	fraction = 0.0;
+	primed = true;
+
+	std::fill(lowState, lowState + 2, 0.0f);
+	std::fill(highState, highState + 2, 0.0f);
+}
+
+static float getDistanceGain(love::audio::Audio::DistanceModel model, float distance, float reference, float rolloff, float maximum)
+{
+	using love::audio::Audio;
+
+	// These follow the OpenAL 1.1 specification.
+	switch (model)
+	{
+	case Audio::DISTANCE_INVERSE_CLAMPED:
+		distance = std::min(std::max(distance, reference), maximum);
+		// fallthrough
+	case Audio::DISTANCE_INVERSE:
+	{
+		float denom = reference + rolloff * (distance - reference);
+		return denom > 0.0f ? reference / denom : 1.0f;
+	}
+	case Audio::DISTANCE_LINEAR_CLAMPED:
+		distance = std::max(distance, reference);
+		// fallthrough
+	case Audio::DISTANCE_LINEAR:
+	{
+		distance = std::min(distance, maximum);
+		if (maximum <= reference)
+			return 1.0f;
+		return std::max(1.0f - rolloff * (distance - reference) / (maximum - reference), 0.0f);
+	}
+	case Audio::DISTANCE_EXPONENT_CLAMPED:
+		distance = std::min(std::max(distance, reference), maximum);
+		// fallthrough
+	case Audio::DISTANCE_EXPONENT:
+		if (distance <= 0.0f || reference <= 0.0f)
+			return 1.0f;
+		return powf(distance / reference, -rolloff);
+	case Audio::DISTANCE_NONE:
+	case Audio::DISTANCE_MAX_ENUM:
+		break;
+	}
+
+	return 1.0f;
+}
+
+double Source::getPendingFramesAtomic() const
+{
+	double frames = 0.0;
+
+	if (primed && currentValid)
+		frames += (1.0 - fraction) + (nextValid ? 1.0 : 0.0);
+
+	if (sourceType == TYPE_QUEUE)
+	{
+		size_t samples = 0;
+		auto buffers = queuedBuffers;
+		while (!buffers.empty())
+		{
+			samples += buffers.front().size();
+			buffers.pop();
+		}
+
+		frames += (double) (samples / channels - queueOffset);
+	}
+
+	return frames;
+}
+
+void Source::getGains(const Listener &listener, float *gains, float &doppler) const
+{
+	float gain = volume;
+	float pan = 0.0f;
+
+	doppler = 1.0f;
+
+	// Multi-channel Sources aren't spatialized, like with OpenAL.
+	if (channels == 1)
+	{
+		Vector3 listenerPos, listenerVel;
+		Vector3 right(1.0f, 0.0f, 0.0f);
+
+		// Relative Sources are already in the listener's space.
+		if (!relative)
+		{
+			listenerPos = Vector3(listener.position[0], listener.position[1], listener.position[2]);
+			listenerVel = Vector3(listener.velocity[0], listener.velocity[1], listener.velocity[2]);
+
+			Vector3 forward(listener.orientation[0], listener.orientation[1], listener.orientation[2]);
+			Vector3 up(listener.orientation[3], listener.orientation[4], listener.orientation[5]);
+			right = Vector3::cross(forward, up);
+			right.normalize();
+		}
+
+		Vector3 pos(position[0], position[1], position[2]);
+		Vector3 vel(velocity[0], velocity[1], velocity[2]);
+		Vector3 dir(direction[0], direction[1], direction[2]);
+
+		Vector3 toListener = listenerPos - pos;
+		float distance = toListener.normalize();
+
+		gain *= getDistanceGain(listener.distanceModel, distance, referenceDistance, rolloffFactor, maxDistance);
+
+		if (distance > 0.0f && dir.normalize() > 0.0f)
+		{
+			float cosine = std::min(std::max(Vector3::dot(dir, toListener), -1.0f), 1.0f);
+			float angle = LOVE_TODEG(acosf(cosine)) * 2.0f;
+
+			if (angle >= cone.outerAngle)
+				gain *= cone.outerVolume;
+			else if (angle > cone.innerAngle)
+			{
+				float t = (angle - cone.innerAngle) / (cone.outerAngle - cone.innerAngle);
+				gain *= 1.0f + t * (cone.outerVolume - 1.0f);
+			}
+		}
+
+		if (distance > 0.0f)
+		{
+			pan = -Vector3::dot(toListener, right);
+
+			float scale = listener.dopplerScale;
+			if (scale > 0.0f)
+			{
+				float limit = SPEED_OF_SOUND / scale;
+				float vls = std::min(Vector3::dot(listenerVel, toListener), limit);
+				float vss = std::min(Vector3::dot(vel, toListener), limit);
+				float denom = SPEED_OF_SOUND - scale * vss;
+
+				if (denom > 0.0f)
+					doppler = std::max((SPEED_OF_SOUND - scale * vls) / denom, 0.0f);
+			}
+		}
+	}
+
+	gain = std::min(std::max(gain, minVolume), maxVolume);
+
+	if (channels == 1)
+	{
+		// Constant power panning.
+		float angle = (std::min(std::max(pan, -1.0f), 1.0f) + 1.0f) * (float) LOVE_M_PI_4;
+		gains[0] = gain * cosf(angle);
+		gains[1] = gain * sinf(angle);
+	}
+	else
+	{
+		gains[0] = gain;
+		gains[1] = gain;
+	}
+}
+
+void Source::filterAtomic(float *samples, int frames, int outputRate)
+{
+	auto getParam = [this](Filter::Parameter p) -> float
+	{
+		auto it = filterParams.find(p);
+		float v = it != filterParams.end() ? it->second : 1.0f;
+		return std::min(std::max(v, 0.0f), 1.0f);
+	};
+
+	Filter::Type type = Filter::TYPE_BASIC;
+	auto it = filterParams.find(Filter::FILTER_TYPE);
+	if (it != filterParams.end())
+		type = (Filter::Type) (int) it->second;
+
+	float gain = getParam(Filter::FILTER_VOLUME);
+	float lowGain = type == Filter::TYPE_HIGHPASS || type == Filter::TYPE_BANDPASS ? getParam(Filter::FILTER_LOWGAIN) : 1.0f;
+	float highGain = type == Filter::TYPE_LOWPASS || type == Filter::TYPE_BANDPASS ? getParam(Filter::FILTER_HIGHGAIN) : 1.0f;
+
+	// The input is resampled to the output rate at this point.
+	float lowAlpha = 1.0f - expf(-2.0f * (float) LOVE_M_PI * FILTER_LOW_FREQUENCY / outputRate);
+	float highAlpha = 1.0f - expf(-2.0f * (float) LOVE_M_PI * FILTER_HIGH_FREQUENCY / outputRate);
+
+	for (int i = 0; i < frames; i++)
+	{
+		for (int c = 0; c < channels; c++)
+		{
+			float &x = samples[i * channels + c];
+
+			// Split the signal into low, mid and high bands.
+			lowState[c] += lowAlpha * (x - lowState[c]);
+			highState[c] += highAlpha * (x - highState[c]);
+
+			float low = lowState[c];
+			float high = x - highState[c];
+			float mid = x - low - high;
+
+			x = gain * (lowGain * low + mid + highGain * high);
+		}
+	}
+}
+
+} // software
+} // audio
+} // love
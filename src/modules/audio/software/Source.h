@@ -0,0 +1,251 @@
+/**
+ * Copyright (c) 2006-2018 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#ifndef LOVE_AUDIO_SOFTWARE_SOURCE_H
+#define LOVE_AUDIO_SOFTWARE_SOURCE_H
+
+// LOVE
+#include "common/config.h"
+#include "common/Object.h"
+#include "common/int.h"
+#include "audio/Source.h"
+#include "audio/Filter.h"
+#include "sound/SoundData.h"
+#include "sound/Decoder.h"
+
+// C++
+#include <queue>
+#include <vector>
+#include <map>
+#include <cfloat>
+
+namespace love
+{
+namespace audio
+{
+namespace software
+{
+
+class Mixer;
+struct Listener;
+
+// Sample data of static Sources, converted to floating point once and shared
+// between clones.
+class StaticDataBuffer : public love::Object
+{
+public:
+
+	StaticDataBuffer(const void *data, size_t size, int bitDepth, int channels);
+	virtual ~StaticDataBuffer();
+
+	inline const float *getSamples() const
+	{
+		return samples.data();
+	}
+
+	inline int getFrameCount() const
+	{
+		return frames;
+	}
+
+private:
+
+	std::vector<float> samples;
+	int frames;
+
+}; // StaticDataBuffer
+
+class Source : public love::audio::Source
+{
+public:
+
+	Source(Mixer *mixer, love::sound::SoundData *soundData);
+	Source(Mixer *mixer, love::sound::Decoder *decoder);
+	Source(Mixer *mixer, int sampleRate, int bitDepth, int channels, int buffers);
+	Source(const Source &s);
+	virtual ~Source();
+
+	virtual love::audio::Source *clone();
+	virtual bool play();
+	virtual bool playAt(double time);
+	virtual void stop();
+	virtual void pause();
+	virtual bool isPlaying() const;
+	virtual bool isFinished() const;
+	virtual bool update();
+	virtual void setPitch(float pitch);
+	virtual float getPitch() const;
+	virtual void setVolume(float volume);
+	virtual float getVolume() const;
+	virtual void seek(float offset, Unit unit);
+	virtual float tell(Unit unit);
+	virtual double getDuration(Unit unit);
+	virtual void setPosition(float *v);
+	virtual void getPosition(float *v) const;
+	virtual void setVelocity(float *v);
+	virtual void getVelocity(float *v) const;
+	virtual void setDirection(float *v);
+	virtual void getDirection(float *v) const;
+	virtual void setCone(float innerAngle, float outerAngle, float outerVolume, float outerHighGain);
+	virtual void getCone(float &innerAngle, float &outerAngle, float &outerVolume, float &outerHighGain) const;
+	virtual void setRelative(bool enable);
+	virtual bool isRelative() const;
+	virtual void setLooping(bool looping);
+	virtual bool isLooping() const;
+	virtual void setMinVolume(float volume);
+	virtual float getMinVolume() const;
+	virtual void setMaxVolume(float volume);
+	virtual float getMaxVolume() const;
+	virtual void setReferenceDistance(float distance);
+	virtual float getReferenceDistance() const;
+	virtual void setRolloffFactor(float factor);
+	virtual float getRolloffFactor() const;
+	virtual void setMaxDistance(float distance);
+	virtual float getMaxDistance() const;
+	virtual void setAirAbsorptionFactor(float factor);
+	virtual float getAirAbsorptionFactor() const;
+	virtual int getChannelCount() const;
+
+	virtual bool setFilter(const std::map<Filter::Parameter, float> &params);
+	virtual bool setFilter();
+	virtual bool getFilter(std::map<Filter::Parameter, float> &params);
+
+	virtual bool setEffect(const char *effect);
+	virtual bool setEffect(const char *effect, const std::map<Filter::Parameter, float> &params);
+	virtual bool unsetEffect(const char *effect);
+	virtual bool getEffect(const char *effect, std::map<Filter::Parameter, float> &params);
+	virtual bool getActiveEffects(std::vector<std::string> &list) const;
+
+	virtual int getFreeBufferCount() const;
+	virtual bool queue(void *data, size_t length, int dataSampleRate, int dataBitDepth, int dataChannels);
+	virtual bool queueAt(void *data, size_t length, int dataSampleRate, int dataBitDepth, int dataChannels, double time);
+
+	/**
+	 * Resamples, filters and pans the next frames of this Source, and adds
+	 * them to an interleaved stereo buffer. Called by the Mixer with its lock
+	 * held.
+	 * @return False once the Source has run out of audio.
+	 **/
+	bool mixAtomic(float *out, int frames, int outputRate, const Listener &listener);
+
+	/**
+	 * Prepares the Source to start playing from its current position, or from
+	 * the start if it has finished. Called by the Mixer with its lock held.
+	 * @param startFrame The Mixer clock frame to start playing at.
+	 **/
+	void prepareAtomic(int64 startFrame);
+
+	inline int64 getStartFrameAtomic() const
+	{
+		return startFrame;
+	}
+
+	/**
+	 * Rewinds the Source after it has been stopped. Called by the Mixer with
+	 * its lock held.
+	 **/
+	void teardownAtomic();
+
+private:
+
+	// Reads the next frame of input. Returns false at the end of the data.
+	bool readFrame(float *frame, int64 &index);
+	bool decodeChunk();
+	void seekAtomic(int64 frame);
+	void primeAtomic();
+
+	// Input frames left to play, including the ones already read ahead.
+	double getPendingFramesAtomic() const;
+
+	void getGains(const Listener &listener, float *gains, float &doppler) const;
+	void filterAtomic(float *samples, int frames, int outputRate);
+
+	Mixer *mixer;
+
+	int sampleRate = 0;
+	int channels = 0;
+	int bitDepth = 0;
+
+	StrongRef<StaticDataBuffer> staticBuffer;
+	int staticOffset = 0;
+
+	StrongRef<love::sound::Decoder> decoder;
+	std::vector<float> streamChunk;
+	int streamFrames = 0;
+	int streamOffset = 0;
+	int64 streamPosition = 0;
+
+	std::queue<std::vector<float>> queuedBuffers;
+	int queueOffset = 0;
+	int64 queuePosition = 0;
+	int buffers = 0;
+
+	// Output is interpolated between the current and the next input frame.
+	// Both are read ahead of time when the Source is primed.
+	bool primed = false;
+	bool currentValid = false;
+	bool nextValid = false;
+	float current[2] = {0.0f, 0.0f};
+	float next[2] = {0.0f, 0.0f};
+	int64 currentIndex = 0;
+	int64 nextIndex = 0;
+	double fraction = 0.0;
+
+	// Mixer clock frame at which the Source starts (or started) playing.
+	int64 startFrame = 0;
+
+	std::vector<float> scratch;
+
+	float pitch = 1.0f;
+	float volume = 1.0f;
+	float position[3] = {0.0f, 0.0f, 0.0f};
+	float velocity[3] = {0.0f, 0.0f, 0.0f};
+	float direction[3] = {0.0f, 0.0f, 0.0f};
+	bool relative = false;
+	bool looping = false;
+	float minVolume = 0.0f;
+	float maxVolume = 1.0f;
+	float referenceDistance = 1.0f;
+	float rolloffFactor = 1.0f;
+	float maxDistance = FLT_MAX;
+	float absorptionFactor = 0.0f;
+
+	struct Cone
+	{
+		float innerAngle = 360.0f; // degrees
+		float outerAngle = 360.0f; // degrees
+		float outerVolume = 0.0f;
+		float outerHighGain = 1.0f;
+	} cone;
+
+	bool hasFilter = false;
+	std::map<Filter::Parameter, float> filterParams;
+
+	// One-pole lowpass filter states, per channel.
+	float lowState[2] = {0.0f, 0.0f};
+	float highState[2] = {0.0f, 0.0f};
+
+}; // Source
+
+} // software
+} // audio
+} // love
+
+#endif // LOVE_AUDIO_SOFTWARE_SOURCE_H
@@ -22,13 +22,21 @@
 #include "wrap_Audio.h"
 
 #include "openal/Audio.h"
+#include "software/Audio.h"
 #include "null/Audio.h"
 
 #include "common/runtime.h"
+#include "filesystem/Filesystem.h"
+#include "sound/SoundData.h"
+
+// libraries
+#include "libraries/xxHash/xxhash.h"
 
 // C++
 #include <iostream>
 #include <cmath>
+#include <cstdlib>
+#include <cstring>
 
 namespace love
 {
@@ -43,6 +51,45 @@ int w_getActiveSourceCount(lua_State *L)
 	return 1;
 }
 
+// Gets a key for the source cache which identifies the contents of the file
+// at the given index, or an empty string if it can't be cached.
+static std::string getSourceCacheKey(lua_State *L, int idx)
+{
+	using namespace love::filesystem;
+
+	std::string filename;
+
+	if (lua_isstring(L, idx))
+		filename = lua_tostring(L, idx);
+	else if (luax_istype(L, idx, File::type))
+		filename = luax_totype<File>(L, idx)->getFilename();
+	else if (luax_istype(L, idx, FileData::type))
+	{
+		// No cheap way to tell whether the contents changed, so hash them.
+		// Still much faster than decoding.
+		FileData *fd = luax_totype<FileData>(L, idx);
+		unsigned long long hash = XXH64(fd->getData(), fd->getSize(), 0);
+
+		char key[64];
+		snprintf(key, sizeof(key), "data:%016llx:%llu", hash, (unsigned long long) fd->getSize());
+		return std::string(key) + ":" + fd->getExtension();
+	}
+	else
+		return std::string();
+
+	auto fs = Module::getInstance<Filesystem>(Module::M_FILESYSTEM);
+	if (fs == nullptr)
+		return std::string();
+
+	Filesystem::Info info = {};
+	if (!fs->getInfo(filename.c_str(), info) || info.type != Filesystem::FILETYPE_FILE || info.modtime < 0)
+		return std::string();
+
+	char key[64];
+	snprintf(key, sizeof(key), ":%lld:%lld", (long long) info.modtime, (long long) info.size);
+	return "file:" + filename + key;
+}
+
 int w_newSource(lua_State *L)
 {
 	Source::Type stype = Source::TYPE_STREAM;
@@ -54,20 +101,41 @@ int w_newSource(lua_State *L)
 			return luax_enumerror(L, "source type", Source::getConstants(stype), stypestr);
 	}
 
+	Source *t = nullptr;
+	std::string cachekey;
+
 	if (lua_isstring(L, 1) || luax_istype(L, 1, love::filesystem::File::type) || luax_istype(L, 1, love::filesystem::FileData::type))
-		luax_convobj(L, 1, "sound", "newDecoder");
+	{
+		// Static Sources made from files are cached, so making another Source
+		// from the same file doesn't decode it again.
+		if (stype == Source::TYPE_STATIC)
+		{
+			cachekey = getSourceCacheKey(L, 1);
+			if (!cachekey.empty())
+				t = instance()->getSourceCache().get(cachekey);
+		}
 
-	if (stype == Source::TYPE_STATIC && luax_istype(L, 1, love::sound::Decoder::type))
-		luax_convobj(L, 1, "sound", "newSoundData");
+		if (t == nullptr)
+			luax_convobj(L, 1, "sound", "newDecoder");
+	}
 
-	Source *t = nullptr;
+	if (t == nullptr && stype == Source::TYPE_STATIC && luax_istype(L, 1, love::sound::Decoder::type))
+		luax_convobj(L, 1, "sound", "newSoundData");
 
-	luax_catchexcept(L, [&]() {
-		if (luax_istype(L, 1, love::sound::SoundData::type))
-			t = instance()->newSource(luax_totype<love::sound::SoundData>(L, 1));
-		else if (luax_istype(L, 1, love::sound::Decoder::type))
-			t = instance()->newSource(luax_totype<love::sound::Decoder>(L, 1));
-	});
+	if (t == nullptr)
+	{
+		luax_catchexcept(L, [&]() {
+			if (luax_istype(L, 1, love::sound::SoundData::type))
+			{
+				auto s = luax_totype<love::sound::SoundData>(L, 1);
+				t = instance()->newSource(s);
+				if (!cachekey.empty())
+					instance()->getSourceCache().add(cachekey, t, s->getSize());
+			}
+			else if (luax_istype(L, 1, love::sound::Decoder::type))
+				t = instance()->newSource(luax_totype<love::sound::Decoder>(L, 1));
+		});
+	}
 
 	if (t != nullptr)
 	{
@@ -146,6 +214,26 @@ int w_play(lua_State *L)
 	return 1;
 }
 
+int w_playAt(lua_State *L)
+{
+	double time = luaL_checknumber(L, 2);
+
+	std::vector<Source*> sources;
+	if (lua_istable(L, 1))
+		sources = readSourceList(L, 1);
+	else
+		sources.push_back(luax_checksource(L, 1));
+
+	luax_pushboolean(L, instance()->playAt(sources, time));
+	return 1;
+}
+
+int w_getClock(lua_State *L)
+{
+	lua_pushnumber(L, instance()->getClock());
+	return 1;
+}
+
 int w_stop(lua_State *L)
 {
 	if (lua_isnone(L, 1))
@@ -527,6 +615,110 @@ int w_setMixWithSystem(lua_State *L)
 	return 1;
 }
 
+int w_setSourceCacheLimit(lua_State *L)
+{
+	lua_Number bytes = luaL_checknumber(L, 1);
+	if (bytes < 0)
+		return luaL_error(L, "Source cache limit must not be negative.");
+
+	instance()->getSourceCache().setBudget((size_t) bytes);
+	return 0;
+}
+
+int w_getSourceCacheLimit(lua_State *L)
+{
+	lua_pushnumber(L, (lua_Number) instance()->getSourceCache().getBudget());
+	return 1;
+}
+
+int w_getSourceCacheSize(lua_State *L)
+{
+	lua_pushnumber(L, (lua_Number) instance()->getSourceCache().getSize());
+	return 1;
+}
+
+int w_clearSourceCache(lua_State *)
+{
+	instance()->getSourceCache().clear();
+	return 0;
+}
+
+static software::Audio *getSoftwareAudio(lua_State *L, const char *func)
+{
+	auto audio = dynamic_cast<software::Audio *>(instance());
+	if (audio == nullptr)
+		luaL_error(L, "%s is only available with the software audio backend.", func);
+	return audio;
+}
+
+int w_render(lua_State *L)
+{
+	software::Audio *audio = getSoftwareAudio(L, "love.audio.render");
+	int samples = (int) luaL_checkinteger(L, 1);
+	if (samples <= 0)
+		return luaL_error(L, "Sample count must be greater than 0.");
+
+	love::sound::SoundData *s = nullptr;
+	luax_catchexcept(L, [&](){ s = audio->render(samples); });
+
+	luax_pushtype(L, s);
+	s->release();
+	return 1;
+}
+
+static void writeLE(std::vector<char> &out, uint32 value, int bytes)
+{
+	for (int i = 0; i < bytes; i++)
+		out.push_back((char) ((value >> (i * 8)) & 0xFF));
+}
+
+int w_renderToFile(lua_State *L)
+{
+	software::Audio *audio = getSoftwareAudio(L, "love.audio.renderToFile");
+	const char *filename = luaL_checkstring(L, 1);
+	int samples = (int) luaL_checkinteger(L, 2);
+	if (samples <= 0)
+		return luaL_error(L, "Sample count must be greater than 0.");
+
+	auto fs = Module::getInstance<love::filesystem::Filesystem>(Module::M_FILESYSTEM);
+	if (fs == nullptr)
+		return luaL_error(L, "love.filesystem is not loaded.");
+
+	luax_catchexcept(L, [&]() {
+		StrongRef<love::sound::SoundData> s(audio->render(samples), Acquire::NORETAIN);
+
+		uint32 size = (uint32) s->getSize();
+		int channels = s->getChannelCount();
+		int rate = s->getSampleRate();
+		int blockalign = channels * (s->getBitDepth() / 8);
+
+		// 16-bit PCM WAVE.
+		std::vector<char> wav;
+		wav.reserve(44 + size);
+		wav.insert(wav.end(), {'R', 'I', 'F', 'F'});
+		writeLE(wav, 36 + size, 4);
+		wav.insert(wav.end(), {'W', 'A', 'V', 'E', 'f', 'm', 't', ' '});
+		writeLE(wav, 16, 4);
+		writeLE(wav, 1, 2);
+		writeLE(wav, channels, 2);
+		writeLE(wav, rate, 4);
+		writeLE(wav, rate * blockalign, 4);
+		writeLE(wav, blockalign, 2);
+		writeLE(wav, s->getBitDepth(), 2);
+		wav.insert(wav.end(), {'d', 'a', 't', 'a'});
+		writeLE(wav, size, 4);
+
+		// Samples are little-endian in WAVE files.
+		const int16 *data = (const int16 *) s->getData();
+		for (size_t i = 0; i < size / 2; i++)
+			writeLE(wav, (uint16) data[i], 2);
+
+		fs->write(filename, wav.data(), (int64) wav.size());
+	});
+
+	return 0;
+}
+
 int w_getSourceCount(lua_State *L)
 {
 	luax_markdeprecated(L, "love.audio.getSourceCount", API_FUNCTION, DEPRECATED_RENAMED, "love.audio.getActiveSourceCount");
@@ -540,6 +732,8 @@ static const luaL_Reg functions[] =
 	{ "newSource", w_newSource },
 	{ "newQueueableSource", w_newQueueableSource },
 	{ "play", w_play },
+	{ "playAt", w_playAt },
+	{ "getClock", w_getClock },
 	{ "stop", w_stop },
 	{ "pause", w_pause },
 	{ "setVolume", w_setVolume },
@@ -564,6 +758,12 @@ static const luaL_Reg functions[] =
 	{ "getMaxSourceEffects", w_getMaxSourceEffects },
 	{ "isEffectsSupported", w_isEffectsSupported },
 	{ "setMixWithSystem", w_setMixWithSystem },
+	{ "setSourceCacheLimit", w_setSourceCacheLimit },
+	{ "getSourceCacheLimit", w_getSourceCacheLimit },
+	{ "getSourceCacheSize", w_getSourceCacheSize },
+	{ "clearSourceCache", w_clearSourceCache },
+	{ "render", w_render },
+	{ "renderToFile", w_renderToFile },
 
 	// Deprecated
 	{ "getSourceCount", w_getSourceCount },
@@ -584,14 +784,32 @@ extern "C" int luaopen_love_audio(lua_State *L)
 
 	if (instance == nullptr)
 	{
-		// Try OpenAL first.
-		try
+		// The software mixer doesn't output anything, so it's only used when
+		// asked for, e.g. for automated tests or offline rendering.
+		const char *backend = getenv("LOVE_AUDIO_BACKEND");
+
+		if (backend != nullptr && strcmp(backend, "software") == 0)
 		{
-			instance = new love::audio::openal::Audio();
+			try
+			{
+				instance = new love::audio::software::Audio();
+			}
+			catch(love::Exception &e)
+			{
+				std::cout << e.what() << std::endl;
+			}
 		}
-		catch(love::Exception &e)
+		else if (backend == nullptr || strcmp(backend, "null") != 0)
 		{
-			std::cout << e.what() << std::endl;
+			// Try OpenAL first.
+			try
+			{
+				instance = new love::audio::openal::Audio();
+			}
+			catch(love::Exception &e)
+			{
+				std::cout << e.what() << std::endl;
+			}
 		}
 	}
 	else
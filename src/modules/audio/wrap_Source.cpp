@@ -53,6 +53,14 @@ int w_Source_play(lua_State *L)
 	return 1;
 }
 
+int w_Source_playAt(lua_State *L)
+{
+	Source *t = luax_checksource(L, 1);
+	double time = luaL_checknumber(L, 2);
+	luax_pushboolean(L, t->playAt(time));
+	return 1;
+}
+
 int w_Source_stop(lua_State *L)
 {
 	Source *t = luax_checksource(L, 1);
@@ -570,6 +578,21 @@ int w_Source_queue(lua_State *L)
 	return 1;
 }
 
+int w_Source_queueAt(lua_State *L)
+{
+	Source *t = luax_checksource(L, 1);
+	love::sound::SoundData *s = luax_checktype<love::sound::SoundData>(L, 2);
+	double time = luaL_checknumber(L, 3);
+
+	bool success = false;
+	luax_catchexcept(L, [&]() {
+		success = t->queueAt(s->getData(), s->getSize(), s->getSampleRate(), s->getBitDepth(), s->getChannelCount(), time);
+	});
+
+	luax_pushboolean(L, success);
+	return 1;
+}
+
 int w_Source_getType(lua_State *L)
 {
 	Source *t = luax_checksource(L, 1);
@@ -596,6 +619,7 @@ static const luaL_Reg w_Source_functions[] =
 	{ "clone", w_Source_clone },
 
 	{ "play", w_Source_play },
+	{ "playAt", w_Source_playAt },
 	{ "stop", w_Source_stop },
 	{ "pause", w_Source_pause },
 
@@ -639,6 +663,7 @@ static const luaL_Reg w_Source_functions[] =
 
 	{ "getFreeBufferCount", w_Source_getFreeBufferCount },
 	{ "queue", w_Source_queue },
+	{ "queueAt", w_Source_queueAt },
 
 	{ "getType", w_Source_getType },
 
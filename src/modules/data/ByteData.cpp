@@ -84,6 +84,38 @@ void ByteData::create()
 	}
 }
 
+ByteData *ByteData::transfer()
+{
+	if (size == 0)
+		throw love::Exception("Cannot transfer the contents of an empty ByteData.");
+
+	// DataViews (and anything else holding on to us) would be left pointing at
+	// memory we no longer own.
+	if (getReferenceCount() > 1)
+		throw love::Exception("Cannot transfer the contents of a ByteData which is referenced elsewhere (e.g. by a DataView).");
+
+	ByteData *d = new ByteData(data, size, true);
+
+	data = nullptr;
+	size = 0;
+
+	return d;
+}
+
+void ByteData::take(ByteData *other)
+{
+	if (other == this)
+		return;
+
+	delete[] data;
+
+	data = other->data;
+	size = other->size;
+
+	other->data = nullptr;
+	other->size = 0;
+}
+
 ByteData *ByteData::clone() const
 {
 	return new ByteData(*this);
@@ -41,6 +41,19 @@ public:
 	ByteData(const ByteData &d);
 	virtual ~ByteData();
 
+	/**
+	 * Creates a new ByteData which takes over this ByteData's memory without
+	 * copying it. This ByteData is left empty (with a size of 0.) Fails if
+	 * anything other than the caller holds a reference to this ByteData.
+	 **/
+	ByteData *transfer();
+
+	/**
+	 * Takes over another ByteData's memory without copying it, leaving the
+	 * other ByteData empty.
+	 **/
+	void take(ByteData *other);
+
 	// Implements Data.
 	ByteData *clone() const override;
 	void *getData() const override;
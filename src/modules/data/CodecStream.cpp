@@ -0,0 +1,127 @@
+/**
+ * Copyright (c) 2006-2018 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+// LOVE
+#include "CodecStream.h"
+
+namespace love
+{
+namespace data
+{
+
+love::Type CodecStream::type("CodecStream", &Object::type);
+
+CodecStream::CodecStream(Mode mode, EncodeFormat format, size_t linelen)
+	: mode(mode)
+	, format(format)
+	, linelen(linelen)
+{
+	reset();
+}
+
+CodecStream::~CodecStream()
+{
+}
+
+CodecStream::Mode CodecStream::getMode() const
+{
+	return mode;
+}
+
+EncodeFormat CodecStream::getFormat() const
+{
+	return format;
+}
+
+size_t CodecStream::getMaxUpdateSize(size_t srclen) const
+{
+	if (mode == MODE_DECODE)
+		return getMaxDecodedSize(format, srclen);
+
+	if (format == ENCODE_BASE64)
+		return b64_encoded_size(srclen + 2, linelen) + 1;
+
+	return getEncodedSize(format, srclen);
+}
+
+size_t CodecStream::update(const char *src, size_t srclen, char *dst)
+{
+	switch (format)
+	{
+	case ENCODE_BASE64:
+	default:
+		if (mode == MODE_ENCODE)
+			return b64_encode_update(b64Encode, src, srclen, dst);
+		else
+			return b64_decode_update(b64Decode, src, srclen, dst);
+	case ENCODE_HEX:
+		if (mode == MODE_ENCODE)
+			return encode(format, src, srclen, dst, getEncodedSize(format, srclen));
+		else
+			return hexDecodeUpdate(hexDecode, src, srclen, dst);
+	}
+}
+
+size_t CodecStream::finish(char *dst)
+{
+	size_t dstlen = 0;
+
+	if (format == ENCODE_BASE64 && mode == MODE_ENCODE)
+		dstlen = b64_encode_end(b64Encode, dst);
+	else if (format == ENCODE_HEX && mode == MODE_DECODE)
+		dstlen = hexDecodeEnd(hexDecode, dst);
+
+	// Like decode(), any base64 bits left over at the end are discarded.
+	reset();
+	return dstlen;
+}
+
+void CodecStream::reset()
+{
+	b64_encode_begin(b64Encode, linelen);
+	b64_decode_begin(b64Decode);
+	hexDecodeBegin(hexDecode);
+}
+
+bool CodecStream::getConstant(const char *in, Mode &out)
+{
+	return modes.find(in, out);
+}
+
+bool CodecStream::getConstant(Mode in, const char *&out)
+{
+	return modes.find(in, out);
+}
+
+std::vector<std::string> CodecStream::getConstants(Mode)
+{
+	return modes.getNames();
+}
+
+StringMap<CodecStream::Mode, CodecStream::MODE_MAX_ENUM>::Entry CodecStream::modeEntries[] =
+{
+	{ "encode", MODE_ENCODE },
+	{ "decode", MODE_DECODE },
+};
+
+StringMap<CodecStream::Mode, CodecStream::MODE_MAX_ENUM> CodecStream::modes(CodecStream::modeEntries, sizeof(CodecStream::modeEntries));
+
+} // data
+} // love
@@ -0,0 +1,111 @@
+/**
+ * Copyright (c) 2006-2018 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#pragma once
+
+// LOVE
+#include "common/Object.h"
+#include "common/StringMap.h"
+#include "common/b64.h"
+#include "DataModule.h"
+
+namespace love
+{
+namespace data
+{
+
+/**
+ * Encodes or decodes data which arrives in pieces. Feeding all of the pieces
+ * through update() and then calling finish() gives the same result as
+ * encode() or decode() on the whole input.
+ **/
+class CodecStream : public Object
+{
+public:
+
+	static love::Type type;
+
+	enum Mode
+	{
+		MODE_ENCODE,
+		MODE_DECODE,
+		MODE_MAX_ENUM
+	};
+
+	// The most bytes finish() can write.
+	static const size_t MAX_FINISH_SIZE = 5;
+
+	/**
+	 * @param linelen The maximum line length when encoding base64, or 0 for
+	 *        no limit.
+	 **/
+	CodecStream(Mode mode, EncodeFormat format, size_t linelen = 0);
+	virtual ~CodecStream();
+
+	Mode getMode() const;
+	EncodeFormat getFormat() const;
+
+	/**
+	 * Gets the most bytes update() can write for srclen bytes of input.
+	 **/
+	size_t getMaxUpdateSize(size_t srclen) const;
+
+	/**
+	 * Encodes or decodes the next piece of input. Input which can't be
+	 * processed until more arrives is kept by the stream.
+	 *
+	 * @param dst The buffer to write into. It must have room for at least
+	 *        getMaxUpdateSize(srclen) bytes.
+	 * @return The number of bytes written to dst.
+	 **/
+	size_t update(const char *src, size_t srclen, char *dst);
+
+	/**
+	 * Writes whatever is left over from previous pieces, and resets the
+	 * stream so it can be used for new input. dst must have room for
+	 * MAX_FINISH_SIZE bytes.
+	 *
+	 * @return The number of bytes written to dst.
+	 **/
+	size_t finish(char *dst);
+
+	static bool getConstant(const char *in, Mode &out);
+	static bool getConstant(Mode in, const char *&out);
+	static std::vector<std::string> getConstants(Mode);
+
+private:
+
+	void reset();
+
+	Mode mode;
+	EncodeFormat format;
+	size_t linelen;
+
+	B64EncodeStream b64Encode;
+	B64DecodeStream b64Decode;
+	HexDecodeStream hexDecode;
+
+	static StringMap<Mode, MODE_MAX_ENUM>::Entry modeEntries[];
+	static StringMap<Mode, MODE_MAX_ENUM> modes;
+
+}; // CodecStream
+
+} // data
+} // love
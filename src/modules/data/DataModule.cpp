@@ -29,37 +29,150 @@
 #include <list>
 #include <iostream>
 
+#if defined(LOVE_SIMD_AVX2)
+#include <immintrin.h>
+#elif defined(LOVE_SIMD_SSE2)
+#include <emmintrin.h>
+#elif defined(LOVE_SIMD_NEON)
+#include <arm_neon.h>
+#endif
+
 namespace
 {
 
 static const char hexchars[] = "0123456789abcdef";
 
-char *bytesToHex(const love::uint8 *src, size_t srclen, size_t &dstlen)
+#if defined(LOVE_SIMD_SSE2)
+
+static inline __m128i hexChars(__m128i nibbles)
 {
-	dstlen = srclen * 2;
+	__m128i chars = _mm_add_epi8(nibbles, _mm_set1_epi8('0'));
+	__m128i alpha = _mm_cmpgt_epi8(nibbles, _mm_set1_epi8(9));
+	return _mm_add_epi8(chars, _mm_and_si128(alpha, _mm_set1_epi8('a' - '0' - 10)));
+}
 
-	if (dstlen == 0)
-		return nullptr;
+// Characters outside of [0-9a-fA-F] decode to 0, the same as nibble().
+static inline __m128i hexNibbles(__m128i chars)
+{
+	__m128i digit = _mm_sub_epi8(chars, _mm_set1_epi8('0'));
+	__m128i isdigit = _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)), digit);
 
-	char *dst = nullptr;
-	try
+	__m128i alpha = _mm_sub_epi8(_mm_or_si128(chars, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+	__m128i isalpha = _mm_cmpeq_epi8(_mm_min_epu8(alpha, _mm_set1_epi8(5)), alpha);
+	alpha = _mm_add_epi8(alpha, _mm_set1_epi8(10));
+
+	return _mm_or_si128(_mm_and_si128(isdigit, digit), _mm_and_si128(isalpha, alpha));
+}
+
+// Combines pairs of nibbles (high nibble first) into 8 bytes.
+static inline __m128i hexCombine(__m128i nibbles)
+{
+	__m128i hi = _mm_slli_epi16(_mm_and_si128(nibbles, _mm_set1_epi16(0x00FF)), 4);
+	return _mm_or_si128(hi, _mm_srli_epi16(nibbles, 8));
+}
+
+#endif // LOVE_SIMD_SSE2
+
+#if defined(LOVE_SIMD_AVX2)
+
+static inline __m256i hexChars(__m256i nibbles)
+{
+	__m256i chars = _mm256_add_epi8(nibbles, _mm256_set1_epi8('0'));
+	__m256i alpha = _mm256_cmpgt_epi8(nibbles, _mm256_set1_epi8(9));
+	return _mm256_add_epi8(chars, _mm256_and_si256(alpha, _mm256_set1_epi8('a' - '0' - 10)));
+}
+
+static inline __m256i hexNibbles(__m256i chars)
+{
+	__m256i digit = _mm256_sub_epi8(chars, _mm256_set1_epi8('0'));
+	__m256i isdigit = _mm256_cmpeq_epi8(_mm256_min_epu8(digit, _mm256_set1_epi8(9)), digit);
+
+	__m256i alpha = _mm256_sub_epi8(_mm256_or_si256(chars, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+	__m256i isalpha = _mm256_cmpeq_epi8(_mm256_min_epu8(alpha, _mm256_set1_epi8(5)), alpha);
+	alpha = _mm256_add_epi8(alpha, _mm256_set1_epi8(10));
+
+	return _mm256_or_si256(_mm256_and_si256(isdigit, digit), _mm256_and_si256(isalpha, alpha));
+}
+
+static inline __m256i hexCombine(__m256i nibbles)
+{
+	__m256i hi = _mm256_slli_epi16(_mm256_and_si256(nibbles, _mm256_set1_epi16(0x00FF)), 4);
+	return _mm256_or_si256(hi, _mm256_srli_epi16(nibbles, 8));
+}
+
+#endif // LOVE_SIMD_AVX2
+
+#if defined(LOVE_SIMD_NEON)
+
+static inline uint8x16_t hexChars(uint8x16_t nibbles)
+{
+	uint8x16_t chars = vaddq_u8(nibbles, vdupq_n_u8('0'));
+	uint8x16_t alpha = vcgtq_u8(nibbles, vdupq_n_u8(9));
+	return vaddq_u8(chars, vandq_u8(alpha, vdupq_n_u8('a' - '0' - 10)));
+}
+
+static inline uint8x16_t hexNibbles(uint8x16_t chars)
+{
+	uint8x16_t digit = vsubq_u8(chars, vdupq_n_u8('0'));
+	uint8x16_t isdigit = vcleq_u8(digit, vdupq_n_u8(9));
+
+	uint8x16_t alpha = vsubq_u8(vorrq_u8(chars, vdupq_n_u8(0x20)), vdupq_n_u8('a'));
+	uint8x16_t isalpha = vcleq_u8(alpha, vdupq_n_u8(5));
+	alpha = vaddq_u8(alpha, vdupq_n_u8(10));
+
+	return vorrq_u8(vandq_u8(isdigit, digit), vandq_u8(isalpha, alpha));
+}
+
+#endif // LOVE_SIMD_NEON
+
+size_t bytesToHex(const love::uint8 *src, size_t srclen, char *dst)
+{
+	size_t i = 0;
+
+#if defined(LOVE_SIMD_AVX2)
+	for (; srclen - i >= 32; i += 32)
 	{
-		dst = new char[dstlen + 1];
+		__m256i v = _mm256_loadu_si256((const __m256i *) (src + i));
+		__m256i hi = hexChars(_mm256_and_si256(_mm256_srli_epi16(v, 4), _mm256_set1_epi8(0x0F)));
+		__m256i lo = hexChars(_mm256_and_si256(v, _mm256_set1_epi8(0x0F)));
+
+		// Unpacking works within each 128 bit lane, so the halves need to be
+		// swapped around afterwards.
+		__m256i a = _mm256_unpacklo_epi8(hi, lo);
+		__m256i b = _mm256_unpackhi_epi8(hi, lo);
+
+		_mm256_storeu_si256((__m256i *) (dst + i * 2), _mm256_permute2x128_si256(a, b, 0x20));
+		_mm256_storeu_si256((__m256i *) (dst + i * 2 + 32), _mm256_permute2x128_si256(a, b, 0x31));
 	}
-	catch (std::exception &)
+#elif defined(LOVE_SIMD_SSE2)
+	for (; srclen - i >= 16; i += 16)
 	{
-		throw love::Exception("Out of memory.");
+		__m128i v = _mm_loadu_si128((const __m128i *) (src + i));
+		__m128i hi = hexChars(_mm_and_si128(_mm_srli_epi16(v, 4), _mm_set1_epi8(0x0F)));
+		__m128i lo = hexChars(_mm_and_si128(v, _mm_set1_epi8(0x0F)));
+
+		_mm_storeu_si128((__m128i *) (dst + i * 2), _mm_unpacklo_epi8(hi, lo));
+		_mm_storeu_si128((__m128i *) (dst + i * 2 + 16), _mm_unpackhi_epi8(hi, lo));
+	}
+#elif defined(LOVE_SIMD_NEON)
+	for (; srclen - i >= 16; i += 16)
+	{
+		uint8x16_t v = vld1q_u8(src + i);
+		uint8x16x2_t out;
+		out.val[0] = hexChars(vshrq_n_u8(v, 4));
+		out.val[1] = hexChars(vandq_u8(v, vdupq_n_u8(0x0F)));
+		vst2q_u8((love::uint8 *) (dst + i * 2), out);
 	}
+#endif
 
-	for (size_t i = 0; i < srclen; i++)
+	for (; i < srclen; i++)
 	{
 		love::uint8 b = src[i];
 		dst[i * 2 + 0] = hexchars[b >> 4];
 		dst[i * 2 + 1] = hexchars[b & 0xF];
 	}
 
-	dst[dstlen] = '\0';
-	return dst;
+	return srclen * 2;
 }
 
 love::uint8 nibble(char c)
@@ -76,38 +189,63 @@ love::uint8 nibble(char c)
 	return 0;
 }
 
-love::uint8 *hexToBytes(const char *src, size_t srclen, size_t &dstlen)
+void skipHexPrefix(const char *&src, size_t &srclen)
 {
 	if (srclen >= 2 && src[0] == '0' && (src[1] == 'x' || src[1] == 'X'))
 	{
 		src += 2;
 		srclen -= 2;
 	}
+}
 
-	dstlen = (srclen + 1) / 2;
+// Decodes count pairs of hex digits, without looking for a "0x" prefix.
+void hexPairsToBytes(const char *src, size_t count, love::uint8 *dst)
+{
+	size_t i = 0;
 
-	if (dstlen == 0)
-		return nullptr;
+#if defined(LOVE_SIMD_AVX2)
+	for (; count - i >= 32; i += 32)
+	{
+		__m256i a = hexCombine(hexNibbles(_mm256_loadu_si256((const __m256i *) (src + i * 2))));
+		__m256i b = hexCombine(hexNibbles(_mm256_loadu_si256((const __m256i *) (src + i * 2 + 32))));
 
-	love::uint8 *dst = nullptr;
-	try
+		// Packing works within each 128 bit lane, so the 64 bit pieces need to
+		// be put back in order afterwards.
+		__m256i out = _mm256_permute4x64_epi64(_mm256_packus_epi16(a, b), _MM_SHUFFLE(3, 1, 2, 0));
+		_mm256_storeu_si256((__m256i *) (dst + i), out);
+	}
+#elif defined(LOVE_SIMD_SSE2)
+	for (; count - i >= 16; i += 16)
 	{
-		dst = new love::uint8[dstlen];
+		__m128i a = hexCombine(hexNibbles(_mm_loadu_si128((const __m128i *) (src + i * 2))));
+		__m128i b = hexCombine(hexNibbles(_mm_loadu_si128((const __m128i *) (src + i * 2 + 16))));
+		_mm_storeu_si128((__m128i *) (dst + i), _mm_packus_epi16(a, b));
 	}
-	catch (std::exception &)
+#elif defined(LOVE_SIMD_NEON)
+	for (; count - i >= 16; i += 16)
 	{
-		throw love::Exception("Out of memory.");
+		uint8x16x2_t in = vld2q_u8((const love::uint8 *) (src + i * 2));
+		uint8x16_t hi = hexNibbles(in.val[0]);
+		uint8x16_t lo = hexNibbles(in.val[1]);
+		vst1q_u8(dst + i, vorrq_u8(vshlq_n_u8(hi, 4), lo));
 	}
+#endif
 
-	for (size_t i = 0; i < dstlen; i++)
-	{
-		dst[i] = nibble(src[i * 2]) << 4;
+	for (; i < count; i++)
+		dst[i] = (nibble(src[i * 2]) << 4) | nibble(src[i * 2 + 1]);
+}
 
-		if (i * 2 + 1 < srclen)
-			dst[i] |= nibble(src[i * 2 + 1]);
-	}
+size_t hexToBytes(const char *src, size_t srclen, love::uint8 *dst)
+{
+	skipHexPrefix(src, srclen);
 
-	return dst;
+	hexPairsToBytes(src, srclen / 2, dst);
+
+	// A trailing digit on its own is the high half of the last byte.
+	if (srclen % 2 != 0)
+		dst[srclen / 2] = nibble(src[srclen - 1]) << 4;
+
+	return (srclen + 1) / 2;
 }
 
 } // anonymous namespace
@@ -163,30 +301,186 @@ char *decompress(Compressor::Format format, const char *cbytes, size_t compresse
 	return compressor->decompress(format, cbytes, compressedsize, rawsize);
 }
 
+size_t getEncodedSize(EncodeFormat format, size_t srclen, size_t linelen)
+{
+	switch (format)
+	{
+	case ENCODE_BASE64:
+	default:
+		return b64_encoded_size(srclen, linelen);
+	case ENCODE_HEX:
+		return srclen * 2;
+	}
+}
+
+size_t getDecodedSize(EncodeFormat format, const char *src, size_t srclen)
+{
+	switch (format)
+	{
+	case ENCODE_BASE64:
+	default:
+		return b64_decoded_size(src, srclen);
+	case ENCODE_HEX:
+		skipHexPrefix(src, srclen);
+		return (srclen + 1) / 2;
+	}
+}
+
+size_t getMaxDecodedSize(EncodeFormat format, size_t srclen)
+{
+	switch (format)
+	{
+	case ENCODE_BASE64:
+	default:
+		return b64_decoded_size_max(srclen);
+	case ENCODE_HEX:
+		return (srclen + 1) / 2;
+	}
+}
+
 char *encode(EncodeFormat format, const char *src, size_t srclen, size_t &dstlen, size_t linelen)
 {
+	dstlen = getEncodedSize(format, srclen, linelen);
+
+	if (dstlen == 0)
+		return nullptr;
+
+	char *dst = nullptr;
+	try
+	{
+		dst = new char[dstlen + 1];
+	}
+	catch (std::exception &)
+	{
+		throw love::Exception("Out of memory.");
+	}
+
+	dstlen = encode(format, src, srclen, dst, dstlen, linelen);
+	dst[dstlen] = '\0';
+
+	return dst;
+}
+
+size_t encode(EncodeFormat format, const char *src, size_t srclen, char *dst, size_t dstsize, size_t linelen)
+{
+	if (dstsize < getEncodedSize(format, srclen, linelen))
+		throw love::Exception("Destination is too small to hold the encoded data.");
+
 	switch (format)
 	{
 	case ENCODE_BASE64:
 	default:
-		return b64_encode(src, srclen, linelen, dstlen);
+		return b64_encode(src, srclen, linelen, dst);
 	case ENCODE_HEX:
-		return bytesToHex((const uint8 *) src, srclen, dstlen);
+		return bytesToHex((const uint8 *) src, srclen, dst);
 	}
 }
 
 char *decode(EncodeFormat format, const char *src, size_t srclen, size_t &dstlen)
 {
+	size_t maxlen = getMaxDecodedSize(format, srclen);
+
+	if (maxlen == 0)
+	{
+		dstlen = 0;
+		return nullptr;
+	}
+
+	char *dst = nullptr;
+	try
+	{
+		dst = new char[maxlen];
+	}
+	catch (std::exception &)
+	{
+		throw love::Exception("Out of memory.");
+	}
+
+	dstlen = decode(format, src, srclen, dst, maxlen);
+	return dst;
+}
+
+size_t decode(EncodeFormat format, const char *src, size_t srclen, char *dst, size_t dstsize)
+{
+	// Only scan the input for the exact size when the cheap bound isn't met.
+	if (dstsize < getMaxDecodedSize(format, srclen) && dstsize < getDecodedSize(format, src, srclen))
+		throw love::Exception("Destination is too small to hold the decoded data.");
+
 	switch (format)
 	{
 	case ENCODE_BASE64:
 	default:
-		return b64_decode(src, srclen, dstlen);
+		return b64_decode(src, srclen, dst);
 	case ENCODE_HEX:
-		return (char *) hexToBytes(src, srclen, dstlen);
+		return hexToBytes(src, srclen, (uint8 *) dst);
 	}
 }
 
+void hexDecodeBegin(HexDecodeStream &stream)
+{
+	stream.started = false;
+	stream.pending = 0;
+	stream.haspending = false;
+}
+
+size_t hexDecodeUpdate(HexDecodeStream &stream, const char *src, size_t srclen, char *dst)
+{
+	uint8 *d = (uint8 *) dst;
+
+	// Pair up a digit left over from the previous piece.
+	if (stream.haspending && srclen > 0)
+	{
+		bool prefix = !stream.started && stream.pending == '0' && (src[0] == 'x' || src[0] == 'X');
+
+		if (!prefix)
+			*(d++) = (nibble(stream.pending) << 4) | nibble(src[0]);
+
+		stream.started = true;
+		stream.haspending = false;
+		src++;
+		srclen--;
+	}
+
+	// The "0x" prefix can only be recognized once two digits have arrived.
+	if (!stream.started)
+	{
+		if (srclen < 2)
+		{
+			if (srclen > 0)
+			{
+				stream.pending = src[0];
+				stream.haspending = true;
+			}
+			return 0;
+		}
+
+		skipHexPrefix(src, srclen);
+		stream.started = true;
+	}
+
+	hexPairsToBytes(src, srclen / 2, d);
+	d += srclen / 2;
+
+	if (srclen % 2 != 0)
+	{
+		stream.pending = src[srclen - 1];
+		stream.haspending = true;
+	}
+
+	return (size_t) (d - (uint8 *) dst);
+}
+
+size_t hexDecodeEnd(HexDecodeStream &stream, char *dst)
+{
+	size_t dstlen = 0;
+
+	if (stream.haspending)
+		dst[dstlen++] = (char) (nibble(stream.pending) << 4);
+
+	hexDecodeBegin(stream);
+	return dstlen;
+}
+
 std::string hash(HashFunction::Function function, Data *input)
 {
 	return hash(function, (const char*) input->getData(), input->getSize());
@@ -84,9 +84,82 @@ char *decompress(CompressedData *data, size_t &decompressedsize);
  **/
 char *decompress(Compressor::Format format, const char *cbytes, size_t compressedsize, size_t &rawsize);
 
+/**
+ * Gets the size in bytes of the output of encode().
+ **/
+size_t getEncodedSize(EncodeFormat format, size_t srclen, size_t linelen = 0);
+
+/**
+ * Gets the exact size in bytes of the output of decode(). This may need to
+ * scan the whole input.
+ **/
+size_t getDecodedSize(EncodeFormat format, const char *src, size_t srclen);
+
+/**
+ * Gets an upper bound on the size in bytes of the output of decode(), based
+ * only on the length of the input.
+ **/
+size_t getMaxDecodedSize(EncodeFormat format, size_t srclen);
+
+/**
+ * Encodes a block of memory into a newly allocated string.
+ *
+ * @param[out] dstlen The length of the encoded string.
+ * @param[in] linelen The maximum line length for base64, or 0 for no limit.
+ * @return The encoded string (allocated with new[]), or null if it's empty.
+ **/
 char *encode(EncodeFormat format, const char *src, size_t srclen, size_t &dstlen, size_t linelen = 0);
+
+/**
+ * Encodes a block of memory into an existing buffer. Throws an exception if
+ * dstsize is smaller than getEncodedSize().
+ *
+ * @return The number of bytes written to dst.
+ **/
+size_t encode(EncodeFormat format, const char *src, size_t srclen, char *dst, size_t dstsize, size_t linelen = 0);
+
 char *decode(EncodeFormat format, const char *src, size_t srclen, size_t &dstlen);
 
+/**
+ * Decodes a string into an existing buffer. Throws an exception if dstsize
+ * is smaller than getDecodedSize().
+ *
+ * @return The number of bytes written to dst.
+ **/
+size_t decode(EncodeFormat format, const char *src, size_t srclen, char *dst, size_t dstsize);
+
+/**
+ * State for decoding a stream of hex data in pieces. The output is identical
+ * to decoding all of the pieces at once. Hex encoding has no state, so pieces
+ * can be passed to encode() directly.
+ **/
+struct HexDecodeStream
+{
+	bool started = false;
+	char pending = 0;
+	bool haspending = false;
+};
+
+void hexDecodeBegin(HexDecodeStream &stream);
+
+/**
+ * Decodes the next piece of a stream. A trailing digit which doesn't have a
+ * pair yet is kept in the stream state.
+ *
+ * @param dst The buffer to write into. It must have room for at least
+ *        getMaxDecodedSize(ENCODE_HEX, srclen) bytes.
+ * @return The number of bytes written to dst.
+ **/
+size_t hexDecodeUpdate(HexDecodeStream &stream, const char *src, size_t srclen, char *dst);
+
+/**
+ * Flushes a leftover digit as the high half of a byte, and resets the
+ * stream. dst must have room for 1 byte.
+ *
+ * @return The number of bytes written to dst.
+ **/
+size_t hexDecodeEnd(HexDecodeStream &stream, char *dst);
+
 /**
  * Hash the input, producing an set of bytes as output.
  *
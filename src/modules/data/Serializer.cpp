@@ -0,0 +1,330 @@
+/**
+ * Copyright (c) 2006-2018 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+#include "Serializer.h"
+#include "common/Exception.h"
+#include "common/int.h"
+
+// STL
+#include <cstring>
+#include <set>
+#include <vector>
+
+namespace love
+{
+namespace data
+{
+
+namespace
+{
+
+const char MAGIC[] = {'L', 'V', 'T', '1'};
+
+// Tables nested deeper than this can't be serialized.
+const int MAX_DEPTH = 128;
+
+enum Tag
+{
+	TAG_NIL = 0,
+	TAG_FALSE,
+	TAG_TRUE,
+	TAG_NUMBER,
+	TAG_STRING,
+	TAG_TABLE,
+};
+
+class Writer
+{
+public:
+
+	Writer(lua_State *L)
+		: L(L)
+	{
+		buffer.insert(buffer.end(), MAGIC, MAGIC + sizeof(MAGIC));
+	}
+
+	void writeValue(int idx, int depth)
+	{
+		switch (lua_type(L, idx))
+		{
+		case LUA_TNIL:
+			buffer.push_back(TAG_NIL);
+			break;
+		case LUA_TBOOLEAN:
+			buffer.push_back(lua_toboolean(L, idx) ? TAG_TRUE : TAG_FALSE);
+			break;
+		case LUA_TNUMBER:
+		{
+			double number = (double) lua_tonumber(L, idx);
+			buffer.push_back(TAG_NUMBER);
+			write(&number, sizeof(number));
+			break;
+		}
+		case LUA_TSTRING:
+		{
+			size_t len = 0;
+			const char *str = lua_tolstring(L, idx, &len);
+			buffer.push_back(TAG_STRING);
+			writeSize(len);
+			write(str, len);
+			break;
+		}
+		case LUA_TTABLE:
+			writeTable(idx, depth);
+			break;
+		default:
+			throw love::Exception("Cannot serialize values of type '%s'.", luaL_typename(L, idx));
+		}
+	}
+
+	std::vector<char> buffer;
+
+private:
+
+	void writeTable(int idx, int depth)
+	{
+		if (idx < 0)
+			idx = lua_gettop(L) + idx + 1;
+
+		const void *table = lua_topointer(L, idx);
+
+		if (depth >= MAX_DEPTH)
+			throw love::Exception("Cannot serialize tables nested more than %d levels deep.", MAX_DEPTH);
+
+		if (!tables.insert(table).second)
+			throw love::Exception("Cannot serialize recursive tables.");
+
+		luaL_checkstack(L, 3, nullptr);
+
+		// The sequence part is written without keys, which covers the common
+		// case of big arrays of numbers or records.
+		size_t arraysize = luax_objlen(L, idx);
+
+		buffer.push_back(TAG_TABLE);
+		writeSize(arraysize);
+
+		size_t hashcountpos = buffer.size();
+		writeSize(0);
+
+		for (size_t i = 1; i <= arraysize; i++)
+		{
+			lua_rawgeti(L, idx, (int) i);
+			writeValue(-1, depth + 1);
+			lua_pop(L, 1);
+		}
+
+		uint32 hashcount = 0;
+
+		lua_pushnil(L);
+		while (lua_next(L, idx))
+		{
+			if (!isArrayKey(-2, arraysize))
+			{
+				writeValue(-2, depth + 1);
+				writeValue(-1, depth + 1);
+				hashcount++;
+			}
+
+			lua_pop(L, 1);
+		}
+
+		memcpy(&buffer[hashcountpos], &hashcount, sizeof(hashcount));
+
+		tables.erase(table);
+	}
+
+	bool isArrayKey(int idx, size_t arraysize) const
+	{
+		if (lua_type(L, idx) != LUA_TNUMBER)
+			return false;
+
+		lua_Number key = lua_tonumber(L, idx);
+		return key >= 1 && key <= (lua_Number) arraysize && key == (lua_Number) (size_t) key;
+	}
+
+	void writeSize(size_t size)
+	{
+		if (size > 0xFFFFFFFF)
+			throw love::Exception("Cannot serialize strings or tables larger than 4 GB.");
+
+		uint32 size32 = (uint32) size;
+		write(&size32, sizeof(size32));
+	}
+
+	void write(const void *data, size_t size)
+	{
+		const char *bytes = (const char *) data;
+		buffer.insert(buffer.end(), bytes, bytes + size);
+	}
+
+	lua_State *L;
+	std::set<const void *> tables;
+};
+
+class Reader
+{
+public:
+
+	Reader(lua_State *L, const void *data, size_t size)
+		: L(L)
+		, pos((const char *) data)
+		, end((const char *) data + size)
+	{
+		if (size < sizeof(MAGIC) || memcmp(pos, MAGIC, sizeof(MAGIC)) != 0)
+			throw love::Exception("Could not deserialize table: data was not made by love.data.serialize.");
+
+		pos += sizeof(MAGIC);
+	}
+
+	// Pushes the next value onto the stack.
+	void readValue(int depth)
+	{
+		luaL_checkstack(L, 1, nullptr);
+
+		switch (readByte())
+		{
+		case TAG_NIL:
+			lua_pushnil(L);
+			break;
+		case TAG_FALSE:
+			lua_pushboolean(L, 0);
+			break;
+		case TAG_TRUE:
+			lua_pushboolean(L, 1);
+			break;
+		case TAG_NUMBER:
+		{
+			double number = 0.0;
+			read(&number, sizeof(number));
+			lua_pushnumber(L, (lua_Number) number);
+			break;
+		}
+		case TAG_STRING:
+		{
+			uint32 len = readSize();
+			const char *str = skip(len);
+			lua_pushlstring(L, str, len);
+			break;
+		}
+		case TAG_TABLE:
+			readTable(depth);
+			break;
+		default:
+			throw love::Exception("Could not deserialize table: invalid value type.");
+		}
+	}
+
+	bool atEnd() const
+	{
+		return pos == end;
+	}
+
+private:
+
+	void readTable(int depth)
+	{
+		if (depth >= MAX_DEPTH)
+			throw love::Exception("Could not deserialize table: tables are nested too deeply.");
+
+		uint32 arraysize = readSize();
+		uint32 hashcount = readSize();
+
+		// Every value takes at least a byte, which catches bogus sizes before
+		// we try to allocate for them.
+		if (arraysize > (size_t) (end - pos) || hashcount > (size_t) (end - pos) / 2)
+			throw love::Exception("Could not deserialize table: data is truncated.");
+
+		luaL_checkstack(L, 3, nullptr);
+		lua_createtable(L, (int) arraysize, (int) hashcount);
+
+		for (uint32 i = 1; i <= arraysize; i++)
+		{
+			readValue(depth + 1);
+			lua_rawseti(L, -2, (int) i);
+		}
+
+		for (uint32 i = 0; i < hashcount; i++)
+		{
+			readValue(depth + 1);
+			if (lua_isnil(L, -1))
+				throw love::Exception("Could not deserialize table: invalid key.");
+
+			readValue(depth + 1);
+			lua_rawset(L, -3);
+		}
+	}
+
+	uint8 readByte()
+	{
+		uint8 byte = 0;
+		read(&byte, 1);
+		return byte;
+	}
+
+	uint32 readSize()
+	{
+		uint32 size = 0;
+		read(&size, sizeof(size));
+		return size;
+	}
+
+	void read(void *dst, size_t size)
+	{
+		memcpy(dst, skip(size), size);
+	}
+
+	const char *skip(size_t size)
+	{
+		if (size > (size_t) (end - pos))
+			throw love::Exception("Could not deserialize table: data is truncated.");
+
+		const char *p = pos;
+		pos += size;
+		return p;
+	}
+
+	lua_State *L;
+	const char *pos;
+	const char *end;
+};
+
+} // anonymous namespace
+
+ByteData *serializeTable(lua_State *L, int idx)
+{
+	if (lua_type(L, idx) != LUA_TTABLE)
+		throw love::Exception("Only tables can be serialized.");
+
+	Writer writer(L);
+	writer.writeValue(idx, 0);
+
+	return new ByteData(writer.buffer.data(), writer.buffer.size());
+}
+
+void deserializeTable(lua_State *L, const void *data, size_t size)
+{
+	Reader reader(L, data, size);
+	reader.readValue(0);
+
+	if (!lua_istable(L, -1) || !reader.atEnd())
+		throw love::Exception("Could not deserialize table: data is not a single serialized table.");
+}
+
+} // data
+} // love
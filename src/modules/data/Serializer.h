@@ -0,0 +1,52 @@
+/**
+ * Copyright (c) 2006-2018 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+#pragma once
+
+// LOVE
+#include "common/runtime.h"
+#include "ByteData.h"
+
+namespace love
+{
+namespace data
+{
+
+/**
+ * Writes a Lua table into a flat buffer which can be read back into a table
+ * in any Lua state, without going through a Variant per element. Keys and
+ * values can be booleans, numbers, strings, or (non-recursive) tables.
+ *
+ * The buffer uses the native byte order, so it's meant for moving tables
+ * between threads rather than for storage.
+ *
+ * @param L The Lua state.
+ * @param idx The stack index of the table.
+ * @return A new ByteData containing the serialized table.
+ **/
+ByteData *serializeTable(lua_State *L, int idx);
+
+/**
+ * Reads a buffer made by serializeTable and pushes the table it contains onto
+ * the Lua stack.
+ **/
+void deserializeTable(lua_State *L, const void *data, size_t size);
+
+} // data
+} // love
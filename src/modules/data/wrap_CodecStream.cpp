@@ -0,0 +1,120 @@
+/**
+ * Copyright (c) 2006-2018 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+// LOVE
+#include "wrap_CodecStream.h"
+#include "wrap_Data.h"
+
+namespace love
+{
+namespace data
+{
+
+CodecStream *luax_checkcodecstream(lua_State *L, int idx)
+{
+	return luax_checktype<CodecStream>(L, idx);
+}
+
+int w_CodecStream_update(lua_State *L)
+{
+	CodecStream *t = luax_checkcodecstream(L, 1);
+
+	size_t srclen = 0;
+	const char *src = nullptr;
+
+	if (luax_istype(L, 2, Data::type))
+	{
+		Data *data = luax_totype<Data>(L, 2);
+		src = (const char *) data->getData();
+		srclen = data->getSize();
+	}
+	else
+		src = luaL_checklstring(L, 2, &srclen);
+
+	char *dst = nullptr;
+	luax_catchexcept(L, [&]() {
+		try
+		{
+			dst = new char[t->getMaxUpdateSize(srclen) + 1];
+		}
+		catch (std::exception &)
+		{
+			throw love::Exception("Out of memory.");
+		}
+	});
+
+	size_t dstlen = t->update(src, srclen, dst);
+
+	lua_pushlstring(L, dst, dstlen);
+	delete[] dst;
+	return 1;
+}
+
+int w_CodecStream_finish(lua_State *L)
+{
+	CodecStream *t = luax_checkcodecstream(L, 1);
+
+	char dst[CodecStream::MAX_FINISH_SIZE];
+	size_t dstlen = t->finish(dst);
+
+	lua_pushlstring(L, dst, dstlen);
+	return 1;
+}
+
+int w_CodecStream_getMode(lua_State *L)
+{
+	CodecStream *t = luax_checkcodecstream(L, 1);
+
+	const char *str = nullptr;
+	if (!CodecStream::getConstant(t->getMode(), str))
+		return luaL_error(L, "Unknown codec stream mode.");
+
+	lua_pushstring(L, str);
+	return 1;
+}
+
+int w_CodecStream_getFormat(lua_State *L)
+{
+	CodecStream *t = luax_checkcodecstream(L, 1);
+
+	const char *str = nullptr;
+	if (!getConstant(t->getFormat(), str))
+		return luaL_error(L, "Unknown encode format.");
+
+	lua_pushstring(L, str);
+	return 1;
+}
+
+static const luaL_Reg w_CodecStream_functions[] =
+{
+	{ "update", w_CodecStream_update },
+	{ "finish", w_CodecStream_finish },
+	{ "getMode", w_CodecStream_getMode },
+	{ "getFormat", w_CodecStream_getFormat },
+	{ 0, 0 }
+};
+
+extern "C" int luaopen_codecstream(lua_State *L)
+{
+	return luax_register_type(L, &CodecStream::type, w_CodecStream_functions, nullptr);
+}
+
+} // data
+} // love
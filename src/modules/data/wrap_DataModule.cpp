@@ -24,7 +24,9 @@
 #include "wrap_ByteData.h"
 #include "wrap_DataView.h"
 #include "wrap_CompressedData.h"
+#include "wrap_CodecStream.h"
 #include "DataModule.h"
+#include "Serializer.h"
 #include "common/b64.h"
 
 // Lua 5.3
@@ -297,6 +299,119 @@ int w_decode(lua_State *L)
 	return 1;
 }
 
+static void luax_checkdestination(lua_State *L, int idx, char *&dst, size_t &dstsize)
+{
+	ByteData *data = luax_checkbytedata(L, idx);
+	lua_Integer offset = luaL_optinteger(L, idx + 1, 0);
+
+	if (offset < 0 || (size_t) offset > data->getSize())
+		luaL_error(L, "Offset argument must be within the destination Data's size.");
+
+	dst = (char *) data->getData() + offset;
+	dstsize = data->getSize() - (size_t) offset;
+}
+
+int w_encodeInto(lua_State *L)
+{
+	const char *formatstr = luaL_checkstring(L, 1);
+	EncodeFormat format;
+	if (!getConstant(formatstr, format))
+		return luax_enumerror(L, "encode format", getConstants(format), formatstr);
+
+	size_t srclen = 0;
+	const char *src = nullptr;
+
+	if (luax_istype(L, 2, Data::type))
+	{
+		Data *data = luax_totype<Data>(L, 2);
+		src = (const char *) data->getData();
+		srclen = data->getSize();
+	}
+	else
+		src = luaL_checklstring(L, 2, &srclen);
+
+	char *dst = nullptr;
+	size_t dstsize = 0;
+	luax_checkdestination(L, 3, dst, dstsize);
+
+	size_t linelen = (size_t) luaL_optinteger(L, 5, 0);
+
+	size_t dstlen = 0;
+	luax_catchexcept(L, [&](){ dstlen = encode(format, src, srclen, dst, dstsize, linelen); });
+
+	lua_pushinteger(L, (lua_Integer) dstlen);
+	return 1;
+}
+
+int w_decodeInto(lua_State *L)
+{
+	const char *formatstr = luaL_checkstring(L, 1);
+	EncodeFormat format;
+	if (!getConstant(formatstr, format))
+		return luax_enumerror(L, "decode format", getConstants(format), formatstr);
+
+	size_t srclen = 0;
+	const char *src = nullptr;
+
+	if (luax_istype(L, 2, Data::type))
+	{
+		Data *data = luax_totype<Data>(L, 2);
+		src = (const char *) data->getData();
+		srclen = data->getSize();
+	}
+	else
+		src = luaL_checklstring(L, 2, &srclen);
+
+	char *dst = nullptr;
+	size_t dstsize = 0;
+	luax_checkdestination(L, 3, dst, dstsize);
+
+	size_t dstlen = 0;
+	luax_catchexcept(L, [&](){ dstlen = decode(format, src, srclen, dst, dstsize); });
+
+	lua_pushinteger(L, (lua_Integer) dstlen);
+	return 1;
+}
+
+int w_getEncodedSize(lua_State *L)
+{
+	const char *formatstr = luaL_checkstring(L, 1);
+	EncodeFormat format;
+	if (!getConstant(formatstr, format))
+		return luax_enumerror(L, "encode format", getConstants(format), formatstr);
+
+	lua_Integer srclen = luaL_checkinteger(L, 2);
+	if (srclen < 0)
+		return luaL_error(L, "Size argument must not be negative.");
+
+	size_t linelen = (size_t) luaL_optinteger(L, 3, 0);
+
+	lua_pushinteger(L, (lua_Integer) getEncodedSize(format, (size_t) srclen, linelen));
+	return 1;
+}
+
+int w_newCodecStream(lua_State *L)
+{
+	const char *modestr = luaL_checkstring(L, 1);
+	CodecStream::Mode mode;
+	if (!CodecStream::getConstant(modestr, mode))
+		return luax_enumerror(L, "codec stream mode", CodecStream::getConstants(mode), modestr);
+
+	const char *formatstr = luaL_checkstring(L, 2);
+	EncodeFormat format;
+	if (!getConstant(formatstr, format))
+		return luax_enumerror(L, "encode format", getConstants(format), formatstr);
+
+	size_t linelen = (size_t) luaL_optinteger(L, 3, 0);
+
+	CodecStream *stream = nullptr;
+	luax_catchexcept(L, [&]() { stream = new CodecStream(mode, format, linelen); });
+
+	luax_pushtype(L, stream);
+	stream->release();
+	return 1;
+}
+
 int w_hash(lua_State *L)
 {
 	const char *fstr = luaL_checkstring(L, 1);
@@ -363,6 +478,36 @@ int w_unpack(lua_State *L)
 	return lua53_str_unpack(L, fmt, data, datasize, 2, 3);
 }
 
+int w_serialize(lua_State *L)
+{
+	luaL_checktype(L, 1, LUA_TTABLE);
+
+	ByteData *d = nullptr;
+	luax_catchexcept(L, [&]() { d = serializeTable(L, 1); });
+
+	luax_pushtype(L, d);
+	d->release();
+	return 1;
+}
+
+int w_deserialize(lua_State *L)
+{
+	const char *data = nullptr;
+	size_t datasize = 0;
+
+	if (luax_istype(L, 1, Data::type))
+	{
+		Data *d = luax_checkdata(L, 1);
+		data = (const char *) d->getData();
+		datasize = d->getSize();
+	}
+	else
+		data = luaL_checklstring(L, 1, &datasize);
+
+	luax_catchexcept(L, [&]() { deserializeTable(L, data, datasize); });
+	return 1;
+}
+
 // List of functions to wrap.
 static const luaL_Reg functions[] =
 {
@@ -372,10 +517,16 @@ static const luaL_Reg functions[] =
 	{ "decompress", w_decompress },
 	{ "encode", w_encode },
 	{ "decode", w_decode },
+	{ "encodeInto", w_encodeInto },
+	{ "decodeInto", w_decodeInto },
+	{ "getEncodedSize", w_getEncodedSize },
+	{ "newCodecStream", w_newCodecStream },
 	{ "hash", w_hash },
 
 	{ "pack", w_pack },
 	{ "unpack", w_unpack },
+	{ "serialize", w_serialize },
+	{ "deserialize", w_deserialize },
 	{ "getPackedSize", lua53_str_packsize },
 
 	{ 0, 0 }
@@ -387,6 +538,7 @@ static const lua_CFunction types[] =
 	luaopen_bytedata,
 	luaopen_dataview,
 	luaopen_compresseddata,
+	luaopen_codecstream,
 	nullptr
 };
 
@@ -20,6 +20,9 @@
 
 #include "Event.h"
 
+// C++
+#include <algorithm>
+
 using love::thread::Mutex;
 using love::thread::Lock;
 
@@ -78,37 +81,193 @@ Message *Message::fromLua(lua_State *L, int n)
 	return new Message(name, vargs);
 }
 
+void QueuedEvent::setName(const std::string &n)
+{
+	Event::EventName id;
+	if (Event::getConstant(n.c_str(), id) && id != Event::EVENT_CUSTOM)
+	{
+		name = id;
+		customName.clear();
+	}
+	else
+	{
+		name = Event::EVENT_CUSTOM;
+		customName = n;
+	}
+}
+
+void QueuedEvent::pushName(lua_State *L) const
+{
+	const char *str = nullptr;
+	if (name == Event::EVENT_CUSTOM)
+		luax_pushstring(L, customName);
+	else if (Event::getConstant((Event::EventName) name, str))
+		lua_pushstring(L, str);
+	else
+		lua_pushnil(L);
+}
+
+void QueuedEvent::moveFrom(QueuedEvent &other)
+{
+	// Drop any arguments this event still holds from a previous use.
+	clear();
+
+	name = other.name;
+	customName.swap(other.customName);
+	argCount = other.argCount;
+
+	int inlinecount = argCount < MAX_INLINE_ARGS ? argCount : MAX_INLINE_ARGS;
+	for (int i = 0; i < inlinecount; i++)
+		args[i] = std::move(other.args[i]);
+
+	// Swapping keeps both vectors' capacity around for later reuse.
+	extraArgs.swap(other.extraArgs);
+	other.extraArgs.clear();
+
+	other.name = -1;
+	other.customName.clear();
+	other.argCount = 0;
+}
+
+void QueuedEvent::clear()
+{
+	int inlinecount = argCount < MAX_INLINE_ARGS ? argCount : MAX_INLINE_ARGS;
+	for (int i = 0; i < inlinecount; i++)
+		args[i] = Variant();
+
+	extraArgs.clear();
+
+	name = -1;
+	customName.clear();
+	argCount = 0;
+}
+
+Event::Event()
+	: queue(INITIAL_QUEUE_SIZE)
+	, queueHead(0)
+	, queueCount(0)
+{
+}
+
 Event::~Event()
 {
 }
 
 void Event::push(Message *msg)
 {
-	Lock lock(mutex);
-	msg->retain();
-	queue.push(msg);
+	QueuedEvent e;
+	e.setName(msg->getName());
+
+	for (const Variant &v : msg->getArgs())
+		e.addArg(v);
+
+	push(e);
 }
 
-bool Event::poll(Message *&msg)
+void Event::push(QueuedEvent &e)
 {
 	Lock lock(mutex);
-	if (queue.empty())
-		return false;
-	msg = queue.front();
-	queue.pop();
-	return true;
+
+	if (queueCount == queue.size())
+		growQueue();
+
+	queue[(queueHead + queueCount) % queue.size()].moveFrom(e);
+	queueCount++;
 }
 
-void Event::clear()
+int Event::poll(QueuedEvent *events, int max)
 {
 	Lock lock(mutex);
-	while (!queue.empty())
+
+	int count = (int) std::min(queueCount, (size_t) std::max(max, 0));
+
+	for (int i = 0; i < count; i++)
 	{
-		// std::queue::pop will remove the first (front) element.
-		queue.front()->release();
-		queue.pop();
+		events[i].moveFrom(queue[queueHead]);
+		queueHead = (queueHead + 1) % queue.size();
 	}
+
+	queueCount -= count;
+	return count;
+}
+
+void Event::clear()
+{
+	Lock lock(mutex);
+
+	for (size_t i = 0; i < queueCount; i++)
+		queue[(queueHead + i) % queue.size()].clear();
+
+	queueHead = 0;
+	queueCount = 0;
 }
 
+int Event::toLua(lua_State *L, const QueuedEvent &e)
+{
+	e.pushName(L);
+
+	for (int i = 0; i < e.argCount; i++)
+		e.getArg(i).toLua(L);
+
+	return e.argCount + 1;
+}
+
+void Event::growQueue()
+{
+	// Only called from push, with the mutex locked.
+	std::vector<QueuedEvent> newqueue(queue.size() * 2);
+
+	for (size_t i = 0; i < queueCount; i++)
+		newqueue[i].moveFrom(queue[(queueHead + i) % queue.size()]);
+
+	queue.swap(newqueue);
+	queueHead = 0;
+}
+
+bool Event::getConstant(const char *in, EventName &out)
+{
+	return events.find(in, out);
+}
+
+bool Event::getConstant(EventName in, const char *&out)
+{
+	return events.find(in, out);
+}
+
+StringMap<Event::EventName, Event::EVENT_MAX_ENUM>::Entry Event::eventEntries[] =
+{
+	{"keypressed", EVENT_KEYPRESSED},
+	{"keyreleased", EVENT_KEYRELEASED},
+	{"textinput", EVENT_TEXTINPUT},
+	{"textedited", EVENT_TEXTEDITED},
+	{"mousemoved", EVENT_MOUSEMOVED},
+	{"mousepressed", EVENT_MOUSEPRESSED},
+	{"mousereleased", EVENT_MOUSERELEASED},
+	{"wheelmoved", EVENT_WHEELMOVED},
+	{"touchpressed", EVENT_TOUCHPRESSED},
+	{"touchreleased", EVENT_TOUCHRELEASED},
+	{"touchmoved", EVENT_TOUCHMOVED},
+	{"joystickpressed", EVENT_JOYSTICKPRESSED},
+	{"joystickreleased", EVENT_JOYSTICKRELEASED},
+	{"joystickaxis", EVENT_JOYSTICKAXIS},
+	{"joystickhat", EVENT_JOYSTICKHAT},
+	{"gamepadpressed", EVENT_GAMEPADPRESSED},
+	{"gamepadreleased", EVENT_GAMEPADRELEASED},
+	{"gamepadaxis", EVENT_GAMEPADAXIS},
+	{"joystickadded", EVENT_JOYSTICKADDED},
+	{"joystickremoved", EVENT_JOYSTICKREMOVED},
+	{"focus", EVENT_FOCUS},
+	{"mousefocus", EVENT_MOUSEFOCUS},
+	{"visible", EVENT_VISIBLE},
+	{"resize", EVENT_RESIZE},
+	{"directorydropped", EVENT_DIRECTORYDROPPED},
+	{"filedropped", EVENT_FILEDROPPED},
+	{"quit", EVENT_QUIT},
+	{"lowmemory", EVENT_LOWMEMORY},
+	{"threaderror", EVENT_THREADERROR},
+};
+
+StringMap<Event::EventName, Event::EVENT_MAX_ENUM> Event::events(Event::eventEntries, sizeof(Event::eventEntries));
+
 } // event
 } // love
@@ -31,8 +31,9 @@
 #include "thread/threads.h"
 
 // C++
-#include <queue>
 #include <vector>
+#include <string>
+#include <utility>
 
 namespace love
 {
@@ -49,6 +50,9 @@ public:
 	int toLua(lua_State *L);
 	static Message *fromLua(lua_State *L, int n);
 
+	const std::string &getName() const { return name; }
+	const std::vector<Variant> &getArgs() const { return args; }
+
 private:
 
 	std::string name;
@@ -56,24 +60,140 @@ private:
 
 }; // Message
 
+/**
+ * A single event as stored in the event queue. LOVE's own events are named by
+ * their Event::EventName and the first MAX_INLINE_ARGS arguments are stored
+ * inline, so queueing a typical input event doesn't allocate anything.
+ **/
+struct QueuedEvent
+{
+	static const int MAX_INLINE_ARGS = 6;
+
+	int name = -1;
+
+	// The name of an Event::EVENT_CUSTOM event.
+	std::string customName;
+
+	int argCount = 0;
+	Variant args[MAX_INLINE_ARGS];
+	std::vector<Variant> extraArgs;
+
+	template <typename... T>
+	void addArg(T&&... v)
+	{
+		if (argCount < MAX_INLINE_ARGS)
+			args[argCount] = Variant(std::forward<T>(v)...);
+		else
+			extraArgs.emplace_back(std::forward<T>(v)...);
+		argCount++;
+	}
+
+	const Variant &getArg(int i) const
+	{
+		return i < MAX_INLINE_ARGS ? args[i] : extraArgs[i - MAX_INLINE_ARGS];
+	}
+
+	void setName(const std::string &n);
+	void pushName(lua_State *L) const;
+
+	// Leaves 'other' empty.
+	void moveFrom(QueuedEvent &other);
+	void clear();
+
+}; // QueuedEvent
+
 class Event : public Module
 {
 public:
+
+	// The events LOVE generates itself. Any other name pushed by the user is
+	// EVENT_CUSTOM, with the name kept as a string in the event.
+	enum EventName
+	{
+		EVENT_KEYPRESSED,
+		EVENT_KEYRELEASED,
+		EVENT_TEXTINPUT,
+		EVENT_TEXTEDITED,
+		EVENT_MOUSEMOVED,
+		EVENT_MOUSEPRESSED,
+		EVENT_MOUSERELEASED,
+		EVENT_WHEELMOVED,
+		EVENT_TOUCHPRESSED,
+		EVENT_TOUCHRELEASED,
+		EVENT_TOUCHMOVED,
+		EVENT_JOYSTICKPRESSED,
+		EVENT_JOYSTICKRELEASED,
+		EVENT_JOYSTICKAXIS,
+		EVENT_JOYSTICKHAT,
+		EVENT_GAMEPADPRESSED,
+		EVENT_GAMEPADRELEASED,
+		EVENT_GAMEPADAXIS,
+		EVENT_JOYSTICKADDED,
+		EVENT_JOYSTICKREMOVED,
+		EVENT_FOCUS,
+		EVENT_MOUSEFOCUS,
+		EVENT_VISIBLE,
+		EVENT_RESIZE,
+		EVENT_DIRECTORYDROPPED,
+		EVENT_FILEDROPPED,
+		EVENT_QUIT,
+		EVENT_LOWMEMORY,
+		EVENT_THREADERROR,
+		EVENT_CUSTOM,
+		EVENT_MAX_ENUM
+	};
+
+	Event();
 	virtual ~Event();
 
 	// Implements Module.
 	virtual ModuleType getModuleType() const { return M_EVENT; }
 
 	void push(Message *msg);
-	bool poll(Message *&msg);
+
+	/**
+	 * Moves the event into the queue, leaving 'e' empty.
+	 **/
+	void push(QueuedEvent &e);
+
+	/**
+	 * Moves up to 'max' events from the front of the queue into 'events'.
+	 * @return The number of events retrieved.
+	 **/
+	int poll(QueuedEvent *events, int max);
+
 	virtual void clear();
 
 	virtual void pump() = 0;
-	virtual Message *wait() = 0;
+	virtual bool wait(QueuedEvent &e) = 0;
+
+	/**
+	 * Pushes the event's name and arguments onto the Lua stack.
+	 * @return The number of values pushed.
+	 **/
+	int toLua(lua_State *L, const QueuedEvent &e);
+
+	static bool getConstant(const char *in, EventName &out);
+	static bool getConstant(EventName in, const char *&out);
 
 protected:
+
 	love::thread::MutexRef mutex;
-	std::queue<Message *> queue;
+
+private:
+
+	static const size_t INITIAL_QUEUE_SIZE = 256;
+
+	void growQueue();
+
+	// Ring buffer of preallocated events. The slots are reused, so their
+	// overflow argument storage stays allocated between frames as well.
+	std::vector<QueuedEvent> queue;
+	size_t queueHead;
+	size_t queueCount;
+
+	static StringMap<EventName, EVENT_MAX_ENUM>::Entry eventEntries[];
+	static StringMap<EventName, EVENT_MAX_ENUM> events;
 
 }; // Event
 
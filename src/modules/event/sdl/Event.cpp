@@ -119,28 +119,25 @@ void Event::pump()
 	exceptionIfInRenderPass("love.event.pump");
 
 	SDL_Event e;
+	QueuedEvent qe;
 
 	while (SDL_PollEvent(&e))
 	{
-		Message *msg = convert(e);
-		if (msg)
-		{
-			push(msg);
-			msg->release();
-		}
+		if (convert(e, qe))
+			push(qe);
 	}
 }
 
-Message *Event::wait()
+bool Event::wait(QueuedEvent &qe)
 {
 	exceptionIfInRenderPass("love.event.wait");
 
 	SDL_Event e;
 
 	if (SDL_WaitEvent(&e) != 1)
-		return nullptr;
+		return false;
 
-	return convert(e);
+	return convert(e, qe);
 }
 
 void Event::clear()
@@ -168,12 +165,9 @@ void Event::exceptionIfInRenderPass(const char *name)
 		throw love::Exception("%s cannot be called while a Canvas is active in love.graphics.", name);
 }
 
-Message *Event::convert(const SDL_Event &e)
+bool Event::convert(const SDL_Event &e, QueuedEvent &out)
 {
-	Message *msg = nullptr;
-
-	std::vector<Variant> vargs;
-	vargs.reserve(4);
+	out.clear();
 
 	love::filesystem::Filesystem *filesystem = nullptr;
 
@@ -214,10 +208,10 @@ Message *Event::convert(const SDL_Event &e)
 		if (!love::keyboard::Keyboard::getConstant(scancode, txt2))
 			txt2 = "unknown";
 
-		vargs.emplace_back(txt, strlen(txt));
-		vargs.emplace_back(txt2, strlen(txt2));
-		vargs.emplace_back(e.key.repeat != 0);
-		msg = new Message("keypressed", vargs);
+		out.addArg(txt, strlen(txt));
+		out.addArg(txt2, strlen(txt2));
+		out.addArg(e.key.repeat != 0);
+		out.name = EVENT_KEYPRESSED;
 		break;
 	case SDL_KEYUP:
 		keyit = keys.find(e.key.keysym.sym);
@@ -231,21 +225,21 @@ Message *Event::convert(const SDL_Event &e)
 		if (!love::keyboard::Keyboard::getConstant(scancode, txt2))
 			txt2 = "unknown";
 
-		vargs.emplace_back(txt, strlen(txt));
-		vargs.emplace_back(txt2, strlen(txt2));
-		msg = new Message("keyreleased", vargs);
+		out.addArg(txt, strlen(txt));
+		out.addArg(txt2, strlen(txt2));
+		out.name = EVENT_KEYRELEASED;
 		break;
 	case SDL_TEXTINPUT:
 		txt = e.text.text;
-		vargs.emplace_back(txt, strlen(txt));
-		msg = new Message("textinput", vargs);
+		out.addArg(txt, strlen(txt));
+		out.name = EVENT_TEXTINPUT;
 		break;
 	case SDL_TEXTEDITING:
 		txt = e.edit.text;
-		vargs.emplace_back(txt, strlen(txt));
-		vargs.emplace_back((double) e.edit.start);
-		vargs.emplace_back((double) e.edit.length);
-		msg = new Message("textedited", vargs);
+		out.addArg(txt, strlen(txt));
+		out.addArg((double) e.edit.start);
+		out.addArg((double) e.edit.length);
+		out.name = EVENT_TEXTEDITED;
 		break;
 	case SDL_MOUSEMOTION:
 		{
@@ -255,12 +249,12 @@ Message *Event::convert(const SDL_Event &e)
 			double yrel = (double) e.motion.yrel;
 			windowToDPICoords(&x, &y);
 			windowToDPICoords(&xrel, &yrel);
-			vargs.emplace_back(x);
-			vargs.emplace_back(y);
-			vargs.emplace_back(xrel);
-			vargs.emplace_back(yrel);
-			vargs.emplace_back(e.motion.which == SDL_TOUCH_MOUSEID);
-			msg = new Message("mousemoved", vargs);
+			out.addArg(x);
+			out.addArg(y);
+			out.addArg(xrel);
+			out.addArg(yrel);
+			out.addArg(e.motion.which == SDL_TOUCH_MOUSEID);
+			out.name = EVENT_MOUSEMOVED;
 		}
 		break;
 	case SDL_MOUSEBUTTONDOWN:
@@ -281,20 +275,20 @@ Message *Event::convert(const SDL_Event &e)
 			double px = (double) e.button.x;
 			double py = (double) e.button.y;
 			windowToDPICoords(&px, &py);
-			vargs.emplace_back(px);
-			vargs.emplace_back(py);
-			vargs.emplace_back((double) button);
-			vargs.emplace_back(e.button.which == SDL_TOUCH_MOUSEID);
-			vargs.emplace_back((double) e.button.clicks);
+			out.addArg(px);
+			out.addArg(py);
+			out.addArg((double) button);
+			out.addArg(e.button.which == SDL_TOUCH_MOUSEID);
+			out.addArg((double) e.button.clicks);
 
 			bool down = e.type == SDL_MOUSEBUTTONDOWN;
-			msg = new Message(down ? "mousepressed" : "mousereleased", vargs);
+			out.name = down ? EVENT_MOUSEPRESSED : EVENT_MOUSERELEASED;
 		}
 		break;
 	case SDL_MOUSEWHEEL:
-		vargs.emplace_back((double) e.wheel.x);
-		vargs.emplace_back((double) e.wheel.y);
-		msg = new Message("wheelmoved", vargs);
+		out.addArg((double) e.wheel.x);
+		out.addArg((double) e.wheel.y);
+		out.name = EVENT_WHEELMOVED;
 		break;
 	case SDL_FINGERDOWN:
 	case SDL_FINGERUP:
@@ -338,20 +332,19 @@ Message *Event::convert(const SDL_Event &e)
 		// bits as can fit in a pointer (for now.)
 		// We use lightuserdata instead of a lua_Number (double) because doubles
 		// can't represent all possible id values on 64-bit systems.
-		vargs.emplace_back((void *) (intptr_t) touchinfo.id);
-		vargs.emplace_back(touchinfo.x);
-		vargs.emplace_back(touchinfo.y);
-		vargs.emplace_back(touchinfo.dx);
-		vargs.emplace_back(touchinfo.dy);
-		vargs.emplace_back(touchinfo.pressure);
+		out.addArg((void *) (intptr_t) touchinfo.id);
+		out.addArg(touchinfo.x);
+		out.addArg(touchinfo.y);
+		out.addArg(touchinfo.dx);
+		out.addArg(touchinfo.dy);
+		out.addArg(touchinfo.pressure);
 
 		if (e.type == SDL_FINGERDOWN)
-			txt = "touchpressed";
+			out.name = EVENT_TOUCHPRESSED;
 		else if (e.type == SDL_FINGERUP)
-			txt = "touchreleased";
+			out.name = EVENT_TOUCHRELEASED;
 		else
-			txt = "touchmoved";
-		msg = new Message(txt, vargs);
+			out.name = EVENT_TOUCHMOVED;
 #endif
 		break;
 	case SDL_JOYBUTTONDOWN:
@@ -364,10 +357,10 @@ Message *Event::convert(const SDL_Event &e)
 	case SDL_CONTROLLERBUTTONDOWN:
 	case SDL_CONTROLLERBUTTONUP:
 	case SDL_CONTROLLERAXISMOTION:
-		msg = convertJoystickEvent(e);
+		convertJoystickEvent(e, out);
 		break;
 	case SDL_WINDOWEVENT:
-		msg = convertWindowEvent(e);
+		convertWindowEvent(e, out);
 		break;
 	case SDL_DROPFILE:
 		filesystem = Module::getInstance<filesystem::Filesystem>(Module::M_FILESYSTEM);
@@ -378,14 +371,14 @@ Message *Event::convert(const SDL_Event &e)
 
 			if (filesystem->isRealDirectory(e.drop.file))
 			{
-				vargs.emplace_back(e.drop.file, strlen(e.drop.file));
-				msg = new Message("directorydropped", vargs);
+				out.addArg(e.drop.file, strlen(e.drop.file));
+				out.name = EVENT_DIRECTORYDROPPED;
 			}
 			else
 			{
 				auto *file = new love::filesystem::DroppedFile(e.drop.file);
-				vargs.emplace_back(&love::filesystem::DroppedFile::type, file);
-				msg = new Message("filedropped", vargs);
+				out.addArg(&love::filesystem::DroppedFile::type, file);
+				out.name = EVENT_FILEDROPPED;
 				file->release();
 			}
 		}
@@ -393,28 +386,25 @@ Message *Event::convert(const SDL_Event &e)
 		break;
 	case SDL_QUIT:
 	case SDL_APP_TERMINATING:
-		msg = new Message("quit");
+		out.name = EVENT_QUIT;
 		break;
 	case SDL_APP_LOWMEMORY:
-		msg = new Message("lowmemory");
+		out.name = EVENT_LOWMEMORY;
 		break;
 	default:
 		break;
 	}
 
-	return msg;
+	return out.name >= 0;
 }
 
-Message *Event::convertJoystickEvent(const SDL_Event &e) const
+bool Event::convertJoystickEvent(const SDL_Event &e, QueuedEvent &out) const
 {
 	auto joymodule = Module::getInstance<joystick::JoystickModule>(Module::M_JOYSTICK);
 	if (!joymodule)
-		return nullptr;
+		return false;
 
-	Message *msg = nullptr;
-
-	std::vector<Variant> vargs;
-	vargs.reserve(4);
+	out.clear();
 
 	love::Type *joysticktype = &love::joystick::Joystick::type;
 	love::joystick::Joystick *stick = nullptr;
@@ -431,11 +421,10 @@ Message *Event::convertJoystickEvent(const SDL_Event &e) const
 		if (!stick)
 			break;
 
-		vargs.emplace_back(joysticktype, stick);
-		vargs.emplace_back((double)(e.jbutton.button+1));
-		msg = new Message((e.type == SDL_JOYBUTTONDOWN) ?
-						  "joystickpressed" : "joystickreleased",
-						  vargs);
+		out.addArg(joysticktype, stick);
+		out.addArg((double)(e.jbutton.button+1));
+		out.name = (e.type == SDL_JOYBUTTONDOWN) ?
+				   EVENT_JOYSTICKPRESSED : EVENT_JOYSTICKRELEASED;
 		break;
 	case SDL_JOYAXISMOTION:
 		{
@@ -443,11 +432,11 @@ Message *Event::convertJoystickEvent(const SDL_Event &e) const
 			if (!stick)
 				break;
 
-			vargs.emplace_back(joysticktype, stick);
-			vargs.emplace_back((double)(e.jaxis.axis+1));
+			out.addArg(joysticktype, stick);
+			out.addArg((double)(e.jaxis.axis+1));
 			float value = joystick::Joystick::clampval(e.jaxis.value / 32768.0f);
-			vargs.emplace_back((double) value);
-			msg = new Message("joystickaxis", vargs);
+			out.addArg((double) value);
+			out.name = EVENT_JOYSTICKAXIS;
 		}
 		break;
 	case SDL_JOYHATMOTION:
@@ -458,10 +447,10 @@ Message *Event::convertJoystickEvent(const SDL_Event &e) const
 		if (!stick)
 			break;
 
-		vargs.emplace_back(joysticktype, stick);
-		vargs.emplace_back((double)(e.jhat.hat+1));
-		vargs.emplace_back(txt, strlen(txt));
-		msg = new Message("joystickhat", vargs);
+		out.addArg(joysticktype, stick);
+		out.addArg((double)(e.jhat.hat+1));
+		out.addArg(txt, strlen(txt));
+		out.name = EVENT_JOYSTICKHAT;
 		break;
 	case SDL_CONTROLLERBUTTONDOWN:
 	case SDL_CONTROLLERBUTTONUP:
@@ -475,10 +464,10 @@ Message *Event::convertJoystickEvent(const SDL_Event &e) const
 		if (!stick)
 			break;
 
-		vargs.emplace_back(joysticktype, stick);
-		vargs.emplace_back(txt, strlen(txt));
-		msg = new Message(e.type == SDL_CONTROLLERBUTTONDOWN ?
-						  "gamepadpressed" : "gamepadreleased", vargs);
+		out.addArg(joysticktype, stick);
+		out.addArg(txt, strlen(txt));
+		out.name = e.type == SDL_CONTROLLERBUTTONDOWN ?
+				   EVENT_GAMEPADPRESSED : EVENT_GAMEPADRELEASED;
 		break;
 	case SDL_CONTROLLERAXISMOTION:
 		if (joystick::sdl::Joystick::getConstant((SDL_GameControllerAxis) e.caxis.axis, padaxis))
@@ -490,11 +479,11 @@ Message *Event::convertJoystickEvent(const SDL_Event &e) const
 			if (!stick)
 				break;
 
-			vargs.emplace_back(joysticktype, stick);
-			vargs.emplace_back(txt, strlen(txt));
+			out.addArg(joysticktype, stick);
+			out.addArg(txt, strlen(txt));
 			float value = joystick::Joystick::clampval(e.caxis.value / 32768.0f);
-			vargs.emplace_back((double) value);
-			msg = new Message("gamepadaxis", vargs);
+			out.addArg((double) value);
+			out.name = EVENT_GAMEPADAXIS;
 		}
 		break;
 	case SDL_JOYDEVICEADDED:
@@ -502,8 +491,8 @@ Message *Event::convertJoystickEvent(const SDL_Event &e) const
 		stick = joymodule->addJoystick(e.jdevice.which);
 		if (stick)
 		{
-			vargs.emplace_back(joysticktype, stick);
-			msg = new Message("joystickadded", vargs);
+			out.addArg(joysticktype, stick);
+			out.name = EVENT_JOYSTICKADDED;
 		}
 		break;
 	case SDL_JOYDEVICEREMOVED:
@@ -512,46 +501,43 @@ Message *Event::convertJoystickEvent(const SDL_Event &e) const
 		if (stick)
 		{
 			joymodule->removeJoystick(stick);
-			vargs.emplace_back(joysticktype, stick);
-			msg = new Message("joystickremoved", vargs);
+			out.addArg(joysticktype, stick);
+			out.name = EVENT_JOYSTICKREMOVED;
 		}
 		break;
 	default:
 		break;
 	}
 
-	return msg;
+	return out.name >= 0;
 }
 
-Message *Event::convertWindowEvent(const SDL_Event &e)
+bool Event::convertWindowEvent(const SDL_Event &e, QueuedEvent &out)
 {
-	Message *msg = nullptr;
-
-	std::vector<Variant> vargs;
-	vargs.reserve(4);
+	out.clear();
 
 	window::Window *win = nullptr;
 	graphics::Graphics *gfx = nullptr;
 
 	if (e.type != SDL_WINDOWEVENT)
-		return nullptr;
+		return false;
 
 	switch (e.window.event)
 	{
 	case SDL_WINDOWEVENT_FOCUS_GAINED:
 	case SDL_WINDOWEVENT_FOCUS_LOST:
-		vargs.emplace_back(e.window.event == SDL_WINDOWEVENT_FOCUS_GAINED);
-		msg = new Message("focus", vargs);
+		out.addArg(e.window.event == SDL_WINDOWEVENT_FOCUS_GAINED);
+		out.name = EVENT_FOCUS;
 		break;
 	case SDL_WINDOWEVENT_ENTER:
 	case SDL_WINDOWEVENT_LEAVE:
-		vargs.emplace_back(e.window.event == SDL_WINDOWEVENT_ENTER);
-		msg = new Message("mousefocus", vargs);
+		out.addArg(e.window.event == SDL_WINDOWEVENT_ENTER);
+		out.name = EVENT_MOUSEFOCUS;
 		break;
 	case SDL_WINDOWEVENT_SHOWN:
 	case SDL_WINDOWEVENT_HIDDEN:
-		vargs.emplace_back(e.window.event == SDL_WINDOWEVENT_SHOWN);
-		msg = new Message("visible", vargs);
+		out.addArg(e.window.event == SDL_WINDOWEVENT_SHOWN);
+		out.name = EVENT_VISIBLE;
 		break;
 	case SDL_WINDOWEVENT_RESIZED:
 		{
@@ -576,9 +562,9 @@ Message *Event::convertWindowEvent(const SDL_Event &e)
 				windowToDPICoords(&width, &height);
 			}
 
-			vargs.emplace_back(width);
-			vargs.emplace_back(height);
-			msg = new Message("resize", vargs);
+			out.addArg(width);
+			out.addArg(height);
+			out.name = EVENT_RESIZE;
 		}
 		break;
 	case SDL_WINDOWEVENT_SIZE_CHANGED:
@@ -611,7 +597,7 @@ Message *Event::convertWindowEvent(const SDL_Event &e)
 		break;
 	}
 
-	return msg;
+	return out.name >= 0;
 }
 
 std::map<SDL_Keycode, love::keyboard::Keyboard::Key> Event::createKeyMap()
@@ -60,7 +60,7 @@ public:
 	 * the screen and game state only needs updating when the user interacts with
 	 * the window.
 	 **/
-	Message *wait();
+	bool wait(QueuedEvent &qe);
 
 	/**
 	 * Clears the event queue.
@@ -71,9 +71,9 @@ private:
 
 	void exceptionIfInRenderPass(const char *name);
 
-	Message *convert(const SDL_Event &e);
-	Message *convertJoystickEvent(const SDL_Event &e) const;
-	Message *convertWindowEvent(const SDL_Event &e);
+	bool convert(const SDL_Event &e, QueuedEvent &out);
+	bool convertJoystickEvent(const SDL_Event &e, QueuedEvent &out) const;
+	bool convertWindowEvent(const SDL_Event &e, QueuedEvent &out);
 
 	static std::map<SDL_Keycode, love::keyboard::Keyboard::Key> createKeyMap();
 	static std::map<SDL_Keycode, love::keyboard::Keyboard::Key> keys;
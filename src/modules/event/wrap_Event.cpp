@@ -37,16 +37,15 @@ namespace event
 
 #define instance() (Module::getInstance<Event>(Module::M_EVENT))
 
+// Number of events moved out of the queue per lock in pollAll.
+static const int POLL_BATCH_SIZE = 32;
+
 static int w_poll_i(lua_State *L)
 {
-	Message *m = nullptr;
+	QueuedEvent e;
 
-	if (instance()->poll(m))
-	{
-		int args = m->toLua(L);
-		m->release();
-		return args;
-	}
+	if (instance()->poll(&e, 1) > 0)
+		return instance()->toLua(L, e);
 
 	// No pending events.
 	return 0;
@@ -58,17 +57,87 @@ int w_pump(lua_State *L)
 	return 0;
 }
 
-int w_wait(lua_State *L)
+int w_pollAll(lua_State *L)
 {
-	Message *m = nullptr;
-	luax_catchexcept(L, [&]() { m = instance()->wait(); });
-	if (m)
+	// Reuse the given table (and the event tables inside it) if there is one,
+	// so polling every frame doesn't have to create garbage.
+	if (lua_istable(L, 1))
+		lua_settop(L, 1);
+	else
+	{
+		lua_settop(L, 0);
+		lua_createtable(L, POLL_BATCH_SIZE, 0);
+	}
+
+	Event *ev = instance();
+	QueuedEvent events[POLL_BATCH_SIZE];
+	int total = 0;
+
+	while (true)
 	{
-		int args = m->toLua(L);
-		m->release();
-		return args;
+		int count = ev->poll(events, POLL_BATCH_SIZE);
+
+		for (int i = 0; i < count; i++)
+		{
+			const QueuedEvent &e = events[i];
+			int index = total + i + 1;
+
+			lua_rawgeti(L, 1, index);
+			if (!lua_istable(L, -1))
+			{
+				lua_pop(L, 1);
+				lua_createtable(L, e.argCount + 1, 0);
+				lua_pushvalue(L, -1);
+				lua_rawseti(L, 1, index);
+			}
+
+			int oldlength = (int) luax_objlen(L, -1);
+
+			e.pushName(L);
+			lua_rawseti(L, -2, 1);
+
+			for (int j = 0; j < e.argCount; j++)
+			{
+				e.getArg(j).toLua(L);
+				lua_rawseti(L, -2, j + 2);
+			}
+
+			for (int j = e.argCount + 2; j <= oldlength; j++)
+			{
+				lua_pushnil(L);
+				lua_rawseti(L, -2, j);
+			}
+
+			lua_pop(L, 1);
+		}
+
+		total += count;
+
+		if (count < POLL_BATCH_SIZE)
+			break;
 	}
 
+	// Events left over from a previous, larger batch are cleared so ipairs
+	// and the # operator only see the new ones.
+	int oldcount = (int) luax_objlen(L, 1);
+	for (int i = total + 1; i <= oldcount; i++)
+	{
+		lua_pushnil(L);
+		lua_rawseti(L, 1, i);
+	}
+
+	lua_pushinteger(L, total);
+	return 2;
+}
+
+int w_wait(lua_State *L)
+{
+	QueuedEvent e;
+	bool success = false;
+	luax_catchexcept(L, [&]() { success = instance()->wait(e); });
+	if (success)
+		return instance()->toLua(L, e);
+
 	return 0;
 }
 
@@ -95,10 +164,11 @@ int w_clear(lua_State *L)
 int w_quit(lua_State *L)
 {
 	luax_catchexcept(L, [&]() {
-		std::vector<Variant> args = {Variant::fromLua(L, 1)};
+		QueuedEvent e;
+		e.name = Event::EVENT_QUIT;
+		e.addArg(Variant::fromLua(L, 1));
 
-		StrongRef<Message> m(new Message("quit", args), Acquire::NORETAIN);
-		instance()->push(m);
+		instance()->push(e);
 	});
 
 	luax_pushboolean(L, true);
@@ -110,6 +180,7 @@ static const luaL_Reg functions[] =
 {
 	{ "pump", w_pump },
 	{ "poll_i", w_poll_i },
+	{ "pollAll", w_pollAll },
 	{ "wait", w_wait },
 	{ "push", w_push },
 	{ "clear", w_clear },
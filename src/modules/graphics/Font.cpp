@@ -26,6 +26,7 @@
 #include "common/math.h"
 #include "common/Matrix.h"
 #include "Graphics.h"
+#include "profiler/Profiler.h"
 
 #include <math.h>
 #include <sstream>
@@ -387,6 +388,8 @@ float Font::getHeight() const
 
 std::vector<Font::DrawCommand> Font::generateVertices(const ColoredCodepoints &codepoints, const Colorf &constantcolor, std::vector<GlyphVertex> &vertices, float extra_spacing, Vector2 offset, TextInfo *info)
 {
+	LOVE_PROFILE_ZONE("graphics", "Font::generateVertices");
+
 	// Spacing counter and newline handling.
 	float dx = offset.x;
 	float dy = offset.y;
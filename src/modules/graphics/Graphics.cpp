@@ -32,6 +32,7 @@
 #include "Video.h"
 #include "Text.h"
 #include "common/deprecation.h"
+#include "profiler/Profiler.h"
 
 // C++
 #include <algorithm>
@@ -1114,6 +1115,8 @@ Graphics::StreamVertexData Graphics::requestStreamDraw(const StreamDrawCommand &
 
 void Graphics::flushStreamDraws()
 {
+	LOVE_PROFILE_ZONE("graphics", "flushStreamDraws");
+
 	using namespace vertex;
 
 	auto &sbstate = streamBufferState;
@@ -1558,15 +1561,47 @@ void Graphics::polygon(DrawMode mode, const Vector2 *coords, size_t count, bool
 		const Matrix4 &t = getTransform();
 		bool is2D = t.isAffine2DTransform();
 
+		int vertexcount = (int)count - (skipLastFilledVertex ? 1 : 0);
+
+		// A fan only covers a concave polygon properly if every vertex can be
+		// seen from the first one. Degenerate polygons which triangulate to
+		// nothing keep using a fan.
+		bool triangulated = false;
+		if (vertexcount > 3 && !math::isConvex(coords, vertexcount))
+		{
+			math::triangulate(coords, vertexcount, nullptr, 0, polygonIndices);
+			triangulated = !polygonIndices.empty();
+		}
+
 		StreamDrawCommand cmd;
 		cmd.formats[0] = vertex::getSinglePositionFormat(is2D);
 		cmd.formats[1] = vertex::CommonFormat::RGBAub;
-		cmd.indexMode = vertex::TriangleIndexMode::FAN;
-		cmd.vertexCount = (int)count - (skipLastFilledVertex ? 1 : 0);
+
+		if (triangulated)
+		{
+			cmd.indexMode = vertex::TriangleIndexMode::NONE;
+			cmd.vertexCount = (int) polygonIndices.size();
+		}
+		else
+		{
+			cmd.indexMode = vertex::TriangleIndexMode::FAN;
+			cmd.vertexCount = vertexcount;
+		}
 
 		StreamVertexData data = requestStreamDraw(cmd);
 
-		if (is2D)
+		if (triangulated)
+		{
+			for (int i = 0; i < cmd.vertexCount; i++)
+			{
+				const Vector2 *v = &coords[polygonIndices[i]];
+				if (is2D)
+					t.transformXY((Vector2 *) data.stream[0] + i, v, 1);
+				else
+					t.transformXY0((Vector3 *) data.stream[0] + i, v, 1);
+			}
+		}
+		else if (is2D)
 			t.transformXY((Vector2 *) data.stream[0], coords, cmd.vertexCount);
 		else
 			t.transformXY0((Vector3 *) data.stream[0], coords, cmd.vertexCount);
@@ -810,7 +810,8 @@ public:
 	void arc(DrawMode drawmode, ArcMode arcmode, float x, float y, float radius, float angle1, float angle2);
 
 	/**
-	 * Draws a polygon with an arbitrary number of vertices.
+	 * Draws a polygon with an arbitrary number of vertices. Filled concave
+	 * polygons are triangulated, convex ones are drawn as a triangle fan.
 	 * @param mode The type of drawing (line/filled).
 	 * @param coords Vertex positions.
 	 * @param count Vertex array size.
@@ -1072,6 +1073,9 @@ private:
 
 	std::vector<uint8> scratchBuffer;
 
+	// Reused between concave polygon fills.
+	std::vector<uint32> polygonIndices;
+
 	std::unordered_map<std::string, ShaderStage *> cachedShaderStages[ShaderStage::STAGE_MAX_ENUM];
 
 	static StringMap<DrawMode, DRAW_MAX_ENUM>::Entry drawModeEntries[];
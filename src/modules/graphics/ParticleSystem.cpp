@@ -25,6 +25,8 @@
 
 #include "common/math.h"
 #include "modules/math/RandomGenerator.h"
+#include "thread/JobSystem.h"
+#include "profiler/Profiler.h"
 
 // STD
 #include <algorithm>
@@ -41,6 +43,9 @@ namespace
 
 love::math::RandomGenerator rng;
 
+// Systems with at least this many particles are updated across threads.
+const int64 PARALLEL_UPDATE_PARTICLES = 8192;
+
 float calculate_variation(float inner, float outer, float var)
 {
 	float low = inner - (outer/2.0f)*var;
@@ -906,100 +911,124 @@ bool ParticleSystem::isFull() const
 	return activeParticles == maxParticles;
 }
 
+void ParticleSystem::updateParticle(Particle *p, float dt) const
+{
+	// Temp variables.
+	love::Vector2 radial, tangential;
+	love::Vector2 ppos = p->position;
+
+	// Get vector from particle center to particle.
+	radial = ppos - p->origin;
+	radial.normalize();
+	tangential = radial;
+
+	// Resize radial acceleration.
+	radial *= p->radialAcceleration;
+
+	// Calculate tangential acceleration.
+	{
+		float a = tangential.x;
+		tangential.x = -tangential.y;
+		tangential.y = a;
+	}
+
+	// Resize tangential.
+	tangential *= p->tangentialAcceleration;
+
+	// Update velocity.
+	p->velocity += (radial + tangential + p->linearAcceleration) * dt;
+
+	// Apply damping.
+	p->velocity *= 1.0f / (1.0f + p->linearDamping * dt);
+
+	// Modify position.
+	ppos += p->velocity * dt;
+
+	p->position = ppos;
+
+	const float t = 1.0f - p->life / p->lifetime;
+
+	// Rotate.
+	p->rotation += (p->spinStart * (1.0f - t) + p->spinEnd * t) * dt;
+
+	p->angle = p->rotation;
+
+	if (relativeRotation)
+		p->angle += atan2f(p->velocity.y, p->velocity.x);
+
+	// Change size according to given intervals:
+	// i = 0       1       2      3          n-1
+	//     |-------|-------|------|--- ... ---|
+	// t = 0    1/(n-1)        3/(n-1)        1
+	//
+	// `s' is the interpolation variable scaled to the current
+	// interval width, e.g. if n = 5 and t = 0.3, then the current
+	// indices are 1,2 and s = 0.3 - 0.25 = 0.05
+	float s = p->sizeOffset + t * p->sizeIntervalSize; // size variation
+	s *= (float)(sizes.size() - 1); // 0 <= s < sizes.size()
+	size_t i = (size_t)s;
+	size_t k = (i == sizes.size() - 1) ? i : i + 1; // boundary check (prevents failing on t = 1.0f)
+	s -= (float)i; // transpose s to be in interval [0:1]: i <= s < i + 1 ~> 0 <= s < 1
+	p->size = sizes[i] * (1.0f - s) + sizes[k] * s;
+
+	// Update color according to given intervals (as above)
+	s = t * (float)(colors.size() - 1);
+	i = (size_t)s;
+	k = (i == colors.size() - 1) ? i : i + 1;
+	s -= (float)i;                            // 0 <= s <= 1
+	p->color = colors[i] * (1.0f - s) + colors[k] * s;
+
+	// Update the quad index.
+	k = quads.size();
+	if (k > 0)
+	{
+		s = t * (float) k; // [0:numquads-1] (clamped below)
+		i = (s > 0.0f) ? (size_t) s : 0;
+		p->quadIndex = (int) ((i < k) ? i : k - 1);
+	}
+}
+
 void ParticleSystem::update(float dt)
 {
+	LOVE_PROFILE_ZONE("graphics", "ParticleSystem::update");
+
 	if (pMem == nullptr || dt == 0.0f)
 		return;
 
-	// Traverse all particles and update.
+	// Particles are independent of each other, so large systems are updated
+	// across the job system's worker threads. The particle memory is
+	// contiguous, which is much friendlier to split up than the linked list.
+	auto updateRange = [&](int64 first, int64 last)
+	{
+		for (int64 i = first; i < last; i++)
+		{
+			Particle *p = &pMem[i];
+
+			// Decrease lifespan.
+			p->life -= dt;
+
+			if (p->life > 0)
+				updateParticle(p, dt);
+		}
+	};
+
+	int64 count = pFree - pMem;
+
+	if (count >= PARALLEL_UPDATE_PARTICLES)
+		love::thread::JobSystem::getInstance()->parallelFor(count, PARALLEL_UPDATE_PARTICLES / 4, updateRange);
+	else
+		updateRange(0, count);
+
+	// Remove dead particles. This moves particles around in memory, so it has
+	// to happen on this thread after they've all been updated.
 	Particle *p = pHead;
 
 	while (p)
 	{
-		// Decrease lifespan.
-		p->life -= dt;
-
 		if (p->life <= 0)
 			p = removeParticle(p);
 		else
-		{
-			// Temp variables.
-			love::Vector2 radial, tangential;
-			love::Vector2 ppos = p->position;
-
-			// Get vector from particle center to particle.
-			radial = ppos - p->origin;
-			radial.normalize();
-			tangential = radial;
-
-			// Resize radial acceleration.
-			radial *= p->radialAcceleration;
-
-			// Calculate tangential acceleration.
-			{
-				float a = tangential.x;
-				tangential.x = -tangential.y;
-				tangential.y = a;
-			}
-
-			// Resize tangential.
-			tangential *= p->tangentialAcceleration;
-
-			// Update velocity.
-			p->velocity += (radial + tangential + p->linearAcceleration) * dt;
-
-			// Apply damping.
-			p->velocity *= 1.0f / (1.0f + p->linearDamping * dt);
-
-			// Modify position.
-			ppos += p->velocity * dt;
-
-			p->position = ppos;
-
-			const float t = 1.0f - p->life / p->lifetime;
-
-			// Rotate.
-			p->rotation += (p->spinStart * (1.0f - t) + p->spinEnd * t) * dt;
-
-			p->angle = p->rotation;
-
-			if (relativeRotation)
-				p->angle += atan2f(p->velocity.y, p->velocity.x);
-
-			// Change size according to given intervals:
-			// i = 0       1       2      3          n-1
-			//     |-------|-------|------|--- ... ---|
-			// t = 0    1/(n-1)        3/(n-1)        1
-			//
-			// `s' is the interpolation variable scaled to the current
-			// interval width, e.g. if n = 5 and t = 0.3, then the current
-			// indices are 1,2 and s = 0.3 - 0.25 = 0.05
-			float s = p->sizeOffset + t * p->sizeIntervalSize; // size variation
-			s *= (float)(sizes.size() - 1); // 0 <= s < sizes.size()
-			size_t i = (size_t)s;
-			size_t k = (i == sizes.size() - 1) ? i : i + 1; // boundary check (prevents failing on t = 1.0f)
-			s -= (float)i; // transpose s to be in interval [0:1]: i <= s < i + 1 ~> 0 <= s < 1
-			p->size = sizes[i] * (1.0f - s) + sizes[k] * s;
-
-			// Update color according to given intervals (as above)
-			s = t * (float)(colors.size() - 1);
-			i = (size_t)s;
-			k = (i == colors.size() - 1) ? i : i + 1;
-			s -= (float)i;                            // 0 <= s <= 1
-			p->color = colors[i] * (1.0f - s) + colors[k] * s;
-
-			// Update the quad index.
-			k = quads.size();
-			if (k > 0)
-			{
-				s = t * (float) k; // [0:numquads-1] (clamped below)
-				i = (s > 0.0f) ? (size_t) s : 0;
-				p->quadIndex = (int) ((i < k) ? i : k - 1);
-			}
-
-			// Next particle.
 			p = p->next;
-		}
 	}
 
 	// Make some more particles.
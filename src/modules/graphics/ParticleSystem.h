@@ -566,6 +566,9 @@ private:
 	void addParticle(float t);
 	Particle *removeParticle(Particle *p);
 
+	// Called by update for every live particle. Can run on any thread.
+	void updateParticle(Particle *p, float dt) const;
+
 	// Called by addParticle.
 	void initParticle(Particle *p, float t);
 	void insertTop(Particle *p);
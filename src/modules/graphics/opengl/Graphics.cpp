@@ -30,6 +30,7 @@
 #include "window/Window.h"
 #include "Buffer.h"
 #include "ShaderStage.h"
+#include "profiler/Profiler.h"
 
 #include "libraries/xxHash/xxhash.h"
 
@@ -885,6 +886,8 @@ void Graphics::bindCachedFBO(const RenderTargets &targets)
 
 void Graphics::present(void *screenshotCallbackData)
 {
+	LOVE_PROFILE_ZONE("graphics", "present");
+
 	if (!isActive())
 		return;
 
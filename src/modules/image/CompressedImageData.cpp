@@ -19,6 +19,7 @@
  **/
 
 #include "CompressedImageData.h"
+#include "profiler/Profiler.h"
 
 namespace love
 {
@@ -31,6 +32,8 @@ CompressedImageData::CompressedImageData(const std::list<FormatHandler *> &forma
 	: format(PIXELFORMAT_UNKNOWN)
 	, sRGB(false)
 {
+	LOVE_PROFILE_ZONE("image", "CompressedImageData::parse");
+
 	FormatHandler *parser = nullptr;
 
 	for (FormatHandler *handler : formats)
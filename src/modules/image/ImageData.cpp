@@ -21,6 +21,11 @@
 #include "ImageData.h"
 #include "Image.h"
 #include "filesystem/Filesystem.h"
+#include "thread/JobSystem.h"
+#include "profiler/Profiler.h"
+
+// STL
+#include <algorithm>
 
 using love::thread::Lock;
 
@@ -31,6 +36,9 @@ namespace image
 
 love::Type ImageData::type("ImageData", &Data::type);
 
+// Pastes which convert at least this many pixels are split across threads.
+static const int64 PARALLEL_PASTE_PIXELS = 256 * 256;
+
 ImageData::ImageData(Data *data)
 {
 	decode(data);
@@ -110,6 +118,8 @@ void ImageData::create(int width, int height, PixelFormat format, void *data)
 
 void ImageData::decode(Data *data)
 {
+	LOVE_PROFILE_ZONE("image", "ImageData::decode");
+
 	FormatHandler *decoder = nullptr;
 	FormatHandler::DecodedImage decodedimage;
 
@@ -353,46 +363,68 @@ void ImageData::paste(ImageData *src, int dx, int dy, int sx, int sy, int sw, in
 	}
 	else if (sw > 0)
 	{
-		// Otherwise, copy each row individually.
-		for (int i = 0; i < sh; i++)
+		// Otherwise, copy each row individually. Rows of the same format are
+		// copied as-is, without a conversion function.
+		void (*pasteRow)(Row src, Row dst, int w) = nullptr;
+
+		if (srcformat == dstformat)
+			pasteRow = nullptr;
+
+		else if (srcformat == PIXELFORMAT_RGBA8 && dstformat == PIXELFORMAT_RGBA16)
+			pasteRow = pasteRGBA8toRGBA16;
+		else if (srcformat == PIXELFORMAT_RGBA8 && dstformat == PIXELFORMAT_RGBA16F)
+			pasteRow = pasteRGBA8toRGBA16F;
+		else if (srcformat == PIXELFORMAT_RGBA8 && dstformat == PIXELFORMAT_RGBA32F)
+			pasteRow = pasteRGBA8toRGBA32F;
+
+		else if (srcformat == PIXELFORMAT_RGBA16 && dstformat == PIXELFORMAT_RGBA8)
+			pasteRow = pasteRGBA16toRGBA8;
+		else if (srcformat == PIXELFORMAT_RGBA16 && dstformat == PIXELFORMAT_RGBA16F)
+			pasteRow = pasteRGBA16toRGBA16F;
+		else if (srcformat == PIXELFORMAT_RGBA16 && dstformat == PIXELFORMAT_RGBA32F)
+			pasteRow = pasteRGBA16toRGBA32F;
+
+		else if (srcformat == PIXELFORMAT_RGBA16F && dstformat == PIXELFORMAT_RGBA8)
+			pasteRow = pasteRGBA16FtoRGBA8;
+		else if (srcformat == PIXELFORMAT_RGBA16F && dstformat == PIXELFORMAT_RGBA16)
+			pasteRow = pasteRGBA16FtoRGBA16;
+		else if (srcformat == PIXELFORMAT_RGBA16F && dstformat == PIXELFORMAT_RGBA32F)
+			pasteRow = pasteRGBA16FtoRGBA32F;
+
+		else if (srcformat == PIXELFORMAT_RGBA32F && dstformat == PIXELFORMAT_RGBA8)
+			pasteRow = pasteRGBA32FtoRGBA8;
+		else if (srcformat == PIXELFORMAT_RGBA32F && dstformat == PIXELFORMAT_RGBA16)
+			pasteRow = pasteRGBA32FtoRGBA16;
+		else if (srcformat == PIXELFORMAT_RGBA32F && dstformat == PIXELFORMAT_RGBA16F)
+			pasteRow = pasteRGBA32FtoRGBA16F;
+
+		else
+			throw love::Exception("Unsupported pixel format combination in ImageData:paste!");
+
+		auto pasteRows = [&](int64 first, int64 last)
 		{
-			Row rowsrc = {s + (sx + (i + sy) * srcW) * srcpixelsize};
-			Row rowdst = {d + (dx + (i + dy) * dstW) * dstpixelsize};
-
-			if (srcformat == dstformat)
-				memcpy(rowdst.u8, rowsrc.u8, srcpixelsize * sw);
-
-			else if (srcformat == PIXELFORMAT_RGBA8 && dstformat == PIXELFORMAT_RGBA16)
-				pasteRGBA8toRGBA16(rowsrc, rowdst, sw);
-			else if (srcformat == PIXELFORMAT_RGBA8 && dstformat == PIXELFORMAT_RGBA16F)
-				pasteRGBA8toRGBA16F(rowsrc, rowdst, sw);
-			else if (srcformat == PIXELFORMAT_RGBA8 && dstformat == PIXELFORMAT_RGBA32F)
-				pasteRGBA8toRGBA32F(rowsrc, rowdst, sw);
-
-			else if (srcformat == PIXELFORMAT_RGBA16 && dstformat == PIXELFORMAT_RGBA8)
-				pasteRGBA16toRGBA8(rowsrc, rowdst, sw);
-			else if (srcformat == PIXELFORMAT_RGBA16 && dstformat == PIXELFORMAT_RGBA16F)
-				pasteRGBA16toRGBA16F(rowsrc, rowdst, sw);
-			else if (srcformat == PIXELFORMAT_RGBA16 && dstformat == PIXELFORMAT_RGBA32F)
-				pasteRGBA16toRGBA32F(rowsrc, rowdst, sw);
-
-			else if (srcformat == PIXELFORMAT_RGBA16F && dstformat == PIXELFORMAT_RGBA8)
-				pasteRGBA16FtoRGBA8(rowsrc, rowdst, sw);
-			else if (srcformat == PIXELFORMAT_RGBA16F && dstformat == PIXELFORMAT_RGBA16)
-				pasteRGBA16FtoRGBA16(rowsrc, rowdst, sw);
-			else if (srcformat == PIXELFORMAT_RGBA16F && dstformat == PIXELFORMAT_RGBA32F)
-				pasteRGBA16FtoRGBA32F(rowsrc, rowdst, sw);
-
-			else if (srcformat == PIXELFORMAT_RGBA32F && dstformat == PIXELFORMAT_RGBA8)
-				pasteRGBA32FtoRGBA8(rowsrc, rowdst, sw);
-			else if (srcformat == PIXELFORMAT_RGBA32F && dstformat == PIXELFORMAT_RGBA16)
-				pasteRGBA32FtoRGBA16(rowsrc, rowdst, sw);
-			else if (srcformat == PIXELFORMAT_RGBA32F && dstformat == PIXELFORMAT_RGBA16F)
-				pasteRGBA32FtoRGBA16F(rowsrc, rowdst, sw);
-
-			else
-				throw love::Exception("Unsupported pixel format combination in ImageData:paste!");
+			for (int i = (int) first; i < (int) last; i++)
+			{
+				Row rowsrc = {s + (sx + (i + sy) * srcW) * srcpixelsize};
+				Row rowdst = {d + (dx + (i + dy) * dstW) * dstpixelsize};
+
+				if (pasteRow != nullptr)
+					pasteRow(rowsrc, rowdst, sw);
+				else
+					memcpy(rowdst.u8, rowsrc.u8, srcpixelsize * sw);
+			}
+		};
+
+		// Large format conversions are split across the job system's worker
+		// threads. Plain copies are limited by memory bandwidth, and pasting
+		// an ImageData into itself has to stay in order.
+		if (pasteRow != nullptr && src != this && (int64) sw * sh >= PARALLEL_PASTE_PIXELS)
+		{
+			int64 grain = std::max(PARALLEL_PASTE_PIXELS / 4 / sw, (int64) 1);
+			love::thread::JobSystem::getInstance()->parallelFor(sh, grain, pasteRows);
 		}
+		else
+			pasteRows(0, sh);
 	}
 }
 
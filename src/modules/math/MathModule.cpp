@@ -27,151 +27,737 @@
 #include "Transform.h"
 
 // STL
+#include <algorithm>
 #include <cmath>
-#include <list>
+#include <deque>
 #include <iostream>
+#include <limits>
 
 // C
 #include <time.h>
 
-using std::list;
 using love::Vector2;
+using love::uint32;
 
 namespace
 {
 
-// check if an angle is oriented counter clockwise
-inline bool is_oriented_ccw(const Vector2 &a, const Vector2 &b, const Vector2 &c)
+// The triangulator is a port of the z-order hashed ear clipping algorithm from
+// Mapbox's earcut (https://github.com/mapbox/earcut, ISC license). Holes are
+// bridged into the outer boundary, ears are found by looking up only the
+// vertices whose z-order values fall in the candidate triangle's bounding box,
+// and polygons it can't clip cleanly (self-intersections, degenerate spots)
+// get cured or split instead of rejected.
+
+struct TriNode
+{
+	uint32 i; // Index of the vertex in the input.
+	float x, y;
+
+	TriNode *prev, *next;
+
+	// Z-order value and neighbours, used to search for vertices near an ear.
+	uint32 z;
+	TriNode *prevZ, *nextZ;
+
+	// Lone vertex of a single-vertex hole.
+	bool steiner;
+};
+
+class Triangulator
+{
+public:
+
+	Triangulator(const Vector2 *vertices, std::vector<uint32> &indices)
+		: vertices(vertices)
+		, indices(indices)
+		, minX(0.0f)
+		, minY(0.0f)
+		, invSize(0.0f)
+	{}
+
+	void run(size_t count, const size_t *holeStarts, size_t holeCount);
+
+private:
+
+	TriNode *linkedList(size_t start, size_t end, bool clockwise);
+	TriNode *filterPoints(TriNode *start, TriNode *end = nullptr);
+	void earcutLinked(TriNode *ear, int pass = 0);
+	bool isEar(const TriNode *ear) const;
+	bool isEarHashed(const TriNode *ear) const;
+	TriNode *cureLocalIntersections(TriNode *start);
+	void splitEarcut(TriNode *start);
+	TriNode *eliminateHoles(const size_t *holeStarts, size_t holeCount, size_t count, TriNode *outer);
+	void eliminateHole(TriNode *hole, TriNode *outer);
+	TriNode *findHoleBridge(const TriNode *hole, TriNode *outer) const;
+	void indexCurve(TriNode *start);
+	uint32 zOrder(float x, float y) const;
+	TriNode *splitPolygon(TriNode *a, TriNode *b);
+	TriNode *insertNode(size_t i, TriNode *last);
+
+	void addTriangle(const TriNode *a, const TriNode *b, const TriNode *c)
+	{
+		indices.push_back(a->i);
+		indices.push_back(b->i);
+		indices.push_back(c->i);
+	}
+
+	const Vector2 *vertices;
+	std::vector<uint32> &indices;
+
+	// Nodes never move once created, which a deque guarantees.
+	std::deque<TriNode> nodes;
+
+	float minX, minY, invSize;
+
+}; // Triangulator
+
+inline float area(const TriNode *p, const TriNode *q, const TriNode *r)
+{
+	return (q->y - p->y) * (r->x - q->x) - (q->x - p->x) * (r->y - q->y);
+}
+
+inline bool equals(const TriNode *a, const TriNode *b)
+{
+	return a->x == b->x && a->y == b->y;
+}
+
+inline bool point_in_triangle(float ax, float ay, float bx, float by, float cx, float cy, float px, float py)
+{
+	return (cx - px) * (ay - py) >= (ax - px) * (cy - py)
+		&& (ax - px) * (by - py) >= (bx - px) * (ay - py)
+		&& (bx - px) * (cy - py) >= (cx - px) * (by - py);
+}
+
+inline int sign(float v)
 {
-	// return det(b-a, c-a) >= 0
-	return ((b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x)) >= 0;
+	return (v > 0.0f) - (v < 0.0f);
 }
 
-// check if a and b are on the same side of the line c->d
-bool on_same_side(const Vector2 &a, const Vector2 &b, const Vector2 &c, const Vector2 &d)
+// checks if q lies on the segment p->r, given that the three are collinear
+inline bool on_segment(const TriNode *p, const TriNode *q, const TriNode *r)
 {
-	float px = d.x - c.x, py = d.y - c.y;
-	// return det(p, a-c) * det(p, b-c) >= 0
-	float l = px * (a.y - c.y) - py * (a.x - c.x);
-	float m = px * (b.y - c.y) - py * (b.x - c.x);
-	return l * m >= 0;
+	return q->x <= std::max(p->x, r->x) && q->x >= std::min(p->x, r->x)
+		&& q->y <= std::max(p->y, r->y) && q->y >= std::min(p->y, r->y);
 }
 
-// checks is p is contained in the triangle abc
-inline bool point_in_triangle(const Vector2 &p, const Vector2 &a, const Vector2 &b, const Vector2 &c)
+bool intersects(const TriNode *p1, const TriNode *q1, const TriNode *p2, const TriNode *q2)
 {
-	return on_same_side(p,a, b,c) && on_same_side(p,b, a,c) && on_same_side(p,c, a,b);
+	int o1 = sign(area(p1, q1, p2));
+	int o2 = sign(area(p1, q1, q2));
+	int o3 = sign(area(p2, q2, p1));
+	int o4 = sign(area(p2, q2, q1));
+
+	if (o1 != o2 && o3 != o4)
+		return true;
+
+	return (o1 == 0 && on_segment(p1, p2, q1))
+		|| (o2 == 0 && on_segment(p1, q2, q1))
+		|| (o3 == 0 && on_segment(p2, p1, q2))
+		|| (o4 == 0 && on_segment(p2, q1, q2));
 }
 
-// checks if any vertex in `vertices' is in the triangle abc.
-bool any_point_in_triangle(const std::list<const Vector2 *> &vertices, const Vector2 &a, const Vector2 &b, const Vector2 &c)
+// checks if the diagonal a->b intersects any edge of the polygon
+bool intersects_polygon(const TriNode *a, const TriNode *b)
 {
-	for (const Vector2 *p : vertices)
+	const TriNode *p = a;
+	do
 	{
-		if ((p != &a) && (p != &b) && (p != &c) && point_in_triangle(*p, a,b,c)) // oh god...
+		if (p->i != a->i && p->next->i != a->i && p->i != b->i && p->next->i != b->i
+			&& intersects(p, p->next, a, b))
 			return true;
-	}
+		p = p->next;
+	} while (p != a);
 
 	return false;
 }
 
-inline bool is_ear(const Vector2 &a, const Vector2 &b, const Vector2 &c, const std::list<const Vector2 *> &vertices)
+// checks if the diagonal a->b starts off inside the polygon at a
+bool locally_inside(const TriNode *a, const TriNode *b)
 {
-	return is_oriented_ccw(a,b,c) && !any_point_in_triangle(vertices, a,b,c);
+	if (area(a->prev, a, a->next) < 0.0f)
+		return area(a, b, a->next) >= 0.0f && area(a, a->prev, b) >= 0.0f;
+	else
+		return area(a, b, a->prev) < 0.0f || area(a, a->next, b) < 0.0f;
 }
 
-} // anonymous namespace
+// checks if the middle of the diagonal a->b is inside the polygon
+bool middle_inside(const TriNode *a, const TriNode *b)
+{
+	const TriNode *p = a;
+	bool inside = false;
+	float px = (a->x + b->x) / 2.0f;
+	float py = (a->y + b->y) / 2.0f;
+	do
+	{
+		if (((p->y > py) != (p->next->y > py)) && p->next->y != p->y
+			&& (px < (p->next->x - p->x) * (py - p->y) / (p->next->y - p->y) + p->x))
+			inside = !inside;
+		p = p->next;
+	} while (p != a);
 
-namespace love
+	return inside;
+}
+
+bool sector_contains_sector(const TriNode *m, const TriNode *p)
 {
-namespace math
+	return area(m->prev, m, p->prev) < 0.0f && area(p->next, m, m->next) < 0.0f;
+}
+
+bool is_valid_diagonal(const TriNode *a, const TriNode *b)
 {
+	if (a->next->i == b->i || a->prev->i == b->i || intersects_polygon(a, b))
+		return false;
+
+	if (locally_inside(a, b) && locally_inside(b, a) && middle_inside(a, b)
+		&& (area(a->prev, a, b->prev) != 0.0f || area(a, b->prev, b) != 0.0f))
+		return true;
+
+	// zero-length diagonal between two convex vertices
+	return equals(a, b) && area(a->prev, a, a->next) > 0.0f && area(b->prev, b, b->next) > 0.0f;
+}
 
-std::vector<Triangle> triangulate(const std::vector<love::Vector2> &polygon)
+void remove_node(TriNode *p)
 {
-	if (polygon.size() < 3)
-		throw love::Exception("Not a polygon");
-	else if (polygon.size() == 3)
-		return std::vector<Triangle>(1, Triangle(polygon[0], polygon[1], polygon[2]));
-
-	// collect list of connections and record leftmost item to check if the polygon
-	// has the expected winding
-	std::vector<size_t> next_idx(polygon.size()), prev_idx(polygon.size());
-	size_t idx_lm = 0;
-	for (size_t i = 0; i < polygon.size(); ++i)
-	{
-		const love::Vector2 &lm = polygon[idx_lm], &p = polygon[i];
-		if (p.x < lm.x || (p.x == lm.x && p.y < lm.y))
-			idx_lm = i;
-		next_idx[i] = i+1;
-		prev_idx[i] = i-1;
-	}
-	next_idx[next_idx.size()-1] = 0;
-	prev_idx[0] = prev_idx.size()-1;
-
-	// check if the polygon has the expected winding and reverse polygon if needed
-	if (!is_oriented_ccw(polygon[prev_idx[idx_lm]], polygon[idx_lm], polygon[next_idx[idx_lm]]))
-		next_idx.swap(prev_idx);
-
-	// collect list of concave polygons
-	std::list<const love::Vector2 *> concave_vertices;
-	for (size_t i = 0; i < polygon.size(); ++i)
-	{
-		if (!is_oriented_ccw(polygon[prev_idx[i]], polygon[i], polygon[next_idx[i]]))
-			concave_vertices.push_back(&polygon[i]);
-	}
-
-	// triangulation according to kong
-	std::vector<Triangle> triangles;
-	size_t n_vertices = polygon.size();
-	size_t current = 1, skipped = 0, next, prev;
-	while (n_vertices > 3)
-	{
-		next = next_idx[current];
-		prev = prev_idx[current];
-		const Vector2 &a = polygon[prev], &b = polygon[current], &c = polygon[next];
-		if (is_ear(a,b,c, concave_vertices))
+	p->next->prev = p->prev;
+	p->prev->next = p->next;
+
+	if (p->prevZ)
+		p->prevZ->nextZ = p->nextZ;
+	if (p->nextZ)
+		p->nextZ->prevZ = p->prevZ;
+}
+
+TriNode *get_leftmost(TriNode *start)
+{
+	TriNode *p = start, *leftmost = start;
+	do
+	{
+		if (p->x < leftmost->x || (p->x == leftmost->x && p->y < leftmost->y))
+			leftmost = p;
+		p = p->next;
+	} while (p != start);
+
+	return leftmost;
+}
+
+void Triangulator::run(size_t count, const size_t *holeStarts, size_t holeCount)
+{
+	size_t outerCount = holeCount > 0 ? holeStarts[0] : count;
+
+	TriNode *outer = linkedList(0, outerCount, true);
+	if (outer == nullptr || outer->next == outer->prev)
+		return;
+
+	if (holeCount > 0)
+		outer = eliminateHoles(holeStarts, holeCount, count, outer);
+
+	// Small polygons are quicker to check against every vertex than to hash.
+	if (count > 80)
+	{
+		float maxX = vertices[0].x, maxY = vertices[0].y;
+		minX = maxX;
+		minY = maxY;
+
+		for (size_t i = 1; i < count; i++)
 		{
-			triangles.push_back(Triangle(a,b,c));
-			next_idx[prev] = next;
-			prev_idx[next] = prev;
-			concave_vertices.remove(&b);
-			--n_vertices;
-			skipped = 0;
+			minX = std::min(minX, vertices[i].x);
+			minY = std::min(minY, vertices[i].y);
+			maxX = std::max(maxX, vertices[i].x);
+			maxY = std::max(maxY, vertices[i].y);
 		}
-		else if (++skipped > n_vertices)
+
+		float size = std::max(maxX - minX, maxY - minY);
+		invSize = size != 0.0f ? 32767.0f / size : 0.0f;
+	}
+
+	earcutLinked(outer);
+}
+
+TriNode *Triangulator::linkedList(size_t start, size_t end, bool clockwise)
+{
+	float sum = 0.0f;
+	for (size_t i = start, j = end - 1; i < end; j = i++)
+		sum += (vertices[j].x - vertices[i].x) * (vertices[i].y + vertices[j].y);
+
+	TriNode *last = nullptr;
+
+	if (clockwise == (sum > 0.0f))
+	{
+		for (size_t i = start; i < end; i++)
+			last = insertNode(i, last);
+	}
+	else
+	{
+		for (size_t i = end; i-- > start;)
+			last = insertNode(i, last);
+	}
+
+	if (last != nullptr && equals(last, last->next))
+	{
+		remove_node(last);
+		last = last->next;
+	}
+
+	return last;
+}
+
+// removes duplicate and collinear vertices
+TriNode *Triangulator::filterPoints(TriNode *start, TriNode *end)
+{
+	if (start == nullptr)
+		return start;
+	if (end == nullptr)
+		end = start;
+
+	TriNode *p = start;
+	bool again;
+	do
+	{
+		again = false;
+
+		if (!p->steiner && (equals(p, p->next) || area(p->prev, p, p->next) == 0.0f))
+		{
+			remove_node(p);
+			p = end = p->prev;
+			if (p == p->next)
+				break;
+			again = true;
+		}
+		else
+			p = p->next;
+	} while (again || p != end);
+
+	return end;
+}
+
+void Triangulator::earcutLinked(TriNode *ear, int pass)
+{
+	if (ear == nullptr)
+		return;
+
+	if (pass == 0 && invSize != 0.0f)
+		indexCurve(ear);
+
+	TriNode *stop = ear;
+
+	while (ear->prev != ear->next)
+	{
+		TriNode *prev = ear->prev;
+		TriNode *next = ear->next;
+
+		if (invSize != 0.0f ? isEarHashed(ear) : isEar(ear))
+		{
+			addTriangle(prev, ear, next);
+			remove_node(ear);
+
+			// Skipping the next vertex leads to fewer sliver triangles.
+			ear = next->next;
+			stop = next->next;
+			continue;
+		}
+
+		ear = next;
+
+		// Went all the way around without finding an ear.
+		if (ear == stop)
 		{
-			throw love::Exception("Cannot triangulate polygon.");
+			if (pass == 0)
+				earcutLinked(filterPoints(ear), 1);
+			else if (pass == 1)
+				earcutLinked(cureLocalIntersections(filterPoints(ear)), 2);
+			else
+				splitEarcut(ear);
+			break;
 		}
-		current = next;
 	}
-	next = next_idx[current];
-	prev = prev_idx[current];
-	triangles.push_back(Triangle(polygon[prev], polygon[current], polygon[next]));
+}
 
-	return triangles;
+bool Triangulator::isEar(const TriNode *ear) const
+{
+	const TriNode *a = ear->prev, *b = ear, *c = ear->next;
+
+	if (area(a, b, c) >= 0.0f)
+		return false; // reflex
+
+	for (const TriNode *p = c->next; p != a; p = p->next)
+	{
+		if (point_in_triangle(a->x, a->y, b->x, b->y, c->x, c->y, p->x, p->y)
+			&& area(p->prev, p, p->next) >= 0.0f)
+			return false;
+	}
+
+	return true;
+}
+
+bool Triangulator::isEarHashed(const TriNode *ear) const
+{
+	const TriNode *a = ear->prev, *b = ear, *c = ear->next;
+
+	if (area(a, b, c) >= 0.0f)
+		return false; // reflex
+
+	float minTX = std::min(a->x, std::min(b->x, c->x));
+	float minTY = std::min(a->y, std::min(b->y, c->y));
+	float maxTX = std::max(a->x, std::max(b->x, c->x));
+	float maxTY = std::max(a->y, std::max(b->y, c->y));
+
+	uint32 minZ = zOrder(minTX, minTY);
+	uint32 maxZ = zOrder(maxTX, maxTY);
+
+	const auto blocks = [&](const TriNode *p) -> bool
+	{
+		return p != a && p != c
+			&& point_in_triangle(a->x, a->y, b->x, b->y, c->x, c->y, p->x, p->y)
+			&& area(p->prev, p, p->next) >= 0.0f;
+	};
+
+	// Look for points inside the triangle in both directions along the curve.
+	const TriNode *p = ear->prevZ, *n = ear->nextZ;
+
+	while (p && p->z >= minZ && n && n->z <= maxZ)
+	{
+		if (blocks(p))
+			return false;
+		p = p->prevZ;
+
+		if (blocks(n))
+			return false;
+		n = n->nextZ;
+	}
+
+	for (; p && p->z >= minZ; p = p->prevZ)
+	{
+		if (blocks(p))
+			return false;
+	}
+
+	for (; n && n->z <= maxZ; n = n->nextZ)
+	{
+		if (blocks(n))
+			return false;
+	}
+
+	return true;
+}
+
+// clips off triangles where two consecutive edges cross each other
+TriNode *Triangulator::cureLocalIntersections(TriNode *start)
+{
+	TriNode *p = start;
+	do
+	{
+		TriNode *a = p->prev, *b = p->next->next;
+
+		if (!equals(a, b) && intersects(a, p, p->next, b) && locally_inside(a, b) && locally_inside(b, a))
+		{
+			addTriangle(a, p, b);
+
+			remove_node(p);
+			remove_node(p->next);
+
+			p = start = b;
+		}
+		p = p->next;
+	} while (p != start);
+
+	return filterPoints(p);
+}
+
+// splits the polygon along a valid diagonal and triangulates both halves
+void Triangulator::splitEarcut(TriNode *start)
+{
+	TriNode *a = start;
+	do
+	{
+		for (TriNode *b = a->next->next; b != a->prev; b = b->next)
+		{
+			if (a->i != b->i && is_valid_diagonal(a, b))
+			{
+				TriNode *c = splitPolygon(a, b);
+
+				a = filterPoints(a, a->next);
+				c = filterPoints(c, c->next);
+
+				earcutLinked(a);
+				earcutLinked(c);
+				return;
+			}
+		}
+		a = a->next;
+	} while (a != start);
+}
+
+TriNode *Triangulator::eliminateHoles(const size_t *holeStarts, size_t holeCount, size_t count, TriNode *outer)
+{
+	std::vector<TriNode *> queue;
+	queue.reserve(holeCount);
+
+	for (size_t i = 0; i < holeCount; i++)
+	{
+		size_t start = holeStarts[i];
+		size_t end = i + 1 < holeCount ? holeStarts[i + 1] : count;
+
+		TriNode *list = linkedList(start, end, false);
+		if (list == nullptr)
+			continue;
+		if (list == list->next)
+			list->steiner = true;
+
+		queue.push_back(get_leftmost(list));
+	}
+
+	std::sort(queue.begin(), queue.end(), [](const TriNode *a, const TriNode *b) { return a->x < b->x; });
+
+	// Bridge the holes from left to right.
+	for (TriNode *hole : queue)
+	{
+		eliminateHole(hole, outer);
+		outer = filterPoints(outer, outer->next);
+	}
+
+	return outer;
+}
+
+void Triangulator::eliminateHole(TriNode *hole, TriNode *outer)
+{
+	TriNode *bridge = findHoleBridge(hole, outer);
+	if (bridge == nullptr)
+		return;
+
+	TriNode *b = splitPolygon(bridge, hole);
+
+	filterPoints(bridge, bridge->next);
+	filterPoints(b, b->next);
+}
+
+// finds a vertex of the outer boundary which the hole's leftmost vertex can
+// connect to without crossing any edges
+TriNode *Triangulator::findHoleBridge(const TriNode *hole, TriNode *outer) const
+{
+	TriNode *p = outer;
+	TriNode *m = nullptr;
+	float hx = hole->x, hy = hole->y;
+	float qx = -std::numeric_limits<float>::infinity();
+
+	// Find the segment to the left of the hole's vertex which is closest to it
+	// along a horizontal ray, and its endpoint with the smaller x.
+	do
+	{
+		if (hy <= p->y && hy >= p->next->y && p->next->y != p->y)
+		{
+			float x = p->x + (hy - p->y) * (p->next->x - p->x) / (p->next->y - p->y);
+			if (x <= hx && x > qx)
+			{
+				qx = x;
+				if (x == hx)
+				{
+					if (hy == p->y)
+						return p;
+					if (hy == p->next->y)
+						return p->next;
+				}
+				m = p->x < p->next->x ? p : p->next;
+			}
+		}
+		p = p->next;
+	} while (p != outer);
+
+	if (m == nullptr)
+		return nullptr;
+
+	// The hole touches the outer segment, its leftmost endpoint will do.
+	if (hx == qx)
+		return m;
+
+	// Any vertex inside the triangle formed by the hole's vertex, the
+	// intersection and m would block the bridge. If there are some, pick the
+	// one with the smallest angle to the ray instead.
+	const TriNode *stop = m;
+	float mx = m->x, my = m->y;
+	float tanMin = std::numeric_limits<float>::infinity();
+
+	p = m;
+	do
+	{
+		if (hx >= p->x && p->x >= mx && hx != p->x
+			&& point_in_triangle(hy < my ? hx : qx, hy, mx, my, hy < my ? qx : hx, hy, p->x, p->y))
+		{
+			float tan = std::abs(hy - p->y) / (hx - p->x);
+
+			if (locally_inside(p, hole)
+				&& (tan < tanMin || (tan == tanMin && (p->x > m->x || (p->x == m->x && sector_contains_sector(m, p))))))
+			{
+				m = p;
+				tanMin = tan;
+			}
+		}
+		p = p->next;
+	} while (p != stop);
+
+	return m;
+}
+
+// links the vertices in z-order, for isEarHashed
+void Triangulator::indexCurve(TriNode *start)
+{
+	std::vector<TriNode *> sorted;
+
+	TriNode *p = start;
+	do
+	{
+		p->z = zOrder(p->x, p->y);
+		sorted.push_back(p);
+		p = p->next;
+	} while (p != start);
+
+	std::sort(sorted.begin(), sorted.end(), [](const TriNode *a, const TriNode *b) { return a->z < b->z; });
+
+	for (size_t i = 0; i < sorted.size(); i++)
+	{
+		sorted[i]->prevZ = i > 0 ? sorted[i - 1] : nullptr;
+		sorted[i]->nextZ = i + 1 < sorted.size() ? sorted[i + 1] : nullptr;
+	}
+}
+
+// interleaves the bits of the 15-bit cell coordinates of a point
+uint32 Triangulator::zOrder(float fx, float fy) const
+{
+	uint32 x = (uint32) ((fx - minX) * invSize);
+	uint32 y = (uint32) ((fy - minY) * invSize);
+
+	x = (x | (x << 8)) & 0x00FF00FF;
+	x = (x | (x << 4)) & 0x0F0F0F0F;
+	x = (x | (x << 2)) & 0x33333333;
+	x = (x | (x << 1)) & 0x55555555;
+
+	y = (y | (y << 8)) & 0x00FF00FF;
+	y = (y | (y << 4)) & 0x0F0F0F0F;
+	y = (y | (y << 2)) & 0x33333333;
+	y = (y | (y << 1)) & 0x55555555;
+
+	return x | (y << 1);
+}
+
+// links a to b with a diagonal. If a and b were part of the same ring, it's
+// split in two; if they were different rings (a hole), they're merged.
+// Returns the node after b in the new ring which contains b.
+TriNode *Triangulator::splitPolygon(TriNode *a, TriNode *b)
+{
+	nodes.push_back(*a);
+	TriNode *a2 = &nodes.back();
+	nodes.push_back(*b);
+	TriNode *b2 = &nodes.back();
+
+	a2->prevZ = a2->nextZ = nullptr;
+	b2->prevZ = b2->nextZ = nullptr;
+
+	TriNode *an = a->next;
+	TriNode *bp = b->prev;
+
+	a->next = b;
+	b->prev = a;
+
+	a2->next = an;
+	an->prev = a2;
+
+	b2->next = a2;
+	a2->prev = b2;
+
+	bp->next = b2;
+	b2->prev = bp;
+
+	return b2;
+}
+
+TriNode *Triangulator::insertNode(size_t i, TriNode *last)
+{
+	TriNode n = {};
+	n.i = (uint32) i;
+	n.x = vertices[i].x;
+	n.y = vertices[i].y;
+
+	nodes.push_back(n);
+	TriNode *p = &nodes.back();
+
+	if (last == nullptr)
+	{
+		p->prev = p;
+		p->next = p;
+	}
+	else
+	{
+		p->next = last->next;
+		p->prev = last;
+		last->next->prev = p;
+		last->next = p;
+	}
+
+	return p;
+}
+
+} // anonymous namespace
+
+namespace love
+{
+namespace math
+{
+
+void triangulate(const Vector2 *vertices, size_t count, const size_t *holeStarts, size_t holeCount, std::vector<uint32> &indices)
+{
+	if (count < 3)
+		throw love::Exception("Not a polygon");
+
+	for (size_t i = 0; i < holeCount; i++)
+	{
+		size_t end = i + 1 < holeCount ? holeStarts[i + 1] : count;
+		if (holeStarts[i] >= end || (i == 0 && holeStarts[i] < 3))
+			throw love::Exception("Invalid polygon hole.");
+	}
+
+	indices.clear();
+
+	if (count == 3 && holeCount == 0)
+	{
+		indices.push_back(0);
+		indices.push_back(1);
+		indices.push_back(2);
+		return;
+	}
+
+	Triangulator triangulator(vertices, indices);
+	triangulator.run(count, holeStarts, holeCount);
 }
 
 bool isConvex(const std::vector<love::Vector2> &polygon)
 {
-	if (polygon.size() < 3)
+	return isConvex(polygon.data(), polygon.size());
+}
+
+bool isConvex(const Vector2 *polygon, size_t count)
+{
+	if (count < 3)
 		return false;
 
 	// a polygon is convex if all corners turn in the same direction
 	// turning direction can be determined using the cross-product of
 	// the forward difference vectors
-	size_t i = polygon.size() - 2, j = polygon.size() - 1, k = 0;
+	size_t i = count - 2, j = count - 1, k = 0;
 	Vector2 p(polygon[j] - polygon[i]);
 	Vector2 q(polygon[k] - polygon[j]);
 	float winding = Vector2::cross(p, q);
 
-	while (k+1 < polygon.size())
+	while (k+1 < count)
 	{
 		i = j; j = k; k++;
 		p = polygon[j] - polygon[i];
 		q = polygon[k] - polygon[j];
 
-		if (Vector2::cross(p, q) * winding < 0)
+		// collinear corners don't tell us the direction yet
+		float cross = Vector2::cross(p, q);
+		if (winding == 0)
+			winding = cross;
+		else if (cross * winding < 0)
 			return false;
 	}
 	return true;
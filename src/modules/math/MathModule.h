@@ -44,21 +44,17 @@ namespace math
 class BezierCurve;
 class Transform;
 
-struct Triangle
-{
-	Triangle(const Vector2 &x, const Vector2 &y, const Vector2 &z)
-		: a(x), b(y), c(z)
-	{}
-	Vector2 a, b, c;
-};
-
 /**
- * Triangulate a simple polygon.
+ * Triangulate a simple polygon with holes, in O(n log n) time for typical
+ * inputs.
  *
- * @param polygon Polygon to triangulate. Must not intersect itself.
- * @return List of triangles the polygon is composed of.
+ * @param vertices The polygon's outline, followed by the outline of each hole.
+ * @param count Total number of vertices.
+ * @param holeStarts Index of the first vertex of each hole, in increasing order.
+ * @param holeCount Number of holes.
+ * @param[out] indices Three indices into vertices for each triangle.
  **/
-std::vector<Triangle> triangulate(const std::vector<love::Vector2> &polygon);
+void triangulate(const Vector2 *vertices, size_t count, const size_t *holeStarts, size_t holeCount, std::vector<uint32> &indices);
 
 /**
  * Checks whether a polygon is convex.
@@ -67,6 +63,7 @@ std::vector<Triangle> triangulate(const std::vector<love::Vector2> &polygon);
  * @return True if the polygon is convex, false otherwise.
  **/
 bool isConvex(const std::vector<love::Vector2> &polygon);
+bool isConvex(const Vector2 *polygon, size_t count);
 
 /**
  * Converts a value from the sRGB (gamma) colorspace to linear RGB.
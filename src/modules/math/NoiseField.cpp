@@ -0,0 +1,457 @@
+/**
+ * Copyright (c) 2006-2018 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+// LOVE
+#include "NoiseField.h"
+#include "common/config.h"
+#include "common/Exception.h"
+#include "common/int.h"
+#include "thread/JobSystem.h"
+
+// Noise
+#include "libraries/noise1234/noise1234.h"
+#include "libraries/noise1234/simplexnoise1234.h"
+
+// C++
+#include <algorithm>
+#include <cmath>
+
+#if defined(LOVE_SIMD_SSE2)
+#include <emmintrin.h>
+#endif
+
+namespace love
+{
+namespace math
+{
+
+// Rows are split across the job system's threads once a field needs this many
+// noise samples, counting every octave.
+static const int64 PARALLEL_NOISE_SAMPLES = 128 * 128;
+
+namespace
+{
+
+// The noise functions below compute the same 2D simplex and Perlin noise as
+// noise1234 (up to float rounding), for a row of x coordinates sharing one y.
+// They write values in [-1, 1]; count must be a multiple of 4.
+
+const float F2 = 0.366025403f; // 0.5 * (sqrt(3) - 1)
+const float G2 = 0.211324865f; // (3 - sqrt(3)) / 6
+
+inline int fastFloor(float x)
+{
+	int i = (int) x;
+	return x < (float) i ? i - 1 : i;
+}
+
+inline float fade(float t)
+{
+	return t * t * t * (t * (t * 6.0f - 15.0f) + 10.0f);
+}
+
+#if defined(LOVE_SIMD_SSE2)
+
+inline __m128i floor4(__m128 v)
+{
+	__m128i i = _mm_cvttps_epi32(v);
+	// Truncation rounds negative values up, take one off those. The
+	// comparison mask is -1 where that's needed.
+	return _mm_add_epi32(i, _mm_castps_si128(_mm_cmpgt_ps(_mm_cvtepi32_ps(i), v)));
+}
+
+// One of the 8 gradients picked by the low 3 bits of the hash: bit 2 swaps x
+// and y, bits 0 and 1 flip their signs. See noise1234's grad().
+inline __m128 grad4(__m128i hash, __m128 x, __m128 y)
+{
+	const __m128i four = _mm_set1_epi32(4);
+	__m128 swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(hash, four), four));
+
+	__m128 u = _mm_or_ps(_mm_and_ps(swap, y), _mm_andnot_ps(swap, x));
+	__m128 v = _mm_or_ps(_mm_and_ps(swap, x), _mm_andnot_ps(swap, y));
+
+	u = _mm_xor_ps(u, _mm_castsi128_ps(_mm_slli_epi32(hash, 31)));
+	v = _mm_xor_ps(v, _mm_castsi128_ps(_mm_slli_epi32(_mm_srli_epi32(hash, 1), 31)));
+
+	return _mm_add_ps(u, _mm_add_ps(v, v));
+}
+
+inline __m128 lerp4(__m128 t, __m128 a, __m128 b)
+{
+	return _mm_add_ps(a, _mm_mul_ps(t, _mm_sub_ps(b, a)));
+}
+
+void simplexRow(const float *xs, float y, int count, float *out)
+{
+	const unsigned char *perm = SimplexNoise1234::perm;
+
+	const __m128 vy = _mm_set1_ps(y);
+	const __m128 f2 = _mm_set1_ps(F2);
+	const __m128 g2 = _mm_set1_ps(G2);
+	const __m128 g2last = _mm_set1_ps(2.0f * G2 - 1.0f);
+	const __m128 half = _mm_set1_ps(0.5f);
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 scale = _mm_set1_ps(45.23f);
+	const __m128i wrap = _mm_set1_epi32(0xFF);
+
+	for (int k = 0; k < count; k += 4)
+	{
+		__m128 x = _mm_loadu_ps(xs + k);
+
+		// Skew to find the simplex cell, then unskew its origin.
+		__m128 s = _mm_mul_ps(_mm_add_ps(x, vy), f2);
+		__m128i i = floor4(_mm_add_ps(x, s));
+		__m128i j = floor4(_mm_add_ps(vy, s));
+		__m128 fi = _mm_cvtepi32_ps(i);
+		__m128 fj = _mm_cvtepi32_ps(j);
+		__m128 t = _mm_mul_ps(_mm_add_ps(fi, fj), g2);
+
+		__m128 x0 = _mm_sub_ps(x, _mm_sub_ps(fi, t));
+		__m128 y0 = _mm_sub_ps(vy, _mm_sub_ps(fj, t));
+
+		// Lower or upper triangle of the cell.
+		__m128 lower = _mm_cmpgt_ps(x0, y0);
+		__m128 x1 = _mm_add_ps(_mm_sub_ps(x0, _mm_and_ps(lower, one)), g2);
+		__m128 y1 = _mm_add_ps(_mm_sub_ps(y0, _mm_andnot_ps(lower, one)), g2);
+		__m128 x2 = _mm_add_ps(x0, g2last);
+		__m128 y2 = _mm_add_ps(y0, g2last);
+
+		// SSE2 has no gathers, the permutation table is read per lane.
+		alignas(16) int32 ia[4], ja[4], la[4];
+		alignas(16) int32 h[3][4];
+		_mm_store_si128((__m128i *) ia, _mm_and_si128(i, wrap));
+		_mm_store_si128((__m128i *) ja, _mm_and_si128(j, wrap));
+		_mm_store_si128((__m128i *) la, _mm_castps_si128(lower));
+
+		for (int l = 0; l < 4; l++)
+		{
+			int ii = ia[l], jj = ja[l];
+			int i1 = la[l] & 1, j1 = 1 - i1;
+			h[0][l] = perm[ii + perm[jj]];
+			h[1][l] = perm[ii + i1 + perm[jj + j1]];
+			h[2][l] = perm[ii + 1 + perm[jj + 1]];
+		}
+
+		// Contributions of the three corners, zero outside their radius.
+		__m128 t0 = _mm_max_ps(_mm_sub_ps(_mm_sub_ps(half, _mm_mul_ps(x0, x0)), _mm_mul_ps(y0, y0)), zero);
+		__m128 t1 = _mm_max_ps(_mm_sub_ps(_mm_sub_ps(half, _mm_mul_ps(x1, x1)), _mm_mul_ps(y1, y1)), zero);
+		__m128 t2 = _mm_max_ps(_mm_sub_ps(_mm_sub_ps(half, _mm_mul_ps(x2, x2)), _mm_mul_ps(y2, y2)), zero);
+
+		t0 = _mm_mul_ps(t0, t0);
+		t1 = _mm_mul_ps(t1, t1);
+		t2 = _mm_mul_ps(t2, t2);
+
+		__m128 n = _mm_mul_ps(_mm_mul_ps(t0, t0), grad4(_mm_load_si128((const __m128i *) h[0]), x0, y0));
+		n = _mm_add_ps(n, _mm_mul_ps(_mm_mul_ps(t1, t1), grad4(_mm_load_si128((const __m128i *) h[1]), x1, y1)));
+		n = _mm_add_ps(n, _mm_mul_ps(_mm_mul_ps(t2, t2), grad4(_mm_load_si128((const __m128i *) h[2]), x2, y2)));
+
+		_mm_storeu_ps(out + k, _mm_mul_ps(n, scale));
+	}
+}
+
+void perlinRow(const float *xs, float y, int count, float *out)
+{
+	const unsigned char *perm = Noise1234::perm;
+
+	// Everything along y is the same for the whole row.
+	int iy0 = fastFloor(y);
+	float fy0 = y - (float) iy0;
+	int py0 = perm[iy0 & 0xFF];
+	int py1 = perm[(iy0 + 1) & 0xFF];
+
+	const __m128 vfy0 = _mm_set1_ps(fy0);
+	const __m128 vfy1 = _mm_set1_ps(fy0 - 1.0f);
+	const __m128 vt = _mm_set1_ps(fade(fy0));
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128 six = _mm_set1_ps(6.0f);
+	const __m128 fifteen = _mm_set1_ps(15.0f);
+	const __m128 ten = _mm_set1_ps(10.0f);
+	const __m128 scale = _mm_set1_ps(0.507f);
+	const __m128i wrap = _mm_set1_epi32(0xFF);
+
+	for (int k = 0; k < count; k += 4)
+	{
+		__m128 x = _mm_loadu_ps(xs + k);
+
+		__m128i ix0 = floor4(x);
+		__m128 fx0 = _mm_sub_ps(x, _mm_cvtepi32_ps(ix0));
+		__m128 fx1 = _mm_sub_ps(fx0, one);
+
+		__m128 s = _mm_sub_ps(_mm_mul_ps(fx0, six), fifteen);
+		s = _mm_add_ps(_mm_mul_ps(fx0, s), ten);
+		s = _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(fx0, fx0), fx0), s);
+
+		alignas(16) int32 ia[4];
+		alignas(16) int32 h[4][4];
+		_mm_store_si128((__m128i *) ia, _mm_and_si128(ix0, wrap));
+
+		for (int l = 0; l < 4; l++)
+		{
+			int i0 = ia[l], i1 = (i0 + 1) & 0xFF;
+			h[0][l] = perm[i0 + py0];
+			h[1][l] = perm[i0 + py1];
+			h[2][l] = perm[i1 + py0];
+			h[3][l] = perm[i1 + py1];
+		}
+
+		__m128 n0 = lerp4(vt, grad4(_mm_load_si128((const __m128i *) h[0]), fx0, vfy0),
+		                      grad4(_mm_load_si128((const __m128i *) h[1]), fx0, vfy1));
+		__m128 n1 = lerp4(vt, grad4(_mm_load_si128((const __m128i *) h[2]), fx1, vfy0),
+		                      grad4(_mm_load_si128((const __m128i *) h[3]), fx1, vfy1));
+
+		_mm_storeu_ps(out + k, _mm_mul_ps(lerp4(s, n0, n1), scale));
+	}
+}
+
+#else // LOVE_SIMD_SSE2
+
+inline float grad(int hash, float x, float y)
+{
+	int h = hash & 7;
+	float u = h < 4 ? x : y;
+	float v = h < 4 ? y : x;
+	return ((h & 1) ? -u : u) + ((h & 2) ? -2.0f * v : 2.0f * v);
+}
+
+inline float lerp(float t, float a, float b)
+{
+	return a + t * (b - a);
+}
+
+void simplexRow(const float *xs, float y, int count, float *out)
+{
+	const unsigned char *perm = SimplexNoise1234::perm;
+
+	for (int k = 0; k < count; k++)
+	{
+		float x = xs[k];
+
+		float s = (x + y) * F2;
+		int i = fastFloor(x + s);
+		int j = fastFloor(y + s);
+		float t = ((float) i + (float) j) * G2;
+
+		float x0 = x - ((float) i - t);
+		float y0 = y - ((float) j - t);
+
+		int i1 = x0 > y0 ? 1 : 0;
+		int j1 = 1 - i1;
+
+		float x1 = x0 - (float) i1 + G2;
+		float y1 = y0 - (float) j1 + G2;
+		float x2 = x0 + (2.0f * G2 - 1.0f);
+		float y2 = y0 + (2.0f * G2 - 1.0f);
+
+		int ii = i & 0xFF;
+		int jj = j & 0xFF;
+
+		float t0 = std::max(0.5f - x0 * x0 - y0 * y0, 0.0f);
+		float t1 = std::max(0.5f - x1 * x1 - y1 * y1, 0.0f);
+		float t2 = std::max(0.5f - x2 * x2 - y2 * y2, 0.0f);
+
+		t0 *= t0;
+		t1 *= t1;
+		t2 *= t2;
+
+		float n = t0 * t0 * grad(perm[ii + perm[jj]], x0, y0);
+		n += t1 * t1 * grad(perm[ii + i1 + perm[jj + j1]], x1, y1);
+		n += t2 * t2 * grad(perm[ii + 1 + perm[jj + 1]], x2, y2);
+
+		out[k] = 45.23f * n;
+	}
+}
+
+void perlinRow(const float *xs, float y, int count, float *out)
+{
+	const unsigned char *perm = Noise1234::perm;
+
+	int iy0 = fastFloor(y);
+	float fy0 = y - (float) iy0;
+	float fy1 = fy0 - 1.0f;
+	float t = fade(fy0);
+	int py0 = perm[iy0 & 0xFF];
+	int py1 = perm[(iy0 + 1) & 0xFF];
+
+	for (int k = 0; k < count; k++)
+	{
+		float x = xs[k];
+
+		int ix0 = fastFloor(x);
+		float fx0 = x - (float) ix0;
+		float fx1 = fx0 - 1.0f;
+		float s = fade(fx0);
+
+		int i0 = ix0 & 0xFF;
+		int i1 = (i0 + 1) & 0xFF;
+
+		float n0 = lerp(t, grad(perm[i0 + py0], fx0, fy0), grad(perm[i0 + py1], fx0, fy1));
+		float n1 = lerp(t, grad(perm[i1 + py0], fx1, fy0), grad(perm[i1 + py1], fx1, fy1));
+
+		out[k] = 0.507f * lerp(s, n0, n1);
+	}
+}
+
+#endif // LOVE_SIMD_SSE2
+
+} // anonymous namespace
+
+void NoiseField::generate(const Settings &settings, int width, int height, const RowFunction &func)
+{
+	if (settings.octaves < 1)
+		throw love::Exception("Noise must have at least one octave.");
+
+	if (width <= 0 || height <= 0)
+		return;
+
+	void (*noiseRow)(const float *, float, int, float *) = settings.type == TYPE_PERLIN ? perlinRow : simplexRow;
+	bool ridged = settings.fractal == FRACTAL_RIDGED;
+	int octaves = settings.octaves;
+
+	// Rows are padded to whole groups of 4 samples.
+	int padded = (width + 3) & ~3;
+
+	// The octaves' weights add up to this, dividing by it keeps the result in
+	// the same range as a single octave.
+	float totalweight = 0.0f;
+	float weight = 1.0f;
+	for (int o = 0; o < octaves; o++)
+	{
+		totalweight += std::abs(weight);
+		weight *= settings.gain;
+	}
+
+	float invweight = 1.0f / totalweight;
+
+	auto generateRows = [&](int64 first, int64 last)
+	{
+		std::vector<float> buffer(padded * 3);
+		float *xs = buffer.data();
+		float *noise = xs + padded;
+		float *sum = noise + padded;
+
+		for (int row = (int) first; row < (int) last; row++)
+		{
+			float frequency = settings.frequency;
+			float w = 1.0f;
+
+			std::fill(sum, sum + padded, 0.0f);
+
+			for (int o = 0; o < octaves; o++)
+			{
+				for (int i = 0; i < padded; i++)
+					xs[i] = (settings.x + (float) i) * frequency;
+
+				noiseRow(xs, (settings.y + (float) row) * frequency, padded, noise);
+
+				if (ridged)
+				{
+					// Sharp creases where the noise crosses zero.
+					for (int i = 0; i < padded; i++)
+					{
+						float r = 1.0f - std::abs(noise[i]);
+						sum[i] += w * r * r;
+					}
+				}
+				else
+				{
+					for (int i = 0; i < padded; i++)
+						sum[i] += w * noise[i];
+				}
+
+				frequency *= settings.lacunarity;
+				w *= settings.gain;
+			}
+
+			// Ridged noise is already in [0, 1], fBm is in [-1, 1].
+			if (ridged)
+			{
+				for (int i = 0; i < width; i++)
+					sum[i] *= invweight;
+			}
+			else
+			{
+				for (int i = 0; i < width; i++)
+					sum[i] = sum[i] * invweight * 0.5f + 0.5f;
+			}
+
+			func(row, sum);
+		}
+	};
+
+	int64 samples = (int64) width * height * octaves;
+
+	if (samples >= PARALLEL_NOISE_SAMPLES && height > 1)
+	{
+		int64 grain = std::max(PARALLEL_NOISE_SAMPLES / 4 / ((int64) padded * octaves), (int64) 1);
+		love::thread::JobSystem::getInstance()->parallelFor(height, grain, generateRows);
+	}
+	else
+		generateRows(0, height);
+}
+
+bool NoiseField::getConstant(const char *in, Type &out)
+{
+	return types.find(in, out);
+}
+
+bool NoiseField::getConstant(Type in, const char *&out)
+{
+	return types.find(in, out);
+}
+
+std::vector<std::string> NoiseField::getConstants(Type)
+{
+	return types.getNames();
+}
+
+bool NoiseField::getConstant(const char *in, Fractal &out)
+{
+	return fractals.find(in, out);
+}
+
+bool NoiseField::getConstant(Fractal in, const char *&out)
+{
+	return fractals.find(in, out);
+}
+
+std::vector<std::string> NoiseField::getConstants(Fractal)
+{
+	return fractals.getNames();
+}
+
+StringMap<NoiseField::Type, NoiseField::TYPE_MAX_ENUM>::Entry NoiseField::typeEntries[] =
+{
+	{ "simplex", TYPE_SIMPLEX },
+	{ "perlin",  TYPE_PERLIN  },
+};
+
+StringMap<NoiseField::Type, NoiseField::TYPE_MAX_ENUM> NoiseField::types(NoiseField::typeEntries, sizeof(NoiseField::typeEntries));
+
+StringMap<NoiseField::Fractal, NoiseField::FRACTAL_MAX_ENUM>::Entry NoiseField::fractalEntries[] =
+{
+	{ "fbm",    FRACTAL_FBM    },
+	{ "ridged", FRACTAL_RIDGED },
+};
+
+StringMap<NoiseField::Fractal, NoiseField::FRACTAL_MAX_ENUM> NoiseField::fractals(NoiseField::fractalEntries, sizeof(NoiseField::fractalEntries));
+
+} // math
+} // love
@@ -0,0 +1,112 @@
+/**
+ * Copyright (c) 2006-2018 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#ifndef LOVE_MATH_NOISE_FIELD_H
+#define LOVE_MATH_NOISE_FIELD_H
+
+// LOVE
+#include "common/StringMap.h"
+
+// C++
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace love
+{
+namespace math
+{
+
+/**
+ * Generates fractal 2D noise over a grid, as a faster alternative to calling
+ * love.math.noise for every sample. Rows are split across the job system's
+ * threads, and on x86 the noise is computed four samples at a time.
+ **/
+class NoiseField
+{
+public:
+
+	enum Type
+	{
+		TYPE_SIMPLEX,
+		TYPE_PERLIN,
+		TYPE_MAX_ENUM
+	};
+
+	enum Fractal
+	{
+		FRACTAL_FBM,
+		FRACTAL_RIDGED,
+		FRACTAL_MAX_ENUM
+	};
+
+	struct Settings
+	{
+		Type type = TYPE_SIMPLEX;
+		Fractal fractal = FRACTAL_FBM;
+
+		// Grid coordinates of the first sample.
+		float x = 0.0f;
+		float y = 0.0f;
+
+		// Sample (x + i, y + j) of the first octave is taken at
+		// ((x + i) * frequency, (y + j) * frequency) in noise space. Each
+		// further octave multiplies the frequency by lacunarity and its
+		// weight by gain.
+		float frequency = 1.0f;
+		int octaves = 1;
+		float lacunarity = 2.0f;
+		float gain = 0.5f;
+	};
+
+	/**
+	 * Receives a row of width samples, in [0, 1] give or take a little.
+	 * Different rows may be passed in at the same time from several threads.
+	 **/
+	typedef std::function<void(int row, const float *samples)> RowFunction;
+
+	/**
+	 * Generates width x height samples and passes them to func, a row at a
+	 * time.
+	 **/
+	static void generate(const Settings &settings, int width, int height, const RowFunction &func);
+
+	static bool getConstant(const char *in, Type &out);
+	static bool getConstant(Type in, const char *&out);
+	static std::vector<std::string> getConstants(Type);
+
+	static bool getConstant(const char *in, Fractal &out);
+	static bool getConstant(Fractal in, const char *&out);
+	static std::vector<std::string> getConstants(Fractal);
+
+private:
+
+	static StringMap<Type, TYPE_MAX_ENUM>::Entry typeEntries[];
+	static StringMap<Type, TYPE_MAX_ENUM> types;
+
+	static StringMap<Fractal, FRACTAL_MAX_ENUM>::Entry fractalEntries[];
+	static StringMap<Fractal, FRACTAL_MAX_ENUM> fractals;
+
+}; // NoiseField
+
+} // math
+} // love
+
+#endif // LOVE_MATH_NOISE_FIELD_H
@@ -23,6 +23,7 @@
 // C++
 #include <sstream>
 #include <iomanip>
+#include <algorithm>
 
 // C
 #include <cmath>
@@ -47,11 +48,50 @@ static uint64 wangHash64(uint64 key)
 	return key;
 }
 
-love::Type RandomGenerator::type("RandomGenerator", &Object::type);
-
 // 64 bit Xorshift implementation taken from the end of Sec. 3 (page 4) in
 // George Marsaglia, "Xorshift RNGs", Journal of Statistical Software, Vol.8 (Issue 14), 2003
 // Use an 'Xorshift*' variant, as shown here: http://xorshift.di.unimi.it
+static inline uint64 xorshift64(uint64 x)
+{
+	x ^= (x >> 12);
+	x ^= (x << 25);
+	x ^= (x >> 27);
+	return x;
+}
+
+// Each step of xorshift is linear over GF(2), so n steps can be taken at once
+// by multiplying the state with the n-th power of the step's 64x64 bit
+// matrix. Matrices are stored as their columns, i.e. column i is what state
+// bit i on its own turns into.
+static uint64 multiplyBitMatrix(const uint64 *columns, uint64 v)
+{
+	uint64 r = 0;
+	for (int i = 0; i < 64; i++)
+		r ^= columns[i] & (0 - ((v >> i) & 1));
+	return r;
+}
+
+struct JumpMatrix
+{
+	uint64 columns[64];
+
+	JumpMatrix()
+	{
+		for (int i = 0; i < 64; i++)
+			columns[i] = xorshift64(1ULL << i);
+
+		// Squaring the matrix doubles the number of steps it takes.
+		for (int e = 0; e < RandomGenerator::JUMP_EXPONENT; e++)
+		{
+			uint64 squared[64];
+			for (int i = 0; i < 64; i++)
+				squared[i] = multiplyBitMatrix(columns, columns[i]);
+			std::copy(squared, squared + 64, columns);
+		}
+	}
+};
+
+love::Type RandomGenerator::type("RandomGenerator", &Object::type);
 
 RandomGenerator::RandomGenerator()
 	: last_randomnormal(std::numeric_limits<double>::infinity())
@@ -66,9 +106,7 @@ RandomGenerator::RandomGenerator()
 
 uint64 RandomGenerator::rand()
 {
-	rng_state.b64 ^= (rng_state.b64 >> 12);
-	rng_state.b64 ^= (rng_state.b64 << 25);
-	rng_state.b64 ^= (rng_state.b64 >> 27);
+	rng_state.b64 = xorshift64(rng_state.b64);
 	return rng_state.b64 * 2685821657736338717ULL;
 }
 
@@ -90,6 +128,129 @@ double RandomGenerator::randomNormal(double stddev)
 	return r * sin(phi) * stddev;
 }
 
+void RandomGenerator::fillUniform(float *dst, size_t count, double min, double max)
+{
+	for (size_t i = 0; i < count; i++)
+		dst[i] = (float) random(min, max);
+}
+
+void RandomGenerator::fillInteger(int32 *dst, size_t count, double min, double max)
+{
+	// Same formula as wrap_RandomGenerator.lua.
+	double range = max - min + 1.0;
+	for (size_t i = 0; i < count; i++)
+		dst[i] = (int32) (floor(random() * range) + min);
+}
+
+void RandomGenerator::fillNormal(float *dst, size_t count, double stddev, double mean)
+{
+	size_t i = 0;
+
+	// Use up the cached number first, so the output matches randomNormal.
+	if (count > 0 && last_randomnormal != std::numeric_limits<double>::infinity())
+		dst[i++] = (float) (randomNormal(stddev) + mean);
+
+	// Both numbers of each Box-Muller pair go straight into the output.
+	for (; i + 1 < count; i += 2)
+	{
+		double r   = sqrt(-2.0 * log(1. - random()));
+		double phi = 2.0 * LOVE_M_PI * (1. - random());
+
+		dst[i + 0] = (float) (r * sin(phi) * stddev + mean);
+		dst[i + 1] = (float) (r * cos(phi) * stddev + mean);
+	}
+
+	if (i < count)
+		dst[i] = (float) (randomNormal(stddev) + mean);
+}
+
+void RandomGenerator::fillWeighted(int32 *dst, size_t count, const std::vector<double> &weights)
+{
+	size_t n = weights.size();
+
+	if (n == 0)
+		throw love::Exception("At least one weight must be given.");
+
+	if (n > (size_t) std::numeric_limits<int32>::max())
+		throw love::Exception("Too many weights.");
+
+	double total = 0.0;
+	for (double w : weights)
+	{
+		if (!(w >= 0.0) || w == std::numeric_limits<double>::infinity())
+			throw love::Exception("Weights must be finite, non-negative numbers.");
+		total += w;
+	}
+
+	if (total <= 0.0)
+		throw love::Exception("At least one weight must be greater than 0.");
+
+	// Vose's alias method: every column i is hit with probability 1/n, and
+	// then either picks i (with probability prob[i]) or alias[i].
+	std::vector<double> prob(n);
+	std::vector<int32> alias(n);
+	std::vector<int32> small;
+	std::vector<int32> large;
+
+	for (size_t i = 0; i < n; i++)
+	{
+		prob[i] = weights[i] * n / total;
+		alias[i] = (int32) i;
+
+		if (prob[i] < 1.0)
+			small.push_back((int32) i);
+		else
+			large.push_back((int32) i);
+	}
+
+	while (!small.empty() && !large.empty())
+	{
+		int32 s = small.back();
+		int32 l = large.back();
+		small.pop_back();
+
+		alias[s] = l;
+		prob[l] = (prob[l] + prob[s]) - 1.0;
+
+		if (prob[l] < 1.0)
+		{
+			large.pop_back();
+			small.push_back(l);
+		}
+	}
+
+	// Whatever is left over is only off from 1 by rounding errors.
+	for (int32 i : large)
+		prob[i] = 1.0;
+	for (int32 i : small)
+		prob[i] = 1.0;
+
+	for (size_t i = 0; i < count; i++)
+	{
+		double u = random() * n;
+		size_t column = std::min((size_t) u, n - 1);
+		dst[i] = (u - column) < prob[column] ? (int32) column : alias[column];
+	}
+}
+
+void RandomGenerator::jump(uint32 count)
+{
+	static const JumpMatrix matrix;
+
+	for (uint32 i = 0; i < count; i++)
+		rng_state.b64 = multiplyBitMatrix(matrix.columns, rng_state.b64);
+
+	// The cached number belongs to the stream we just jumped over.
+	last_randomnormal = std::numeric_limits<double>::infinity();
+}
+
+RandomGenerator *RandomGenerator::split()
+{
+	RandomGenerator *rng = new RandomGenerator(*this);
+	jump();
+	return rng;
+}
+
 void RandomGenerator::setSeed(RandomGenerator::Seed newseed)
 {
 	seed = newseed;
@@ -141,5 +302,30 @@ std::string RandomGenerator::getState() const
 	return ss.str();
 }
 
+bool RandomGenerator::getConstant(const char *in, Distribution &out)
+{
+	return distributions.find(in, out);
+}
+
+bool RandomGenerator::getConstant(Distribution in, const char *&out)
+{
+	return distributions.find(in, out);
+}
+
+std::vector<std::string> RandomGenerator::getConstants(Distribution)
+{
+	return distributions.getNames();
+}
+
+StringMap<RandomGenerator::Distribution, RandomGenerator::DISTRIBUTION_MAX_ENUM>::Entry RandomGenerator::distributionEntries[] =
+{
+	{ "uniform",  DISTRIBUTION_UNIFORM  },
+	{ "integer",  DISTRIBUTION_INTEGER  },
+	{ "normal",   DISTRIBUTION_NORMAL   },
+	{ "weighted", DISTRIBUTION_WEIGHTED },
+};
+
+StringMap<RandomGenerator::Distribution, RandomGenerator::DISTRIBUTION_MAX_ENUM> RandomGenerator::distributions(RandomGenerator::distributionEntries, sizeof(RandomGenerator::distributionEntries));
+
 } // math
 } // love
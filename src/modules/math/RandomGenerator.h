@@ -27,10 +27,12 @@
 #include "common/math.h"
 #include "common/int.h"
 #include "common/Object.h"
+#include "common/StringMap.h"
 
 // C++
 #include <limits>
 #include <string>
+#include <vector>
 
 namespace love
 {
@@ -43,6 +45,24 @@ public:
 
 	static love::Type type;
 
+	enum Distribution
+	{
+		DISTRIBUTION_UNIFORM,
+		DISTRIBUTION_INTEGER,
+		DISTRIBUTION_NORMAL,
+		DISTRIBUTION_WEIGHTED,
+		DISTRIBUTION_MAX_ENUM
+	};
+
+	/**
+	 * Number of rand() calls skipped by a single jump(). The generator's
+	 * period is 2^64 - 1, so this gives 65535 non-overlapping streams.
+	 **/
+	static const int JUMP_EXPONENT = 48;
+
+	// Jumping further than this wraps around to states already handed out.
+	static const uint32 MAX_JUMP_COUNT = (1u << (64 - JUMP_EXPONENT)) - 1;
+
 	union Seed
 	{
 		uint64 b64;
@@ -112,6 +132,46 @@ public:
 	 **/
 	double randomNormal(double stddev);
 
+	/**
+	 * Fills dst with count calls' worth of random(min, max), rounded to
+	 * float (which can round a number just below max up to max).
+	 **/
+	void fillUniform(float *dst, size_t count, double min, double max);
+
+	/**
+	 * Fills dst with count integers in [min, max], the same integers count
+	 * calls to RandomGenerator:random(min, max) in Lua would give.
+	 **/
+	void fillInteger(int32 *dst, size_t count, double min, double max);
+
+	/**
+	 * Fills dst with count calls' worth of randomNormal(stddev) + mean,
+	 * rounded to float.
+	 **/
+	void fillNormal(float *dst, size_t count, double stddev, double mean);
+
+	/**
+	 * Fills dst with count indices in [0, weights.size()), each picked with a
+	 * probability proportional to its weight. Uses Vose's alias method, so
+	 * every sample takes constant time regardless of the number of weights.
+	 **/
+	void fillWeighted(int32 *dst, size_t count, const std::vector<double> &weights);
+
+	/**
+	 * Advances the state by count * 2^JUMP_EXPONENT calls to rand(), without
+	 * having to make them. count must not exceed MAX_JUMP_COUNT.
+	 **/
+	void jump(uint32 count = 1);
+
+	/**
+	 * Creates a generator which continues from this one's state, and then
+	 * jumps this one ahead. The new generator won't reach the state this one
+	 * is left in until 2^JUMP_EXPONENT numbers have been drawn from it, so
+	 * repeated splits of a generator hand out independent, reproducible
+	 * streams (e.g. one per thread).
+	 **/
+	RandomGenerator *split();
+
 	/**
 	 * Set pseudo-random seed.
 	 * It's up to the implementation how to use this.
@@ -134,8 +194,15 @@ public:
 	 **/
 	std::string getState() const;
 
+	static bool getConstant(const char *in, Distribution &out);
+	static bool getConstant(Distribution in, const char *&out);
+	static std::vector<std::string> getConstants(Distribution);
+
 private:
 
+	static StringMap<Distribution, DISTRIBUTION_MAX_ENUM>::Entry distributionEntries[];
+	static StringMap<Distribution, DISTRIBUTION_MAX_ENUM> distributions;
+
 	Seed seed;
 	Seed rng_state;
 	double last_randomnormal;
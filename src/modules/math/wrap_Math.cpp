@@ -25,12 +25,20 @@
 #include "MathModule.h"
 #include "BezierCurve.h"
 #include "Transform.h"
+#include "NoiseField.h"
 
 #include "data/wrap_DataModule.h"
 #include "data/wrap_CompressedData.h"
+#include "data/wrap_ByteData.h"
 #include "data/DataModule.h"
+#include "common/halffloat.h"
+
+#ifdef LOVE_ENABLE_IMAGE
+#include "image/ImageData.h"
+#endif
 
 #include <cmath>
+#include <cstring>
 #include <iostream>
 #include <algorithm>
 
@@ -147,24 +155,46 @@ int w_newTransform(lua_State *L)
 	return 1;
 }
 
+static void luax_checkvertextable(lua_State *L, int idx, std::vector<love::Vector2> &vertices)
+{
+	int top = (int) luax_objlen(L, idx);
+	vertices.reserve(vertices.size() + top / 2);
+	for (int i = 1; i <= top; i += 2)
+	{
+		lua_rawgeti(L, idx, i);
+		lua_rawgeti(L, idx, i+1);
+
+		Vector2 v;
+		v.x = (float) luaL_checknumber(L, -2);
+		v.y = (float) luaL_checknumber(L, -1);
+		vertices.push_back(v);
+
+		lua_pop(L, 2);
+	}
+}
+
 int w_triangulate(lua_State *L)
 {
 	std::vector<love::Vector2> vertices;
+	std::vector<size_t> holes;
+
 	if (lua_istable(L, 1))
 	{
-		int top = (int) luax_objlen(L, 1);
-		vertices.reserve(top / 2);
-		for (int i = 1; i <= top; i += 2)
-		{
-			lua_rawgeti(L, 1, i);
-			lua_rawgeti(L, 1, i+1);
+		luax_checkvertextable(L, 1, vertices);
 
-			Vector2 v;
-			v.x = (float) luaL_checknumber(L, -2);
-			v.y = (float) luaL_checknumber(L, -1);
-			vertices.push_back(v);
-
-			lua_pop(L, 2);
+		// Optional list of holes, each a table of vertices like the outline.
+		if (!lua_isnoneornil(L, 2))
+		{
+			luaL_checktype(L, 2, LUA_TTABLE);
+			int count = (int) luax_objlen(L, 2);
+			for (int i = 1; i <= count; i++)
+			{
+				lua_rawgeti(L, 2, i);
+				luaL_checktype(L, -1, LUA_TTABLE);
+				holes.push_back(vertices.size());
+				luax_checkvertextable(L, lua_gettop(L), vertices);
+				lua_pop(L, 1);
+			}
 		}
 	}
 	else
@@ -183,33 +213,25 @@ int w_triangulate(lua_State *L)
 	if (vertices.size() < 3)
 		return luaL_error(L, "Need at least 3 vertices to triangulate");
 
-	std::vector<Triangle> triangles;
-
+	std::vector<uint32> indices;
 	luax_catchexcept(L, [&]() {
-		if (vertices.size() == 3)
-			triangles.push_back(Triangle(vertices[0], vertices[1], vertices[2]));
-		else
-			triangles = triangulate(vertices);
+		triangulate(vertices.data(), vertices.size(), holes.data(), holes.size(), indices);
 	});
 
-	lua_createtable(L, (int) triangles.size(), 0);
-	for (int i = 0; i < (int) triangles.size(); ++i)
-	{
-		const Triangle &tri = triangles[i];
+	int trianglecount = (int) indices.size() / 3;
 
+	lua_createtable(L, trianglecount, 0);
+	for (int i = 0; i < trianglecount; ++i)
+	{
 		lua_createtable(L, 6, 0);
-		lua_pushnumber(L, tri.a.x);
-		lua_rawseti(L, -2, 1);
-		lua_pushnumber(L, tri.a.y);
-		lua_rawseti(L, -2, 2);
-		lua_pushnumber(L, tri.b.x);
-		lua_rawseti(L, -2, 3);
-		lua_pushnumber(L, tri.b.y);
-		lua_rawseti(L, -2, 4);
-		lua_pushnumber(L, tri.c.x);
-		lua_rawseti(L, -2, 5);
-		lua_pushnumber(L, tri.c.y);
-		lua_rawseti(L, -2, 6);
+		for (int j = 0; j < 3; j++)
+		{
+			const Vector2 &v = vertices[indices[i * 3 + j]];
+			lua_pushnumber(L, v.x);
+			lua_rawseti(L, -2, j * 2 + 1);
+			lua_pushnumber(L, v.y);
+			lua_rawseti(L, -2, j * 2 + 2);
+		}
 
 		lua_rawseti(L, -2, i+1);
 	}
@@ -221,22 +243,7 @@ int w_isConvex(lua_State *L)
 {
 	std::vector<love::Vector2> vertices;
 	if (lua_istable(L, 1))
-	{
-		int top = (int) luax_objlen(L, 1);
-		vertices.reserve(top / 2);
-		for (int i = 1; i <= top; i += 2)
-		{
-			lua_rawgeti(L, 1, i);
-			lua_rawgeti(L, 1, i+1);
-
-			love::Vector2 v;
-			v.x = (float) luaL_checknumber(L, -2);
-			v.y = (float) luaL_checknumber(L, -1);
-			vertices.push_back(v);
-
-			lua_pop(L, 2);
-		}
-	}
+		luax_checkvertextable(L, 1, vertices);
 	else
 	{
 		int top = lua_gettop(L);
@@ -348,6 +355,165 @@ int w_noise(lua_State *L)
 	return 1;
 }
 
+static void luax_checknoisesettings(lua_State *L, int idx, NoiseField::Settings &s)
+{
+	if (lua_isnoneornil(L, idx))
+		return;
+
+	luaL_checktype(L, idx, LUA_TTABLE);
+
+	lua_getfield(L, idx, "type");
+	if (!lua_isnoneornil(L, -1))
+	{
+		const char *str = luaL_checkstring(L, -1);
+		if (!NoiseField::getConstant(str, s.type))
+			luax_enumerror(L, "noise type", NoiseField::getConstants(s.type), str);
+	}
+	lua_pop(L, 1);
+
+	lua_getfield(L, idx, "fractal");
+	if (!lua_isnoneornil(L, -1))
+	{
+		const char *str = luaL_checkstring(L, -1);
+		if (!NoiseField::getConstant(str, s.fractal))
+			luax_enumerror(L, "fractal noise type", NoiseField::getConstants(s.fractal), str);
+	}
+	lua_pop(L, 1);
+
+	s.x = (float) luax_numberflag(L, idx, "x", s.x);
+	s.y = (float) luax_numberflag(L, idx, "y", s.y);
+	s.frequency = (float) luax_numberflag(L, idx, "frequency", s.frequency);
+	s.octaves = luax_intflag(L, idx, "octaves", s.octaves);
+	s.lacunarity = (float) luax_numberflag(L, idx, "lacunarity", s.lacunarity);
+	s.gain = (float) luax_numberflag(L, idx, "gain", s.gain);
+}
+
+#ifdef LOVE_ENABLE_IMAGE
+
+static inline uint8 noiseToUnorm8(float v)
+{
+	return (uint8) (std::min(std::max(v, 0.0f), 1.0f) * 255.0f + 0.5f);
+}
+
+static inline uint16 noiseToUnorm16(float v)
+{
+	return (uint16) (std::min(std::max(v, 0.0f), 1.0f) * 65535.0f + 0.5f);
+}
+
+static inline float noiseToFloat(float v)
+{
+	return v;
+}
+
+typedef void (*NoiseRowWriter)(void *dst, const float *samples, int width);
+
+// The first colors components of each pixel get the noise value (so RGB is
+// grey), the rest (alpha) are opaque.
+template <typename T, T (*convert)(float), int colors, int components>
+static void writeNoiseRow(void *dst, const float *samples, int width)
+{
+	T one = convert(1.0f);
+	T *p = (T *) dst;
+
+	for (int i = 0; i < width; i++)
+	{
+		T v = convert(samples[i]);
+		for (int c = 0; c < components; c++)
+			p[c] = c < colors ? v : one;
+		p += components;
+	}
+}
+
+static NoiseRowWriter getNoiseRowWriter(PixelFormat format)
+{
+	switch (format)
+	{
+	case PIXELFORMAT_R8:
+		return writeNoiseRow<uint8, noiseToUnorm8, 1, 1>;
+	case PIXELFORMAT_RG8:
+		return writeNoiseRow<uint8, noiseToUnorm8, 2, 2>;
+	case PIXELFORMAT_LA8:
+		return writeNoiseRow<uint8, noiseToUnorm8, 1, 2>;
+	case PIXELFORMAT_RGBA8:
+	case PIXELFORMAT_sRGBA8:
+		return writeNoiseRow<uint8, noiseToUnorm8, 3, 4>;
+	case PIXELFORMAT_R16:
+		return writeNoiseRow<uint16, noiseToUnorm16, 1, 1>;
+	case PIXELFORMAT_RG16:
+		return writeNoiseRow<uint16, noiseToUnorm16, 2, 2>;
+	case PIXELFORMAT_RGBA16:
+		return writeNoiseRow<uint16, noiseToUnorm16, 3, 4>;
+	case PIXELFORMAT_R16F:
+		return writeNoiseRow<half, floatToHalf, 1, 1>;
+	case PIXELFORMAT_RG16F:
+		return writeNoiseRow<half, floatToHalf, 2, 2>;
+	case PIXELFORMAT_RGBA16F:
+		return writeNoiseRow<half, floatToHalf, 3, 4>;
+	case PIXELFORMAT_R32F:
+		return writeNoiseRow<float, noiseToFloat, 1, 1>;
+	case PIXELFORMAT_RG32F:
+		return writeNoiseRow<float, noiseToFloat, 2, 2>;
+	case PIXELFORMAT_RGBA32F:
+		return writeNoiseRow<float, noiseToFloat, 3, 4>;
+	default:
+		throw love::Exception("Unsupported ImageData format");
+	}
+}
+
+#endif // LOVE_ENABLE_IMAGE
+
+int w_fillNoise(lua_State *L)
+{
+	NoiseField::Settings settings;
+
+#ifdef LOVE_ENABLE_IMAGE
+	if (luax_istype(L, 1, love::image::ImageData::type))
+	{
+		love::image::ImageData *img = luax_checktype<love::image::ImageData>(L, 1);
+		luax_checknoisesettings(L, 2, settings);
+
+		PixelFormat format = img->getFormat();
+		int width = img->getWidth();
+		int height = img->getHeight();
+		size_t rowsize = img->getPixelSize() * width;
+		uint8 *data = (uint8 *) img->getData();
+
+		luax_catchexcept(L, [&]() {
+			NoiseRowWriter writeRow = getNoiseRowWriter(format);
+			love::thread::Lock lock(img->getMutex());
+			NoiseField::generate(settings, width, height, [&](int row, const float *samples)
+			{
+				writeRow(data + row * rowsize, samples, width);
+			});
+		});
+	}
+	else
+#endif // LOVE_ENABLE_IMAGE
+	{
+		love::data::ByteData *data = love::data::luax_checkbytedata(L, 1);
+		int width = (int) luaL_checkinteger(L, 2);
+		int height = (int) luaL_checkinteger(L, 3);
+		luax_checknoisesettings(L, 4, settings);
+
+		if (width <= 0 || height <= 0)
+			return luaL_error(L, "Invalid noise field dimensions.");
+
+		if ((size_t) width * height * sizeof(float) > data->getSize())
+			return luaL_error(L, "The ByteData is too small for %d x %d float values.", width, height);
+
+		float *dst = (float *) data->getData();
+
+		luax_catchexcept(L, [&]() {
+			NoiseField::generate(settings, width, height, [&](int row, const float *samples)
+			{
+				memcpy(dst + (size_t) row * width, samples, width * sizeof(float));
+			});
+		});
+	}
+
+	return 0;
+}
+
 int w_compress(lua_State *L)
 {
 	using namespace love::data;
@@ -460,6 +626,7 @@ static const luaL_Reg functions[] =
 	{ "gammaToLinear", w_gammaToLinear },
 	{ "linearToGamma", w_linearToGamma },
 	{ "noise", w_noise },
+	{ "fillNoise", w_fillNoise },
 
 	// Deprecated.
 	{ "compress", w_compress },
@@ -19,9 +19,11 @@
  **/
 
 #include "wrap_RandomGenerator.h"
+#include "data/wrap_ByteData.h"
 
 #include <cmath>
 #include <algorithm>
+#include <vector>
 
 // Put the Lua code directly into a raw string literal.
 static const char randomgenerator_lua[] =
@@ -85,6 +87,109 @@ int w_RandomGenerator_randomNormal(lua_State *L)
 	return 1;
 }
 
+int w_RandomGenerator_fill(lua_State *L)
+{
+	RandomGenerator *rng = luax_checkrandomgenerator(L, 1);
+	love::data::ByteData *data = love::data::luax_checkbytedata(L, 2);
+	lua_Integer count = luaL_checkinteger(L, 3);
+
+	const char *diststr = luaL_checkstring(L, 4);
+	RandomGenerator::Distribution dist;
+	if (!RandomGenerator::getConstant(diststr, dist))
+		return luax_enumerror(L, "random distribution", RandomGenerator::getConstants(dist), diststr);
+
+	if (count < 0)
+		return luaL_argerror(L, 3, "count must not be negative");
+
+	// Every distribution writes either floats or 32 bit integers.
+	if ((size_t) count > data->getSize() / sizeof(float))
+		return luaL_error(L, "The ByteData is too small for %d values.", (int) count);
+
+	float *floats = (float *) data->getData();
+	int32 *ints = (int32 *) data->getData();
+
+	switch (dist)
+	{
+	case RandomGenerator::DISTRIBUTION_UNIFORM:
+	{
+		double min = luaL_optnumber(L, 5, 0.0);
+		double max = luaL_optnumber(L, 6, 1.0);
+		rng->fillUniform(floats, (size_t) count, min, max);
+		break;
+	}
+	case RandomGenerator::DISTRIBUTION_INTEGER:
+	{
+		// Same arguments as RandomGenerator:random(max) and random(min, max).
+		double min = 1.0;
+		double max = luaL_checknumber(L, 5);
+		if (!lua_isnoneornil(L, 6))
+		{
+			min = max;
+			max = luaL_checknumber(L, 6);
+		}
+
+		if (!(min <= max))
+			return luaL_error(L, "Invalid integer range: [%f, %f]", min, max);
+
+		if (min < (double) std::numeric_limits<int32>::min() || max > (double) std::numeric_limits<int32>::max())
+			return luaL_error(L, "Integer range must fit in 32 bits.");
+
+		rng->fillInteger(ints, (size_t) count, min, max);
+		break;
+	}
+	case RandomGenerator::DISTRIBUTION_NORMAL:
+	{
+		double stddev = luaL_optnumber(L, 5, 1.0);
+		double mean = luaL_optnumber(L, 6, 0.0);
+		rng->fillNormal(floats, (size_t) count, stddev, mean);
+		break;
+	}
+	case RandomGenerator::DISTRIBUTION_WEIGHTED:
+	default:
+	{
+		luaL_checktype(L, 5, LUA_TTABLE);
+
+		std::vector<double> weights(luax_objlen(L, 5));
+		for (size_t i = 0; i < weights.size(); i++)
+		{
+			lua_rawgeti(L, 5, (int) i + 1);
+			weights[i] = luaL_checknumber(L, -1);
+			lua_pop(L, 1);
+		}
+
+		luax_catchexcept(L, [&](){ rng->fillWeighted(ints, (size_t) count, weights); });
+
+		// Indices into the weights table, starting at 1 like the table does.
+		for (lua_Integer i = 0; i < count; i++)
+			ints[i] += 1;
+		break;
+	}
+	}
+
+	return 0;
+}
+
+int w_RandomGenerator_jump(lua_State *L)
+{
+	RandomGenerator *rng = luax_checkrandomgenerator(L, 1);
+	lua_Integer count = luaL_optinteger(L, 2, 1);
+
+	if (count < 0 || count > (lua_Integer) RandomGenerator::MAX_JUMP_COUNT)
+		return luaL_argerror(L, 2, "jump count out of range");
+
+	rng->jump((uint32) count);
+	return 0;
+}
+
+int w_RandomGenerator_split(lua_State *L)
+{
+	RandomGenerator *rng = luax_checkrandomgenerator(L, 1);
+	RandomGenerator *newrng = rng->split();
+	luax_pushtype(L, newrng);
+	newrng->release();
+	return 1;
+}
+
 int w_RandomGenerator_setSeed(lua_State *L)
 {
 	RandomGenerator *rng = luax_checkrandomgenerator(L, 1);
@@ -149,6 +254,9 @@ static const luaL_Reg w_RandomGenerator_functions[] =
 {
 	{ "_random", w_RandomGenerator__random }, // random() is defined in wrap_RandomGenerator.lua.
 	{ "randomNormal", w_RandomGenerator_randomNormal },
+	{ "fill", w_RandomGenerator_fill },
+	{ "jump", w_RandomGenerator_jump },
+	{ "split", w_RandomGenerator_split },
 	{ "setSeed", w_RandomGenerator_setSeed },
 	{ "getSeed", w_RandomGenerator_getSeed },
 	{ "setState", w_RandomGenerator_setState },
@@ -21,7 +21,6 @@
 #include "Body.h"
 
 #include "common/math.h"
-#include "common/Memoizer.h"
 
 #include "Shape.h"
 #include "Fixture.h"
@@ -44,6 +43,7 @@ Body::Body(World *world, b2Vec2 p, Body::Type type)
 {
 	udata = new bodyudata();
 	udata->ref = nullptr;
+	udata->body = this;
 	b2BodyDef def;
 	def.position = Physics::scaleDown(p);
 	def.userData = (void *) udata;
@@ -51,7 +51,6 @@ Body::Body(World *world, b2Vec2 p, Body::Type type)
 	// Box2D body holds a reference to the love Body.
 	this->retain();
 	this->setType(type);
-	Memoizer::add(body, this);
 }
 
 Body::Body(b2Body *b)
@@ -59,10 +58,15 @@ Body::Body(b2Body *b)
 	, udata(nullptr)
 {
 	udata = (bodyudata *) b->GetUserData();
-	world = (World *) Memoizer::find(b->GetWorld());
+	if (udata == nullptr)
+	{
+		udata = new bodyudata();
+		body->SetUserData((void *) udata);
+	}
+	udata->body = this;
+	world = World::fromBox2D(b->GetWorld());
 	// Box2D body holds a reference to the love Body.
 	this->retain();
-	Memoizer::add(body, this);
 }
 
 Body::~Body()
@@ -70,12 +74,22 @@ Body::~Body()
 	if (!udata)
 		return;
 
+	// Don't leave the Box2D body pointing at deleted userdata.
+	if (body != nullptr)
+		body->SetUserData(nullptr);
+
 	if (udata->ref)
 		delete udata->ref;
 
 	delete udata;
 }
 
+Body *Body::fromBox2D(const b2Body *b)
+{
+	const bodyudata *udata = (const bodyudata *) b->GetUserData();
+	return udata != nullptr ? udata->body : nullptr;
+}
+
 float Body::getX()
 {
 	return Physics::scaleUp(body->GetPosition().x);
@@ -452,9 +466,9 @@ int Body::getFixtures(lua_State *L) const
 	{
 		if (!f)
 			break;
-		Fixture *fixture = (Fixture *)Memoizer::find(f);
+		Fixture *fixture = Fixture::fromBox2D(f);
 		if (!fixture)
-			throw love::Exception("A fixture has escaped Memoizer!");
+			throw love::Exception("A Box2D fixture has no LOVE object!");
 		luax_pushtype(L, fixture);
 		lua_rawseti(L, -2, i);
 		i++;
@@ -474,9 +488,9 @@ int Body::getJoints(lua_State *L) const
 		if (!je)
 			break;
 
-		Joint *joint = (Joint *) Memoizer::find(je->joint);
+		Joint *joint = Joint::fromBox2D(je->joint);
 		if (!joint)
-			throw love::Exception("A joint has escaped Memoizer!");
+			throw love::Exception("A Box2D joint has no LOVE object!");
 
 		luax_pushjoint(L, joint);
 		lua_rawseti(L, -2, i);
@@ -497,7 +511,7 @@ int Body::getContacts(lua_State *L) const
 		if (!ce)
 			break;
 
-		Contact *contact = (Contact *) Memoizer::find(ce->contact);
+		Contact *contact = Contact::fromBox2D(ce->contact);
 		if (!contact)
 			contact = new Contact(ce->contact);
 		else
@@ -538,7 +552,6 @@ void Body::destroy()
 	}
 
 	world->world->DestroyBody(body);
-	Memoizer::remove(body);
 	body = NULL;
 
 	// Remove userdata reference to avoid it sticking around after GC
@@ -556,6 +569,7 @@ int Body::setUserData(lua_State *L)
 	if (udata == nullptr)
 	{
 		udata = new bodyudata();
+		udata->body = this;
 		body->SetUserData((void *) udata);
 	}
 
@@ -39,16 +39,20 @@ namespace box2d
 // Forward declarations.
 class World;
 class Shape;
+class Body;
 class Fixture;
 
 /**
- * This struct is stored in a void pointer in the Box2D Body class. For now, all
- * we need is a Lua reference to arbitrary data, but we might need more later.
+ * This struct is stored in a void pointer in the Box2D Body class. It holds a
+ * Lua reference to arbitrary data, and leads back to the Body from Box2D.
  **/
 struct bodyudata
 {
 	// Reference to arbitrary data.
 	Reference *ref = nullptr;
+
+	// The Body which owns the Box2D body.
+	Body *body = nullptr;
 };
 
 /**
@@ -84,6 +88,11 @@ public:
 
 	virtual ~Body();
 
+	/**
+	 * Gets the Body of a Box2D body, or null if it has none.
+	 **/
+	static Body *fromBox2D(const b2Body *b);
+
 	/**
 	 * Gets the current x-position of the Body.
 	 **/
@@ -22,8 +22,6 @@
 #include "World.h"
 #include "Physics.h"
 
-#include "common/Memoizer.h"
-
 namespace love
 {
 namespace physics
@@ -36,7 +34,7 @@ love::Type Contact::type("Contact", &Object::type);
 Contact::Contact(b2Contact *contact)
 	: contact(contact)
 {
-	Memoizer::add(contact, this);
+	contact->SetUserData(this);
 }
 
 Contact::~Contact()
@@ -48,11 +46,16 @@ void Contact::invalidate()
 {
 	if (contact != NULL)
 	{
-		Memoizer::remove(contact);
+		contact->SetUserData(nullptr);
 		contact = NULL;
 	}
 }
 
+Contact *Contact::fromBox2D(const b2Contact *contact)
+{
+	return (Contact *) contact->GetUserData();
+}
+
 bool Contact::isValid()
 {
 	return contact != NULL ? true : false;
@@ -146,11 +149,11 @@ void Contact::getChildren(int &childA, int &childB)
 
 void Contact::getFixtures(Fixture *&fixtureA, Fixture *&fixtureB)
 {
-	fixtureA = (Fixture *) Memoizer::find(contact->GetFixtureA());
-	fixtureB = (Fixture *) Memoizer::find(contact->GetFixtureB());
+	fixtureA = Fixture::fromBox2D(contact->GetFixtureA());
+	fixtureB = Fixture::fromBox2D(contact->GetFixtureB());
 
 	if (!fixtureA || !fixtureB)
-		throw love::Exception("A fixture has escaped Memoizer!");
+		throw love::Exception("A Box2D fixture has no LOVE object!");
 }
 
 } // box2d
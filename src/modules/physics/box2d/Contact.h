@@ -62,11 +62,16 @@ public:
 	virtual ~Contact();
 
 	/**
-	 * Removes the b2Contact pointer from Memoizer and sets it
-	 * to null on the Contact.
+	 * Detaches the Contact from its b2Contact, which must still exist, and
+	 * sets the pointer to null on the Contact.
 	 **/
 	void invalidate();
 
+	/**
+	 * Gets the Contact of a Box2D contact, or null if it has none.
+	 **/
+	static Contact *fromBox2D(const b2Contact *contact);
+
 	/**
 	 * Returns if the Contact still points to a valid b2Contact.
 	 * @return True if the contact is still valid or false if it has been destroyed.
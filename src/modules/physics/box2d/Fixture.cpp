@@ -25,8 +25,6 @@
 #include "World.h"
 #include "Physics.h"
 
-#include "common/Memoizer.h"
-
 // STD
 #include <bitset>
 
@@ -45,24 +43,30 @@ Fixture::Fixture(Body *body, Shape *shape, float density)
 {
 	udata = new fixtureudata();
 	udata->ref = nullptr;
+	udata->fixture = this;
 	b2FixtureDef def;
 	def.shape = shape->shape;
 	def.userData = (void *)udata;
 	def.density = density;
 	fixture = body->body->CreateFixture(&def);
 	this->retain();
-	Memoizer::add(fixture, this);
+	udata->id = body->world->registerFixture(this);
 }
 
 Fixture::Fixture(b2Fixture *f)
 	: fixture(f)
 {
 	udata = (fixtureudata *)f->GetUserData();
-	body = (Body *)Memoizer::find(f->GetBody());
+	if (udata == nullptr)
+	{
+		udata = new fixtureudata();
+		fixture->SetUserData((void *) udata);
+	}
+	udata->fixture = this;
+	body = Body::fromBox2D(f->GetBody());
 	if (!body)
 		body = new Body(f->GetBody());
 	this->retain();
-	Memoizer::add(fixture, this);
 }
 
 Fixture::~Fixture()
@@ -76,6 +80,12 @@ Fixture::~Fixture()
 	delete udata;
 }
 
+Fixture *Fixture::fromBox2D(const b2Fixture *f)
+{
+	const fixtureudata *udata = (const fixtureudata *) f->GetUserData();
+	return udata != nullptr ? udata->fixture : nullptr;
+}
+
 void Fixture::checkCreateShape()
 {
 	if (shape.get() != nullptr || fixture == nullptr || fixture->GetShape() == nullptr)
@@ -156,6 +166,11 @@ Body *Fixture::getBody() const
 	return body;
 }
 
+uint32 Fixture::getID() const
+{
+	return udata != nullptr ? udata->id : 0;
+}
+
 Shape *Fixture::getShape()
 {
 	checkCreateShape();
@@ -275,6 +290,7 @@ int Fixture::setUserData(lua_State *L)
 	if (udata == nullptr)
 	{
 		udata = new fixtureudata();
+		udata->fixture = this;
 		fixture->SetUserData((void *) udata);
 	}
 
@@ -361,9 +377,11 @@ void Fixture::destroy(bool implicit)
 
 	if (!implicit && fixture != nullptr)
 		body->body->DestroyFixture(fixture);
-	Memoizer::remove(fixture);
 	fixture = nullptr;
 
+	if (udata)
+		body->world->unregisterFixture(udata->id);
+
 	// Remove userdata reference to avoid it sticking around after GC
 	if (udata && udata->ref)
 		udata->ref->unref();
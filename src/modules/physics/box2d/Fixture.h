@@ -27,6 +27,7 @@
 #include "physics/box2d/Shape.h"
 #include "common/Object.h"
 #include "common/Reference.h"
+#include "common/int.h"
 
 // Box2D
 #include <Box2D/Box2D.h>
@@ -38,16 +39,24 @@ namespace physics
 namespace box2d
 {
 
+class Fixture;
+
 /**
  * This struct is stored in a void pointer
- * in the Box2D Fixture class. For now, all we
- * need is a Lua reference to arbitrary data,
- * but we might need more later.
+ * in the Box2D Fixture class. It holds a Lua
+ * reference to arbitrary data, and leads back
+ * to the Fixture from Box2D.
  **/
 struct fixtureudata
 {
 	// Reference to arbitrary data.
 	Reference *ref = nullptr;
+
+	// Identifies the Fixture in its World's contact events.
+	uint32 id = 0;
+
+	// The Fixture which owns the Box2D fixture.
+	Fixture *fixture = nullptr;
 };
 
 /**
@@ -75,6 +84,11 @@ public:
 
 	virtual ~Fixture();
 
+	/**
+	 * Gets the Fixture of a Box2D fixture, or null if it has none.
+	 **/
+	static Fixture *fromBox2D(const b2Fixture *f);
+
 	/**
 	 * Gets the type of the Fixture's Shape. Useful for
 	 * debug drawing.
@@ -108,6 +122,11 @@ public:
 	 **/
 	Body *getBody() const;
 
+	/**
+	 * Gets the ID of this Fixture, which is unique within its World.
+	 **/
+	uint32 getID() const;
+
 	/**
 	 * Sets the filter data. An integer array is used even though the
 	 * first two elements are unsigned shorts. The elements are:
@@ -23,9 +23,6 @@
 // STD
 #include <bitset>
 
-// LOVE
-#include "common/Memoizer.h"
-
 // Module
 #include "Body.h"
 #include "World.h"
@@ -70,6 +67,12 @@ Joint::~Joint()
 	delete udata;
 }
 
+Joint *Joint::fromBox2D(const b2Joint *j)
+{
+	const jointudata *udata = (const jointudata *) j->GetUserData();
+	return udata != nullptr ? udata->joint : nullptr;
+}
+
 Joint::Type Joint::getType() const
 {
 	switch (joint->GetType())
@@ -107,9 +110,9 @@ Body *Joint::getBodyA() const
 	if (b2body == nullptr)
 		return nullptr;
 
-	Body *body = (Body *) Memoizer::find(b2body);
+	Body *body = Body::fromBox2D(b2body);
 	if (body == nullptr)
-		throw love::Exception("A body has escaped Memoizer!");
+		throw love::Exception("A Box2D body has no LOVE object!");
 
 	return body;
 }
@@ -120,9 +123,9 @@ Body *Joint::getBodyB() const
 	if (b2body == nullptr)
 		return nullptr;
 
-	Body *body = (Body *) Memoizer::find(b2body);
+	Body *body = Body::fromBox2D(b2body);
 	if (body == nullptr)
-		throw love::Exception("A body has escaped Memoizer!");
+		throw love::Exception("A Box2D body has no LOVE object!");
 
 	return body;
 }
@@ -157,9 +160,9 @@ float Joint::getReactionTorque(float dt)
 
 b2Joint *Joint::createJoint(b2JointDef *def)
 {
+	udata->joint = this;
 	def->userData = udata;
 	joint = world->world->CreateJoint(def);
-	Memoizer::add(joint, this);
 	// Box2D joint has a reference to this love Joint.
 	this->retain();
 	return joint;
@@ -177,7 +180,6 @@ void Joint::destroyJoint(bool implicit)
 
 	if (!implicit && joint != 0)
 		world->world->DestroyJoint(joint);
-	Memoizer::remove(joint);
 	joint = NULL;
 
 	// Remove userdata reference to avoid it sticking around after GC
@@ -205,6 +207,7 @@ int Joint::setUserData(lua_State *L)
 	if (udata == nullptr)
 	{
 		udata = new jointudata();
+		udata->joint = this;
 		joint->SetUserData((void *) udata);
 	}
 
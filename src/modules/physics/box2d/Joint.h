@@ -37,16 +37,20 @@ namespace box2d
 
 // Forward declarations.
 class Body;
+class Joint;
 class World;
 
 /**
- * This struct is stored in a void pointer in the Box2D Joint class. For now, all
- * we need is a Lua reference to arbitrary data, but we might need more later.
+ * This struct is stored in a void pointer in the Box2D Joint class. It holds a
+ * Lua reference to arbitrary data, and leads back to the Joint from Box2D.
  **/
 struct jointudata
 {
     // Reference to arbitrary data.
     Reference *ref = nullptr;
+
+    // The Joint which owns the Box2D joint.
+    Joint *joint = nullptr;
 };
 
 /**
@@ -74,6 +78,11 @@ public:
 
 	virtual ~Joint();
 
+	/**
+	 * Gets the Joint of a Box2D joint, or null if it has none.
+	 **/
+	static Joint *fromBox2D(const b2Joint *j);
+
 	/**
 	 * Returns true if the joint is active in a Box2D world.
 	 **/
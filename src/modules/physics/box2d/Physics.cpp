@@ -23,6 +23,10 @@
 // LOVE
 #include "common/math.h"
 #include "wrap_Body.h"
+#include "thread/JobSystem.h"
+
+// C++
+#include <algorithm>
 
 namespace love
 {
@@ -323,6 +327,55 @@ int Physics::getDistance(lua_State *L)
 	return 5;
 }
 
+void Physics::updateWorlds(const std::vector<World *> &worlds, float dt, int velocityIterations, int positionIterations)
+{
+	std::vector<World *> sorted = worlds;
+	std::sort(sorted.begin(), sorted.end());
+	if (std::adjacent_find(sorted.begin(), sorted.end()) != sorted.end())
+		throw love::Exception("The same World can't be updated more than once at a time.");
+
+	std::vector<World *> parallel;
+	std::vector<World *> serial;
+
+	for (World *w : worlds)
+	{
+		if (w->isLocked())
+			throw love::Exception("Cannot update a World from inside one of its callbacks.");
+
+		if (w->canUpdateInParallel())
+			parallel.push_back(w);
+		else
+			serial.push_back(w);
+	}
+
+	auto stepRange = [&](int64 first, int64 last)
+	{
+		for (int64 i = first; i < last; i++)
+			parallel[(size_t) i]->step(dt, velocityIterations, positionIterations, true);
+	};
+
+	// Every World which was stepped still needs finishing if one of them
+	// failed, so the error is rethrown afterwards.
+	std::string error;
+	try
+	{
+		love::thread::JobSystem::getInstance()->parallelFor((int64) parallel.size(), 1, stepRange);
+	}
+	catch (love::Exception &e)
+	{
+		error = e.what();
+	}
+
+	for (World *w : parallel)
+		w->finishUpdate();
+
+	if (!error.empty())
+		throw love::Exception("%s", error.c_str());
+
+	for (World *w : serial)
+		w->update(dt, velocityIterations, positionIterations);
+}
+
 void Physics::setMeter(float scale)
 {
 	if (scale < 1) throw love::Exception("Physics error: invalid meter");
@@ -288,6 +288,14 @@ public:
 	 **/
 	int getDistance(lua_State *L);
 
+	/**
+	 * Updates several independent Worlds. The ones which can be updated in
+	 * parallel (see World::canUpdateInParallel) are stepped at the same time
+	 * on the JobSystem's worker threads, the rest are updated afterwards on
+	 * the calling thread.
+	 **/
+	void updateWorlds(const std::vector<World *> &worlds, float dt, int velocityIterations, int positionIterations);
+
 	/**
 	 * Sets the number of pixels in one meter.
 	 * @param scale The number of pixels in one meter. (1m ~= 3.3ft).
@@ -24,8 +24,14 @@
 #include "Shape.h"
 #include "Contact.h"
 #include "Physics.h"
-#include "common/Memoizer.h"
 #include "common/Reference.h"
+#include "profiler/Profiler.h"
+#include "thread/JobSystem.h"
+
+// C++
+#include <algorithm>
+#include <atomic>
+#include <cstring>
 
 namespace love
 {
@@ -36,6 +42,36 @@ namespace box2d
 
 love::Type World::type("World", &Object::type);
 
+// Runs Box2D's parallel work on the JobSystem. It has no state of its own, so
+// all Worlds share one.
+class JobTaskScheduler : public b2TaskScheduler
+{
+public:
+
+	void ParallelFor(int32 count, int32 minRange, b2ParallelTask *task, void *context) override
+	{
+		love::thread::JobSystem::getInstance()->parallelFor(count, minRange, [&](int64 begin, int64 end)
+		{
+			task((int32) begin, (int32) end, context);
+		});
+	}
+};
+
+static JobTaskScheduler taskScheduler;
+
+// Identifies the World a snapshot was taken from.
+static std::atomic<uint32> nextWorldID(1);
+
+struct SnapshotHeader
+{
+	uint32 magic;
+	uint32 worldID;
+	uint32 stateSize;
+	uint32 reserved;
+};
+
+static const uint32 SNAPSHOT_MAGIC = 0x534E5357; // "WSNS"
+
 World::ContactCallback::ContactCallback()
 	: ref(nullptr)
 	, L(nullptr)
@@ -57,23 +93,23 @@ void World::ContactCallback::process(b2Contact *contact, const b2ContactImpulse
 
 		// Push first fixture.
 		{
-			Fixture *a = (Fixture *)Memoizer::find(contact->GetFixtureA());
+			Fixture *a = Fixture::fromBox2D(contact->GetFixtureA());
 			if (a != nullptr)
 				luax_pushtype(L, a);
 			else
-				throw love::Exception("A fixture has escaped Memoizer!");
+				throw love::Exception("A Box2D fixture has no LOVE object!");
 		}
 
 		// Push second fixture.
 		{
-			Fixture *b = (Fixture *)Memoizer::find(contact->GetFixtureB());
+			Fixture *b = Fixture::fromBox2D(contact->GetFixtureB());
 			if (b != nullptr)
 				luax_pushtype(L, b);
 			else
-				throw love::Exception("A fixture has escaped Memoizer!");
+				throw love::Exception("A Box2D fixture has no LOVE object!");
 		}
 
-		Contact *cobj = (Contact *)Memoizer::find(contact);
+		Contact *cobj = Contact::fromBox2D(contact);
 		if (!cobj)
 			cobj = new Contact(contact);
 		else
@@ -154,9 +190,9 @@ bool World::QueryCallback::ReportFixture(b2Fixture *fixture)
 	if (L != nullptr)
 	{
 		lua_pushvalue(L, funcidx);
-		Fixture *f = (Fixture *)Memoizer::find(fixture);
+		Fixture *f = Fixture::fromBox2D(fixture);
 		if (!f)
-			throw love::Exception("A fixture has escaped Memoizer!");
+			throw love::Exception("A Box2D fixture has no LOVE object!");
 		luax_pushtype(L, f);
 		lua_call(L, 1, 1);
 		bool cont = luax_toboolean(L, -1);
@@ -183,9 +219,9 @@ float32 World::RayCastCallback::ReportFixture(b2Fixture *fixture, const b2Vec2 &
 	if (L != nullptr)
 	{
 		lua_pushvalue(L, funcidx);
-		Fixture *f = (Fixture *)Memoizer::find(fixture);
+		Fixture *f = Fixture::fromBox2D(fixture);
 		if (!f)
-			throw love::Exception("A fixture has escaped Memoizer!");
+			throw love::Exception("A Box2D fixture has no LOVE object!");
 		luax_pushtype(L, f);
 		b2Vec2 scaledPoint = Physics::scaleUp(point);
 		lua_pushnumber(L, scaledPoint.x);
@@ -206,14 +242,14 @@ float32 World::RayCastCallback::ReportFixture(b2Fixture *fixture, const b2Vec2 &
 
 void World::SayGoodbye(b2Fixture *fixture)
 {
-	Fixture *f = (Fixture *)Memoizer::find(fixture);
+	Fixture *f = Fixture::fromBox2D(fixture);
 	// Hint implicit destruction with true.
 	if (f) f->destroy(true);
 }
 
 void World::SayGoodbye(b2Joint *joint)
 {
-	Joint *j = (Joint *)Memoizer::find(joint);
+	Joint *j = Joint::fromBox2D(joint);
 	// Hint implicit destruction with true.
 	if (j) j->destroyJoint(true);
 }
@@ -221,6 +257,10 @@ void World::SayGoodbye(b2Joint *joint)
 World::World()
 	: world(nullptr)
 	, destructWorld(false)
+	, contactEventsEnabled(false)
+	, lastUpdateEventCount(0)
+	, nextFixtureID(1)
+	, id(nextWorldID++)
 {
 	world = new b2World(b2Vec2(0,0));
 	world->SetAllowSleeping(true);
@@ -229,12 +269,16 @@ World::World()
 	world->SetDestructionListener(this);
 	b2BodyDef def;
 	groundBody = world->CreateBody(&def);
-	Memoizer::add(world, this);
+	world->SetUserData(this);
 }
 
 World::World(b2Vec2 gravity, bool sleep)
 	: world(nullptr)
 	, destructWorld(false)
+	, contactEventsEnabled(false)
+	, lastUpdateEventCount(0)
+	, nextFixtureID(1)
+	, id(nextWorldID++)
 {
 	world = new b2World(Physics::scaleDown(gravity));
 	world->SetAllowSleeping(sleep);
@@ -243,7 +287,7 @@ World::World(b2Vec2 gravity, bool sleep)
 	world->SetDestructionListener(this);
 	b2BodyDef def;
 	groundBody = world->CreateBody(&def);
-	Memoizer::add(world, this);
+	world->SetUserData(this);
 }
 
 World::~World()
@@ -258,8 +302,32 @@ void World::update(float dt)
 
 void World::update(float dt, int velocityIterations, int positionIterations)
 {
+	step(dt, velocityIterations, positionIterations, false);
+	finishUpdate();
+}
+
+bool World::canUpdateInParallel() const
+{
+	return contactEventsEnabled && presolve.ref == nullptr && filter.ref == nullptr;
+}
+
+void World::step(float dt, int velocityIterations, int positionIterations, bool parallel)
+{
+	LOVE_PROFILE_ZONE("physics", "World::update");
+
+	if (parallel && !canUpdateInParallel())
+		throw love::Exception("This World uses Lua callbacks during update, it can't be updated in parallel.");
+
+	// Events from the previous update have been seen by now.
+	contactEvents.erase(contactEvents.begin(), contactEvents.begin() + lastUpdateEventCount);
+
 	world->Step(dt, velocityIterations, positionIterations);
 
+	lastUpdateEventCount = contactEvents.size();
+}
+
+void World::finishUpdate()
+{
 	// Destroy all objects marked during the time step.
 	for (Body *b : destructBodies)
 	{
@@ -289,15 +357,21 @@ void World::update(float dt, int velocityIterations, int positionIterations)
 
 void World::BeginContact(b2Contact *contact)
 {
-	begin.process(contact);
+	if (contactEventsEnabled)
+		recordContactEvent(CONTACT_EVENT_BEGIN, contact, nullptr);
+	else
+		begin.process(contact);
 }
 
 void World::EndContact(b2Contact *contact)
 {
-	end.process(contact);
+	if (contactEventsEnabled)
+		recordContactEvent(CONTACT_EVENT_END, contact, nullptr);
+	else
+		end.process(contact);
 
 	// Letting the Contact know that the b2Contact will be destroyed any second.
-	Contact *c = (Contact *)Memoizer::find(contact);
+	Contact *c = Contact::fromBox2D(contact);
 	if (c != NULL)
 		c->invalidate();
 }
@@ -310,16 +384,167 @@ void World::PreSolve(b2Contact *contact, const b2Manifold *oldManifold)
 
 void World::PostSolve(b2Contact *contact, const b2ContactImpulse *impulse)
 {
-	postsolve.process(contact, impulse);
+	if (contactEventsEnabled)
+		recordContactEvent(CONTACT_EVENT_POSTSOLVE, contact, impulse);
+	else
+		postsolve.process(contact, impulse);
+}
+
+static_assert(sizeof(World::ContactEvent) == 56, "ContactEvent must match the documented 56-byte layout");
+
+void World::recordContactEvent(ContactEventType type, b2Contact *contact, const b2ContactImpulse *impulse)
+{
+	// Fixture IDs live in the Box2D fixture's userdata.
+	const fixtureudata *udataA = (const fixtureudata *) contact->GetFixtureA()->GetUserData();
+	const fixtureudata *udataB = (const fixtureudata *) contact->GetFixtureB()->GetUserData();
+
+	b2WorldManifold manifold;
+	contact->GetWorldManifold(&manifold);
+
+	ContactEvent e = {};
+	e.type = (uint32) type;
+	e.fixtureA = udataA != nullptr ? udataA->id : 0;
+	e.fixtureB = udataB != nullptr ? udataB->id : 0;
+	e.pointCount = (uint32) contact->GetManifold()->pointCount;
+	e.normal[0] = manifold.normal.x;
+	e.normal[1] = manifold.normal.y;
+
+	for (int i = 0; i < (int) e.pointCount && i < b2_maxManifoldPoints; i++)
+	{
+		b2Vec2 point = Physics::scaleUp(manifold.points[i]);
+		e.points[i * 2 + 0] = point.x;
+		e.points[i * 2 + 1] = point.y;
+	}
+
+	if (impulse != nullptr)
+	{
+		for (int i = 0; i < impulse->count && i < b2_maxManifoldPoints; i++)
+		{
+			e.normalImpulses[i] = Physics::scaleUp(impulse->normalImpulses[i]);
+			e.tangentImpulses[i] = Physics::scaleUp(impulse->tangentImpulses[i]);
+		}
+	}
+
+	contactEvents.push_back(e);
+}
+
+void World::setParallelSolveEnabled(bool enable)
+{
+	if (world->IsLocked())
+		throw love::Exception("Cannot change the solver while the World is locked.");
+
+	world->SetTaskScheduler(enable ? &taskScheduler : nullptr);
+}
+
+bool World::isParallelSolveEnabled() const
+{
+	return world->GetTaskScheduler() != nullptr;
+}
+
+void World::setContactEventsEnabled(bool enable)
+{
+	contactEventsEnabled = enable;
+
+	if (!enable)
+	{
+		contactEvents.clear();
+		lastUpdateEventCount = 0;
+	}
+}
+
+bool World::isContactEventsEnabled() const
+{
+	return contactEventsEnabled;
+}
+
+const std::vector<World::ContactEvent> &World::getContactEvents() const
+{
+	return contactEvents;
+}
+
+Fixture *World::getFixtureByID(uint32 id) const
+{
+	auto it = fixturesByID.find(id);
+	if (it != fixturesByID.end())
+		return it->second;
+	return nullptr;
+}
+
+size_t World::getSnapshotSize() const
+{
+	return sizeof(SnapshotHeader) + world->GetStateSize();
+}
+
+void World::snapshot(void *data) const
+{
+	if (world->IsLocked())
+		throw love::Exception("Cannot take a snapshot while the World is locked.");
+
+	SnapshotHeader *header = (SnapshotHeader *) data;
+	header->magic = SNAPSHOT_MAGIC;
+	header->worldID = id;
+	header->stateSize = (uint32) world->GetStateSize();
+	header->reserved = 0;
+
+	world->SaveState(header + 1);
+}
+
+void World::restore(const void *data, size_t size)
+{
+	if (world->IsLocked())
+		throw love::Exception("Cannot restore a snapshot while the World is locked.");
+
+	const SnapshotHeader *header = (const SnapshotHeader *) data;
+	if (size < sizeof(SnapshotHeader) || header->magic != SNAPSHOT_MAGIC
+		|| size - sizeof(SnapshotHeader) < header->stateSize)
+		throw love::Exception("Invalid World snapshot.");
+
+	if (header->worldID != id)
+		throw love::Exception("The snapshot was taken from a different World.");
+
+	// The structure version is the first thing in Box2D's state.
+	uint32 structureVersion = 0;
+	memcpy(&structureVersion, header + 1, sizeof(uint32));
+	if (structureVersion != world->GetStructureVersion())
+		throw love::Exception("Bodies, Fixtures or Joints have been created or destroyed since the snapshot was taken.");
+
+	// The snapshot is just bytes, which could have been saved to a file by
+	// another run of the game. Box2D checks all of it before we change
+	// anything.
+	if (!world->CheckState(header + 1, (int32) header->stateSize))
+		throw love::Exception("Invalid World snapshot.");
+
+	// Every b2Contact is about to be replaced.
+	for (b2Contact *c = world->GetContactList(); c != nullptr; c = c->GetNext())
+	{
+		Contact *contact = Contact::fromBox2D(c);
+		if (contact != nullptr)
+			contact->invalidate();
+	}
+
+	if (!world->LoadState(header + 1, (int32) header->stateSize))
+		throw love::Exception("Invalid World snapshot.");
+}
+
+uint32 World::registerFixture(Fixture *fixture)
+{
+	uint32 id = nextFixtureID++;
+	fixturesByID[id] = fixture;
+	return id;
+}
+
+void World::unregisterFixture(uint32 id)
+{
+	fixturesByID.erase(id);
 }
 
 bool World::ShouldCollide(b2Fixture *fixtureA, b2Fixture *fixtureB)
 {
 	// Fixtures should be memoized, if we created them
-	Fixture *a = (Fixture *)Memoizer::find(fixtureA);
-	Fixture *b = (Fixture *)Memoizer::find(fixtureB);
+	Fixture *a = Fixture::fromBox2D(fixtureA);
+	Fixture *b = Fixture::fromBox2D(fixtureB);
 	if (!a || !b)
-		throw love::Exception("A fixture has escaped Memoizer!");
+		throw love::Exception("A Box2D fixture has no LOVE object!");
 	return filter.process(a, b);
 }
 
@@ -472,9 +697,9 @@ int World::getBodies(lua_State *L) const
 			break;
 		if (b == groundBody)
 			continue;
-		Body *body = (Body *)Memoizer::find(b);
+		Body *body = Body::fromBox2D(b);
 		if (!body)
-			throw love::Exception("A body has escaped Memoizer!");
+			throw love::Exception("A Box2D body has no LOVE object!");
 		luax_pushtype(L, body);
 		lua_rawseti(L, -2, i);
 		i++;
@@ -483,6 +708,168 @@ int World::getBodies(lua_State *L) const
 	return 1;
 }
 
+static float *writeBodyState(const b2Body *b, const std::vector<World::BodyStateField> &fields, float *dst)
+{
+	for (World::BodyStateField field : fields)
+	{
+		switch (field)
+		{
+		case World::BODY_STATE_POSITION:
+		{
+			b2Vec2 p = Physics::scaleUp(b->GetPosition());
+			*(dst++) = p.x;
+			*(dst++) = p.y;
+			break;
+		}
+		case World::BODY_STATE_ANGLE:
+			*(dst++) = b->GetAngle();
+			break;
+		case World::BODY_STATE_LINEAR_VELOCITY:
+		{
+			b2Vec2 v = Physics::scaleUp(b->GetLinearVelocity());
+			*(dst++) = v.x;
+			*(dst++) = v.y;
+			break;
+		}
+		case World::BODY_STATE_ANGULAR_VELOCITY:
+			*(dst++) = b->GetAngularVelocity();
+			break;
+		default:
+			break;
+		}
+	}
+
+	return dst;
+}
+
+static const float *readBodyState(b2Body *b, const std::vector<World::BodyStateField> &fields, const float *src)
+{
+	b2Vec2 position = b->GetPosition();
+	float angle = b->GetAngle();
+	bool transformed = false;
+
+	for (World::BodyStateField field : fields)
+	{
+		switch (field)
+		{
+		case World::BODY_STATE_POSITION:
+			position = Physics::scaleDown(b2Vec2(src[0], src[1]));
+			transformed = true;
+			src += 2;
+			break;
+		case World::BODY_STATE_ANGLE:
+			angle = *(src++);
+			transformed = true;
+			break;
+		case World::BODY_STATE_LINEAR_VELOCITY:
+			b->SetLinearVelocity(Physics::scaleDown(b2Vec2(src[0], src[1])));
+			src += 2;
+			break;
+		case World::BODY_STATE_ANGULAR_VELOCITY:
+			b->SetAngularVelocity(*(src++));
+			break;
+		default:
+			break;
+		}
+	}
+
+	// Position and angle share one SetTransform, which also updates the
+	// broadphase proxies of every fixture.
+	if (transformed)
+		b->SetTransform(position, angle);
+
+	return src;
+}
+
+void World::getBodyStates(const std::vector<BodyStateField> &fields, Body * const *bodies, int count, float *dst) const
+{
+	if (bodies != nullptr)
+	{
+		for (int i = 0; i < count; i++)
+		{
+			if (bodies[i]->getWorld() != this)
+				throw love::Exception("Body #%d does not belong to this World.", i + 1);
+			dst = writeBodyState(bodies[i]->body, fields, dst);
+		}
+		return;
+	}
+
+	int i = 0;
+	for (const b2Body *b = world->GetBodyList(); b != nullptr && i < count; b = b->GetNext())
+	{
+		if (b == groundBody)
+			continue;
+		dst = writeBodyState(b, fields, dst);
+		i++;
+	}
+}
+
+void World::setBodyStates(const std::vector<BodyStateField> &fields, Body * const *bodies, int count, const float *src)
+{
+	if (world->IsLocked())
+		throw love::Exception("Cannot set body states while the World is locked (in a callback).");
+
+	if (bodies != nullptr)
+	{
+		for (int i = 0; i < count; i++)
+		{
+			if (bodies[i]->getWorld() != this)
+				throw love::Exception("Body #%d does not belong to this World.", i + 1);
+		}
+
+		for (int i = 0; i < count; i++)
+			src = readBodyState(bodies[i]->body, fields, src);
+		return;
+	}
+
+	int i = 0;
+	for (b2Body *b = world->GetBodyList(); b != nullptr && i < count; b = b->GetNext())
+	{
+		if (b == groundBody)
+			continue;
+		src = readBodyState(b, fields, src);
+		i++;
+	}
+}
+
+int World::getBodyStateStride(const std::vector<BodyStateField> &fields)
+{
+	int stride = 0;
+	for (BodyStateField field : fields)
+	{
+		if (field == BODY_STATE_POSITION || field == BODY_STATE_LINEAR_VELOCITY)
+			stride += 2;
+		else
+			stride += 1;
+	}
+	return stride;
+}
+
+bool World::getConstant(const char *in, BodyStateField &out)
+{
+	return bodyStateFields.find(in, out);
+}
+
+bool World::getConstant(BodyStateField in, const char *&out)
+{
+	return bodyStateFields.find(in, out);
+}
+
+std::vector<std::string> World::getConstants(BodyStateField)
+{
+	return bodyStateFields.getNames();
+}
+
+StringMap<World::BodyStateField, World::BODY_STATE_MAX_ENUM>::Entry World::bodyStateFieldEntries[] =
+{
+	{"position", World::BODY_STATE_POSITION},
+	{"angle", World::BODY_STATE_ANGLE},
+	{"linearvelocity", World::BODY_STATE_LINEAR_VELOCITY},
+	{"angularvelocity", World::BODY_STATE_ANGULAR_VELOCITY},
+};
+
+StringMap<World::BodyStateField, World::BODY_STATE_MAX_ENUM> World::bodyStateFields(World::bodyStateFieldEntries, sizeof(World::bodyStateFieldEntries));
+
 int World::getJoints(lua_State *L) const
 {
 	lua_newtable(L);
@@ -491,8 +878,8 @@ int World::getJoints(lua_State *L) const
 	do
 	{
 		if (!j) break;
-		Joint *joint = (Joint *)Memoizer::find(j);
-		if (!joint) throw love::Exception("A joint has escaped Memoizer!");
+		Joint *joint = Joint::fromBox2D(j);
+		if (!joint) throw love::Exception("A Box2D joint has no LOVE object!");
 		luax_pushtype(L, joint);
 		lua_rawseti(L, -2, i);
 		i++;
@@ -509,7 +896,7 @@ int World::getContacts(lua_State *L) const
 	do
 	{
 		if (!c) break;
-		Contact *contact = (Contact *)Memoizer::find(c);
+		Contact *contact = Contact::fromBox2D(c);
 		if (!contact)
 			contact = new Contact(c);
 		else
@@ -528,6 +915,11 @@ b2Body *World::getGroundBody() const
 	return groundBody;
 }
 
+World *World::fromBox2D(const b2World *world)
+{
+	return (World *) world->GetUserData();
+}
+
 int World::queryBoundingBox(lua_State *L)
 {
 	b2AABB box;
@@ -557,6 +949,146 @@ int World::rayCast(lua_State *L)
 	return 0;
 }
 
+// Reports the closest hit of a ray, for rayCastClosest.
+class ClosestRayCastCallback : public b2RayCastCallback
+{
+public:
+
+	ClosestRayCastCallback(uint16 categoryMask, World::RayCastHit *hit)
+		: categoryMask(categoryMask)
+		, hit(hit)
+	{
+	}
+
+	float32 ReportFixture(b2Fixture *fixture, const b2Vec2 &point, const b2Vec2 &normal, float32 fraction) override
+	{
+		if ((fixture->GetFilterData().categoryBits & categoryMask) == 0)
+			return -1.0f;
+
+		const fixtureudata *udata = (const fixtureudata *) fixture->GetUserData();
+		b2Vec2 scaledPoint = Physics::scaleUp(point);
+
+		hit->fixture = udata != nullptr ? udata->id : 0;
+		hit->fraction = fraction;
+		hit->point[0] = scaledPoint.x;
+		hit->point[1] = scaledPoint.y;
+		hit->normal[0] = normal.x;
+		hit->normal[1] = normal.y;
+
+		// Only look for hits closer than this one from now on.
+		return fraction;
+	}
+
+private:
+
+	uint16 categoryMask;
+	World::RayCastHit *hit;
+};
+
+// Collects the IDs of the fixtures overlapping a box, for queryBoundingBoxes.
+class CollectQueryCallback : public b2QueryCallback
+{
+public:
+
+	CollectQueryCallback(uint16 categoryMask, std::vector<uint32> &fixtures)
+		: categoryMask(categoryMask)
+		, fixtures(fixtures)
+	{
+	}
+
+	bool ReportFixture(b2Fixture *fixture) override
+	{
+		if ((fixture->GetFilterData().categoryBits & categoryMask) != 0)
+		{
+			const fixtureudata *udata = (const fixtureudata *) fixture->GetUserData();
+			fixtures.push_back(udata != nullptr ? udata->id : 0);
+		}
+		return true;
+	}
+
+private:
+
+	uint16 categoryMask;
+	std::vector<uint32> &fixtures;
+};
+
+void World::rayCastClosest(const float *rays, int count, uint16 categoryMask, RayCastHit *dst) const
+{
+	if (world->IsLocked())
+		throw love::Exception("Cannot cast rays while the World is locked.");
+
+	// Queries only read the broad-phase and the shapes, so any number of them
+	// can run at once as long as the World isn't being changed.
+	love::thread::JobSystem::getInstance()->parallelFor(count, 64, [&](int64 begin, int64 end)
+	{
+		for (int64 i = begin; i < end; i++)
+		{
+			const float *ray = rays + i * 4;
+			RayCastHit *hit = dst + i;
+			memset(hit, 0, sizeof(RayCastHit));
+
+			b2Vec2 v1 = Physics::scaleDown(b2Vec2(ray[0], ray[1]));
+			b2Vec2 v2 = Physics::scaleDown(b2Vec2(ray[2], ray[3]));
+
+			// Box2D asserts on zero-length rays.
+			if (v1 == v2)
+				continue;
+
+			ClosestRayCastCallback callback(categoryMask, hit);
+			world->RayCast(&callback, v1, v2);
+		}
+	});
+}
+
+void World::queryBoundingBoxes(const float *boxes, int count, uint16 categoryMask, std::vector<uint32> &ranges, std::vector<uint32> &fixtures) const
+{
+	if (world->IsLocked())
+		throw love::Exception("Cannot query the World while it is locked.");
+
+	// The number of hits isn't known up front, so each chunk of boxes collects
+	// its own list and they're joined afterwards.
+	const int chunkSize = 64;
+	int chunkCount = (count + chunkSize - 1) / chunkSize;
+	std::vector<std::vector<uint32>> chunks(chunkCount);
+
+	ranges.resize((size_t) count * 2);
+
+	love::thread::JobSystem::getInstance()->parallelFor(chunkCount, 1, [&](int64 begin, int64 end)
+	{
+		for (int64 c = begin; c < end; c++)
+		{
+			std::vector<uint32> &chunk = chunks[c];
+			CollectQueryCallback callback(categoryMask, chunk);
+
+			int last = std::min((int) (c + 1) * chunkSize, count);
+			for (int i = (int) c * chunkSize; i < last; i++)
+			{
+				const float *box = boxes + i * 4;
+				b2AABB aabb;
+				aabb.lowerBound = Physics::scaleDown(b2Vec2(box[0], box[1]));
+				aabb.upperBound = Physics::scaleDown(b2Vec2(box[2], box[3]));
+
+				size_t start = chunk.size();
+				world->QueryAABB(&callback, aabb);
+
+				ranges[i * 2 + 0] = (uint32) start;
+				ranges[i * 2 + 1] = (uint32) (chunk.size() - start);
+			}
+		}
+	});
+
+	fixtures.clear();
+	for (int c = 0; c < chunkCount; c++)
+	{
+		uint32 offset = (uint32) fixtures.size();
+		int last = std::min((c + 1) * chunkSize, count);
+		for (int i = c * chunkSize; i < last; i++)
+			ranges[i * 2] += offset;
+
+		fixtures.insert(fixtures.end(), chunks[c].begin(), chunks[c].end());
+	}
+}
+
 void World::destroy()
 {
 	if (world == nullptr)
@@ -586,14 +1118,14 @@ void World::destroy()
 		b = b->GetNext();
 		if (t == groundBody)
 			continue;
-		Body *body = (Body *)Memoizer::find(t);
+		Body *body = Body::fromBox2D(t);
 		if (!body)
-			throw love::Exception("A body has escaped Memoizer!");
+			throw love::Exception("A Box2D body has no LOVE object!");
 		body->destroy();
 	}
 
 	world->DestroyBody(groundBody);
-	Memoizer::remove(world);
+	world->SetUserData(nullptr);
 
 	delete world;
 	world = nullptr;
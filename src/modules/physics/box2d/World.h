@@ -25,9 +25,12 @@
 #include "common/Object.h"
 #include "common/runtime.h"
 #include "common/Reference.h"
+#include "common/int.h"
+#include "common/StringMap.h"
 
 // STD
 #include <vector>
+#include <unordered_map>
 
 // Box2D
 #include <Box2D/Box2D.h>
@@ -68,6 +71,59 @@ public:
 
 	static love::Type type;
 
+	enum ContactEventType
+	{
+		CONTACT_EVENT_BEGIN,
+		CONTACT_EVENT_END,
+		CONTACT_EVENT_POSTSOLVE,
+		CONTACT_EVENT_MAX_ENUM
+	};
+
+	/**
+	 * A begin, end or postsolve contact, as recorded during update when
+	 * contact events are enabled. Lua gets these as a packed array in a
+	 * ByteData, so the layout (56 bytes, native endianness) is part of the
+	 * API. Points are in world coordinates, and the impulses are only set
+	 * for postsolve events.
+	 **/
+	struct ContactEvent
+	{
+		uint32 type;
+		uint32 fixtureA;
+		uint32 fixtureB;
+		uint32 pointCount;
+		float normal[2];
+		float points[4];
+		float normalImpulses[2];
+		float tangentImpulses[2];
+	};
+
+	/**
+	 * The closest hit of a ray, as written by rayCastClosest. This is copied
+	 * to ByteData, so the layout (24 bytes, native endianness) is part of the
+	 * API. fixture is 0 if the ray didn't hit anything.
+	 **/
+	struct RayCastHit
+	{
+		uint32 fixture;
+		float fraction;
+		float point[2];
+		float normal[2];
+	};
+
+	/**
+	 * Per-body values that can be read and written in bulk with
+	 * getBodyStates and setBodyStates.
+	 **/
+	enum BodyStateField
+	{
+		BODY_STATE_POSITION,
+		BODY_STATE_ANGLE,
+		BODY_STATE_LINEAR_VELOCITY,
+		BODY_STATE_ANGULAR_VELOCITY,
+		BODY_STATE_MAX_ENUM
+	};
+
 	class ContactCallback
 	{
 	public:
@@ -135,6 +191,22 @@ public:
 	void update(float dt);
 	void update(float dt, int velocityIterations, int positionIterations);
 
+	/**
+	 * Whether update can run on a thread other than the one which owns the
+	 * Lua callbacks. This requires contact events to be enabled, and no
+	 * presolve or contact filter callbacks to be set.
+	 **/
+	bool canUpdateInParallel() const;
+
+	/**
+	 * The two halves of update, for stepping several Worlds at once (see
+	 * Physics::updateWorlds.) step may run on any thread if
+	 * canUpdateInParallel is true. finishUpdate must then be called on the
+	 * main thread.
+	 **/
+	void step(float dt, int velocityIterations, int positionIterations, bool parallel);
+	void finishUpdate();
+
 	// From b2ContactListener
 	void BeginContact(b2Contact *contact);
 	void EndContact(b2Contact *contact);
@@ -173,6 +245,48 @@ public:
 	 **/
 	void setCallbacksL(lua_State *L);
 
+	/**
+	 * Sets whether begin, end and postsolve contacts are recorded as
+	 * ContactEvents instead of calling the Lua callbacks during update. The
+	 * presolve callback is still called, since it can change the contact.
+	 **/
+	void setContactEventsEnabled(bool enable);
+	bool isContactEventsEnabled() const;
+
+	/**
+	 * Sets whether each update spreads the contact updates and the island
+	 * solver over the JobSystem's threads. The results are the same either
+	 * way, but postsolve callbacks are made after all islands are solved.
+	 **/
+	void setParallelSolveEnabled(bool enable);
+	bool isParallelSolveEnabled() const;
+
+	/**
+	 * Copies the state of all Bodies, Fixtures, Joints and contacts into
+	 * memory of getSnapshotSize bytes. Shapes and Lua callbacks aren't
+	 * included.
+	 **/
+	size_t getSnapshotSize() const;
+	void snapshot(void *data) const;
+
+	/**
+	 * Puts back the state copied by snapshot. The snapshot must come from this
+	 * World, and no Bodies, Fixtures or Joints may have been created or
+	 * destroyed since. Existing Contact objects are invalidated.
+	 **/
+	void restore(const void *data, size_t size);
+
+	/**
+	 * Gets the events recorded by the most recent update, along with any
+	 * recorded since then (e.g. when destroying bodies.)
+	 **/
+	const std::vector<ContactEvent> &getContactEvents() const;
+
+	/**
+	 * Gets the Fixture with the given ID (see Fixture::getID), or null.
+	 **/
+	Fixture *getFixtureByID(uint32 id) const;
+
 	/**
 	 * Sets the ContactFilter callback.
 	 **/
@@ -247,6 +361,29 @@ public:
 	 **/
 	int getBodies(lua_State *L) const;
 
+	/**
+	 * Writes the given fields of each Body into dst as packed floats, in the
+	 * order the fields are listed. If bodies is null, the first count bodies
+	 * of the World are written, in the same order as getBodies.
+	 * @param dst Must have room for count * getBodyStateStride(fields) floats.
+	 **/
+	void getBodyStates(const std::vector<BodyStateField> &fields, Body * const *bodies, int count, float *dst) const;
+
+	/**
+	 * Reads the given fields of each Body from src, using the same layout as
+	 * getBodyStates.
+	 **/
+	void setBodyStates(const std::vector<BodyStateField> &fields, Body * const *bodies, int count, const float *src);
+
+	/**
+	 * Gets the number of floats each Body takes up with the given fields.
+	 **/
+	static int getBodyStateStride(const std::vector<BodyStateField> &fields);
+
+	static bool getConstant(const char *in, BodyStateField &out);
+	static bool getConstant(BodyStateField in, const char *&out);
+	static std::vector<std::string> getConstants(BodyStateField);
+
 	/**
 	 * Get an array of all the Joints in the World.
 	 * @return An array of Joints.
@@ -265,6 +402,11 @@ public:
 	 **/
 	b2Body *getGroundBody() const;
 
+	/**
+	 * Gets the World of a Box2D world, or null if it has none.
+	 **/
+	static World *fromBox2D(const b2World *world);
+
 	/**
 	 * Gets all fixtures that overlap a given bounding box.
 	 **/
@@ -275,6 +417,20 @@ public:
 	 **/
 	int rayCast(lua_State *L);
 
+	/**
+	 * Finds the closest Fixture hit by each of count rays, given as x1, y1,
+	 * x2, y2 in rays. Only Fixtures with a category in categoryMask are hit.
+	 * The rays are spread over the JobSystem's threads.
+	 **/
+	void rayCastClosest(const float *rays, int count, uint16 categoryMask, RayCastHit *dst) const;
+
+	/**
+	 * Finds the IDs of the Fixtures overlapping each of count boxes, given as
+	 * x1, y1, x2, y2 in boxes, like queryBoundingBox. The hits of box i are
+	 * ranges[i * 2 + 1] IDs starting at fixtures[ranges[i * 2]].
+	 **/
+	void queryBoundingBoxes(const float *boxes, int count, uint16 categoryMask, std::vector<uint32> &ranges, std::vector<uint32> &fixtures) const;
+
 	/**
 	 * Destroy this world.
 	 **/
@@ -297,6 +453,27 @@ private:
 	// Contact callbacks.
 	ContactCallback begin, end, presolve, postsolve;
 	ContactFilter filter;
+
+	void recordContactEvent(ContactEventType type, b2Contact *contact, const b2ContactImpulse *impulse);
+
+	uint32 registerFixture(Fixture *fixture);
+	void unregisterFixture(uint32 id);
+
+	bool contactEventsEnabled;
+	std::vector<ContactEvent> contactEvents;
+
+	// Number of events at the end of the last update. Those are removed at
+	// the start of the next update, anything recorded in between is kept.
+	size_t lastUpdateEventCount;
+
+	std::unordered_map<uint32, Fixture *> fixturesByID;
+	uint32 nextFixtureID;
+
+	// Unique among all Worlds, see snapshot.
+	uint32 id;
+
+	static StringMap<BodyStateField, BODY_STATE_MAX_ENUM>::Entry bodyStateFieldEntries[];
+	static StringMap<BodyStateField, BODY_STATE_MAX_ENUM> bodyStateFields;
 };
 
 } // box2d
@@ -115,6 +115,13 @@ int w_Fixture_getBody(lua_State *L)
 	return 1;
 }
 
+int w_Fixture_getID(lua_State *L)
+{
+	Fixture *t = luax_checkfixture(L, 1);
+	lua_pushnumber(L, (lua_Number) t->getID());
+	return 1;
+}
+
 int w_Fixture_getShape(lua_State *L)
 {
 	Fixture *t = luax_checkfixture(L, 1);
@@ -279,6 +286,7 @@ static const luaL_Reg w_Fixture_functions[] =
 	{ "getRestitution", w_Fixture_getRestitution },
 	{ "getDensity", w_Fixture_getDensity },
 	{ "getBody", w_Fixture_getBody },
+	{ "getID", w_Fixture_getID },
 	{ "getShape", w_Fixture_getShape },
 	{ "isSensor", w_Fixture_isSensor },
 	{ "testPoint", w_Fixture_testPoint },
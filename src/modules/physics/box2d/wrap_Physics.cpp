@@ -469,6 +469,32 @@ int w_getDistance(lua_State *L)
 	return instance()->getDistance(L);
 }
 
+int w_updateWorlds(lua_State *L)
+{
+	luaL_checktype(L, 1, LUA_TTABLE);
+	float dt = (float) luaL_checknumber(L, 2);
+	int velocityiterations = (int) luaL_optinteger(L, 3, 8);
+	int positioniterations = (int) luaL_optinteger(L, 4, 3);
+
+	int count = (int) luax_objlen(L, 1);
+	std::vector<World *> worlds;
+	worlds.reserve(count);
+
+	for (int i = 1; i <= count; i++)
+	{
+		lua_rawgeti(L, 1, i);
+		World *w = luax_checkworld(L, -1);
+		lua_pop(L, 1);
+
+		// Worlds which are updated on this thread call their callbacks here.
+		w->setCallbacksL(L);
+		worlds.push_back(w);
+	}
+
+	luax_catchexcept(L, [&](){ instance()->updateWorlds(worlds, dt, velocityiterations, positioniterations); });
+	return 0;
+}
+
 int w_setMeter(lua_State *L)
 {
 	float arg1 = (float) luaL_checknumber(L, 1);
@@ -505,6 +531,7 @@ static const luaL_Reg functions[] =
 	{ "newRopeJoint", w_newRopeJoint },
 	{ "newMotorJoint", w_newMotorJoint },
 	{ "getDistance", w_getDistance },
+	{ "updateWorlds", w_updateWorlds },
 	{ "getMeter", w_getMeter },
 	{ "setMeter", w_setMeter },
 	{ 0, 0 },
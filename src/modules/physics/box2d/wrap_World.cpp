@@ -19,6 +19,12 @@
  **/
 
 #include "wrap_World.h"
+#include "wrap_Body.h"
+#include "modules/data/ByteData.h"
+
+// C++
+#include <algorithm>
+#include <cstring>
 
 namespace love
 {
@@ -160,6 +166,109 @@ int w_World_getBodies(lua_State *L)
 	return ret;
 }
 
+static void luax_checkbodystatefields(lua_State *L, int idx, std::vector<World::BodyStateField> &fields)
+{
+	luaL_checktype(L, idx, LUA_TTABLE);
+
+	int count = (int) luax_objlen(L, idx);
+	if (count == 0)
+		luaL_argerror(L, idx, "expected at least one field");
+
+	for (int i = 1; i <= count; i++)
+	{
+		lua_rawgeti(L, idx, i);
+		const char *str = luaL_checkstring(L, -1);
+		World::BodyStateField field;
+		if (!World::getConstant(str, field))
+			luax_enumerror(L, "body state field", World::getConstants(World::BODY_STATE_MAX_ENUM), str);
+		fields.push_back(field);
+		lua_pop(L, 1);
+	}
+}
+
+static void luax_checkbodylist(lua_State *L, int idx, std::vector<Body *> &bodies)
+{
+	luaL_checktype(L, idx, LUA_TTABLE);
+
+	int count = (int) luax_objlen(L, idx);
+	bodies.reserve(count);
+
+	for (int i = 1; i <= count; i++)
+	{
+		lua_rawgeti(L, idx, i);
+		bodies.push_back(luax_checkbody(L, -1));
+		lua_pop(L, 1);
+	}
+}
+
+int w_World_getBodyStates(lua_State *L)
+{
+	World *t = luax_checkworld(L, 1);
+
+	std::vector<World::BodyStateField> fields;
+	luax_checkbodystatefields(L, 3, fields);
+
+	std::vector<Body *> bodies;
+	bool listed = !lua_isnoneornil(L, 4);
+	if (listed)
+		luax_checkbodylist(L, 4, bodies);
+
+	int count = listed ? (int) bodies.size() : t->getBodyCount();
+	size_t size = (size_t) count * World::getBodyStateStride(fields) * sizeof(float);
+
+	// Reuse the given ByteData if the states fit, so syncing every frame
+	// doesn't allocate.
+	data::ByteData *d = nullptr;
+	if (!lua_isnoneornil(L, 2))
+	{
+		d = luax_checktype<data::ByteData>(L, 2);
+		if (d->getSize() < size)
+			d = nullptr;
+		else
+			lua_pushvalue(L, 2);
+	}
+
+	if (d == nullptr)
+	{
+		luax_catchexcept(L, [&]() { d = new data::ByteData(std::max(size, (size_t) 1)); });
+		luax_pushtype(L, d);
+		d->release();
+	}
+
+	luax_catchexcept(L, [&]() {
+		t->getBodyStates(fields, listed ? bodies.data() : nullptr, count, (float *) d->getData());
+	});
+
+	lua_pushinteger(L, count);
+	return 2;
+}
+
+int w_World_setBodyStates(lua_State *L)
+{
+	World *t = luax_checkworld(L, 1);
+	love::Data *d = luax_checktype<love::Data>(L, 2);
+
+	std::vector<World::BodyStateField> fields;
+	luax_checkbodystatefields(L, 3, fields);
+
+	std::vector<Body *> bodies;
+	bool listed = !lua_isnoneornil(L, 4);
+	if (listed)
+		luax_checkbodylist(L, 4, bodies);
+
+	int count = listed ? (int) bodies.size() : t->getBodyCount();
+	size_t size = (size_t) count * World::getBodyStateStride(fields) * sizeof(float);
+
+	if (d->getSize() < size)
+		return luaL_error(L, "Data is too small for %d body states (%d bytes needed, got %d.)", count, (int) size, (int) d->getSize());
+
+	luax_catchexcept(L, [&]() {
+		t->setBodyStates(fields, listed ? bodies.data() : nullptr, count, (const float *) d->getData());
+	});
+
+	return 0;
+}
+
 int w_World_getJoints(lua_State *L)
 {
 	World *t = luax_checkworld(L, 1);
@@ -178,6 +287,113 @@ int w_World_getContacts(lua_State *L)
 	return ret;
 }
 
+int w_World_setContactEventsEnabled(lua_State *L)
+{
+	World *t = luax_checkworld(L, 1);
+	t->setContactEventsEnabled(luax_checkboolean(L, 2));
+	return 0;
+}
+
+int w_World_isContactEventsEnabled(lua_State *L)
+{
+	World *t = luax_checkworld(L, 1);
+	luax_pushboolean(L, t->isContactEventsEnabled());
+	return 1;
+}
+
+int w_World_setParallelSolveEnabled(lua_State *L)
+{
+	World *t = luax_checkworld(L, 1);
+	bool enable = luax_checkboolean(L, 2);
+	luax_catchexcept(L, [&](){ t->setParallelSolveEnabled(enable); });
+	return 0;
+}
+
+int w_World_isParallelSolveEnabled(lua_State *L)
+{
+	World *t = luax_checkworld(L, 1);
+	luax_pushboolean(L, t->isParallelSolveEnabled());
+	return 1;
+}
+
+int w_World_snapshot(lua_State *L)
+{
+	World *t = luax_checkworld(L, 1);
+	size_t size = t->getSnapshotSize();
+
+	// Reuse the given ByteData if the snapshot fits.
+	data::ByteData *d = nullptr;
+	if (!lua_isnoneornil(L, 2))
+	{
+		d = luax_checktype<data::ByteData>(L, 2);
+		if (d->getSize() < size)
+			d = nullptr;
+		else
+			lua_pushvalue(L, 2);
+	}
+
+	if (d == nullptr)
+	{
+		luax_catchexcept(L, [&]() { d = new data::ByteData(size); });
+		luax_pushtype(L, d);
+		d->release();
+	}
+
+	luax_catchexcept(L, [&]() { t->snapshot(d->getData()); });
+	return 1;
+}
+
+int w_World_restore(lua_State *L)
+{
+	World *t = luax_checkworld(L, 1);
+	love::Data *d = luax_checktype<love::Data>(L, 2);
+	luax_catchexcept(L, [&]() { t->restore(d->getData(), d->getSize()); });
+	return 0;
+}
+
+int w_World_getContactEvents(lua_State *L)
+{
+	World *t = luax_checkworld(L, 1);
+	const std::vector<World::ContactEvent> &events = t->getContactEvents();
+	size_t size = events.size() * sizeof(World::ContactEvent);
+
+	// Reuse the given ByteData if the events fit, to avoid an allocation
+	// every frame.
+	data::ByteData *d = nullptr;
+	if (!lua_isnoneornil(L, 2))
+	{
+		d = luax_checktype<data::ByteData>(L, 2);
+		if (d->getSize() < size)
+			d = nullptr;
+		else
+			lua_pushvalue(L, 2);
+	}
+
+	if (d == nullptr)
+	{
+		luax_catchexcept(L, [&]() { d = new data::ByteData(std::max(size, (size_t) 1)); });
+		luax_pushtype(L, d);
+		d->release();
+	}
+
+	if (size > 0)
+		memcpy(d->getData(), events.data(), size);
+
+	lua_pushinteger(L, (lua_Integer) events.size());
+	return 2;
+}
+
+int w_World_getFixtureByID(lua_State *L)
+{
+	World *t = luax_checkworld(L, 1);
+	uint32 id = (uint32) luaL_checknumber(L, 2);
+	Fixture *f = t->getFixtureByID(id);
+	if (f == nullptr)
+		return 0;
+	luax_pushtype(L, f);
+	return 1;
+}
+
 int w_World_queryBoundingBox(lua_State *L)
 {
 	World *t = luax_checkworld(L, 1);
@@ -194,6 +410,92 @@ int w_World_rayCast(lua_State *L)
 	return ret;
 }
 
+// Gets the packed rays or boxes of the batched queries: count groups of four
+// floats, by default as many as fit in the Data.
+static const float *luax_checkquerylist(lua_State *L, int idx, int &count)
+{
+	love::Data *data = luax_checktype<love::Data>(L, idx);
+	size_t available = data->getSize() / (sizeof(float) * 4);
+
+	count = (int) luaL_optinteger(L, idx + 1, (lua_Integer) available);
+	if (count < 0 || (size_t) count > available)
+		luaL_error(L, "Data is too small for %d queries.", count);
+
+	return (const float *) data->getData();
+}
+
+int w_World_rayCastClosest(lua_State *L)
+{
+	World *t = luax_checkworld(L, 1);
+	int count = 0;
+	const float *rays = luax_checkquerylist(L, 2, count);
+	uint16 mask = (uint16) luaL_optinteger(L, 4, 0xFFFF);
+	size_t size = (size_t) count * sizeof(World::RayCastHit);
+
+	// Reuse the given ByteData if the hits fit.
+	data::ByteData *d = nullptr;
+	if (!lua_isnoneornil(L, 5))
+	{
+		d = luax_checktype<data::ByteData>(L, 5);
+		if (d->getSize() < size)
+			d = nullptr;
+		else
+			lua_pushvalue(L, 5);
+	}
+
+	if (d == nullptr)
+	{
+		luax_catchexcept(L, [&]() { d = new data::ByteData(std::max(size, (size_t) 1)); });
+		luax_pushtype(L, d);
+		d->release();
+	}
+
+	luax_catchexcept(L, [&]() { t->rayCastClosest(rays, count, mask, (World::RayCastHit *) d->getData()); });
+	return 1;
+}
+
+int w_World_queryBoundingBoxes(lua_State *L)
+{
+	World *t = luax_checkworld(L, 1);
+	int count = 0;
+	const float *boxes = luax_checkquerylist(L, 2, count);
+	uint16 mask = (uint16) luaL_optinteger(L, 4, 0xFFFF);
+
+	std::vector<uint32> ranges;
+	std::vector<uint32> fixtures;
+	luax_catchexcept(L, [&]() { t->queryBoundingBoxes(boxes, count, mask, ranges, fixtures); });
+
+	size_t size = (ranges.size() + fixtures.size()) * sizeof(uint32);
+
+	// Reuse the given ByteData if the results fit.
+	data::ByteData *d = nullptr;
+	if (!lua_isnoneornil(L, 5))
+	{
+		d = luax_checktype<data::ByteData>(L, 5);
+		if (d->getSize() < size)
+			d = nullptr;
+		else
+			lua_pushvalue(L, 5);
+	}
+
+	if (d == nullptr)
+	{
+		luax_catchexcept(L, [&]() { d = new data::ByteData(std::max(size, (size_t) 1)); });
+		luax_pushtype(L, d);
+		d->release();
+	}
+
+	// The ranges of all boxes come first, then the fixture IDs.
+	uint32 *dst = (uint32 *) d->getData();
+	if (!ranges.empty())
+		memcpy(dst, ranges.data(), ranges.size() * sizeof(uint32));
+	if (!fixtures.empty())
+		memcpy(dst + ranges.size(), fixtures.data(), fixtures.size() * sizeof(uint32));
+
+	lua_pushinteger(L, (lua_Integer) fixtures.size());
+	return 2;
+}
+
 int w_World_destroy(lua_State *L)
 {
 	World *t = luax_checkworld(L, 1);
@@ -243,10 +545,22 @@ static const luaL_Reg w_World_functions[] =
 	{ "getJointCount", w_World_getJointCount },
 	{ "getContactCount", w_World_getContactCount },
 	{ "getBodies", w_World_getBodies },
+	{ "getBodyStates", w_World_getBodyStates },
+	{ "setBodyStates", w_World_setBodyStates },
 	{ "getJoints", w_World_getJoints },
 	{ "getContacts", w_World_getContacts },
+	{ "setContactEventsEnabled", w_World_setContactEventsEnabled },
+	{ "isContactEventsEnabled", w_World_isContactEventsEnabled },
+	{ "setParallelSolveEnabled", w_World_setParallelSolveEnabled },
+	{ "isParallelSolveEnabled", w_World_isParallelSolveEnabled },
+	{ "snapshot", w_World_snapshot },
+	{ "restore", w_World_restore },
+	{ "getContactEvents", w_World_getContactEvents },
+	{ "getFixtureByID", w_World_getFixtureByID },
 	{ "queryBoundingBox", w_World_queryBoundingBox },
 	{ "rayCast", w_World_rayCast },
+	{ "rayCastClosest", w_World_rayCastClosest },
+	{ "queryBoundingBoxes", w_World_queryBoundingBoxes },
 	{ "destroy", w_World_destroy },
 	{ "isDestroyed", w_World_isDestroyed },
 
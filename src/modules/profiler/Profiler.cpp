@@ -0,0 +1,282 @@
+/**
+ * Copyright (c) 2006-2018 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#include "Profiler.h"
+#include "thread/threads.h"
+
+// C++
+#include <chrono>
+#include <vector>
+#include <cstdio>
+
+namespace love
+{
+namespace profiler
+{
+
+namespace
+{
+
+struct Zone
+{
+	const char *category;
+	const char *name;
+	int64 start;
+	int64 end;
+};
+
+// Zones are only ever written by the thread which owns the buffer, and only
+// appended, so readers just need to see 'count' (and 'generation') with
+// acquire semantics to safely read everything before it.
+struct ThreadBuffer
+{
+	Zone *zones;
+	std::atomic<int> count;
+	std::atomic<int64> dropped;
+	std::atomic<uint32> generation;
+	std::atomic<bool> owned;
+	int id;
+	bool main;
+};
+
+// Releases the thread's buffer when the thread exits, so new threads can
+// reuse it instead of allocating another one.
+struct ThreadBufferRef
+{
+	ThreadBuffer *buffer = nullptr;
+	bool main = false;
+
+	~ThreadBufferRef()
+	{
+		if (buffer != nullptr)
+			buffer->owned.store(false);
+	}
+};
+
+thread_local ThreadBufferRef localBuffer;
+
+// Buffers live for the rest of the process, since a thread might still be
+// finishing a zone when the module is destroyed.
+std::vector<ThreadBuffer *> buffers;
+
+// Incremented by every start, so each thread clears its own stale zones
+// before recording new ones.
+std::atomic<uint32> generation(0);
+
+int64 startTime = 0;
+
+std::atomic<thread::Mutex *> buffersMutex(nullptr);
+
+thread::Mutex *getBuffersMutex()
+{
+	thread::Mutex *mutex = buffersMutex.load();
+	if (mutex != nullptr)
+		return mutex;
+
+	thread::Mutex *newmutex = thread::newMutex();
+	if (buffersMutex.compare_exchange_strong(mutex, newmutex))
+		return newmutex;
+
+	// Another thread got there first.
+	delete newmutex;
+	return mutex;
+}
+
+ThreadBuffer *acquireThreadBuffer()
+{
+	thread::Lock lock(getBuffersMutex());
+
+	for (ThreadBuffer *buffer : buffers)
+	{
+		bool owned = false;
+		if (buffer->owned.compare_exchange_strong(owned, true))
+		{
+			buffer->main = localBuffer.main;
+			return buffer;
+		}
+	}
+
+	ThreadBuffer *buffer = new ThreadBuffer();
+	buffer->zones = new Zone[Profiler::ZONES_PER_THREAD];
+	buffer->count.store(0);
+	buffer->dropped.store(0);
+	buffer->generation.store(generation.load());
+	buffer->owned.store(true);
+	buffer->id = (int) buffers.size() + 1;
+	buffer->main = localBuffer.main;
+
+	buffers.push_back(buffer);
+	return buffer;
+}
+
+void appendEscaped(std::string &str, const char *s)
+{
+	for (; *s != '\0'; s++)
+	{
+		if (*s == '"' || *s == '\\')
+			str += '\\';
+		str += *s;
+	}
+}
+
+} // anonymous namespace
+
+std::atomic<bool> Profiler::active(false);
+
+Profiler::Profiler()
+{
+	// Modules are loaded on the main thread.
+	localBuffer.main = true;
+}
+
+Profiler::~Profiler()
+{
+	stop();
+}
+
+void Profiler::start()
+{
+	thread::Lock lock(getBuffersMutex());
+
+	startTime = getTimestamp();
+	generation.fetch_add(1);
+	active.store(true);
+}
+
+void Profiler::stop()
+{
+	active.store(false);
+}
+
+std::string Profiler::getTrace(int64 &zonecount)
+{
+	thread::Lock lock(getBuffersMutex());
+
+	uint32 gen = generation.load();
+	zonecount = 0;
+
+	std::string trace = "{\"traceEvents\":[\n";
+	char buf[256];
+	bool first = true;
+
+	for (ThreadBuffer *buffer : buffers)
+	{
+		// A buffer from an older generation hasn't recorded anything since
+		// the last start. Its owner can't reset it while we hold the lock,
+		// since that only happens after a start.
+		if (buffer->generation.load(std::memory_order_acquire) != gen)
+			continue;
+
+		int count = buffer->count.load(std::memory_order_acquire);
+		if (count == 0)
+			continue;
+
+		char threadname[32];
+		if (buffer->main)
+			snprintf(threadname, sizeof(threadname), "Main thread");
+		else
+			snprintf(threadname, sizeof(threadname), "Thread %d", buffer->id);
+
+		snprintf(buf, sizeof(buf), "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+		         first ? "" : ",\n", buffer->id, threadname);
+		trace += buf;
+		first = false;
+
+		for (int i = 0; i < count; i++)
+		{
+			const Zone &zone = buffer->zones[i];
+
+			trace += ",\n{\"name\":\"";
+			appendEscaped(trace, zone.name);
+			trace += "\",\"cat\":\"";
+			appendEscaped(trace, zone.category);
+
+			// Chrome traces use microseconds.
+			snprintf(buf, sizeof(buf), "\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%d}",
+			         (zone.start - startTime) / 1000.0, (zone.end - zone.start) / 1000.0, buffer->id);
+			trace += buf;
+		}
+
+		zonecount += count;
+	}
+
+	trace += "\n],\"displayTimeUnit\":\"ms\"}\n";
+	return trace;
+}
+
+int64 Profiler::getDroppedCount()
+{
+	thread::Lock lock(getBuffersMutex());
+
+	uint32 gen = generation.load();
+	int64 dropped = 0;
+
+	for (ThreadBuffer *buffer : buffers)
+	{
+		if (buffer->generation.load(std::memory_order_acquire) == gen)
+			dropped += buffer->dropped.load(std::memory_order_relaxed);
+	}
+
+	return dropped;
+}
+
+int64 Profiler::getTimestamp()
+{
+	auto now = std::chrono::steady_clock::now().time_since_epoch();
+	return (int64) std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+}
+
+void Profiler::recordZone(const char *category, const char *name, int64 start, int64 end)
+{
+	ThreadBuffer *buffer = localBuffer.buffer;
+	if (buffer == nullptr)
+	{
+		buffer = acquireThreadBuffer();
+		localBuffer.buffer = buffer;
+	}
+
+	// Clear zones from a previous run. The count is reset before the new
+	// generation is published, so readers never pair the two up wrongly.
+	uint32 gen = generation.load(std::memory_order_acquire);
+	if (buffer->generation.load(std::memory_order_relaxed) != gen)
+	{
+		buffer->count.store(0, std::memory_order_relaxed);
+		buffer->dropped.store(0, std::memory_order_relaxed);
+		buffer->generation.store(gen, std::memory_order_release);
+	}
+
+	int count = buffer->count.load(std::memory_order_relaxed);
+	if (count >= ZONES_PER_THREAD)
+	{
+		buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+
+	Zone &zone = buffer->zones[count];
+	zone.category = category;
+	zone.name = name;
+	zone.start = start;
+	zone.end = end;
+
+	buffer->count.store(count + 1, std::memory_order_release);
+}
+
+} // profiler
+} // love
@@ -0,0 +1,132 @@
+/**
+ * Copyright (c) 2006-2018 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#ifndef LOVE_PROFILER_PROFILER_H
+#define LOVE_PROFILER_PROFILER_H
+
+// LOVE
+#include "common/config.h"
+#include "common/Module.h"
+#include "common/int.h"
+
+// C++
+#include <atomic>
+#include <string>
+
+/**
+ * Instrumentation zones. A zone measures the time until the end of the
+ * enclosing scope while the profiler is running. Both strings must be string
+ * literals (or otherwise outlive the profiler), since only the pointers are
+ * stored.
+ *
+ * When love.profiler is disabled at compile time the zones compile to nothing.
+ **/
+#ifdef LOVE_ENABLE_PROFILER
+#	define LOVE_PROFILE_CONCAT_(a, b) a##b
+#	define LOVE_PROFILE_CONCAT(a, b) LOVE_PROFILE_CONCAT_(a, b)
+#	define LOVE_PROFILE_ZONE(category, name) \
+		love::profiler::ScopedZone LOVE_PROFILE_CONCAT(love_profile_zone_, __LINE__)(category, name)
+#else
+#	define LOVE_PROFILE_ZONE(category, name)
+#endif
+
+namespace love
+{
+namespace profiler
+{
+
+class Profiler : public Module
+{
+public:
+
+	Profiler();
+	virtual ~Profiler();
+
+	// Implements Module.
+	virtual ModuleType getModuleType() const { return M_PROFILER; }
+	virtual const char *getName() const { return "love.profiler"; }
+
+	/**
+	 * Discards any previously recorded zones and starts recording.
+	 **/
+	void start();
+	void stop();
+
+	/**
+	 * Gets the recorded zones of every thread as Chrome trace event JSON,
+	 * which can be loaded in chrome://tracing or similar tools.
+	 * @param[out] zonecount The number of zones in the trace.
+	 **/
+	std::string getTrace(int64 &zonecount);
+
+	/**
+	 * Gets the number of zones which didn't fit in their thread's buffer
+	 * since the profiler was started.
+	 **/
+	int64 getDroppedCount();
+
+	static bool isActive()
+	{
+		return active.load(std::memory_order_relaxed);
+	}
+
+	// Monotonic time in nanoseconds.
+	static int64 getTimestamp();
+
+	static void recordZone(const char *category, const char *name, int64 start, int64 end);
+
+	// Maximum number of zones recorded per thread between start and dump.
+	static const int ZONES_PER_THREAD = 1 << 16;
+
+private:
+
+	static std::atomic<bool> active;
+
+}; // Profiler
+
+class ScopedZone
+{
+public:
+
+	ScopedZone(const char *category, const char *name)
+		: category(category)
+		, name(name)
+		, start(Profiler::isActive() ? Profiler::getTimestamp() : -1)
+	{
+	}
+
+	~ScopedZone()
+	{
+		if (start >= 0)
+			Profiler::recordZone(category, name, start, Profiler::getTimestamp());
+	}
+
+private:
+
+	const char *category;
+	const char *name;
+	int64 start;
+
+}; // ScopedZone
+
+} // profiler
+} // love
+
+#endif // LOVE_PROFILER_PROFILER_H
@@ -0,0 +1,114 @@
+/**
+ * Copyright (c) 2006-2018 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#include "wrap_Profiler.h"
+#include "filesystem/Filesystem.h"
+
+namespace love
+{
+namespace profiler
+{
+
+#define instance() (Module::getInstance<Profiler>(Module::M_PROFILER))
+
+int w_start(lua_State *L)
+{
+	luax_catchexcept(L, [&]() { instance()->start(); });
+	return 0;
+}
+
+int w_stop(lua_State *L)
+{
+	instance()->stop();
+	return 0;
+}
+
+int w_isActive(lua_State *L)
+{
+	luax_pushboolean(L, Profiler::isActive());
+	return 1;
+}
+
+int w_dump(lua_State *L)
+{
+	const char *filename = luaL_optstring(L, 1, nullptr);
+
+	std::string trace;
+	int64 zonecount = 0;
+	luax_catchexcept(L, [&]() { trace = instance()->getTrace(zonecount); });
+
+	if (filename == nullptr)
+	{
+		luax_pushstring(L, trace);
+		lua_pushnumber(L, (lua_Number) zonecount);
+		return 2;
+	}
+
+	auto fs = Module::getInstance<love::filesystem::Filesystem>(Module::M_FILESYSTEM);
+	if (fs == nullptr)
+		return luaL_error(L, "love.filesystem must be loaded to write a trace to a file.");
+
+	luax_catchexcept(L, [&]() { fs->write(filename, trace.data(), (int64) trace.size()); });
+
+	lua_pushnumber(L, (lua_Number) zonecount);
+	return 1;
+}
+
+int w_getDroppedCount(lua_State *L)
+{
+	int64 dropped = 0;
+	luax_catchexcept(L, [&]() { dropped = instance()->getDroppedCount(); });
+	lua_pushnumber(L, (lua_Number) dropped);
+	return 1;
+}
+
+// List of functions to wrap.
+static const luaL_Reg functions[] =
+{
+	{ "start", w_start },
+	{ "stop", w_stop },
+	{ "isActive", w_isActive },
+	{ "dump", w_dump },
+	{ "getDroppedCount", w_getDroppedCount },
+	{ 0, 0 }
+};
+
+extern "C" int luaopen_love_profiler(lua_State *L)
+{
+	Profiler *instance = instance();
+	if (instance == nullptr)
+	{
+		luax_catchexcept(L, [&](){ instance = new Profiler(); });
+	}
+	else
+		instance->retain();
+
+	WrappedModule w;
+	w.module = instance;
+	w.name = "profiler";
+	w.type = &Module::type;
+	w.functions = functions;
+	w.types = nullptr;
+
+	return luax_register_module(L, w);
+}
+
+} // profiler
+} // love
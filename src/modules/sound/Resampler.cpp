@@ -0,0 +1,332 @@
+/**
+ * Copyright (c) 2006-2018 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#include "Resampler.h"
+#include "common/Exception.h"
+#include "common/math.h"
+
+// C++
+#include <algorithm>
+#include <cmath>
+
+#if defined(LOVE_SIMD_SSE)
+#include <xmmintrin.h>
+#endif
+#if defined(LOVE_SIMD_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace love
+{
+namespace sound
+{
+
+struct QualitySettings
+{
+	// Filter length in input frames, when not downsampling.
+	int taps;
+
+	// Kaiser window shape. Higher values give more stopband attenuation, at
+	// the cost of a wider transition band.
+	double beta;
+
+	// Cutoff frequency as a fraction of the Nyquist frequency.
+	double cutoff;
+};
+
+static const QualitySettings qualitySettings[Resampler::QUALITY_MAX_ENUM] =
+{
+	{ 8,  5.0, 0.85 },
+	{ 16, 7.0, 0.90 },
+	{ 32, 9.0, 0.94 },
+};
+
+static int64 gcd(int64 a, int64 b)
+{
+	while (b != 0)
+	{
+		int64 t = a % b;
+		a = b;
+		b = t;
+	}
+	return a;
+}
+
+// Zeroth order modified Bessel function of the first kind.
+static double bessel0(double x)
+{
+	double sum = 1.0;
+	double term = 1.0;
+
+	for (int k = 1; k < 32; k++)
+	{
+		double t = x / (2.0 * k);
+		term *= t * t;
+		sum += term;
+
+		if (term < sum * 1e-12)
+			break;
+	}
+
+	return sum;
+}
+
+Resampler::Resampler(int inputRate, int outputRate, int channels, Quality quality)
+	: inputRate(inputRate)
+	, outputRate(outputRate)
+	, channels(channels)
+	, up(1)
+	, down(1)
+	, phases(1)
+	, taps(0)
+	, position(0)
+	, fraction(0)
+	, inputFrames(0)
+	, outputFrames(0)
+{
+	if (inputRate <= 0 || outputRate <= 0)
+		throw love::Exception("Invalid sample rate.");
+
+	if (channels <= 0)
+		throw love::Exception("Invalid channel count: %d", channels);
+
+	if (quality < 0 || quality >= QUALITY_MAX_ENUM)
+		throw love::Exception("Invalid resampling quality.");
+
+	int64 g = gcd(inputRate, outputRate);
+	up = outputRate / g;
+	down = inputRate / g;
+	phases = (int) std::min(up, (int64) MAX_PHASES);
+
+	const QualitySettings &settings = qualitySettings[quality];
+
+	// When downsampling, the filter has to cut off below the output's Nyquist
+	// frequency, which takes proportionally more input frames.
+	double ratio = std::min((double) outputRate / (double) inputRate, 1.0);
+	double cutoff = 0.5 * settings.cutoff * ratio;
+
+	// Keep the length a multiple of 4 for the SIMD dot product.
+	taps = (int) ceil(settings.taps / ratio);
+	taps = (taps + 3) & ~3;
+
+	double halfLength = taps / 2;
+	double beta = settings.beta;
+	double norm = bessel0(beta);
+
+	coefficients.resize((size_t) phases * taps);
+
+	for (int p = 0; p < phases; p++)
+	{
+		float *h = &coefficients[(size_t) p * taps];
+		double offset = (double) p / (double) phases;
+		double sum = 0.0;
+
+		for (int k = 0; k < taps; k++)
+		{
+			// Distance in input frames from this tap to the output frame.
+			double t = (k - (halfLength - 1)) - offset;
+
+			double x = 2.0 * cutoff * t;
+			double sinc = x == 0.0 ? 1.0 : sin(LOVE_M_PI * x) / (LOVE_M_PI * x);
+
+			double w = t / halfLength;
+			double window = w * w < 1.0 ? bessel0(beta * sqrt(1.0 - w * w)) / norm : 0.0;
+
+			double v = sinc * window;
+			h[k] = (float) v;
+			sum += v;
+		}
+
+		// Each phase gets unity gain, so DC passes through unchanged.
+		for (int k = 0; k < taps; k++)
+			h[k] = (float) (h[k] / sum);
+	}
+
+	history.resize(channels);
+	reset();
+}
+
+Resampler::~Resampler()
+{
+}
+
+void Resampler::reset()
+{
+	// The filter is centered on the output frame, so the first few outputs
+	// need input from before the start. That input is silence.
+	for (auto &h : history)
+		h.assign(taps / 2 - 1, 0.0f);
+
+	position = 0;
+	fraction = 0;
+	inputFrames = 0;
+	outputFrames = 0;
+}
+
+void Resampler::process(const float *in, int frames, std::vector<float> &out)
+{
+	if (frames <= 0)
+		return;
+
+	// Deinterleave, so each channel's filter runs over contiguous memory.
+	for (int c = 0; c < channels; c++)
+	{
+		std::vector<float> &h = history[c];
+		size_t size = h.size();
+		h.resize(size + frames);
+
+		for (int i = 0; i < frames; i++)
+			h[size + i] = in[i * channels + c];
+	}
+
+	inputFrames += frames;
+	produce(out, -1);
+}
+
+void Resampler::flush(std::vector<float> &out)
+{
+	for (auto &h : history)
+		h.resize(h.size() + taps / 2, 0.0f);
+
+	produce(out, getOutputFrames(inputFrames, inputRate, outputRate));
+}
+
+void Resampler::produce(std::vector<float> &out, int64 limit)
+{
+	size_t available = history[0].size();
+
+	while (position + taps <= available && (limit < 0 || outputFrames < limit))
+	{
+		int phase = (int) (phases == up ? fraction : (fraction * phases) / up);
+		const float *h = &coefficients[(size_t) phase * taps];
+
+		for (int c = 0; c < channels; c++)
+			out.push_back(dot(h, &history[c][position], taps));
+
+		outputFrames++;
+
+		fraction += down;
+		position += (size_t) (fraction / up);
+		fraction %= up;
+	}
+
+	// Drop the input which no output needs anymore.
+	size_t consumed = std::min(position, available);
+	if (consumed > 0)
+	{
+		for (auto &h : history)
+			h.erase(h.begin(), h.begin() + consumed);
+
+		position -= consumed;
+	}
+}
+
+float Resampler::dot(const float *a, const float *b, int count)
+{
+	int i = 0;
+	float sum = 0.0f;
+
+#if defined(LOVE_SIMD_SSE)
+	__m128 acc0 = _mm_setzero_ps();
+	__m128 acc1 = _mm_setzero_ps();
+
+	for (; i + 8 <= count; i += 8)
+	{
+		acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(a + i + 0), _mm_loadu_ps(b + i + 0)));
+		acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(a + i + 4), _mm_loadu_ps(b + i + 4)));
+	}
+
+	for (; i + 4 <= count; i += 4)
+		acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+
+	float lanes[4];
+	_mm_storeu_ps(lanes, _mm_add_ps(acc0, acc1));
+	sum = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+#elif defined(LOVE_SIMD_NEON)
+	float32x4_t acc0 = vdupq_n_f32(0.0f);
+	float32x4_t acc1 = vdupq_n_f32(0.0f);
+
+	for (; i + 8 <= count; i += 8)
+	{
+		acc0 = vmlaq_f32(acc0, vld1q_f32(a + i + 0), vld1q_f32(b + i + 0));
+		acc1 = vmlaq_f32(acc1, vld1q_f32(a + i + 4), vld1q_f32(b + i + 4));
+	}
+
+	for (; i + 4 <= count; i += 4)
+		acc0 = vmlaq_f32(acc0, vld1q_f32(a + i), vld1q_f32(b + i));
+
+	float lanes[4];
+	vst1q_f32(lanes, vaddq_f32(acc0, acc1));
+	sum = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+#endif
+
+	for (; i < count; i++)
+		sum += a[i] * b[i];
+
+	return sum;
+}
+
+int Resampler::getInputRate() const
+{
+	return inputRate;
+}
+
+int Resampler::getOutputRate() const
+{
+	return outputRate;
+}
+
+int Resampler::getChannelCount() const
+{
+	return channels;
+}
+
+int64 Resampler::getOutputFrames(int64 inputFrames, int inputRate, int outputRate)
+{
+	// Every output frame at or before the last input frame's position.
+	return (inputFrames * outputRate + inputRate - 1) / inputRate;
+}
+
+bool Resampler::getConstant(const char *in, Quality &out)
+{
+	return qualities.find(in, out);
+}
+
+bool Resampler::getConstant(Quality in, const char *&out)
+{
+	return qualities.find(in, out);
+}
+
+std::vector<std::string> Resampler::getConstants(Quality)
+{
+	return qualities.getNames();
+}
+
+StringMap<Resampler::Quality, Resampler::QUALITY_MAX_ENUM>::Entry Resampler::qualityEntries[] =
+{
+	{"low",    QUALITY_LOW},
+	{"medium", QUALITY_MEDIUM},
+	{"high",   QUALITY_HIGH},
+};
+
+StringMap<Resampler::Quality, Resampler::QUALITY_MAX_ENUM> Resampler::qualities(Resampler::qualityEntries, sizeof(Resampler::qualityEntries));
+
+} // sound
+} // love
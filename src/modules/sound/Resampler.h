@@ -0,0 +1,132 @@
+/**
+ * Copyright (c) 2006-2018 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#ifndef LOVE_SOUND_RESAMPLER_H
+#define LOVE_SOUND_RESAMPLER_H
+
+// LOVE
+#include "common/config.h"
+#include "common/int.h"
+#include "common/StringMap.h"
+
+// C++
+#include <vector>
+#include <string>
+
+namespace love
+{
+namespace sound
+{
+
+/**
+ * Converts audio between sample rates with a polyphase windowed-sinc filter.
+ * Works on interleaved float samples, and keeps enough of its input around
+ * that audio can be fed to it in pieces of any size.
+ **/
+class Resampler
+{
+public:
+
+	enum Quality
+	{
+		QUALITY_LOW,
+		QUALITY_MEDIUM,
+		QUALITY_HIGH,
+		QUALITY_MAX_ENUM
+	};
+
+	Resampler(int inputRate, int outputRate, int channels, Quality quality);
+	~Resampler();
+
+	/**
+	 * Resamples interleaved frames and appends the result to out. The last
+	 * few input frames are held back until more input (or flush) follows.
+	 **/
+	void process(const float *in, int frames, std::vector<float> &out);
+
+	/**
+	 * Appends the output for the held back input, as if it was followed by
+	 * silence. The total output then matches getOutputFrames.
+	 **/
+	void flush(std::vector<float> &out);
+
+	/**
+	 * Forgets all input, to start over with unrelated audio.
+	 **/
+	void reset();
+
+	int getInputRate() const;
+	int getOutputRate() const;
+	int getChannelCount() const;
+
+	/**
+	 * Gets the number of frames a given number of input frames resample to.
+	 **/
+	static int64 getOutputFrames(int64 inputFrames, int inputRate, int outputRate);
+
+	static bool getConstant(const char *in, Quality &out);
+	static bool getConstant(Quality in, const char *&out);
+	static std::vector<std::string> getConstants(Quality);
+
+private:
+
+	void produce(std::vector<float> &out, int64 limit);
+
+	static float dot(const float *a, const float *b, int count);
+
+	// Most filter phases to precompute. Ratios which need more than this use
+	// the nearest phase below.
+	static const int MAX_PHASES = 512;
+
+	int inputRate;
+	int outputRate;
+	int channels;
+
+	// The ratio of the rates, in lowest terms: up output frames for every
+	// down input frames.
+	int64 up;
+	int64 down;
+
+	int phases;
+	int taps;
+
+	// Filter coefficients, taps of them for each phase.
+	std::vector<float> coefficients;
+
+	// Input which is still needed, one buffer per channel.
+	std::vector<std::vector<float>> history;
+
+	// Index in history of the first input of the next output frame, and
+	// where between that input and the next one the output falls (out of up).
+	size_t position;
+	int64 fraction;
+
+	int64 inputFrames;
+	int64 outputFrames;
+
+	static StringMap<Quality, QUALITY_MAX_ENUM>::Entry qualityEntries[];
+	static StringMap<Quality, QUALITY_MAX_ENUM> qualities;
+
+}; // Resampler
+
+} // sound
+} // love
+
+#endif // LOVE_SOUND_RESAMPLER_H
@@ -0,0 +1,133 @@
+/**
+ * Copyright (c) 2006-2018 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#include "ResamplingDecoder.h"
+#include "SoundData.h"
+
+// C++
+#include <algorithm>
+
+namespace love
+{
+namespace sound
+{
+
+ResamplingDecoder::ResamplingDecoder(Decoder *source, int sampleRate, Resampler::Quality quality)
+	: Decoder(nullptr, "", source->getSize())
+	, source(source)
+	, quality(quality)
+	, resampler(source->getSampleRate(), sampleRate, source->getChannelCount(), quality)
+	, pendingOffset(0)
+	, sourceFinished(false)
+{
+	this->sampleRate = sampleRate;
+}
+
+ResamplingDecoder::~ResamplingDecoder()
+{
+}
+
+Decoder *ResamplingDecoder::clone()
+{
+	StrongRef<Decoder> s(source->clone(), Acquire::NORETAIN);
+	return new ResamplingDecoder(s, sampleRate, quality);
+}
+
+int ResamplingDecoder::decode()
+{
+	int channels = getChannelCount();
+	int bitDepth = getBitDepth();
+	int frameSize = channels * (bitDepth / 8);
+	size_t wanted = (size_t) (bufferSize / frameSize) * channels;
+
+	while (pending.size() - pendingOffset < wanted && !sourceFinished)
+	{
+		// Move what's left to the front before adding more.
+		pending.erase(pending.begin(), pending.begin() + pendingOffset);
+		pendingOffset = 0;
+
+		int decoded = source->decode();
+		if (decoded <= 0)
+		{
+			resampler.flush(pending);
+			sourceFinished = true;
+			break;
+		}
+
+		int samples = decoded / (bitDepth / 8);
+		input.resize(samples);
+		SoundData::toFloat(source->getBuffer(), bitDepth, samples, input.data());
+
+		resampler.process(input.data(), samples / channels, pending);
+	}
+
+	size_t samples = std::min(pending.size() - pendingOffset, wanted);
+	SoundData::fromFloat(pending.data() + pendingOffset, samples, bitDepth, buffer);
+	pendingOffset += samples;
+
+	if (samples == 0)
+		eof = true;
+
+	return (int) (samples * (bitDepth / 8));
+}
+
+void ResamplingDecoder::restart()
+{
+	resampler.reset();
+	pending.clear();
+	pendingOffset = 0;
+	sourceFinished = false;
+	eof = false;
+}
+
+bool ResamplingDecoder::seek(float s)
+{
+	restart();
+	return source->seek(s);
+}
+
+bool ResamplingDecoder::rewind()
+{
+	restart();
+	return source->rewind();
+}
+
+bool ResamplingDecoder::isSeekable()
+{
+	return source->isSeekable();
+}
+
+int ResamplingDecoder::getChannelCount() const
+{
+	return source->getChannelCount();
+}
+
+int ResamplingDecoder::getBitDepth() const
+{
+	return source->getBitDepth();
+}
+
+double ResamplingDecoder::getDuration()
+{
+	return source->getDuration();
+}
+
+} // sound
+} // love
@@ -0,0 +1,77 @@
+/**
+ * Copyright (c) 2006-2018 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#ifndef LOVE_SOUND_RESAMPLING_DECODER_H
+#define LOVE_SOUND_RESAMPLING_DECODER_H
+
+// LOVE
+#include "Decoder.h"
+#include "Resampler.h"
+
+// C++
+#include <vector>
+
+namespace love
+{
+namespace sound
+{
+
+/**
+ * Decodes another Decoder's audio and resamples it to a different sample
+ * rate on the fly.
+ **/
+class ResamplingDecoder : public Decoder
+{
+public:
+
+	ResamplingDecoder(Decoder *source, int sampleRate, Resampler::Quality quality);
+	virtual ~ResamplingDecoder();
+
+	Decoder *clone();
+	int decode();
+	bool seek(float s);
+	bool rewind();
+	bool isSeekable();
+	int getChannelCount() const;
+	int getBitDepth() const;
+	double getDuration();
+
+private:
+
+	void restart();
+
+	StrongRef<Decoder> source;
+	Resampler::Quality quality;
+	Resampler resampler;
+
+	std::vector<float> input;
+
+	// Resampled audio which didn't fit in the buffer yet.
+	std::vector<float> pending;
+	size_t pendingOffset;
+
+	bool sourceFinished;
+
+}; // ResamplingDecoder
+
+} // sound
+} // love
+
+#endif // LOVE_SOUND_RESAMPLING_DECODER_H
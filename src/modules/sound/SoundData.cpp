@@ -28,6 +28,15 @@
 #include <limits>
 #include <iostream>
 #include <vector>
+#include <algorithm>
+#include <cmath>
+
+#if defined(LOVE_SIMD_SSE2)
+#include <emmintrin.h>
+#endif
+#if defined(LOVE_SIMD_NEON)
+#include <arm_neon.h>
+#endif
 
 namespace love
 {
@@ -36,6 +45,32 @@ namespace sound
 
 love::Type SoundData::type("SoundData", &Data::type);
 
+// Number of samples converted at once by the bulk operations which work on
+// floats internally.
+static const size_t BLOCK_SAMPLES = 1024;
+
+// Runs func(samples, offset, count) over blocks of whole sample frames in the
+// given range of raw samples, converted to floats. The blocks are converted
+// back afterwards. Offsets and counts are in samples, not frames.
+template <typename T>
+static void processSamples(uint8 *data, int bitDepth, int channels, size_t first, size_t count, T func)
+{
+	size_t blockSize = std::max(BLOCK_SAMPLES / channels, (size_t) 1) * channels;
+	std::vector<float> block(blockSize);
+
+	uint8 *p = data + first * (bitDepth / 8);
+
+	for (size_t offset = 0; offset < count; offset += blockSize)
+	{
+		size_t n = std::min(count - offset, blockSize);
+		uint8 *src = p + offset * (bitDepth / 8);
+
+		SoundData::toFloat(src, bitDepth, n, block.data());
+		func(block.data(), offset, n);
+		SoundData::fromFloat(block.data(), n, bitDepth, src);
+	}
+}
+
 SoundData::SoundData(Decoder *decoder)
 	: data(0)
 	, size(0)
@@ -258,5 +293,415 @@ float SoundData::getSample(int i, int channel) const
 	return getSample(i * channels + (channel - 1));
 }
 
+void SoundData::checkRange(int start, int count, int channel) const
+{
+	if (channel < 0 || channel > channels)
+		throw love::Exception("Invalid channel: %d", channel);
+
+	if (start < 0 || count < 0 || count > getSampleCount() - start)
+		throw love::Exception("Sample range out of bounds!");
+}
+
+void SoundData::getSamples(int start, int count, int channel, float *dst) const
+{
+	checkRange(start, count, channel);
+
+	size_t first = (size_t) start * channels;
+
+	if (channel == 0 || channels == 1)
+	{
+		toFloat(data + first * (bitDepth / 8), bitDepth, (size_t) count * channels, dst);
+		return;
+	}
+
+	// Convert whole frames and pick out the channel.
+	size_t frames = std::max(BLOCK_SAMPLES / channels, (size_t) 1);
+	std::vector<float> block(frames * channels);
+
+	for (size_t offset = 0; offset < (size_t) count; offset += frames)
+	{
+		size_t n = std::min((size_t) count - offset, frames);
+		toFloat(data + (first + offset * channels) * (bitDepth / 8), bitDepth, n * channels, block.data());
+
+		for (size_t i = 0; i < n; i++)
+			dst[offset + i] = block[i * channels + channel - 1];
+	}
+}
+
+void SoundData::setSamples(int start, int count, int channel, const float *src)
+{
+	checkRange(start, count, channel);
+
+	size_t first = (size_t) start * channels;
+
+	if (channel == 0 || channels == 1)
+	{
+		fromFloat(src, (size_t) count * channels, bitDepth, data + first * (bitDepth / 8));
+		return;
+	}
+
+	// Only whole frames can be converted at once, so the other channels are
+	// converted back and forth.
+	int c = channels;
+	processSamples(data, bitDepth, channels, first, (size_t) count * channels, [&](float *block, size_t offset, size_t n)
+	{
+		const float *s = src + offset / c;
+		for (size_t i = 0; i < n / c; i++)
+			block[i * c + channel - 1] = s[i];
+	});
+}
+
+void SoundData::mix(const SoundData *other, float gain, int start)
+{
+	if (other->getChannelCount() != channels)
+		throw love::Exception("Cannot mix SoundData with %d channels into SoundData with %d channels.", other->getChannelCount(), channels);
+
+	if (start < 0 || start > getSampleCount())
+		throw love::Exception("Sample range out of bounds!");
+
+	int frames = std::min(other->getSampleCount(), getSampleCount() - start);
+	int otherDepth = other->getBitDepth();
+	const uint8 *otherData = (const uint8 *) other->getData();
+
+	std::vector<float> block(std::max(BLOCK_SAMPLES / channels, (size_t) 1) * channels);
+
+	processSamples(data, bitDepth, channels, (size_t) start * channels, (size_t) frames * channels, [&](float *samples, size_t offset, size_t n)
+	{
+		toFloat(otherData + offset * (otherDepth / 8), otherDepth, n, block.data());
+		for (size_t i = 0; i < n; i++)
+			samples[i] += block[i] * gain;
+	});
+}
+
+void SoundData::applyGain(float gain, int start, int count)
+{
+	checkRange(start, count, 0);
+
+	processSamples(data, bitDepth, channels, (size_t) start * channels, (size_t) count * channels, [&](float *samples, size_t, size_t n)
+	{
+		for (size_t i = 0; i < n; i++)
+			samples[i] *= gain;
+	});
+}
+
+void SoundData::fade(float from, float to, int start, int count)
+{
+	checkRange(start, count, 0);
+
+	if (count == 0)
+		return;
+
+	double step = count > 1 ? (double) (to - from) / (count - 1) : 0.0;
+	int c = channels;
+
+	processSamples(data, bitDepth, channels, (size_t) start * channels, (size_t) count * channels, [&](float *samples, size_t offset, size_t n)
+	{
+		size_t frame = offset / c;
+		for (size_t i = 0; i < n / c; i++)
+		{
+			float gain = (float) (from + step * (double) (frame + i));
+			for (int j = 0; j < c; j++)
+				samples[i * c + j] *= gain;
+		}
+	});
+}
+
+float SoundData::normalize(float peak)
+{
+	size_t count = size / (bitDepth / 8);
+	float block[BLOCK_SAMPLES];
+	float loudest = 0.0f;
+
+	for (size_t offset = 0; offset < count; offset += BLOCK_SAMPLES)
+	{
+		size_t n = std::min(count - offset, BLOCK_SAMPLES);
+		toFloat(data + offset * (bitDepth / 8), bitDepth, n, block);
+
+		for (size_t i = 0; i < n; i++)
+			loudest = std::max(loudest, fabsf(block[i]));
+	}
+
+	// Silence stays silent.
+	if (loudest == 0.0f)
+		return 1.0f;
+
+	float gain = peak / loudest;
+	applyGain(gain, 0, getSampleCount());
+	return gain;
+}
+
+SoundData *SoundData::convert(int bitDepth, int channels) const
+{
+	if (channels != this->channels && channels != 1 && this->channels != 1)
+		throw love::Exception("Cannot convert SoundData from %d to %d channels.", this->channels, channels);
+
+	int frames = getSampleCount();
+	SoundData *converted = new SoundData(frames, sampleRate, bitDepth, channels);
+
+	uint8 *dst = (uint8 *) converted->getData();
+	int srcChannels = this->channels;
+
+	// Whole frames of the source data, converted at a time.
+	size_t blockFrames = std::max(BLOCK_SAMPLES / srcChannels, (size_t) 1);
+
+	std::vector<float> in(blockFrames * srcChannels);
+	std::vector<float> out(blockFrames * channels);
+
+	for (size_t offset = 0; offset < (size_t) frames; offset += blockFrames)
+	{
+		size_t n = std::min((size_t) frames - offset, blockFrames);
+		toFloat(data + offset * srcChannels * (this->bitDepth / 8), this->bitDepth, n * srcChannels, in.data());
+
+		const float *result = in.data();
+
+		if (channels == 1 && srcChannels > 1)
+		{
+			// Mix down to mono.
+			float scale = 1.0f / srcChannels;
+			for (size_t i = 0; i < n; i++)
+			{
+				float sum = 0.0f;
+				for (int c = 0; c < srcChannels; c++)
+					sum += in[i * srcChannels + c];
+				out[i] = sum * scale;
+			}
+			result = out.data();
+		}
+		else if (srcChannels == 1 && channels > 1)
+		{
+			for (size_t i = 0; i < n; i++)
+			{
+				for (int c = 0; c < channels; c++)
+					out[i * channels + c] = in[i];
+			}
+			result = out.data();
+		}
+
+		fromFloat(result, n * channels, bitDepth, dst + offset * channels * (bitDepth / 8));
+	}
+
+	return converted;
+}
+
+SoundData *SoundData::resample(int sampleRate, Resampler::Quality quality) const
+{
+	if (sampleRate == this->sampleRate)
+		return clone();
+
+	Resampler resampler(this->sampleRate, sampleRate, channels, quality);
+
+	int frames = getSampleCount();
+	int64 outFrames = Resampler::getOutputFrames(frames, this->sampleRate, sampleRate);
+	if (outFrames > std::numeric_limits<int>::max())
+		throw love::Exception("Data is too big!");
+
+	SoundData *resampled = new SoundData((int) outFrames, sampleRate, bitDepth, channels);
+	uint8 *dst = (uint8 *) resampled->getData();
+	size_t written = 0;
+	size_t total = (size_t) outFrames * channels;
+
+	size_t blockFrames = std::max(BLOCK_SAMPLES / channels, (size_t) 1);
+	std::vector<float> in(blockFrames * channels);
+	std::vector<float> out;
+
+	auto write = [&]()
+	{
+		size_t count = std::min(out.size(), total - written);
+		fromFloat(out.data(), count, bitDepth, dst + written * (bitDepth / 8));
+		written += count;
+		out.clear();
+	};
+
+	for (size_t offset = 0; offset < (size_t) frames; offset += blockFrames)
+	{
+		size_t n = std::min((size_t) frames - offset, blockFrames);
+		toFloat(data + offset * channels * (bitDepth / 8), bitDepth, n * channels, in.data());
+		resampler.process(in.data(), (int) n, out);
+		write();
+	}
+
+	resampler.flush(out);
+	write();
+
+	return resampled;
+}
+
+void SoundData::toFloat(const void *src, int bitDepth, size_t count, float *dst)
+{
+	size_t i = 0;
+
+	if (bitDepth == 16)
+	{
+		// 16-bit sample values are signed.
+		const int16 *s = (const int16 *) src;
+		// Divide rather than multiply by the reciprocal, so values convert back
+		// to exactly the same integers.
+		const float scale = (float) LOVE_INT16_MAX;
+
+#if defined(LOVE_SIMD_SSE2)
+		const __m128 vscale = _mm_set1_ps(scale);
+
+		for (; i + 8 <= count; i += 8)
+		{
+			__m128i v = _mm_loadu_si128((const __m128i *) (s + i));
+
+			// Sign-extend to 32 bits by unpacking into the high halves.
+			__m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+			__m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+
+			_mm_storeu_ps(dst + i + 0, _mm_div_ps(_mm_cvtepi32_ps(lo), vscale));
+			_mm_storeu_ps(dst + i + 4, _mm_div_ps(_mm_cvtepi32_ps(hi), vscale));
+		}
+#elif defined(LOVE_SIMD_NEON) && defined(__aarch64__)
+		const float32x4_t vscale = vdupq_n_f32(scale);
+
+		for (; i + 8 <= count; i += 8)
+		{
+			int16x8_t v = vld1q_s16(s + i);
+			vst1q_f32(dst + i + 0, vdivq_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(v))), vscale));
+			vst1q_f32(dst + i + 4, vdivq_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(v))), vscale));
+		}
+#endif
+
+		for (; i < count; i++)
+			dst[i] = (float) s[i] / scale;
+	}
+	else
+	{
+		// 8-bit sample values are unsigned internally.
+		const uint8 *s = (const uint8 *) src;
+		const float scale = 127.0f;
+
+#if defined(LOVE_SIMD_SSE2)
+		const __m128i zero = _mm_setzero_si128();
+		const __m128 bias = _mm_set1_ps(128.0f);
+		const __m128 vscale = _mm_set1_ps(scale);
+
+		for (; i + 16 <= count; i += 16)
+		{
+			__m128i v = _mm_loadu_si128((const __m128i *) (s + i));
+			__m128i lo = _mm_unpacklo_epi8(v, zero);
+			__m128i hi = _mm_unpackhi_epi8(v, zero);
+
+			__m128i w[4] = {
+				_mm_unpacklo_epi16(lo, zero), _mm_unpackhi_epi16(lo, zero),
+				_mm_unpacklo_epi16(hi, zero), _mm_unpackhi_epi16(hi, zero),
+			};
+
+			for (int j = 0; j < 4; j++)
+			{
+				__m128 f = _mm_sub_ps(_mm_cvtepi32_ps(w[j]), bias);
+				_mm_storeu_ps(dst + i + j * 4, _mm_div_ps(f, vscale));
+			}
+		}
+#elif defined(LOVE_SIMD_NEON) && defined(__aarch64__)
+		const float32x4_t bias = vdupq_n_f32(128.0f);
+		const float32x4_t vscale = vdupq_n_f32(scale);
+
+		for (; i + 8 <= count; i += 8)
+		{
+			uint16x8_t v = vmovl_u8(vld1_u8(s + i));
+			float32x4_t lo = vcvtq_f32_u32(vmovl_u16(vget_low_u16(v)));
+			float32x4_t hi = vcvtq_f32_u32(vmovl_u16(vget_high_u16(v)));
+			vst1q_f32(dst + i + 0, vdivq_f32(vsubq_f32(lo, bias), vscale));
+			vst1q_f32(dst + i + 4, vdivq_f32(vsubq_f32(hi, bias), vscale));
+		}
+#endif
+
+		for (; i < count; i++)
+			dst[i] = ((float) s[i] - 128.0f) / scale;
+	}
+}
+
+void SoundData::fromFloat(const float *src, size_t count, int bitDepth, void *dst)
+{
+	size_t i = 0;
+
+	if (bitDepth == 16)
+	{
+		int16 *d = (int16 *) dst;
+
+#if defined(LOVE_SIMD_SSE2)
+		const __m128 scale = _mm_set1_ps((float) LOVE_INT16_MAX);
+		const __m128 lo = _mm_set1_ps(-1.0f);
+		const __m128 hi = _mm_set1_ps(1.0f);
+
+		for (; i + 8 <= count; i += 8)
+		{
+			__m128 a = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + i + 0), lo), hi);
+			__m128 b = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + i + 4), lo), hi);
+			__m128i ia = _mm_cvttps_epi32(_mm_mul_ps(a, scale));
+			__m128i ib = _mm_cvttps_epi32(_mm_mul_ps(b, scale));
+			_mm_storeu_si128((__m128i *) (d + i), _mm_packs_epi32(ia, ib));
+		}
+#elif defined(LOVE_SIMD_NEON)
+		const float32x4_t scale = vdupq_n_f32((float) LOVE_INT16_MAX);
+		const float32x4_t lo = vdupq_n_f32(-1.0f);
+		const float32x4_t hi = vdupq_n_f32(1.0f);
+
+		for (; i + 8 <= count; i += 8)
+		{
+			float32x4_t a = vminq_f32(vmaxq_f32(vld1q_f32(src + i + 0), lo), hi);
+			float32x4_t b = vminq_f32(vmaxq_f32(vld1q_f32(src + i + 4), lo), hi);
+			int16x4_t ia = vqmovn_s32(vcvtq_s32_f32(vmulq_f32(a, scale)));
+			int16x4_t ib = vqmovn_s32(vcvtq_s32_f32(vmulq_f32(b, scale)));
+			vst1q_s16(d + i, vcombine_s16(ia, ib));
+		}
+#endif
+
+		for (; i < count; i++)
+		{
+			float sample = std::min(std::max(src[i], -1.0f), 1.0f);
+			d[i] = (int16) (sample * (float) LOVE_INT16_MAX);
+		}
+	}
+	else
+	{
+		uint8 *d = (uint8 *) dst;
+
+#if defined(LOVE_SIMD_SSE2)
+		const __m128 scale = _mm_set1_ps(127.0f);
+		const __m128 bias = _mm_set1_ps(128.0f);
+		const __m128 lo = _mm_set1_ps(-1.0f);
+		const __m128 hi = _mm_set1_ps(1.0f);
+
+		for (; i + 16 <= count; i += 16)
+		{
+			__m128i w[4];
+			for (int j = 0; j < 4; j++)
+			{
+				__m128 f = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + i + j * 4), lo), hi);
+				w[j] = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(f, scale), bias));
+			}
+
+			__m128i a = _mm_packs_epi32(w[0], w[1]);
+			__m128i b = _mm_packs_epi32(w[2], w[3]);
+			_mm_storeu_si128((__m128i *) (d + i), _mm_packus_epi16(a, b));
+		}
+#elif defined(LOVE_SIMD_NEON)
+		const float32x4_t scale = vdupq_n_f32(127.0f);
+		const float32x4_t bias = vdupq_n_f32(128.0f);
+		const float32x4_t lo = vdupq_n_f32(-1.0f);
+		const float32x4_t hi = vdupq_n_f32(1.0f);
+
+		for (; i + 8 <= count; i += 8)
+		{
+			float32x4_t a = vminq_f32(vmaxq_f32(vld1q_f32(src + i + 0), lo), hi);
+			float32x4_t b = vminq_f32(vmaxq_f32(vld1q_f32(src + i + 4), lo), hi);
+			uint32x4_t ia = vcvtq_u32_f32(vmlaq_f32(bias, a, scale));
+			uint32x4_t ib = vcvtq_u32_f32(vmlaq_f32(bias, b, scale));
+			uint16x8_t w = vcombine_u16(vqmovn_u32(ia), vqmovn_u32(ib));
+			vst1_u8(d + i, vqmovn_u16(w));
+		}
+#endif
+
+		for (; i < count; i++)
+		{
+			float sample = std::min(std::max(src[i], -1.0f), 1.0f);
+			d[i] = (uint8) ((sample * 127.0f) + 128.0f);
+		}
+	}
+}
+
 } // sound
 } // love
@@ -25,6 +25,7 @@
 #include "filesystem/File.h"
 #include "common/int.h"
 #include "Decoder.h"
+#include "Resampler.h"
 
 namespace love
 {
@@ -61,9 +62,71 @@ public:
 	float getSample(int i) const;
 	float getSample(int i, int channel) const;
 
+	/**
+	 * Copies a range of sample frames out as floats in [-1, 1].
+	 * @param start The first sample frame.
+	 * @param count The number of sample frames.
+	 * @param channel A single channel (starting at 1) to copy, or 0 to copy
+	 *        all channels interleaved.
+	 * @param dst Room for count floats, or count * channels for all channels.
+	 **/
+	void getSamples(int start, int count, int channel, float *dst) const;
+
+	/**
+	 * Sets a range of sample frames from floats. Values outside [-1, 1] are
+	 * clamped. The parameters mirror getSamples.
+	 **/
+	void setSamples(int start, int count, int channel, const float *src);
+
+	/**
+	 * Adds the samples of another SoundData with the same channel count,
+	 * starting at the given sample frame. The result is clamped.
+	 **/
+	void mix(const SoundData *other, float gain, int start);
+
+	/**
+	 * Multiplies a range of sample frames by a gain.
+	 **/
+	void applyGain(float gain, int start, int count);
+
+	/**
+	 * Multiplies a range of sample frames by a gain which goes linearly from
+	 * one value to another.
+	 **/
+	void fade(float from, float to, int start, int count);
+
+	/**
+	 * Scales the samples so the loudest one has the given amplitude.
+	 * @return The gain which was applied.
+	 **/
+	float normalize(float peak);
+
+	/**
+	 * Creates a copy of this SoundData with a different bit depth and/or
+	 * channel count. Mono data can be converted to any channel count, and any
+	 * channel count to mono.
+	 **/
+	SoundData *convert(int bitDepth, int channels) const;
+
+	/**
+	 * Creates a copy of this SoundData at a different sample rate.
+	 **/
+	SoundData *resample(int sampleRate, Resampler::Quality quality) const;
+
+	/**
+	 * Converts 8 or 16 bit samples to floats in [-1, 1].
+	 **/
+	static void toFloat(const void *src, int bitDepth, size_t count, float *dst);
+
+	/**
+	 * Converts floats to 8 or 16 bit samples, clamping them to [-1, 1].
+	 **/
+	static void fromFloat(const float *src, size_t count, int bitDepth, void *dst);
+
 private:
 
 	void load(int samples, int sampleRate, int bitDepth, int channels, void *newData = 0);
+	void checkRange(int start, int count, int channel) const;
 
 	uint8 *data;
 	size_t size;
@@ -21,6 +21,7 @@
 #include "wrap_Decoder.h"
 #include "SoundData.h"
 #include "Sound.h"
+#include "ResamplingDecoder.h"
 
 #define instance() (Module::getInstance<Sound>(Module::M_SOUND))
 
@@ -96,6 +97,24 @@ int w_Decoder_seek(lua_State *L)
 	return 0;
 }
 
+int w_Decoder_resample(lua_State *L)
+{
+	Decoder *t = luax_checkdecoder(L, 1);
+	int sampleRate = (int) luaL_checkinteger(L, 2);
+
+	Resampler::Quality quality = Resampler::QUALITY_MEDIUM;
+	const char *qualitystr = lua_isnoneornil(L, 3) ? nullptr : luaL_checkstring(L, 3);
+	if (qualitystr && !Resampler::getConstant(qualitystr, quality))
+		return luax_enumerror(L, "resample quality", Resampler::getConstants(quality), qualitystr);
+
+	Decoder *d = nullptr;
+	luax_catchexcept(L, [&](){ d = new ResamplingDecoder(t, sampleRate, quality); });
+
+	luax_pushtype(L, d);
+	d->release();
+	return 1;
+}
+
 int w_Decoder_getChannels(lua_State *L)
 {
 	luax_markdeprecated(L, "Decoder:getChannels", API_METHOD, DEPRECATED_RENAMED, "Decoder:getChannelCount");
@@ -110,6 +129,7 @@ static const luaL_Reg w_Decoder_functions[] =
 	{ "getDuration", w_Decoder_getDuration },
 	{ "decode", w_Decoder_decode },
 	{ "seek", w_Decoder_seek },
+	{ "resample", w_Decoder_resample },
 
 	// Deprecated
 	{ "getChannels", w_Decoder_getChannels },
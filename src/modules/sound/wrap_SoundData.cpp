@@ -21,6 +21,10 @@
 #include "wrap_SoundData.h"
 
 #include "data/wrap_Data.h"
+#include "data/ByteData.h"
+
+// C++
+#include <algorithm>
 
 // Shove the wrap_SoundData.lua code directly into a raw string literal.
 static const char sounddata_lua[] =
@@ -121,6 +125,113 @@ int w_SoundData_getSample(lua_State *L)
 	return 1;
 }
 
+int w_SoundData_getSamples(lua_State *L)
+{
+	SoundData *sd = luax_checksounddata(L, 1);
+	int start = (int) luaL_optinteger(L, 2, 0);
+	int count = (int) luaL_optinteger(L, 3, sd->getSampleCount() - start);
+	int channel = (int) luaL_optinteger(L, 4, 0);
+
+	size_t samples = (size_t) std::max(count, 0) * (channel == 0 ? sd->getChannelCount() : 1);
+	StrongRef<love::data::ByteData> d;
+
+	luax_catchexcept(L, [&]() {
+		d.set(new love::data::ByteData(samples * sizeof(float)), Acquire::NORETAIN);
+		sd->getSamples(start, count, channel, (float *) d->getData());
+	});
+
+	luax_pushtype(L, d.get());
+	return 1;
+}
+
+int w_SoundData_setSamples(lua_State *L)
+{
+	SoundData *sd = luax_checksounddata(L, 1);
+	love::Data *data = luax_checktype<love::Data>(L, 2);
+	int start = (int) luaL_optinteger(L, 3, 0);
+	int channel = (int) luaL_optinteger(L, 4, 0);
+
+	size_t samples = data->getSize() / sizeof(float);
+	int count = (int) (samples / (channel == 0 ? sd->getChannelCount() : 1));
+
+	luax_catchexcept(L, [&](){ sd->setSamples(start, count, channel, (const float *) data->getData()); });
+	return 0;
+}
+
+int w_SoundData_mix(lua_State *L)
+{
+	SoundData *sd = luax_checksounddata(L, 1);
+	SoundData *other = luax_checksounddata(L, 2);
+	float gain = (float) luaL_optnumber(L, 3, 1.0);
+	int start = (int) luaL_optinteger(L, 4, 0);
+
+	luax_catchexcept(L, [&](){ sd->mix(other, gain, start); });
+	return 0;
+}
+
+int w_SoundData_applyGain(lua_State *L)
+{
+	SoundData *sd = luax_checksounddata(L, 1);
+	float gain = (float) luaL_checknumber(L, 2);
+	int start = (int) luaL_optinteger(L, 3, 0);
+	int count = (int) luaL_optinteger(L, 4, sd->getSampleCount() - start);
+
+	luax_catchexcept(L, [&](){ sd->applyGain(gain, start, count); });
+	return 0;
+}
+
+int w_SoundData_fade(lua_State *L)
+{
+	SoundData *sd = luax_checksounddata(L, 1);
+	float from = (float) luaL_checknumber(L, 2);
+	float to = (float) luaL_checknumber(L, 3);
+	int start = (int) luaL_optinteger(L, 4, 0);
+	int count = (int) luaL_optinteger(L, 5, sd->getSampleCount() - start);
+
+	luax_catchexcept(L, [&](){ sd->fade(from, to, start, count); });
+	return 0;
+}
+
+int w_SoundData_normalize(lua_State *L)
+{
+	SoundData *sd = luax_checksounddata(L, 1);
+	float peak = (float) luaL_optnumber(L, 2, 1.0);
+	lua_pushnumber(L, sd->normalize(peak));
+	return 1;
+}
+
+int w_SoundData_convert(lua_State *L)
+{
+	SoundData *sd = luax_checksounddata(L, 1);
+	int bitDepth = (int) luaL_optinteger(L, 2, sd->getBitDepth());
+	int channels = (int) luaL_optinteger(L, 3, sd->getChannelCount());
+
+	SoundData *c = nullptr;
+	luax_catchexcept(L, [&](){ c = sd->convert(bitDepth, channels); });
+
+	luax_pushtype(L, c);
+	c->release();
+	return 1;
+}
+
+int w_SoundData_resample(lua_State *L)
+{
+	SoundData *sd = luax_checksounddata(L, 1);
+	int sampleRate = (int) luaL_checkinteger(L, 2);
+
+	Resampler::Quality quality = Resampler::QUALITY_MEDIUM;
+	const char *qualitystr = lua_isnoneornil(L, 3) ? nullptr : luaL_checkstring(L, 3);
+	if (qualitystr && !Resampler::getConstant(qualitystr, quality))
+		return luax_enumerror(L, "resample quality", Resampler::getConstants(quality), qualitystr);
+
+	SoundData *r = nullptr;
+	luax_catchexcept(L, [&](){ r = sd->resample(sampleRate, quality); });
+
+	luax_pushtype(L, r);
+	r->release();
+	return 1;
+}
+
 int w_SoundData_getChannels(lua_State *L)
 {
 	luax_markdeprecated(L, "SoundData:getChannels", API_METHOD, DEPRECATED_RENAMED, "SoundData:getChannelCount");
@@ -137,6 +248,14 @@ static const luaL_Reg w_SoundData_functions[] =
 	{ "getDuration", w_SoundData_getDuration },
 	{ "setSample", w_SoundData_setSample },
 	{ "getSample", w_SoundData_getSample },
+	{ "getSamples", w_SoundData_getSamples },
+	{ "setSamples", w_SoundData_setSamples },
+	{ "mix", w_SoundData_mix },
+	{ "applyGain", w_SoundData_applyGain },
+	{ "fade", w_SoundData_fade },
+	{ "normalize", w_SoundData_normalize },
+	{ "convert", w_SoundData_convert },
+	{ "resample", w_SoundData_resample },
 
 	// Deprecated
 	{ "getChannels", w_SoundData_getChannels },
@@ -24,6 +24,10 @@
 
 #include <timer/Timer.h>
 
+// C++
+#include <algorithm>
+#include <cmath>
+
 namespace love
 {
 namespace thread
@@ -51,16 +55,34 @@ Channel *Channel::getChannel(const std::string &name)
 	return namedChannels[name];
 }
 
-Channel::Channel()
+Channel::Channel(int capacity, bool lockFree)
 	: named(false)
+	, capacity(capacity)
+	, ring(nullptr)
+	, ringCount(0)
+	, waiters(0)
 	, sent(0)
 	, received(0)
 {
+	if (capacity < 0)
+		throw love::Exception("Invalid Channel capacity: %d", capacity);
+
+	if (lockFree)
+	{
+		if (capacity == 0)
+			throw love::Exception("Lock-free Channels need a capacity.");
+
+		ring = new RingBuffer<Variant>(capacity);
+	}
 }
 
 Channel::Channel(const std::string &name)
 	: named(true)
 	, name(name)
+	, capacity(0)
+	, ring(nullptr)
+	, ringCount(0)
+	, waiters(0)
 	, sent(0)
 	, received(0)
 {
@@ -73,12 +95,67 @@ Channel::~Channel()
 		Lock l(namedChannelMutex);
 		namedChannels.erase(name);
 	}
+
+	delete ring;
+}
+
+bool Channel::isFull() const
+{
+	return capacity > 0 && (int) queue.size() >= capacity;
+}
+
+template <typename T>
+bool Channel::waitLockFree(T ready, double timeout)
+{
+	if (ready())
+		return true;
+
+	waiters++;
+
+	// Pairs with the fence in notifyLockFree: either our ready() check below
+	// sees the ring change, or the notifier sees our waiters increment.
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+
+	bool result = false;
+
+	{
+		Lock l(mutex);
+
+		while (true)
+		{
+			if (ready())
+			{
+				result = true;
+				break;
+			}
+
+			if (timeout < 0)
+				cond->wait(mutex);
+			else if (timeout > 0)
+			{
+				double start = love::timer::Timer::getTime();
+				cond->wait(mutex, (int) ceil(timeout * 1000));
+				timeout = std::max(timeout - (love::timer::Timer::getTime() - start), 0.0);
+			}
+			else
+				break;
+		}
+	}
+
+	waiters--;
+	return result;
 }
 
 uint64 Channel::push(const Variant &var)
 {
+	if (ring != nullptr)
+		return pushLockFree(var);
+
 	Lock l(mutex);
 
+	if (isFull())
+		return 0;
+
 	// Keep a reference to ourselves
 	// if we're non-empty and named.
 	if (named && queue.empty())
@@ -92,7 +169,19 @@ uint64 Channel::push(const Variant &var)
 
 bool Channel::supply(const Variant &var)
 {
+	if (ring != nullptr)
+	{
+		uint64 id = 0;
+		waitLockFree([&]() { return (id = pushLockFree(var)) != 0; }, -1.0);
+		waitLockFree([&]() { return received >= id; }, -1.0);
+		return true;
+	}
+
 	Lock l(mutex);
+
+	while (isFull())
+		cond->wait(mutex);
+
 	uint64 id = push(var);
 
 	while (received < id)
@@ -103,12 +192,35 @@ bool Channel::supply(const Variant &var)
 
 bool Channel::supply(const Variant &var, double timeout)
 {
+	if (ring != nullptr)
+	{
+		// A negative timeout means no waiting at all (waitLockFree treats it
+		// as forever), but the value still goes in if there's room.
+		if (timeout < 0)
+		{
+			pushLockFree(var);
+			return false;
+		}
+
+		uint64 id = 0;
+		double start = love::timer::Timer::getTime();
+
+		if (!waitLockFree([&]() { return (id = pushLockFree(var)) != 0; }, timeout))
+			return false;
+
+		timeout = std::max(timeout - (love::timer::Timer::getTime() - start), 0.0);
+		return waitLockFree([&]() { return received >= id; }, timeout);
+	}
+
 	Lock l(mutex);
 	uint64 id = push(var);
 
 	while (timeout >= 0)
 	{
-		if (received >= id)
+		if (id == 0)
+			id = push(var);
+
+		if (id != 0 && received >= id)
 			return true;
 
 		double start = love::timer::Timer::getTime();
@@ -123,6 +235,9 @@ bool Channel::supply(const Variant &var, double timeout)
 
 bool Channel::pop(Variant *var)
 {
+	if (ring != nullptr)
+		return popLockFree(var);
+
 	Lock l(mutex);
 
 	if (queue.empty())
@@ -144,6 +259,9 @@ bool Channel::pop(Variant *var)
 
 bool Channel::demand(Variant *var)
 {
+	if (ring != nullptr)
+		return waitLockFree([&]() { return popLockFree(var); }, -1.0);
+
 	Lock l(mutex);
 
 	while (!pop(var))
@@ -154,6 +272,14 @@ bool Channel::demand(Variant *var)
 
 bool Channel::demand(Variant *var, double timeout)
 {
+	if (ring != nullptr)
+	{
+		if (timeout < 0)
+			return false;
+
+		return waitLockFree([&]() { return popLockFree(var); }, timeout);
+	}
+
 	Lock l(mutex);
 
 	while (timeout >= 0)
@@ -173,6 +299,10 @@ bool Channel::demand(Variant *var, double timeout)
 
 bool Channel::peek(Variant *var)
 {
+	// Another thread could pop (and free) the value while it's being copied.
+	if (ring != nullptr)
+		throw love::Exception("Lock-free Channels can't be peeked.");
+
 	Lock l(mutex);
 
 	if (queue.empty())
@@ -184,18 +314,34 @@ bool Channel::peek(Variant *var)
 
 int Channel::getCount() const
 {
+	if (ring != nullptr)
+		return (int) ring->getCount();
+
 	Lock l(mutex);
 	return (int) queue.size();
 }
 
 bool Channel::hasRead(uint64 id) const
 {
+	if (ring != nullptr)
+		return received >= id;
+
 	Lock l(mutex);
 	return received >= id;
 }
 
 void Channel::clear()
 {
+	if (ring != nullptr)
+	{
+		// Popping everything also finishes the supply waits.
+		Variant var;
+		while (popLockFree(&var))
+			;
+
+		return;
+	}
+
 	Lock l(mutex);
 
 	// We're already empty.
@@ -215,6 +361,120 @@ void Channel::clear()
 		release();
 }
 
+int Channel::pushMany(const std::vector<Variant> &vars, uint64 &id)
+{
+	int count = 0;
+
+	if (ring != nullptr)
+	{
+		for (const Variant &var : vars)
+		{
+			uint64 pushed = pushLockFree(var);
+			if (pushed == 0)
+				break;
+
+			id = pushed;
+			count++;
+		}
+
+		return count;
+	}
+
+	// Push them all under one lock, so they stay together.
+	Lock l(mutex);
+
+	for (const Variant &var : vars)
+	{
+		uint64 pushed = push(var);
+		if (pushed == 0)
+			break;
+
+		id = pushed;
+		count++;
+	}
+
+	return count;
+}
+
+int Channel::popMany(std::vector<Variant> &vars, int max)
+{
+	int count = 0;
+	Variant var;
+
+	if (ring != nullptr)
+	{
+		while (count < max && popLockFree(&var))
+		{
+			vars.push_back(var);
+			count++;
+		}
+
+		return count;
+	}
+
+	Lock l(mutex);
+
+	while (count < max && pop(&var))
+	{
+		vars.push_back(var);
+		count++;
+	}
+
+	return count;
+}
+
+int Channel::getCapacity() const
+{
+	return capacity;
+}
+
+bool Channel::isLockFree() const
+{
+	return ring != nullptr;
+}
+
+uint64 Channel::pushLockFree(const Variant &var)
+{
+	uint64 position = 0;
+	if (!ring->push(var, position))
+		return 0;
+
+	// Keep a reference to ourselves while we're non-empty and named.
+	if (named && ringCount.fetch_add(1) == 0)
+		retain();
+
+	notifyLockFree();
+	return position + 1;
+}
+
+bool Channel::popLockFree(Variant *var)
+{
+	if (!ring->pop(*var))
+		return false;
+
+	received++;
+
+	if (named && ringCount.fetch_sub(1) == 1)
+		release();
+
+	notifyLockFree();
+	return true;
+}
+
+void Channel::notifyLockFree()
+{
+	// Waiters register themselves before checking whether they still need to
+	// wait, so either they see the change or we see them. The ring's release
+	// store doesn't order the load below after it, the fence does.
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+
+	if (waiters.load() > 0)
+	{
+		Lock l(mutex);
+		cond->broadcast();
+	}
+}
+
 void Channel::lockMutex()
 {
 	mutex->lock();
@@ -24,11 +24,14 @@
 // STL
 #include <queue>
 #include <string>
+#include <vector>
+#include <atomic>
 
 // LOVE
 #include "common/Variant.h"
 #include "common/int.h"
 #include "threads.h"
+#include "RingBuffer.h"
 
 namespace love
 {
@@ -44,11 +47,21 @@ public:
 
 	static love::Type type;
 
-	Channel();
+	/**
+	 * @param capacity The most values the Channel can hold at once, or 0 for
+	 *        no limit.
+	 * @param lockFree Whether to use a lock-free queue, which needs a capacity.
+	 *        Threads then only block on the Channel's mutex when they have to
+	 *        wait. peek and performAtomic aren't available.
+	 **/
+	Channel(int capacity = 0, bool lockFree = false);
 	~Channel();
 
 	static Channel *getChannel(const std::string &name);
 
+	/**
+	 * @return The id of the pushed value, or 0 if the Channel is full.
+	 **/
 	uint64 push(const Variant &var);
 	bool supply(const Variant &var); // blocking push
 	bool supply(const Variant &var, double timeout);
@@ -60,20 +73,60 @@ public:
 	bool hasRead(uint64 id) const;
 	void clear();
 
+	/**
+	 * Pushes as many of the values as there's room for, in order.
+	 * @param id Set to the id of the last value pushed.
+	 * @return The number of values pushed.
+	 **/
+	int pushMany(const std::vector<Variant> &vars, uint64 &id);
+
+	/**
+	 * Pops up to max values, appending them to vars.
+	 * @return The number of values popped.
+	 **/
+	int popMany(std::vector<Variant> &vars, int max);
+
+	int getCapacity() const;
+	bool isLockFree() const;
+
 private:
 
 	Channel(const std::string &name);
 	void lockMutex();
 	void unlockMutex();
 
+	bool isFull() const;
+
+	// Lock-free versions of push and pop.
+	uint64 pushLockFree(const Variant &var);
+	bool popLockFree(Variant *var);
+
+	// Wakes up threads waiting in waitLockFree.
+	void notifyLockFree();
+
+	// Blocks until ready returns true or the timeout (in seconds) runs out.
+	// A negative timeout waits forever.
+	template <typename T>
+	bool waitLockFree(T ready, double timeout);
+
 	MutexRef mutex;
 	ConditionalRef cond;
 	std::queue<Variant> queue;
 	bool named;
 	std::string name;
 
+	int capacity;
+	RingBuffer<Variant> *ring;
+
+	// Number of values in the ring, for keeping named Channels alive. Can dip
+	// below zero when a pop finishes before the push of the same value.
+	std::atomic<int64> ringCount;
+
+	// Threads blocked in waitLockFree.
+	std::atomic<int> waiters;
+
 	uint64 sent;
-	uint64 received;
+	std::atomic<uint64> received;
 
 }; // Channel
 
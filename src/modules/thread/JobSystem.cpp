@@ -0,0 +1,467 @@
+/**
+ * Copyright (c) 2006-2018 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+#include "JobSystem.h"
+#include "LuaThread.h"
+#include "common/Exception.h"
+#include "common/runtime.h"
+#include "timer/Timer.h"
+
+// STL
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <string>
+
+namespace love
+{
+namespace thread
+{
+
+love::Type Task::type("Task", &Object::type);
+
+Task::Task()
+	: done(false)
+{
+}
+
+Task::~Task()
+{
+}
+
+bool Task::isDone() const
+{
+	return done.load();
+}
+
+struct JobSystem::ParallelFor
+{
+	const std::function<void(int64, int64)> *func;
+
+	int64 count;
+	int64 grain;
+	int64 ranges;
+
+	std::atomic<int64> next;
+	std::atomic<int64> completed;
+
+	// Protected by the JobSystem's doneMutex.
+	std::string error;
+};
+
+class JobSystem::ParallelForTask : public Task
+{
+public:
+
+	ParallelForTask(const std::shared_ptr<ParallelFor> &pfor)
+		: pfor(pfor)
+	{}
+
+	void run(JobSystem *system, int /*worker*/) override
+	{
+		// The parallelFor may have finished already if the other threads got
+		// through every range before this Task started. The shared state stays
+		// alive until we're done with it.
+		system->runParallelFor(*pfor);
+	}
+
+private:
+
+	std::shared_ptr<ParallelFor> pfor;
+};
+
+JobSystem::Worker::Worker(JobSystem *owner, int index)
+	: L(nullptr)
+	, owner(owner)
+	, index(index)
+{
+	threadName = "Job";
+}
+
+JobSystem::Worker::~Worker()
+{
+}
+
+void JobSystem::Worker::threadFunction()
+{
+	while (true)
+	{
+		Task *task = owner->take(index);
+
+		if (task != nullptr)
+		{
+			owner->execute(task, index);
+			continue;
+		}
+
+		Lock lock(owner->sleepMutex);
+
+		if (owner->finish)
+			break;
+
+		if (owner->pending.load() == 0)
+			owner->sleepCond->wait(owner->sleepMutex);
+	}
+
+	// The Lua state has to be closed on the thread which used it, since
+	// closing it can run arbitrary Lua code (__gc metamethods.)
+	if (L != nullptr)
+	{
+		lua_close(L);
+		L = nullptr;
+	}
+}
+
+JobSystem *JobSystem::instance = nullptr;
+
+static std::atomic<Mutex *> instanceMutex(nullptr);
+
+static Mutex *getInstanceMutex()
+{
+	Mutex *mutex = instanceMutex.load();
+	if (mutex != nullptr)
+		return mutex;
+
+	Mutex *newmutex = newMutex();
+	if (instanceMutex.compare_exchange_strong(mutex, newmutex))
+		return newmutex;
+
+	// Another thread got there first.
+	delete newmutex;
+	return mutex;
+}
+
+JobSystem *JobSystem::getInstance()
+{
+	Lock lock(getInstanceMutex());
+
+	if (instance == nullptr)
+	{
+		// Leave a core for the thread which submits the work. Lua jobs still
+		// need somewhere to run on single-core systems though.
+		int cores = getProcessorCount();
+		instance = new JobSystem(std::max(cores - 1, 1), std::max(cores - 1, 0));
+	}
+
+	return instance;
+}
+
+void JobSystem::shutdown()
+{
+	JobSystem *system = nullptr;
+
+	{
+		Lock lock(getInstanceMutex());
+		system = instance;
+		instance = nullptr;
+	}
+
+	// Destroyed outside the lock, so a running Task which calls getInstance
+	// can't deadlock with us.
+	delete system;
+}
+
+JobSystem::JobSystem(int workerCount, int parallelCount)
+	: nextWorker(0)
+	, parallelCount(parallelCount)
+	, pending(0)
+	, waitingWorkers(0)
+	, finish(false)
+{
+	for (int i = 0; i < workerCount; i++)
+		workers.push_back(new Worker(this, i));
+
+	// Started separately, so a worker never sees a partially filled list.
+	for (Worker *worker : workers)
+		worker->start();
+}
+
+JobSystem::~JobSystem()
+{
+	{
+		Lock lock(sleepMutex);
+		finish = true;
+		sleepCond->broadcast();
+	}
+
+	for (Worker *worker : workers)
+		worker->wait();
+
+	for (Worker *worker : workers)
+	{
+		for (Task *task : worker->tasks)
+			task->release();
+
+		delete worker;
+	}
+}
+
+int JobSystem::getWorkerCount() const
+{
+	return (int) workers.size();
+}
+
+void JobSystem::submit(Task *task)
+{
+	task->retain();
+	task->done = false;
+
+	Worker *worker = workers[nextWorker.fetch_add(1) % workers.size()];
+
+	{
+		Lock lock(worker->mutex);
+		worker->tasks.push_back(task);
+	}
+
+	{
+		Lock lock(sleepMutex);
+		pending++;
+		sleepCond->signal();
+	}
+
+	// Workers waiting for a Task which wasn't queued yet need to check again.
+	if (waitingWorkers.load() > 0)
+	{
+		Lock lock(doneMutex);
+		doneCond->broadcast();
+	}
+}
+
+Task *JobSystem::take(int worker)
+{
+	Task *task = nullptr;
+	int count = (int) workers.size();
+
+	// Newest first from our own queue, since its data is most likely to still
+	// be in the cache. Oldest first from everyone else's.
+	for (int i = 0; i < count && task == nullptr; i++)
+	{
+		Worker *w = workers[(worker + i) % count];
+		Lock lock(w->mutex);
+
+		if (w->tasks.empty())
+			continue;
+
+		if (i == 0)
+		{
+			task = w->tasks.back();
+			w->tasks.pop_back();
+		}
+		else
+		{
+			task = w->tasks.front();
+			w->tasks.pop_front();
+		}
+	}
+
+	if (task != nullptr)
+		pending--;
+
+	return task;
+}
+
+void JobSystem::execute(Task *task, int worker)
+{
+	// Tasks are expected to deal with their own errors, but an exception
+	// escaping here would take the whole worker thread down with it.
+	try
+	{
+		task->run(this, worker);
+	}
+	catch (std::exception &)
+	{
+	}
+
+	{
+		Lock lock(doneMutex);
+		task->done = true;
+		doneCond->broadcast();
+	}
+
+	task->release();
+}
+
+bool JobSystem::wait(Task *task, double timeout, int worker)
+{
+	bool isworker = worker >= 0 && worker < (int) workers.size();
+	double start = timeout >= 0.0 ? love::timer::Timer::getTime() : 0.0;
+
+	Lock lock(doneMutex);
+
+	if (isworker)
+		waitingWorkers++;
+
+	while (!task->isDone())
+	{
+		// A worker which waits for a Task that hasn't started yet runs it
+		// itself, otherwise a pool full of waiting workers would never make
+		// progress. This can't deadlock: the Task had to run before the wait
+		// could finish either way.
+		if (isworker && takeTask(task))
+		{
+			doneMutex->unlock();
+			execute(task, worker);
+			doneMutex->lock();
+			continue;
+		}
+
+		if (timeout < 0.0)
+			doneCond->wait(doneMutex);
+		else
+		{
+			double remaining = timeout - (love::timer::Timer::getTime() - start);
+			if (remaining <= 0.0)
+				break;
+
+			doneCond->wait(doneMutex, (int) std::ceil(remaining * 1000.0));
+		}
+	}
+
+	if (isworker)
+		waitingWorkers--;
+
+	return task->isDone();
+}
+
+bool JobSystem::takeTask(Task *task)
+{
+	for (Worker *w : workers)
+	{
+		Lock lock(w->mutex);
+
+		auto it = std::find(w->tasks.begin(), w->tasks.end(), task);
+		if (it != w->tasks.end())
+		{
+			w->tasks.erase(it);
+			pending--;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void JobSystem::parallelFor(int64 count, int64 grain, const std::function<void(int64, int64)> &func)
+{
+	if (count <= 0)
+		return;
+
+	grain = std::max(grain, (int64) 1);
+	int64 ranges = (count + grain - 1) / grain;
+
+	if (ranges == 1 || parallelCount == 0)
+	{
+		func(0, count);
+		return;
+	}
+
+	std::shared_ptr<ParallelFor> pfor(new ParallelFor());
+	pfor->func = &func;
+	pfor->count = count;
+	pfor->grain = grain;
+	pfor->ranges = ranges;
+	pfor->next = 0;
+	pfor->completed = 0;
+
+	int helpers = (int) std::min(ranges - 1, (int64) parallelCount);
+
+	for (int i = 0; i < helpers; i++)
+	{
+		StrongRef<Task> task(new ParallelForTask(pfor), Acquire::NORETAIN);
+		submit(task);
+	}
+
+	runParallelFor(*pfor);
+
+	std::string error;
+
+	{
+		Lock lock(doneMutex);
+
+		while (pfor->completed.load() < ranges)
+			doneCond->wait(doneMutex);
+
+		error = pfor->error;
+	}
+
+	if (!error.empty())
+		throw love::Exception("%s", error.c_str());
+}
+
+void JobSystem::runParallelFor(ParallelFor &pfor)
+{
+	while (true)
+	{
+		int64 range = pfor.next.fetch_add(1);
+		if (range >= pfor.ranges)
+			break;
+
+		int64 first = range * pfor.grain;
+		int64 last = std::min(first + pfor.grain, pfor.count);
+
+		try
+		{
+			(*pfor.func)(first, last);
+		}
+		catch (std::exception &e)
+		{
+			Lock lock(doneMutex);
+			if (pfor.error.empty())
+				pfor.error = e.what();
+		}
+
+		if (pfor.completed.fetch_add(1) + 1 == pfor.ranges)
+		{
+			Lock lock(doneMutex);
+			doneCond->broadcast();
+		}
+	}
+}
+
+lua_State *JobSystem::getLuaState(int worker)
+{
+	Worker *w = workers[worker];
+
+	if (w->L == nullptr)
+	{
+		lua_State *L = luaL_newstate();
+
+		// Set before love.thread is loaded, so it knows not to count this
+		// state as a user of the JobSystem.
+		lua_pushinteger(L, worker);
+		lua_setfield(L, LUA_REGISTRYINDEX, "_love_jobworker");
+
+		LuaThread::openLibraries(L);
+
+		w->L = L;
+	}
+
+	return w->L;
+}
+
+int JobSystem::getLuaStateWorker(lua_State *L)
+{
+	lua_getfield(L, LUA_REGISTRYINDEX, "_love_jobworker");
+	int worker = lua_isnumber(L, -1) ? (int) lua_tointeger(L, -1) : -1;
+	lua_pop(L, 1);
+	return worker;
+}
+
+} // thread
+} // love
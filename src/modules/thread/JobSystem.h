@@ -0,0 +1,210 @@
+/**
+ * Copyright (c) 2006-2018 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+#ifndef LOVE_THREAD_JOBSYSTEM_H
+#define LOVE_THREAD_JOBSYSTEM_H
+
+// LOVE
+#include "common/config.h"
+#include "common/int.h"
+#include "common/Object.h"
+#include "threads.h"
+
+// STL
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <vector>
+
+struct lua_State;
+
+namespace love
+{
+namespace thread
+{
+
+class JobSystem;
+
+/**
+ * A unit of work which can be submitted to the JobSystem.
+ **/
+class Task : public love::Object
+{
+public:
+
+	static love::Type type;
+
+	Task();
+	virtual ~Task();
+
+	/**
+	 * Called on one of the JobSystem's worker threads.
+	 * @param system The JobSystem the Task was submitted to.
+	 * @param worker The index of the worker running the Task.
+	 **/
+	virtual void run(JobSystem *system, int worker) = 0;
+
+	bool isDone() const;
+
+private:
+
+	friend class JobSystem;
+
+	std::atomic<bool> done;
+
+}; // Task
+
+/**
+ * A fixed pool of worker threads which run Tasks. Every worker has its own
+ * queue of Tasks, and idle workers steal from the other queues before going
+ * to sleep.
+ **/
+class JobSystem
+{
+public:
+
+	/**
+	 * Gets the shared JobSystem, creating it (and its worker threads) if
+	 * needed.
+	 **/
+	static JobSystem *getInstance();
+
+	/**
+	 * Stops the worker threads and destroys the shared JobSystem. Tasks which
+	 * haven't started yet are discarded without running.
+	 **/
+	static void shutdown();
+
+	int getWorkerCount() const;
+
+	/**
+	 * Queues a Task to be run on a worker thread. The Task is retained until
+	 * it has finished running.
+	 **/
+	void submit(Task *task);
+
+	/**
+	 * Waits for a submitted Task to finish.
+	 * @param timeout The maximum time to wait in seconds, or a negative value
+	 * to wait forever.
+	 * @param worker The index of the calling worker thread, or -1 if the caller
+	 * isn't a worker. Workers run the Task themselves if it hasn't started yet,
+	 * so Tasks which wait for each other can't starve the pool.
+	 * @return Whether the Task has finished.
+	 **/
+	bool wait(Task *task, double timeout = -1.0, int worker = -1);
+
+	/**
+	 * Calls func(first, last) for consecutive ranges of [0, count) across the
+	 * worker threads and the calling thread, and returns once every range has
+	 * been processed. Ranges are at least grain items long (except the last
+	 * one). Small loops, or systems with a single worker, run directly on the
+	 * calling thread.
+	 **/
+	void parallelFor(int64 count, int64 grain, const std::function<void(int64, int64)> &func);
+
+	/**
+	 * Gets the Lua state owned by a worker thread, creating it if needed. Must
+	 * only be called from that worker's thread.
+	 **/
+	lua_State *getLuaState(int worker);
+
+	/**
+	 * Gets the index of the worker thread which owns a Lua state, or -1 if the
+	 * state doesn't belong to a worker.
+	 **/
+	static int getLuaStateWorker(lua_State *L);
+
+private:
+
+	class Worker : public Threadable
+	{
+	public:
+
+		Worker(JobSystem *owner, int index);
+		virtual ~Worker();
+
+		void threadFunction();
+
+		// Tasks are pushed to and popped from the back by their owner, and
+		// stolen from the front by other workers.
+		std::deque<Task *> tasks;
+		MutexRef mutex;
+
+		lua_State *L;
+
+	private:
+
+		JobSystem *owner;
+		int index;
+	};
+
+	struct ParallelFor;
+	class ParallelForTask;
+
+	friend class Worker;
+	friend class ParallelForTask;
+
+	JobSystem(int workerCount, int parallelCount);
+	~JobSystem();
+
+	// Takes the next Task for a worker from its own queue, or steals one.
+	Task *take(int worker);
+
+	// Removes a specific Task from whichever queue it's in. Returns false if
+	// it isn't queued (it's already running or done.)
+	bool takeTask(Task *task);
+
+	// Runs a Task and wakes anything waiting for it.
+	void execute(Task *task, int worker);
+
+	// Processes ranges of a parallelFor until there are none left.
+	void runParallelFor(ParallelFor &pfor);
+
+	static JobSystem *instance;
+
+	std::vector<Worker *> workers;
+	std::atomic<unsigned int> nextWorker;
+
+	// Number of workers which help with a parallelFor. Zero on single-core
+	// systems, where splitting the work up would only add overhead.
+	int parallelCount;
+
+	// Number of queued Tasks which haven't been taken yet. Protected by
+	// sleepMutex when it's incremented, so sleeping workers can't miss work.
+	std::atomic<int> pending;
+
+	// Number of workers blocked in wait. Protected by doneMutex when it's
+	// modified.
+	std::atomic<int> waitingWorkers;
+
+	bool finish;
+
+	MutexRef sleepMutex;
+	ConditionalRef sleepCond;
+
+	MutexRef doneMutex;
+	ConditionalRef doneCond;
+
+}; // JobSystem
+
+} // thread
+} // love
+
+#endif // LOVE_THREAD_JOBSYSTEM_H
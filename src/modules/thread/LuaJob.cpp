@@ -0,0 +1,152 @@
+/**
+ * Copyright (c) 2006-2018 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+#include "LuaJob.h"
+#include "common/Exception.h"
+#include "common/runtime.h"
+
+#include "libraries/xxHash/xxhash.h"
+
+namespace love
+{
+namespace thread
+{
+
+love::Type LuaJob::type("Job", &Task::type);
+
+LuaJob::LuaJob(const std::string &name, love::Data *code, const std::vector<Variant> &args)
+	: code(code)
+	, name(name)
+	, hash(XXH64(code->getData(), code->getSize(), 0))
+	, args(args)
+{
+}
+
+LuaJob::~LuaJob()
+{
+}
+
+void LuaJob::run(JobSystem *system, int worker)
+{
+	lua_State *L = system->getLuaState(worker);
+	int top = lua_gettop(L);
+
+	lua_pushcfunction(L, luax_traceback);
+	int tracebackidx = lua_gettop(L);
+
+	lua_getfield(L, LUA_REGISTRYINDEX, "_love_jobchunks");
+	if (!lua_istable(L, -1))
+	{
+		lua_pop(L, 1);
+		lua_newtable(L);
+		lua_pushvalue(L, -1);
+		lua_setfield(L, LUA_REGISTRYINDEX, "_love_jobchunks");
+	}
+
+	int cacheidx = lua_gettop(L);
+
+	// Compiled chunks are keyed by the hash of their code, since the same code
+	// is usually submitted from many different strings or Data objects.
+	lua_pushlstring(L, (const char *) &hash, sizeof(hash));
+	lua_rawget(L, cacheidx);
+
+	if (lua_isnil(L, -1))
+	{
+		lua_pop(L, 1);
+
+		if (luaL_loadbuffer(L, (const char *) code->getData(), code->getSize(), name.c_str()) != 0)
+		{
+			error = luax_tostring(L, -1);
+			lua_settop(L, top);
+			args.clear();
+			return;
+		}
+
+		lua_getfield(L, cacheidx, "n");
+		int cached = (int) lua_tointeger(L, -1);
+		lua_pop(L, 1);
+
+		// Start over rather than growing forever if lots of different code is
+		// submitted.
+		if (cached >= MAX_CACHED_CHUNKS)
+		{
+			lua_newtable(L);
+			lua_pushvalue(L, -1);
+			lua_setfield(L, LUA_REGISTRYINDEX, "_love_jobchunks");
+			lua_replace(L, cacheidx);
+			cached = 0;
+		}
+
+		lua_pushlstring(L, (const char *) &hash, sizeof(hash));
+		lua_pushvalue(L, -2);
+		lua_rawset(L, cacheidx);
+
+		lua_pushinteger(L, cached + 1);
+		lua_setfield(L, cacheidx, "n");
+	}
+
+	int pushedargs = (int) args.size();
+
+	for (int i = 0; i < pushedargs; i++)
+		args[i].toLua(L);
+
+	args.clear();
+
+	if (lua_pcall(L, pushedargs, LUA_MULTRET, tracebackidx) != 0)
+		error = luax_tostring(L, -1);
+	else
+	{
+		int nresults = lua_gettop(L) - cacheidx;
+
+		try
+		{
+			for (int i = 1; i <= nresults; i++)
+			{
+				results.push_back(Variant::fromLua(L, cacheidx + i));
+
+				if (results.back().getType() == Variant::UNKNOWN)
+				{
+					results.clear();
+					error = "Job results must be booleans, numbers, strings, love types, or flat tables.";
+					break;
+				}
+			}
+		}
+		catch (love::Exception &e)
+		{
+			results.clear();
+			error = e.what();
+		}
+	}
+
+	lua_settop(L, top);
+}
+
+const std::vector<Variant> &LuaJob::getResults() const
+{
+	return results;
+}
+
+const std::string &LuaJob::getError() const
+{
+	return error;
+}
+
+} // thread
+} // love
@@ -0,0 +1,84 @@
+/**
+ * Copyright (c) 2006-2018 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+#ifndef LOVE_THREAD_LUAJOB_H
+#define LOVE_THREAD_LUAJOB_H
+
+// LOVE
+#include "common/Data.h"
+#include "common/int.h"
+#include "common/Variant.h"
+#include "JobSystem.h"
+
+// STL
+#include <string>
+#include <vector>
+
+namespace love
+{
+namespace thread
+{
+
+/**
+ * Runs a chunk of Lua code in a worker thread's Lua state. The worker states
+ * are kept alive between jobs, and compiled chunks are cached in them, so a
+ * job only pays for loading love once per worker.
+ **/
+class LuaJob : public Task
+{
+public:
+
+	static love::Type type;
+
+	LuaJob(const std::string &name, love::Data *code, const std::vector<Variant> &args);
+	virtual ~LuaJob();
+
+	void run(JobSystem *system, int worker) override;
+
+	/**
+	 * Gets the values returned by the Lua code. Only valid once the job is
+	 * done.
+	 **/
+	const std::vector<Variant> &getResults() const;
+
+	/**
+	 * Gets the error raised by the Lua code, if any. Only valid once the job
+	 * is done.
+	 **/
+	const std::string &getError() const;
+
+private:
+
+	// Maximum number of compiled chunks cached in each worker's Lua state.
+	static const int MAX_CACHED_CHUNKS = 64;
+
+	StrongRef<love::Data> code;
+	std::string name;
+	uint64 hash;
+
+	std::vector<Variant> args;
+	std::vector<Variant> results;
+	std::string error;
+
+}; // LuaJob
+
+} // thread
+} // love
+
+#endif // LOVE_THREAD_LUAJOB_H
@@ -0,0 +1,343 @@
+/**
+ * Copyright (c) 2006-2018 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+#include "LuaStatePool.h"
+#include "LuaThread.h"
+#include "threads.h"
+#include "common/runtime.h"
+
+#include "libraries/xxHash/xxhash.h"
+
+// STL
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace love
+{
+namespace thread
+{
+
+namespace
+{
+
+// Heap-allocated, and only touched with the mutex held, so Threads which
+// finish after a shutdown don't use freed memory.
+struct PoolState
+{
+	std::vector<lua_State *> idle;
+	int size = 0;
+
+	bool bytecodeCache = false;
+	std::map<uint64, std::shared_ptr<std::string>> bytecode;
+};
+
+PoolState *poolState = nullptr;
+
+std::atomic<Mutex *> poolMutex(nullptr);
+
+Mutex *getPoolMutex()
+{
+	Mutex *mutex = poolMutex.load();
+	if (mutex != nullptr)
+		return mutex;
+
+	Mutex *newmutex = newMutex();
+	if (poolMutex.compare_exchange_strong(mutex, newmutex))
+		return newmutex;
+
+	// Another thread got there first.
+	delete newmutex;
+	return mutex;
+}
+
+PoolState &getPoolState()
+{
+	if (poolState == nullptr)
+		poolState = new PoolState();
+	return *poolState;
+}
+
+void pushGlobals(lua_State *L)
+{
+#if LUA_VERSION_NUM == 501
+	lua_pushvalue(L, LUA_GLOBALSINDEX);
+#else
+	lua_rawgeti(L, LUA_REGISTRYINDEX, LUA_RIDX_GLOBALS);
+#endif
+}
+
+int writeBytecode(lua_State *, const void *p, size_t size, void *ud)
+{
+	std::string *bytecode = (std::string *) ud;
+	bytecode->append((const char *) p, size);
+	return 0;
+}
+
+} // anonymous namespace
+
+lua_State *LuaStatePool::acquire()
+{
+	{
+		Lock lock(getPoolMutex());
+		PoolState &pool = getPoolState();
+
+		if (!pool.idle.empty())
+		{
+			lua_State *L = pool.idle.back();
+			pool.idle.pop_back();
+			return L;
+		}
+	}
+
+	return newState();
+}
+
+void LuaStatePool::release(lua_State *L, bool reuse)
+{
+	if (reuse)
+	{
+		lua_settop(L, 0);
+		resetGlobals(L);
+
+		// Whatever the last Thread left behind shouldn't stay alive while the
+		// state sits in the pool.
+		lua_gc(L, LUA_GCCOLLECT, 0);
+
+		Lock lock(getPoolMutex());
+
+		// A Thread which finishes after shutdown() mustn't recreate the pool,
+		// nothing would free it again.
+		if (poolState != nullptr && (int) poolState->idle.size() < poolState->size)
+		{
+			poolState->idle.push_back(L);
+			return;
+		}
+	}
+
+	lua_close(L);
+}
+
+void LuaStatePool::setSize(int size)
+{
+	std::vector<lua_State *> closing;
+	int missing = 0;
+
+	{
+		Lock lock(getPoolMutex());
+		PoolState &pool = getPoolState();
+
+		pool.size = std::max(size, 0);
+
+		while ((int) pool.idle.size() > pool.size)
+		{
+			closing.push_back(pool.idle.back());
+			pool.idle.pop_back();
+		}
+
+		missing = pool.size - (int) pool.idle.size();
+	}
+
+	for (lua_State *L : closing)
+		lua_close(L);
+
+	// Creating a state loads several love modules, so it's done without the
+	// lock held.
+	for (int i = 0; i < missing; i++)
+		release(newState(), true);
+}
+
+int LuaStatePool::getSize()
+{
+	Lock lock(getPoolMutex());
+	return getPoolState().size;
+}
+
+void LuaStatePool::setBytecodeCacheEnabled(bool enable)
+{
+	Lock lock(getPoolMutex());
+	PoolState &pool = getPoolState();
+
+	pool.bytecodeCache = enable;
+
+	if (!enable)
+		pool.bytecode.clear();
+}
+
+bool LuaStatePool::isBytecodeCacheEnabled()
+{
+	Lock lock(getPoolMutex());
+	return getPoolState().bytecodeCache;
+}
+
+int LuaStatePool::load(lua_State *L, love::Data *code, const std::string &name)
+{
+	const char *source = (const char *) code->getData();
+	size_t size = code->getSize();
+
+	// The chunk name is baked into the bytecode, so it's part of the key.
+	uint64 key = XXH64(name.data(), name.size(), XXH64(source, size, 0));
+	std::shared_ptr<std::string> bytecode;
+	bool usecache = false;
+
+	{
+		Lock lock(getPoolMutex());
+		PoolState &pool = getPoolState();
+
+		usecache = pool.bytecodeCache;
+
+		auto it = pool.bytecode.find(key);
+		if (usecache && it != pool.bytecode.end())
+			bytecode = it->second;
+	}
+
+	if (!usecache)
+		return luaL_loadbuffer(L, source, size, name.c_str());
+
+	if (bytecode)
+		return luaL_loadbuffer(L, bytecode->data(), bytecode->size(), name.c_str());
+
+	int status = luaL_loadbuffer(L, source, size, name.c_str());
+	if (status != 0)
+		return status;
+
+	bytecode.reset(new std::string());
+
+#if LUA_VERSION_NUM >= 503
+	lua_dump(L, writeBytecode, bytecode.get(), 0);
+#else
+	lua_dump(L, writeBytecode, bytecode.get());
+#endif
+
+	Lock lock(getPoolMutex());
+	PoolState &pool = getPoolState();
+
+	// Start over rather than growing forever if lots of different code is
+	// loaded.
+	if (pool.bytecode.size() >= MAX_CACHED_CHUNKS)
+		pool.bytecode.clear();
+
+	pool.bytecode[key] = bytecode;
+
+	return status;
+}
+
+bool LuaStatePool::isPooled(lua_State *L)
+{
+	lua_getfield(L, LUA_REGISTRYINDEX, "_love_pooledstate");
+	bool pooled = lua_toboolean(L, -1) != 0;
+	lua_pop(L, 1);
+	return pooled;
+}
+
+void LuaStatePool::shutdown()
+{
+	PoolState *pool = nullptr;
+
+	{
+		Lock lock(getPoolMutex());
+		pool = poolState;
+		poolState = nullptr;
+	}
+
+	if (pool == nullptr)
+		return;
+
+	for (lua_State *L : pool->idle)
+		lua_close(L);
+
+	delete pool;
+}
+
+lua_State *LuaStatePool::newState()
+{
+	lua_State *L = luaL_newstate();
+
+	// Set before love.thread is loaded, so it knows an idle state in the pool
+	// shouldn't keep love.thread's shared resources alive.
+	lua_pushboolean(L, 1);
+	lua_setfield(L, LUA_REGISTRYINDEX, "_love_pooledstate");
+
+	LuaThread::openLibraries(L);
+
+	// Remember the initial globals, so they can be restored when the state is
+	// returned to the pool.
+	lua_newtable(L);
+	pushGlobals(L);
+
+	lua_pushnil(L);
+	while (lua_next(L, -2))
+	{
+		lua_pushvalue(L, -2);
+		lua_insert(L, -2);
+		lua_rawset(L, -5);
+	}
+
+	lua_pop(L, 1);
+	lua_setfield(L, LUA_REGISTRYINDEX, "_love_pooledglobals");
+
+	return L;
+}
+
+void LuaStatePool::resetGlobals(lua_State *L)
+{
+	lua_getfield(L, LUA_REGISTRYINDEX, "_love_pooledglobals");
+	int initialidx = lua_gettop(L);
+
+	pushGlobals(L);
+	int globalsidx = lua_gettop(L);
+
+	lua_pushnil(L);
+	lua_setmetatable(L, globalsidx);
+
+	// Remove globals which weren't there initially. Clearing fields of a
+	// table while traversing it with lua_next is allowed.
+	lua_pushnil(L);
+	while (lua_next(L, globalsidx))
+	{
+		lua_pop(L, 1);
+		lua_pushvalue(L, -1);
+		lua_rawget(L, initialidx);
+
+		if (lua_isnil(L, -1))
+		{
+			lua_pushvalue(L, -2);
+			lua_pushnil(L);
+			lua_rawset(L, globalsidx);
+		}
+
+		lua_pop(L, 1);
+	}
+
+	// Restore the initial values of the ones which were.
+	lua_pushnil(L);
+	while (lua_next(L, initialidx))
+	{
+		lua_pushvalue(L, -2);
+		lua_insert(L, -2);
+		lua_rawset(L, globalsidx);
+	}
+
+	lua_settop(L, initialidx - 1);
+}
+
+} // thread
+} // love
@@ -0,0 +1,98 @@
+/**
+ * Copyright (c) 2006-2018 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+#ifndef LOVE_THREAD_LUASTATEPOOL_H
+#define LOVE_THREAD_LUASTATEPOOL_H
+
+// LOVE
+#include "common/Data.h"
+
+// STL
+#include <string>
+
+struct lua_State;
+
+namespace love
+{
+namespace thread
+{
+
+/**
+ * Keeps Lua states which have already loaded love, love.thread and
+ * love.filesystem around between Thread runs, and optionally caches the
+ * bytecode of Thread code so it only has to be compiled once.
+ **/
+class LuaStatePool
+{
+public:
+
+	/**
+	 * Gets a ready-to-use Lua state, from the pool if one is available.
+	 **/
+	static lua_State *acquire();
+
+	/**
+	 * Returns a Lua state from acquire to the pool, or closes it if the pool
+	 * is full or the state shouldn't be reused. Globals added or replaced
+	 * while the state was in use are reset, but changes made to the contents
+	 * of existing tables (including package.loaded) are kept.
+	 **/
+	static void release(lua_State *L, bool reuse);
+
+	/**
+	 * Sets the maximum number of idle states kept in the pool. States are
+	 * created on the calling thread until the pool is full.
+	 **/
+	static void setSize(int size);
+	static int getSize();
+
+	static void setBytecodeCacheEnabled(bool enable);
+	static bool isBytecodeCacheEnabled();
+
+	/**
+	 * Loads a chunk of Lua code onto the stack like luaL_loadbuffer, using
+	 * the bytecode cache if it's enabled.
+	 **/
+	static int load(lua_State *L, love::Data *code, const std::string &name);
+
+	/**
+	 * Gets whether a Lua state was created by the pool.
+	 **/
+	static bool isPooled(lua_State *L);
+
+	/**
+	 * Closes all idle states, clears the bytecode cache and resets the
+	 * settings.
+	 **/
+	static void shutdown();
+
+private:
+
+	// Maximum number of chunks kept in the bytecode cache.
+	static const int MAX_CACHED_CHUNKS = 64;
+
+	static lua_State *newState();
+	static void resetGlobals(lua_State *L);
+
+}; // LuaStatePool
+
+} // thread
+} // love
+
+#endif // LOVE_THREAD_LUASTATEPOOL_H
@@ -19,6 +19,7 @@
  **/
 
 #include "LuaThread.h"
+#include "LuaStatePool.h"
 #include "event/Event.h"
 #include "common/config.h"
 
@@ -48,28 +49,12 @@ void LuaThread::threadFunction()
 {
 	error.clear();
 
-	lua_State *L = luaL_newstate();
-	luaL_openlibs(L);
-
-#ifdef LOVE_BUILD_STANDALONE
-	luax_preload(L, luaopen_love, "love");
-	luax_require(L, "love");
-	lua_pop(L, 1);
-#endif // LOVE_BUILD_STANDALONE
-
-	luax_require(L, "love.thread");
-	lua_pop(L, 1);
-
-	// We load love.filesystem by default, since require still exists without it
-	// but won't load files from the proper paths. love.filesystem also must be
-	// loaded before using any love function that can take a filepath argument.
-	luax_require(L, "love.filesystem");
-	lua_pop(L, 1);
+	lua_State *L = LuaStatePool::acquire();
 
 	lua_pushcfunction(L, luax_traceback);
 	int tracebackidx = lua_gettop(L);
 
-	if (luaL_loadbuffer(L, (const char *) code->getData(), code->getSize(), name.c_str()) != 0)
+	if (LuaStatePool::load(L, code, name) != 0)
 		error = luax_tostring(L, -1);
 	else
 	{
@@ -84,12 +69,34 @@ void LuaThread::threadFunction()
 			error = luax_tostring(L, -1);
 	}
 
-	lua_close(L);
+	// States which hit an error might be in a strange state, so they aren't
+	// reused.
+	LuaStatePool::release(L, error.empty());
 
 	if (!error.empty())
 		onError();
 }
 
+void LuaThread::openLibraries(lua_State *L)
+{
+	luaL_openlibs(L);
+
+#ifdef LOVE_BUILD_STANDALONE
+	luax_preload(L, luaopen_love, "love");
+	luax_require(L, "love");
+	lua_pop(L, 1);
+#endif // LOVE_BUILD_STANDALONE
+
+	luax_require(L, "love.thread");
+	lua_pop(L, 1);
+
+	// We load love.filesystem by default, since require still exists without it
+	// but won't load files from the proper paths. love.filesystem also must be
+	// loaded before using any love function that can take a filepath argument.
+	luax_require(L, "love.filesystem");
+	lua_pop(L, 1);
+}
+
 bool LuaThread::start(const std::vector<Variant> &args)
 {
 	this->args = args;
@@ -110,13 +117,12 @@ void LuaThread::onError()
 	if (!eventmodule)
 		return;
 
-	std::vector<Variant> vargs = {
-		Variant(&LuaThread::type, this),
-		Variant(error.c_str(), error.length())
-	};
+	event::QueuedEvent e;
+	e.name = event::Event::EVENT_THREADERROR;
+	e.addArg(&LuaThread::type, this);
+	e.addArg(error.c_str(), error.length());
 
-	StrongRef<event::Message> msg(new event::Message("threaderror", vargs), Acquire::NORETAIN);
-	eventmodule->push(msg);
+	eventmodule->push(e);
 }
 
 } // thread
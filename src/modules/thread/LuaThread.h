@@ -49,6 +49,12 @@ public:
 
 	bool start(const std::vector<Variant> &args);
 
+	/**
+	 * Opens the standard libraries and loads love, love.thread and
+	 * love.filesystem into a new Lua state.
+	 **/
+	static void openLibraries(lua_State *L);
+
 private:
 
 	void onError();
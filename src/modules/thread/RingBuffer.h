@@ -0,0 +1,162 @@
+/**
+ * Copyright (c) 2006-2018 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#ifndef LOVE_THREAD_RING_BUFFER_H
+#define LOVE_THREAD_RING_BUFFER_H
+
+// LOVE
+#include "common/int.h"
+
+// C++
+#include <atomic>
+#include <vector>
+
+namespace love
+{
+namespace thread
+{
+
+/**
+ * Bounded queue which any number of threads can push to and pop from at once,
+ * without locking. Each slot carries a sequence number saying whether it's
+ * ready to be written or read for a given position in the queue, so pushing
+ * and popping only ever contend on a single compare-and-swap.
+ **/
+template <typename T>
+class RingBuffer
+{
+public:
+
+	RingBuffer(size_t capacity)
+		: cells(capacity)
+		, capacity(capacity)
+		, head(0)
+		, tail(0)
+	{
+		for (size_t i = 0; i < capacity; i++)
+			cells[i].sequence.store(i, std::memory_order_relaxed);
+	}
+
+	/**
+	 * Pushes a value unless the queue is full.
+	 * @param position Set to the position of the value in the queue, counting
+	 *        every value ever pushed.
+	 **/
+	bool push(const T &value, uint64 &position)
+	{
+		uint64 pos = tail.load(std::memory_order_relaxed);
+
+		while (true)
+		{
+			Cell &cell = cells[pos % capacity];
+			uint64 seq = cell.sequence.load(std::memory_order_acquire);
+			int64 diff = (int64) seq - (int64) pos;
+
+			if (diff == 0)
+			{
+				if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+				{
+					cell.value = value;
+					cell.sequence.store(pos + 1, std::memory_order_release);
+					position = pos;
+					return true;
+				}
+			}
+			else if (diff < 0)
+				return false; // Full.
+			else
+				pos = tail.load(std::memory_order_relaxed);
+		}
+	}
+
+	bool pop(T &value)
+	{
+		uint64 pos = head.load(std::memory_order_relaxed);
+
+		while (true)
+		{
+			Cell &cell = cells[pos % capacity];
+			uint64 seq = cell.sequence.load(std::memory_order_acquire);
+			int64 diff = (int64) seq - (int64) (pos + 1);
+
+			if (diff == 0)
+			{
+				if (head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+				{
+					value = cell.value;
+
+					// Don't keep whatever the value references alive.
+					cell.value = T();
+					cell.sequence.store(pos + capacity, std::memory_order_release);
+					return true;
+				}
+			}
+			else if (diff < 0)
+				return false; // Empty.
+			else
+				pos = head.load(std::memory_order_relaxed);
+		}
+	}
+
+	// Approximate while other threads are pushing or popping.
+	size_t getCount() const
+	{
+		uint64 t = tail.load(std::memory_order_acquire);
+		uint64 h = head.load(std::memory_order_acquire);
+		return t > h ? (size_t) (t - h) : 0;
+	}
+
+	uint64 getPushCount() const
+	{
+		return tail.load(std::memory_order_acquire);
+	}
+
+	size_t getCapacity() const
+	{
+		return capacity;
+	}
+
+private:
+
+	struct Cell
+	{
+		std::atomic<uint64> sequence;
+		T value;
+	};
+
+	// Keep the positions apart so they don't share a cache line, since
+	// producers and consumers hammer them from different threads.
+	static const size_t CACHE_LINE_SIZE = 64;
+
+	std::vector<Cell> cells;
+	size_t capacity;
+
+	char padding0[CACHE_LINE_SIZE];
+	std::atomic<uint64> head;
+	char padding1[CACHE_LINE_SIZE];
+	std::atomic<uint64> tail;
+	char padding2[CACHE_LINE_SIZE];
+
+}; // RingBuffer
+
+} // thread
+} // love
+
+#endif // LOVE_THREAD_RING_BUFFER_H
@@ -0,0 +1,452 @@
+/**
+ * Copyright (c) 2006-2018 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+#include "SharedTable.h"
+#include "common/Exception.h"
+
+#include "libraries/xxHash/xxhash.h"
+
+// STL
+#include <cmath>
+#include <cstring>
+#include <map>
+#include <set>
+#include <string>
+#include <unordered_map>
+
+namespace love
+{
+namespace thread
+{
+
+namespace
+{
+
+// Tables nested deeper than this can't be shared.
+const int MAX_DEPTH = 128;
+
+uint32 mixHash(uint64 x)
+{
+	// splitmix64 finalizer.
+	x ^= x >> 30;
+	x *= 0xBF58476D1CE4E5B9ULL;
+	x ^= x >> 27;
+	x *= 0x94D049BB133111EBULL;
+	x ^= x >> 31;
+	return (uint32) x;
+}
+
+uint32 hashNumber(double number)
+{
+	// -0 and 0 are the same key in Lua.
+	if (number == 0.0)
+		number = 0.0;
+
+	uint64 bits = 0;
+	memcpy(&bits, &number, sizeof(bits));
+	return mixHash(bits);
+}
+
+uint32 hashString(const char *str, size_t len)
+{
+	return XXH32(str, len, 0);
+}
+
+uint32 hashBoolean(bool boolean)
+{
+	return mixHash(boolean ? 2 : 1);
+}
+
+} // anonymous namespace
+
+class SharedTable::Builder
+{
+public:
+
+	Builder(lua_State *L, Storage *storage)
+		: L(L)
+		, storage(storage)
+	{}
+
+	uint32 addTable(int idx, int depth)
+	{
+		if (idx < 0)
+			idx = lua_gettop(L) + idx + 1;
+
+		const void *pointer = lua_topointer(L, idx);
+
+		// Tables which show up more than once are only stored once.
+		auto it = built.find(pointer);
+		if (it != built.end())
+			return it->second;
+
+		if (depth >= MAX_DEPTH)
+			throw love::Exception("Cannot share tables nested more than %d levels deep.", MAX_DEPTH);
+
+		if (!inProgress.insert(pointer).second)
+			throw love::Exception("Cannot share recursive tables.");
+
+		luaL_checkstack(L, 3, nullptr);
+
+		uint32 index = (uint32) storage->tables.size();
+		storage->tables.push_back(Table());
+
+		// Nested tables are added to the storage while we go, so this table's
+		// values are collected first and copied in at the end.
+		size_t arraylength = luax_objlen(L, idx);
+		std::vector<Value> array;
+		array.reserve(arraylength);
+
+		for (size_t i = 1; i <= arraylength; i++)
+		{
+			lua_rawgeti(L, idx, (int) i);
+			array.push_back(makeValue(-1, depth));
+			lua_pop(L, 1);
+		}
+
+		std::vector<Entry> hashed;
+
+		lua_pushnil(L);
+		while (lua_next(L, idx))
+		{
+			if (!isArrayKey(-2, arraylength))
+			{
+				if (lua_type(L, -2) == LUA_TTABLE)
+					throw love::Exception("Shared tables can't use tables as keys.");
+
+				Entry entry;
+				entry.key = makeValue(-2, depth);
+				entry.value = makeValue(-1, depth);
+				hashed.push_back(entry);
+			}
+
+			lua_pop(L, 1);
+		}
+
+		Table table;
+		table.arrayStart = (uint32) storage->arrays.size();
+		table.arrayLength = (uint32) arraylength;
+		table.hashStart = (uint32) storage->entries.size();
+		table.hashCapacity = 0;
+
+		storage->arrays.insert(storage->arrays.end(), array.begin(), array.end());
+
+		if (!hashed.empty())
+		{
+			// Keep the load factor at or below 1/2, so probes stay short and
+			// there's always an empty slot to stop at.
+			uint32 capacity = 2;
+			while (capacity < hashed.size() * 2)
+				capacity *= 2;
+
+			Entry empty;
+			memset(&empty, 0, sizeof(Entry));
+			storage->entries.resize(storage->entries.size() + capacity, empty);
+
+			Entry *slots = &storage->entries[table.hashStart];
+
+			for (const Entry &entry : hashed)
+			{
+				uint32 i = entry.key.hash & (capacity - 1);
+				while (slots[i].key.type != TYPE_NIL)
+					i = (i + 1) & (capacity - 1);
+
+				slots[i] = entry;
+			}
+
+			table.hashCapacity = capacity;
+		}
+
+		storage->tables[index] = table;
+
+		inProgress.erase(pointer);
+		built[pointer] = index;
+
+		return index;
+	}
+
+private:
+
+	Value makeValue(int idx, int depth)
+	{
+		Value value;
+		memset(&value, 0, sizeof(Value));
+
+		switch (lua_type(L, idx))
+		{
+		case LUA_TNIL:
+			value.type = TYPE_NIL;
+			break;
+		case LUA_TBOOLEAN:
+			value.type = TYPE_BOOLEAN;
+			value.boolean = lua_toboolean(L, idx) != 0;
+			value.hash = hashBoolean(value.boolean);
+			break;
+		case LUA_TNUMBER:
+			value.type = TYPE_NUMBER;
+			value.number = (double) lua_tonumber(L, idx);
+			value.hash = hashNumber(value.number);
+			break;
+		case LUA_TSTRING:
+		{
+			size_t len = 0;
+			const char *str = lua_tolstring(L, idx, &len);
+
+			if (len > 0xFFFFFFFF)
+				throw love::Exception("Cannot share strings larger than 4 GB.");
+
+			value.type = TYPE_STRING;
+			value.length = (uint32) len;
+			value.offset = addString(str, len);
+			value.hash = hashString(str, len);
+			break;
+		}
+		case LUA_TTABLE:
+			value.type = TYPE_TABLE;
+			value.table = addTable(idx, depth + 1);
+			break;
+		default:
+			throw love::Exception("Cannot share values of type '%s'.", luaL_typename(L, idx));
+		}
+
+		return value;
+	}
+
+	uint32 addString(const char *str, size_t len)
+	{
+		// Lots of records tend to use the same strings as keys.
+		std::string key(str, len);
+
+		auto it = strings.find(key);
+		if (it != strings.end())
+			return it->second;
+
+		if (storage->strings.size() + len > 0xFFFFFFFF)
+			throw love::Exception("Cannot share more than 4 GB of strings.");
+
+		uint32 offset = (uint32) storage->strings.size();
+		storage->strings.insert(storage->strings.end(), str, str + len);
+
+		strings[key] = offset;
+		return offset;
+	}
+
+	bool isArrayKey(int idx, size_t arraylength) const
+	{
+		if (lua_type(L, idx) != LUA_TNUMBER)
+			return false;
+
+		lua_Number key = lua_tonumber(L, idx);
+		return key >= 1 && key <= (lua_Number) arraylength && key == (lua_Number) (size_t) key;
+	}
+
+	lua_State *L;
+	Storage *storage;
+
+	std::map<const void *, uint32> built;
+	std::set<const void *> inProgress;
+	std::unordered_map<std::string, uint32> strings;
+};
+
+love::Type SharedTable::type("SharedTable", &Object::type);
+
+SharedTable::SharedTable(Storage *storage, uint32 table)
+	: storage(storage)
+	, table(table)
+{
+}
+
+SharedTable::~SharedTable()
+{
+}
+
+SharedTable *SharedTable::fromLua(lua_State *L, int idx)
+{
+	if (lua_type(L, idx) != LUA_TTABLE)
+		throw love::Exception("Only tables can be shared.");
+
+	StrongRef<Storage> storage(new Storage(), Acquire::NORETAIN);
+
+	Builder builder(L, storage);
+	uint32 root = builder.addTable(idx, 0);
+
+	storage->tables.shrink_to_fit();
+	storage->arrays.shrink_to_fit();
+	storage->entries.shrink_to_fit();
+	storage->strings.shrink_to_fit();
+
+	return new SharedTable(storage, root);
+}
+
+void SharedTable::get(lua_State *L, int firstkey, int keycount) const
+{
+	uint32 current = table;
+	const Value *value = nullptr;
+
+	for (int i = 0; i < keycount; i++)
+	{
+		value = find(L, storage->tables[current], firstkey + i);
+
+		if (value == nullptr || (i < keycount - 1 && value->type != TYPE_TABLE))
+		{
+			lua_pushnil(L);
+			return;
+		}
+
+		current = value->table;
+	}
+
+	if (value != nullptr)
+		pushValue(L, *value);
+	else
+		lua_pushnil(L);
+}
+
+size_t SharedTable::getLength() const
+{
+	return storage->tables[table].arrayLength;
+}
+
+void SharedTable::pushKeys(lua_State *L) const
+{
+	const Table &t = storage->tables[table];
+
+	lua_createtable(L, (int) t.arrayLength, 0);
+	int n = 0;
+
+	for (uint32 i = 0; i < t.arrayLength; i++)
+	{
+		if (storage->arrays[t.arrayStart + i].type == TYPE_NIL)
+			continue;
+
+		lua_pushnumber(L, (lua_Number) (i + 1));
+		lua_rawseti(L, -2, ++n);
+	}
+
+	for (uint32 i = 0; i < t.hashCapacity; i++)
+	{
+		const Entry &entry = storage->entries[t.hashStart + i];
+		if (entry.key.type == TYPE_NIL || entry.value.type == TYPE_NIL)
+			continue;
+
+		pushValue(L, entry.key);
+		lua_rawseti(L, -2, ++n);
+	}
+}
+
+size_t SharedTable::getMemorySize() const
+{
+	return sizeof(Storage)
+		+ storage->tables.capacity() * sizeof(Table)
+		+ storage->arrays.capacity() * sizeof(Value)
+		+ storage->entries.capacity() * sizeof(Entry)
+		+ storage->strings.capacity();
+}
+
+const SharedTable::Value *SharedTable::find(lua_State *L, const Table &t, int keyidx) const
+{
+	uint32 hash = 0;
+	int type = lua_type(L, keyidx);
+
+	double number = 0.0;
+	const char *str = nullptr;
+	size_t len = 0;
+	bool boolean = false;
+
+	switch (type)
+	{
+	case LUA_TNUMBER:
+		number = (double) lua_tonumber(L, keyidx);
+
+		// The sequence part is indexed directly.
+		if (number >= 1.0 && number <= (double) t.arrayLength && number == std::floor(number))
+			return &storage->arrays[t.arrayStart + (uint32) number - 1];
+
+		hash = hashNumber(number);
+		break;
+	case LUA_TSTRING:
+		str = lua_tolstring(L, keyidx, &len);
+		hash = hashString(str, len);
+		break;
+	case LUA_TBOOLEAN:
+		boolean = lua_toboolean(L, keyidx) != 0;
+		hash = hashBoolean(boolean);
+		break;
+	default:
+		return nullptr;
+	}
+
+	if (t.hashCapacity == 0)
+		return nullptr;
+
+	const Entry *slots = &storage->entries[t.hashStart];
+	const char *strings = storage->strings.data();
+	uint32 mask = t.hashCapacity - 1;
+
+	for (uint32 i = hash & mask; slots[i].key.type != TYPE_NIL; i = (i + 1) & mask)
+	{
+		const Value &key = slots[i].key;
+
+		if (key.hash != hash)
+			continue;
+
+		if (type == LUA_TNUMBER && key.type == TYPE_NUMBER && key.number == number)
+			return &slots[i].value;
+		else if (type == LUA_TSTRING && key.type == TYPE_STRING && key.length == len
+		         && (len == 0 || memcmp(strings + key.offset, str, len) == 0))
+			return &slots[i].value;
+		else if (type == LUA_TBOOLEAN && key.type == TYPE_BOOLEAN && key.boolean == boolean)
+			return &slots[i].value;
+	}
+
+	return nullptr;
+}
+
+void SharedTable::pushValue(lua_State *L, const Value &value) const
+{
+	switch (value.type)
+	{
+	case TYPE_BOOLEAN:
+		lua_pushboolean(L, value.boolean);
+		break;
+	case TYPE_NUMBER:
+		lua_pushnumber(L, (lua_Number) value.number);
+		break;
+	case TYPE_STRING:
+		if (value.length > 0)
+			lua_pushlstring(L, storage->strings.data() + value.offset, value.length);
+		else
+			lua_pushliteral(L, "");
+		break;
+	case TYPE_TABLE:
+	{
+		SharedTable *t = new SharedTable(storage, value.table);
+		luax_pushtype(L, t);
+		t->release();
+		break;
+	}
+	case TYPE_NIL:
+	default:
+		lua_pushnil(L);
+		break;
+	}
+}
+
+} // thread
+} // love
@@ -0,0 +1,148 @@
+/**
+ * Copyright (c) 2006-2018 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+#ifndef LOVE_THREAD_SHAREDTABLE_H
+#define LOVE_THREAD_SHAREDTABLE_H
+
+// LOVE
+#include "common/Object.h"
+#include "common/runtime.h"
+#include "common/int.h"
+
+// STL
+#include <vector>
+
+namespace love
+{
+namespace thread
+{
+
+/**
+ * An immutable copy of a Lua table (including nested tables) in native
+ * memory. It can be passed to any thread and read from there directly, so
+ * big lookup tables don't need a copy in every Lua state.
+ *
+ * Lookups go through an open-addressing hash index per table, plus a plain
+ * array for the sequence part.
+ **/
+class SharedTable : public love::Object
+{
+public:
+
+	static love::Type type;
+
+	virtual ~SharedTable();
+
+	/**
+	 * Copies the Lua table at the given stack index into a new SharedTable.
+	 * Keys can be booleans, numbers or strings, values can also be tables.
+	 **/
+	static SharedTable *fromLua(lua_State *L, int idx);
+
+	/**
+	 * Looks up a chain of keys (t[k1][k2]...) from the Lua stack, and pushes
+	 * the result or nil. Nested tables are pushed as new SharedTables which
+	 * share this one's memory.
+	 **/
+	void get(lua_State *L, int firstkey, int keycount) const;
+
+	/**
+	 * Gets the length of the sequence part of the table.
+	 **/
+	size_t getLength() const;
+
+	/**
+	 * Pushes a new Lua table containing all of the table's keys.
+	 **/
+	void pushKeys(lua_State *L) const;
+
+	/**
+	 * Gets the amount of memory used by the whole SharedTable, including the
+	 * tables nested in it.
+	 **/
+	size_t getMemorySize() const;
+
+private:
+
+	enum ValueType
+	{
+		TYPE_NIL = 0,
+		TYPE_BOOLEAN,
+		TYPE_NUMBER,
+		TYPE_STRING,
+		TYPE_TABLE,
+	};
+
+	struct Value
+	{
+		uint8 type;
+		bool boolean;
+		uint32 length; // Strings.
+
+		union
+		{
+			double number;
+			uint32 offset; // Strings, into the string storage.
+			uint32 table;  // Tables, into the table list.
+		};
+
+		uint32 hash;
+	};
+
+	struct Entry
+	{
+		Value key;
+		Value value;
+	};
+
+	struct Table
+	{
+		uint32 arrayStart;
+		uint32 arrayLength;
+		uint32 hashStart;
+		uint32 hashCapacity; // A power of two, or 0.
+	};
+
+	// Memory shared by a SharedTable and all the nested tables in it.
+	class Storage : public love::Object
+	{
+	public:
+
+		std::vector<Table> tables;
+		std::vector<Value> arrays;
+		std::vector<Entry> entries;
+		std::vector<char> strings;
+	};
+
+	class Builder;
+
+	SharedTable(Storage *storage, uint32 table);
+
+	const Value *find(lua_State *L, const Table &table, int keyidx) const;
+	void pushValue(lua_State *L, const Value &value) const;
+
+	StrongRef<Storage> storage;
+	uint32 table;
+
+}; // SharedTable
+
+} // thread
+} // love
+
+#endif // LOVE_THREAD_SHAREDTABLE_H
@@ -25,14 +25,16 @@ namespace love
 namespace thread
 {
 
+std::atomic<int> ThreadModule::luaUsers(0);
+
 LuaThread *ThreadModule::newThread(const std::string &name, love::Data *data)
 {
 	return new LuaThread(name, data);
 }
 
-Channel *ThreadModule::newChannel()
+Channel *ThreadModule::newChannel(int capacity, bool lockFree)
 {
-	return new Channel();
+	return new Channel(capacity, lockFree);
 }
 
 Channel *ThreadModule::getChannel(const std::string &name)
@@ -40,6 +42,32 @@ Channel *ThreadModule::getChannel(const std::string &name)
 	return Channel::getChannel(name);
 }
 
+LuaJob *ThreadModule::submit(const std::string &name, love::Data *code, const std::vector<Variant> &args)
+{
+	LuaJob *job = new LuaJob(name, code, args);
+	JobSystem::getInstance()->submit(job);
+	return job;
+}
+
+int ThreadModule::getWorkerCount() const
+{
+	return JobSystem::getInstance()->getWorkerCount();
+}
+
+void ThreadModule::addLuaUser()
+{
+	luaUsers++;
+}
+
+void ThreadModule::removeLuaUser()
+{
+	if (--luaUsers == 0)
+	{
+		JobSystem::shutdown();
+		LuaStatePool::shutdown();
+	}
+}
+
 const char *ThreadModule::getName() const
 {
 	return "love.thread.sdl";
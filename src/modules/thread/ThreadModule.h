@@ -22,7 +22,9 @@
 #define LOVE_THREAD_THREADMODULE_H
 
 // STL
+#include <atomic>
 #include <string>
+#include <vector>
 
 // LOVE
 #include "common/Data.h"
@@ -32,6 +34,8 @@
 #include "Thread.h"
 #include "Channel.h"
 #include "LuaThread.h"
+#include "LuaJob.h"
+#include "LuaStatePool.h"
 #include "threads.h"
 
 namespace love
@@ -44,13 +48,30 @@ public:
 
 	virtual ~ThreadModule() {}
 	virtual LuaThread *newThread(const std::string &name, love::Data *data);
-	virtual Channel *newChannel();
+	virtual Channel *newChannel(int capacity = 0, bool lockFree = false);
 	virtual Channel *getChannel(const std::string &name);
 
+	/**
+	 * Runs Lua code on one of the JobSystem's worker threads.
+	 **/
+	virtual LuaJob *submit(const std::string &name, love::Data *code, const std::vector<Variant> &args);
+	virtual int getWorkerCount() const;
+
+	/**
+	 * Keeps track of the Lua states which use love.thread. The JobSystem and
+	 * the pool of idle Lua states are shut down once the last one is closed.
+	 **/
+	static void addLuaUser();
+	static void removeLuaUser();
+
 	// Implements Module.
 	virtual const char *getName() const;
 	virtual ModuleType getModuleType() const { return M_THREAD; }
 
+private:
+
+	static std::atomic<int> luaUsers;
+
 }; // ThreadModule
 
 } // thread
@@ -19,6 +19,7 @@
 **/
 
 #include "wrap_Channel.h"
+#include "data/ByteData.h"
 
 namespace love
 {
@@ -38,11 +39,79 @@ int w_Channel_push(lua_State *L)
 		if (var.getType() == Variant::UNKNOWN)
 			luaL_argerror(L, 2, "boolean, number, string, love type, or table expected");
 		uint64 id = c->push(var);
-		lua_pushnumber(L, (lua_Number) id);
+		if (id != 0)
+			lua_pushnumber(L, (lua_Number) id);
+		else
+			lua_pushnil(L);
 	});
 	return 1;
 }
 
+int w_Channel_pushMove(lua_State *L)
+{
+	Channel *c = luax_checkchannel(L, 1);
+	love::data::ByteData *d = luax_checktype<love::data::ByteData>(L, 2);
+
+	luax_catchexcept(L, [&]() {
+		// The receiver gets a new ByteData which owns the memory, so the
+		// sender can't touch the contents once they've been sent.
+		StrongRef<love::data::ByteData> moved(d->transfer(), Acquire::NORETAIN);
+
+		uint64 id = c->push(Variant(&love::data::ByteData::type, moved));
+		if (id != 0)
+			lua_pushnumber(L, (lua_Number) id);
+		else
+		{
+			// The Channel is full, give the memory back.
+			d->take(moved);
+			lua_pushnil(L);
+		}
+	});
+	return 1;
+}
+
+int w_Channel_pushMany(lua_State *L)
+{
+	Channel *c = luax_checkchannel(L, 1);
+	luaL_checktype(L, 2, LUA_TTABLE);
+
+	int count = 0;
+	uint64 id = 0;
+	bool valid = true;
+
+	luax_catchexcept(L, [&]() {
+		int n = (int) luax_objlen(L, 2);
+
+		std::vector<Variant> vars;
+		vars.reserve(n);
+
+		for (int i = 1; i <= n; i++)
+		{
+			lua_rawgeti(L, 2, i);
+			vars.push_back(Variant::fromLua(L, -1));
+			lua_pop(L, 1);
+
+			if (vars.back().getType() == Variant::UNKNOWN)
+			{
+				valid = false;
+				return;
+			}
+		}
+
+		count = c->pushMany(vars, id);
+	});
+
+	if (!valid)
+		return luaL_argerror(L, 2, "boolean, number, string, love type, or table expected in the list of values");
+
+	lua_pushinteger(L, count);
+	if (count > 0)
+		lua_pushnumber(L, (lua_Number) id);
+	else
+		lua_pushnil(L);
+	return 2;
+}
+
 int w_Channel_supply(lua_State *L)
 {
 	Channel *c = luax_checkchannel(L, 1);
@@ -72,6 +141,24 @@ int w_Channel_pop(lua_State *L)
 	return 1;
 }
 
+int w_Channel_popMany(lua_State *L)
+{
+	Channel *c = luax_checkchannel(L, 1);
+	int max = (int) luaL_optinteger(L, 2, LOVE_INT32_MAX);
+
+	std::vector<Variant> vars;
+	c->popMany(vars, max);
+
+	lua_createtable(L, (int) vars.size(), 0);
+	for (size_t i = 0; i < vars.size(); i++)
+	{
+		vars[i].toLua(L);
+		lua_rawseti(L, -2, (int) i + 1);
+	}
+
+	return 1;
+}
+
 int w_Channel_demand(lua_State *L)
 {
 	Channel *c = luax_checkchannel(L, 1);
@@ -94,7 +181,9 @@ int w_Channel_peek(lua_State *L)
 {
 	Channel *c = luax_checkchannel(L, 1);
 	Variant var;
-	if (c->peek(&var))
+	bool result = false;
+	luax_catchexcept(L, [&](){ result = c->peek(&var); });
+	if (result)
 		var.toLua(L);
 	else
 		lua_pushnil(L);
@@ -116,6 +205,20 @@ int w_Channel_hasRead(lua_State *L)
 	return 1;
 }
 
+int w_Channel_getCapacity(lua_State *L)
+{
+	Channel *c = luax_checkchannel(L, 1);
+	lua_pushinteger(L, c->getCapacity());
+	return 1;
+}
+
+int w_Channel_isLockFree(lua_State *L)
+{
+	Channel *c = luax_checkchannel(L, 1);
+	luax_pushboolean(L, c->isLockFree());
+	return 1;
+}
+
 int w_Channel_clear(lua_State *L)
 {
 	Channel *c = luax_checkchannel(L, 1);
@@ -128,6 +231,11 @@ int w_Channel_performAtomic(lua_State *L)
 	Channel *c = luax_checkchannel(L, 1);
 	luaL_checktype(L, 2, LUA_TFUNCTION);
 
+	// Lock-free Channels don't take the mutex for their operations, so holding
+	// it wouldn't make anything atomic.
+	if (c->isLockFree())
+		return luaL_error(L, "Lock-free Channels can't perform atomic calls.");
+
 	// Pass this channel as an argument to the function.
 	lua_pushvalue(L, 1);
 	lua_insert(L, 3);
@@ -153,13 +261,18 @@ int w_Channel_performAtomic(lua_State *L)
 static const luaL_Reg w_Channel_functions[] =
 {
 	{ "push", w_Channel_push },
+	{ "pushMove", w_Channel_pushMove },
+	{ "pushMany", w_Channel_pushMany },
 	{ "supply", w_Channel_supply },
 	{ "pop", w_Channel_pop },
+	{ "popMany", w_Channel_popMany },
 	{ "demand", w_Channel_demand },
 	{ "peek", w_Channel_peek },
 	{ "getCount", w_Channel_getCount },
 	{ "hasRead", w_Channel_hasRead },
 	{ "clear", w_Channel_clear },
+	{ "getCapacity", w_Channel_getCapacity },
+	{ "isLockFree", w_Channel_isLockFree },
 	{ "performAtomic", w_Channel_performAtomic },
 	{ 0, 0 }
 };
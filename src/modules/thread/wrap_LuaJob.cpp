@@ -0,0 +1,95 @@
+/**
+ * Copyright (c) 2006-2018 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+#include "wrap_LuaJob.h"
+
+namespace love
+{
+namespace thread
+{
+
+LuaJob *luax_checkjob(lua_State *L, int idx)
+{
+	return luax_checktype<LuaJob>(L, idx);
+}
+
+int w_Job_isDone(lua_State *L)
+{
+	LuaJob *j = luax_checkjob(L, 1);
+	luax_pushboolean(L, j->isDone());
+	return 1;
+}
+
+int w_Job_wait(lua_State *L)
+{
+	LuaJob *j = luax_checkjob(L, 1);
+	double timeout = luaL_optnumber(L, 2, -1.0);
+
+	// Jobs which wait on other jobs help run them, instead of blocking the
+	// worker thread.
+	int worker = JobSystem::getLuaStateWorker(L);
+
+	bool done = false;
+	luax_catchexcept(L, [&]() { done = JobSystem::getInstance()->wait(j, timeout, worker); });
+
+	luax_pushboolean(L, done);
+	return 1;
+}
+
+int w_Job_getResults(lua_State *L)
+{
+	LuaJob *j = luax_checkjob(L, 1);
+	if (!j->isDone())
+		return 0;
+
+	const std::vector<Variant> &results = j->getResults();
+	luaL_checkstack(L, (int) results.size(), nullptr);
+
+	for (const Variant &v : results)
+		v.toLua(L);
+
+	return (int) results.size();
+}
+
+int w_Job_getError(lua_State *L)
+{
+	LuaJob *j = luax_checkjob(L, 1);
+	if (!j->isDone() || j->getError().empty())
+		lua_pushnil(L);
+	else
+		luax_pushstring(L, j->getError());
+	return 1;
+}
+
+static const luaL_Reg w_Job_functions[] =
+{
+	{ "isDone", w_Job_isDone },
+	{ "wait", w_Job_wait },
+	{ "getResults", w_Job_getResults },
+	{ "getError", w_Job_getError },
+	{ 0, 0 }
+};
+
+extern "C" int luaopen_job(lua_State *L)
+{
+	return luax_register_type(L, &LuaJob::type, w_Job_functions, nullptr);
+}
+
+} // thread
+} // love
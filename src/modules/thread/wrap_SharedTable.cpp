@@ -0,0 +1,80 @@
+/**
+ * Copyright (c) 2006-2018 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+#include "wrap_SharedTable.h"
+
+namespace love
+{
+namespace thread
+{
+
+SharedTable *luax_checksharedtable(lua_State *L, int idx)
+{
+	return luax_checktype<SharedTable>(L, idx);
+}
+
+int w_SharedTable_get(lua_State *L)
+{
+	SharedTable *t = luax_checksharedtable(L, 1);
+	int keycount = lua_gettop(L) - 1;
+
+	if (keycount < 1)
+		return luaL_argerror(L, 2, "key expected");
+
+	t->get(L, 2, keycount);
+	return 1;
+}
+
+int w_SharedTable_getLength(lua_State *L)
+{
+	SharedTable *t = luax_checksharedtable(L, 1);
+	lua_pushnumber(L, (lua_Number) t->getLength());
+	return 1;
+}
+
+int w_SharedTable_getKeys(lua_State *L)
+{
+	SharedTable *t = luax_checksharedtable(L, 1);
+	t->pushKeys(L);
+	return 1;
+}
+
+int w_SharedTable_getMemorySize(lua_State *L)
+{
+	SharedTable *t = luax_checksharedtable(L, 1);
+	lua_pushnumber(L, (lua_Number) t->getMemorySize());
+	return 1;
+}
+
+static const luaL_Reg w_SharedTable_functions[] =
+{
+	{ "get", w_SharedTable_get },
+	{ "getLength", w_SharedTable_getLength },
+	{ "getKeys", w_SharedTable_getKeys },
+	{ "getMemorySize", w_SharedTable_getMemorySize },
+	{ 0, 0 }
+};
+
+extern "C" int luaopen_sharedtable(lua_State *L)
+{
+	return luax_register_type(L, &SharedTable::type, w_SharedTable_functions, nullptr);
+}
+
+} // thread
+} // love
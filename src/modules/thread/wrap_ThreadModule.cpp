@@ -22,6 +22,8 @@
 #include "wrap_ThreadModule.h"
 #include "wrap_LuaThread.h"
 #include "wrap_Channel.h"
+#include "wrap_LuaJob.h"
+#include "wrap_SharedTable.h"
 #include "ThreadModule.h"
 
 #include "filesystem/File.h"
@@ -37,43 +39,45 @@ namespace thread
 
 #define instance() (Module::getInstance<ThreadModule>(Module::M_THREAD))
 
-int w_newThread(lua_State *L)
+// Gets Lua code from a filename, a string of code, a File, or a Data.
+static love::Data *checkCode(lua_State *L, int idx, std::string &name)
 {
-	std::string name = "Thread code";
-	love::Data *data = nullptr;
-
-	if (lua_isstring(L, 1))
+	if (lua_isstring(L, idx))
 	{
 		size_t slen = 0;
-		const char *str = lua_tolstring(L, 1, &slen);
+		const char *str = lua_tolstring(L, idx, &slen);
 
 		// Treat the string as Lua code if it's long or has a newline.
 		if (slen >= 1024 || memchr(str, '\n', slen))
 		{
 			// Construct a FileData from the string.
-			lua_pushvalue(L, 1);
+			lua_pushvalue(L, idx);
 			lua_pushstring(L, "string");
 			int idxs[] = {lua_gettop(L) - 1, lua_gettop(L)};
 			luax_convobj(L, idxs, 2, "filesystem", "newFileData");
 			lua_pop(L, 1);
-			lua_replace(L, 1);
+			lua_replace(L, idx);
 		}
 		else
-			luax_convobj(L, 1, "filesystem", "newFileData");
+			luax_convobj(L, idx, "filesystem", "newFileData");
 	}
-	else if (luax_istype(L, 1, love::filesystem::File::type))
-		luax_convobj(L, 1, "filesystem", "newFileData");
+	else if (luax_istype(L, idx, love::filesystem::File::type))
+		luax_convobj(L, idx, "filesystem", "newFileData");
 
-	if (luax_istype(L, 1, love::filesystem::FileData::type))
+	if (luax_istype(L, idx, love::filesystem::FileData::type))
 	{
-		love::filesystem::FileData *fdata = luax_checktype<love::filesystem::FileData>(L, 1);
+		love::filesystem::FileData *fdata = luax_checktype<love::filesystem::FileData>(L, idx);
 		name = std::string("@") + fdata->getFilename();
-		data = fdata;
+		return fdata;
 	}
 	else
-	{
-		data = luax_checktype<love::Data>(L, 1);
-	}
+		return luax_checktype<love::Data>(L, idx);
+}
+
+int w_newThread(lua_State *L)
+{
+	std::string name = "Thread code";
+	love::Data *data = checkCode(L, 1, name);
 
 	LuaThread *t = instance()->newThread(name, data);
 	luax_pushtype(L, t);
@@ -83,7 +87,24 @@ int w_newThread(lua_State *L)
 
 int w_newChannel(lua_State *L)
 {
-	Channel *c = instance()->newChannel();
+	int capacity = 0;
+	bool lockFree = false;
+
+	if (lua_istable(L, 1))
+	{
+		lua_getfield(L, 1, "capacity");
+		capacity = (int) luaL_optinteger(L, -1, 0);
+		lua_pop(L, 1);
+
+		lua_getfield(L, 1, "lockfree");
+		lockFree = luax_toboolean(L, -1);
+		lua_pop(L, 1);
+	}
+	else if (!lua_isnoneornil(L, 1))
+		return luax_typerror(L, 1, "table");
+
+	Channel *c = nullptr;
+	luax_catchexcept(L, [&](){ c = instance()->newChannel(capacity, lockFree); });
 	luax_pushtype(L, c);
 	c->release();
 	return 1;
@@ -98,18 +119,105 @@ int w_getChannel(lua_State *L)
 	return 1;
 }
 
+int w_newSharedTable(lua_State *L)
+{
+	luaL_checktype(L, 1, LUA_TTABLE);
+
+	SharedTable *t = nullptr;
+	luax_catchexcept(L, [&](){ t = SharedTable::fromLua(L, 1); });
+	luax_pushtype(L, t);
+	t->release();
+	return 1;
+}
+
+int w_submit(lua_State *L)
+{
+	std::string name = "Job code";
+	love::Data *data = checkCode(L, 1, name);
+
+	std::vector<Variant> args;
+	int nargs = lua_gettop(L) - 1;
+
+	for (int i = 0; i < nargs; ++i)
+	{
+		luax_catchexcept(L, [&]() {
+			args.push_back(Variant::fromLua(L, i+2));
+		});
+
+		if (args.back().getType() == Variant::UNKNOWN)
+		{
+			args.clear();
+			return luaL_argerror(L, i+2, "boolean, number, string, love type, or flat table expected");
+		}
+	}
+
+	LuaJob *j = nullptr;
+	luax_catchexcept(L, [&](){ j = instance()->submit(name, data, args); });
+	luax_pushtype(L, j);
+	j->release();
+	return 1;
+}
+
+int w_getWorkerCount(lua_State *L)
+{
+	int count = 0;
+	luax_catchexcept(L, [&](){ count = instance()->getWorkerCount(); });
+	lua_pushinteger(L, count);
+	return 1;
+}
+
+int w_setStatePoolSize(lua_State *L)
+{
+	int size = (int) luaL_checkinteger(L, 1);
+	luax_catchexcept(L, [&](){ LuaStatePool::setSize(size); });
+	return 0;
+}
+
+int w_getStatePoolSize(lua_State *L)
+{
+	lua_pushinteger(L, LuaStatePool::getSize());
+	return 1;
+}
+
+int w_setBytecodeCacheEnabled(lua_State *L)
+{
+	LuaStatePool::setBytecodeCacheEnabled(luax_checkboolean(L, 1));
+	return 0;
+}
+
+int w_isBytecodeCacheEnabled(lua_State *L)
+{
+	luax_pushboolean(L, LuaStatePool::isBytecodeCacheEnabled());
+	return 1;
+}
+
+static int w_luauser__gc(lua_State *)
+{
+	ThreadModule::removeLuaUser();
+	return 0;
+}
+
 // List of functions to wrap.
 static const luaL_Reg module_functions[] =
 {
 	{ "newThread", w_newThread },
 	{ "newChannel", w_newChannel },
 	{ "getChannel", w_getChannel },
+	{ "newSharedTable", w_newSharedTable },
+	{ "submit", w_submit },
+	{ "getWorkerCount", w_getWorkerCount },
+	{ "setStatePoolSize", w_setStatePoolSize },
+	{ "getStatePoolSize", w_getStatePoolSize },
+	{ "setBytecodeCacheEnabled", w_setBytecodeCacheEnabled },
+	{ "isBytecodeCacheEnabled", w_isBytecodeCacheEnabled },
 	{ 0, 0 }
 };
 
 static const lua_CFunction types[] = {
 	luaopen_thread,
 	luaopen_channel,
+	luaopen_job,
+	luaopen_sharedtable,
 	0
 };
 
@@ -123,6 +231,25 @@ extern "C" int luaopen_love_thread(lua_State *L)
 	else
 		instance->retain();
 
+	// The JobSystem's worker threads and the pooled Lua states are cleaned up
+	// once the last state which can use them is closed. States owned by the
+	// workers and the pool don't count, since they're only closed as part of
+	// that cleanup.
+	if (JobSystem::getLuaStateWorker(L) < 0 && !LuaStatePool::isPooled(L))
+	{
+		ThreadModule::addLuaUser();
+
+		// Any old data that we can attach a metatable to, for __gc.
+		lua_newuserdata(L, sizeof(int));
+
+		luaL_newmetatable(L, "love_threaduser");
+		lua_pushcfunction(L, w_luauser__gc);
+		lua_setfield(L, -2, "__gc");
+		lua_setmetatable(L, -2);
+
+		lua_setfield(L, LUA_REGISTRYINDEX, "_love_threaduser");
+	}
+
 	WrappedModule w;
 	w.module = instance;
 	w.name = "thread";
@@ -24,6 +24,10 @@
 #include "common/delay.h"
 #include "Timer.h"
 
+// C++
+#include <algorithm>
+#include <cmath>
+
 #if defined(LOVE_WINDOWS)
 #include <windows.h>
 #elif defined(LOVE_MACOSX) || defined(LOVE_IOS)
@@ -49,6 +53,8 @@ namespace love
 namespace timer
 {
 
+const double Timer::FRAME_HISTOGRAM_BIN_WIDTH = 0.00025;
+
 Timer::Timer()
 	: currTime(0)
 	, prevFpsUpdate(0)
@@ -57,8 +63,16 @@ Timer::Timer()
 	, fpsUpdateFrequency(1)
 	, frames(0)
 	, dt(0)
+	, stepped(false)
+	, frameTarget(0)
+	, nextFrameTime(0)
+	, sleepMean(0.002)
+	, sleepVariance(0)
+	, frameTimeHead(0)
+	, frameTimeCount(0)
 {
 	prevFpsUpdate = currTime = getTime();
+	resetFrameTimes();
 }
 
 double Timer::step()
@@ -85,6 +99,11 @@ double Timer::step()
 		frames = 0;
 	}
 
+	if (stepped)
+		recordFrameTime(dt);
+
+	stepped = true;
+
 	return dt;
 }
 
@@ -109,6 +128,120 @@ double Timer::getAverageDelta() const
 	return averageDelta;
 }
 
+void Timer::setFrameTarget(double hz)
+{
+	frameTarget = std::max(hz, 0.0);
+	nextFrameTime = 0;
+}
+
+double Timer::getFrameTarget() const
+{
+	return frameTarget;
+}
+
+void Timer::waitForNextFrame()
+{
+	if (frameTarget <= 0)
+	{
+		sleep(0.001);
+		return;
+	}
+
+	double period = 1.0 / frameTarget;
+	double now = getTime();
+
+	// Deadlines advance by exactly one period so small overshoots don't
+	// accumulate into drift. If we're more than a frame behind (a hitch, or
+	// the first frame) we start over from now instead of rushing through
+	// frames to catch up.
+	nextFrameTime += period;
+	if (nextFrameTime < now - period)
+		nextFrameTime = now;
+
+	sleepUntil(nextFrameTime);
+}
+
+void Timer::sleepUntil(double time)
+{
+	double now = getTime();
+
+	// Sleep in 1ms steps while the remaining time comfortably exceeds what a
+	// 1ms sleep has been observed to take, and keep refining that estimate.
+	while (time - now > sleepMean + std::sqrt(sleepVariance))
+	{
+		love::sleep(1);
+
+		double after = getTime();
+		double observed = after - now;
+		now = after;
+
+		const double alpha = 0.05;
+		double delta = observed - sleepMean;
+		sleepMean += alpha * delta;
+		sleepVariance = (1.0 - alpha) * (sleepVariance + alpha * delta * delta);
+	}
+
+	// The scheduler can't be trusted with the rest.
+	while (now < time)
+		now = getTime();
+}
+
+void Timer::recordFrameTime(double seconds)
+{
+	frameTimes[frameTimeHead] = seconds;
+	frameTimeHead = (frameTimeHead + 1) % FRAME_HISTORY_SIZE;
+	frameTimeCount = std::min(frameTimeCount + 1, (int) FRAME_HISTORY_SIZE);
+
+	int bin = (int) (seconds / FRAME_HISTOGRAM_BIN_WIDTH);
+	bin = std::max(std::min(bin, FRAME_HISTOGRAM_BINS - 1), 0);
+	frameHistogram[bin]++;
+}
+
+int Timer::getFrameTimes(double *times, int max) const
+{
+	int count = std::min(std::max(max, 0), frameTimeCount);
+	int first = frameTimeHead - count + FRAME_HISTORY_SIZE;
+
+	for (int i = 0; i < count; i++)
+		times[i] = frameTimes[(first + i) % FRAME_HISTORY_SIZE];
+
+	return count;
+}
+
+int Timer::getFrameTimeCount() const
+{
+	return frameTimeCount;
+}
+
+double Timer::getFrameTimePercentile(double percentile)
+{
+	if (frameTimeCount == 0)
+		return 0.0;
+
+	int count = getFrameTimes(sortedFrameTimes, frameTimeCount);
+
+	// Nearest-rank percentile.
+	double rank = std::ceil(percentile / 100.0 * count);
+	int index = std::min(std::max((int) rank - 1, 0), count - 1);
+
+	std::nth_element(sortedFrameTimes, sortedFrameTimes + index, sortedFrameTimes + count);
+	return sortedFrameTimes[index];
+}
+
+const uint32 *Timer::getFrameTimeHistogram() const
+{
+	return frameHistogram;
+}
+
+void Timer::resetFrameTimes()
+{
+	frameTimeHead = 0;
+	frameTimeCount = 0;
+
+	for (int i = 0; i < FRAME_HISTOGRAM_BINS; i++)
+		frameHistogram[i] = 0;
+}
+
 double Timer::getTimerPeriod()
 {
 #if defined(LOVE_MACOSX) || defined(LOVE_IOS)
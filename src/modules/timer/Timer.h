@@ -23,6 +23,7 @@
 
 // LOVE
 #include "common/Module.h"
+#include "common/int.h"
 
 namespace love
 {
@@ -79,6 +80,53 @@ public:
 	 **/
 	static double getTime();
 
+	/**
+	 * Sets the rate at which waitForNextFrame paces frames.
+	 * @param hz The target frame rate, or 0 to disable pacing.
+	 **/
+	void setFrameTarget(double hz);
+	double getFrameTarget() const;
+
+	/**
+	 * Waits until the next frame should start. With a frame target this
+	 * sleeps most of the remaining time and spin-waits the rest, so frames
+	 * start at a steady cadence. Without one it sleeps for 1ms.
+	 **/
+	void waitForNextFrame();
+
+	/**
+	 * Waits until getTime() reaches the given time, using a sleep for as
+	 * much of the interval as the OS scheduler can be trusted with and a
+	 * spin-wait for the remainder.
+	 **/
+	void sleepUntil(double time);
+
+	/**
+	 * Copies the most recent frame durations (as measured by step) into
+	 * 'times', oldest first.
+	 * @return The number of durations copied.
+	 **/
+	int getFrameTimes(double *times, int max) const;
+	int getFrameTimeCount() const;
+
+	/**
+	 * Gets a percentile (0-100) of the recent frame durations.
+	 **/
+	double getFrameTimePercentile(double percentile);
+
+	/**
+	 * Gets the histogram of all frame durations recorded since the last
+	 * reset. Each bin is FRAME_HISTOGRAM_BIN_WIDTH seconds wide, and the
+	 * last bin also counts all longer frames.
+	 **/
+	const uint32 *getFrameTimeHistogram() const;
+
+	void resetFrameTimes();
+
+	static const int FRAME_HISTORY_SIZE = 256;
+	static const int FRAME_HISTOGRAM_BINS = 200;
+	static const double FRAME_HISTOGRAM_BIN_WIDTH;
+
 private:
 
 	// Frame delta vars.
@@ -99,6 +147,30 @@ private:
 	// The current timestep.
 	double dt;
 
+	// Whether step has been called before. The first step measures the time
+	// since startup rather than a frame, so it isn't recorded.
+	bool stepped;
+
+	// Frame pacing.
+	double frameTarget;
+	double nextFrameTime;
+
+	// Running estimate of how long a 1ms sleep actually takes.
+	double sleepMean;
+	double sleepVariance;
+
+	// Ring buffer of recent frame durations.
+	double frameTimes[FRAME_HISTORY_SIZE];
+	int frameTimeHead;
+	int frameTimeCount;
+
+	// Scratch space for percentile queries, so they don't allocate.
+	double sortedFrameTimes[FRAME_HISTORY_SIZE];
+
+	uint32 frameHistogram[FRAME_HISTOGRAM_BINS];
+
+	void recordFrameTime(double seconds);
+
 	// Returns the timer period on some platforms.
 	static double getTimerPeriod();
 
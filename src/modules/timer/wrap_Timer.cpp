@@ -66,6 +66,108 @@ int w_getTime(lua_State *L)
 	return 1;
 }
 
+int w_setFrameTarget(lua_State *L)
+{
+	instance()->setFrameTarget(luaL_optnumber(L, 1, 0.0));
+	return 0;
+}
+
+int w_getFrameTarget(lua_State *L)
+{
+	lua_pushnumber(L, instance()->getFrameTarget());
+	return 1;
+}
+
+int w_waitForNextFrame(lua_State *L)
+{
+	instance()->waitForNextFrame();
+	return 0;
+}
+
+int w_getFrameTimes(lua_State *L)
+{
+	double times[Timer::FRAME_HISTORY_SIZE];
+	int count = instance()->getFrameTimes(times, Timer::FRAME_HISTORY_SIZE);
+
+	// Reuse the given table if there is one.
+	if (lua_istable(L, 1))
+		lua_settop(L, 1);
+	else
+	{
+		lua_settop(L, 0);
+		lua_createtable(L, count, 0);
+	}
+
+	for (int i = 0; i < count; i++)
+	{
+		lua_pushnumber(L, times[i]);
+		lua_rawseti(L, 1, i + 1);
+	}
+
+	int oldcount = (int) luax_objlen(L, 1);
+	for (int i = count + 1; i <= oldcount; i++)
+	{
+		lua_pushnil(L);
+		lua_rawseti(L, 1, i);
+	}
+
+	lua_pushinteger(L, count);
+	return 2;
+}
+
+int w_getFrameTimePercentiles(lua_State *L)
+{
+	int nargs = lua_gettop(L);
+
+	if (nargs == 0)
+	{
+		lua_pushnumber(L, instance()->getFrameTimePercentile(50));
+		lua_pushnumber(L, instance()->getFrameTimePercentile(95));
+		lua_pushnumber(L, instance()->getFrameTimePercentile(99));
+		return 3;
+	}
+
+	for (int i = 1; i <= nargs; i++)
+	{
+		double percentile = luaL_checknumber(L, i);
+		if (percentile < 0 || percentile > 100)
+			return luaL_error(L, "Invalid percentile: %f (expected a value between 0 and 100)", percentile);
+	}
+
+	for (int i = 1; i <= nargs; i++)
+		lua_pushnumber(L, instance()->getFrameTimePercentile(lua_tonumber(L, i)));
+
+	return nargs;
+}
+
+int w_getFrameTimeHistogram(lua_State *L)
+{
+	const uint32 *histogram = instance()->getFrameTimeHistogram();
+
+	if (lua_istable(L, 1))
+		lua_settop(L, 1);
+	else
+	{
+		lua_settop(L, 0);
+		lua_createtable(L, Timer::FRAME_HISTOGRAM_BINS, 0);
+	}
+
+	for (int i = 0; i < Timer::FRAME_HISTOGRAM_BINS; i++)
+	{
+		lua_pushnumber(L, (lua_Number) histogram[i]);
+		lua_rawseti(L, 1, i + 1);
+	}
+
+	lua_pushnumber(L, Timer::FRAME_HISTOGRAM_BIN_WIDTH);
+	return 2;
+}
+
+int w_resetFrameTimes(lua_State *L)
+{
+	instance()->resetFrameTimes();
+	return 0;
+}
+
 // List of functions to wrap.
 static const luaL_Reg functions[] =
 {
@@ -75,6 +177,13 @@ static const luaL_Reg functions[] =
 	{ "getAverageDelta", w_getAverageDelta },
 	{ "sleep", w_sleep },
 	{ "getTime", w_getTime },
+	{ "setFrameTarget", w_setFrameTarget },
+	{ "getFrameTarget", w_getFrameTarget },
+	{ "waitForNextFrame", w_waitForNextFrame },
+	{ "getFrameTimes", w_getFrameTimes },
+	{ "getFrameTimePercentiles", w_getFrameTimePercentiles },
+	{ "getFrameTimeHistogram", w_getFrameTimeHistogram },
+	{ "resetFrameTimes", w_resetFrameTimes },
 	{ 0, 0 }
 };
 
@@ -412,6 +412,7 @@ function love.init()
 			audio = true,
 			math = true,
 			physics = true,
+			profiler = true,
 			sound = true,
 			system = true,
 			font = true,
@@ -469,6 +470,7 @@ function love.init()
 	for k,v in ipairs{
 		"data",
 		"thread",
+		"profiler",
 		"timer",
 		"event",
 		"keyboard",
@@ -608,7 +610,7 @@ function love.run()
 			love.graphics.present()
 		end
 
-		if love.timer then love.timer.sleep(0.001) end
+		if love.timer then love.timer.waitForNextFrame() end
 	end
 
 end